@@ -32,11 +32,11 @@ namespace Forsyth
     //-----------------------------------------------------------------------------
     //  Parameters:
     //      indexList
-    //          input index list
+    //          input index list, using 16-bit or 32-bit indices
     //      indexCount
     //          the number of indices in the list
     //      vertexCount
-    //          the largest index value in indexList
+    //          one greater than the largest index value in indexList
     //      newIndexList
     //          a pointer to a preallocated buffer the same size as indexList to
     //          hold the optimized index list
@@ -44,6 +44,7 @@ namespace Forsyth
     //          the size of the simulated post-transform cache (max:64)
     //-----------------------------------------------------------------------------
     void OptimizeFaces(const uint16* indexList, uint indexCount, uint vertexCount, uint16* newIndexList, uint16 lruCacheSize);
+    void OptimizeFaces(const uint* indexList, uint indexCount, uint vertexCount, uint* newIndexList, uint16 lruCacheSize);
     
     namespace
     {
@@ -173,7 +174,8 @@ namespace Forsyth
         };
     }
     
-    void OptimizeFaces(const uint16* indexList, uint indexCount, uint vertexCount, uint16* newIndexList, uint16 lruCacheSize)
+    template <typename IndexType>
+    void OptimizeFacesImpl(const IndexType* indexList, uint indexCount, uint vertexCount, IndexType* newIndexList, uint16 lruCacheSize)
     {
         std::vector<OptimizeVertexData> vertexDataList;
         vertexDataList.resize(vertexCount);
@@ -181,7 +183,7 @@ namespace Forsyth
         // compute face count per vertex
         for (uint i=0; i<indexCount; ++i)
         {
-            uint16 index = indexList[i];
+            IndexType index = indexList[i];
             assert(index < vertexCount);
             OptimizeVertexData& vertexData = vertexDataList[index];
             vertexData.activeFaceListSize++;
@@ -212,7 +214,7 @@ namespace Forsyth
         {
             for (uint j=0; j<3; ++j)
             {
-                uint16 index = indexList[i+j];
+                IndexType index = indexList[i+j];
                 OptimizeVertexData& vertexData = vertexDataList[index];
                 activeFaceList[vertexData.activeFaceListStart + vertexData.activeFaceListSize] = i;
                 vertexData.activeFaceListSize++;
@@ -222,9 +224,9 @@ namespace Forsyth
         std::vector<byte> processedFaceList;
         processedFaceList.resize(indexCount);
         
-        uint16 vertexCacheBuffer[(kMaxVertexCacheSize+3)*2];
-        uint16* cache0 = vertexCacheBuffer;
-        uint16* cache1 = vertexCacheBuffer+(kMaxVertexCacheSize+3);
+        IndexType vertexCacheBuffer[(kMaxVertexCacheSize+3)*2];
+        IndexType* cache0 = vertexCacheBuffer;
+        IndexType* cache1 = vertexCacheBuffer+(kMaxVertexCacheSize+3);
         uint16 entriesInCache0 = 0;
         
         uint bestFace = 0;
@@ -246,7 +248,7 @@ namespace Forsyth
                         float faceScore = 0.f;
                         for (uint k=0; k<3; ++k)
                         {
-                            uint16 index = indexList[face+k];
+                            IndexType index = indexList[face+k];
                             OptimizeVertexData& vertexData = vertexDataList[index];
                             assert(vertexData.activeFaceListSize > 0);
                             assert(vertexData.cachePos0 >= lruCacheSize);
@@ -275,7 +277,7 @@ namespace Forsyth
             // add bestFace to LRU cache and to newIndexList
             for (uint v = 0; v < 3; ++v)
             {
-                uint16 index = indexList[bestFace+v];
+                IndexType index = indexList[bestFace+v];
                 newIndexList[i+v] = index;
                 
                 OptimizeVertexData& vertexData = vertexDataList[index];
@@ -306,7 +308,7 @@ namespace Forsyth
             // move the rest of the old verts in the cache down and compute their new scores
             for (uint c0 = 0; c0 < entriesInCache0; ++c0)
             {
-                uint16 index = cache0[c0];
+                IndexType index = cache0[c0];
                 OptimizeVertexData& vertexData = vertexDataList[index];
                 
                 if (vertexData.cachePos1 >= entriesInCache1)
@@ -321,7 +323,7 @@ namespace Forsyth
             bestScore = -1.f;
             for (uint c1 = 0; c1 < entriesInCache1; ++c1)
             {
-                uint16 index = cache1[c1];
+                IndexType index = cache1[c1];
                 OptimizeVertexData& vertexData = vertexDataList[index];
                 vertexData.cachePos0 = vertexData.cachePos1;
                 vertexData.cachePos1 = kEvictedCacheIndex;
@@ -331,7 +333,7 @@ namespace Forsyth
                     float faceScore = 0.f;
                     for (uint v=0; v<3; v++)
                     {
-                        uint16 faceIndex = indexList[face+v];
+                        IndexType faceIndex = indexList[face+v];
                         OptimizeVertexData& faceVertexData = vertexDataList[faceIndex];
                         faceScore += faceVertexData.score;
                     }
@@ -347,5 +349,15 @@ namespace Forsyth
             entriesInCache0 = std::min(entriesInCache1, lruCacheSize);
         }
     }
+
+    void OptimizeFaces(const uint16* indexList, uint indexCount, uint vertexCount, uint16* newIndexList, uint16 lruCacheSize)
+    {
+        OptimizeFacesImpl(indexList, indexCount, vertexCount, newIndexList, lruCacheSize);
+    }
+
+    void OptimizeFaces(const uint* indexList, uint indexCount, uint vertexCount, uint* newIndexList, uint16 lruCacheSize)
+    {
+        OptimizeFacesImpl(indexList, indexCount, vertexCount, newIndexList, lruCacheSize);
+    }
     
 } // namespace Forsyth
\ No newline at end of file
@@ -27,11 +27,11 @@ namespace Forsyth {
     //-----------------------------------------------------------------------------
     //  Parameters:
     //      indexList
-    //          input index list
+    //          input index list, using 16-bit or 32-bit indices
     //      indexCount
     //          the number of indices in the list
     //      vertexCount
-    //          the largest index value in indexList
+    //          one greater than the largest index value in indexList
     //      newIndexList
     //          a pointer to a preallocated buffer the same size as indexList to
     //          hold the optimized index list
@@ -39,6 +39,7 @@ namespace Forsyth {
     //          the size of the simulated post-transform cache (max:64)
     //-----------------------------------------------------------------------------
     void OptimizeFaces(const uint16* indexList, uint indexCount, uint vertexCount, uint16* newIndexList, uint16 lruCacheSize);
+    void OptimizeFaces(const uint* indexList, uint indexCount, uint vertexCount, uint* newIndexList, uint16 lruCacheSize);
 };
 
 #endif
@@ -40,6 +40,7 @@
 #include "resources/bundle/KRBundle.h"
 #include "KRPresentationThread.h"
 #include "KRStreamerThread.h"
+#include "KRThreadPool.h"
 
 #if defined(ANDROID)
 #include <chrono>
@@ -73,14 +74,12 @@ KRContext::KRContext(const KrInitializeInfo* initializeInfo)
   : m_resourceMapSize(initializeInfo->resourceMapSize)
   , m_resourceMap(nullptr)
   , m_nodeMapSize(initializeInfo->nodeMapSize)
-  , m_nodeMap(nullptr)
 {
   m_presentationThread = std::make_unique<KRPresentationThread>(*this);
   m_streamerThread = std::make_unique<KRStreamerThread>(*this);
+  m_threadPool = std::make_unique<KRThreadPool>();
   m_resourceMap = (KRResource**)malloc(sizeof(KRResource*) * m_resourceMapSize);
   memset(m_resourceMap, 0, m_resourceMapSize * sizeof(KRResource*));
-  m_nodeMap = (KRNode**)malloc(sizeof(KRNode*) * m_nodeMapSize);
-  memset(m_nodeMap, 0, m_nodeMapSize * sizeof(KRNode*));
   m_streamingEnabled = false;
 #ifdef __APPLE__
   mach_timebase_info(&m_timebase_info);
@@ -117,12 +116,14 @@ KRContext::KRContext(const KrInitializeInfo* initializeInfo)
 
   m_presentationThread->start();
   m_streamerThread->start();
+  m_threadPool->start();
 }
 
 KRContext::~KRContext()
 {
   m_presentationThread->stop();
   m_streamerThread->stop();
+  m_threadPool->stop();
   m_pSceneManager.reset();
   m_pMeshManager.reset();
   m_pMaterialManager.reset();
@@ -152,10 +153,6 @@ KRContext::~KRContext()
     delete m_resourceMap;
     m_resourceMap = nullptr;
   }
-  if (m_nodeMap) {
-    delete m_nodeMap;
-    m_nodeMap = nullptr;
-  }
 }
 
 void KRContext::SetLogCallback(log_callback* log_callback, void* user_data)
@@ -260,6 +257,10 @@ KRUniformBufferManager* KRContext::getUniformBufferManager()
 {
   return m_uniformBufferManager.get();
 }
+KRThreadPool* KRContext::getThreadPool()
+{
+  return m_threadPool.get();
+}
 KRUnknownManager* KRContext::getUnknownManager()
 {
   return m_pUnknownManager.get();
@@ -327,7 +328,7 @@ KRResource* KRContext::loadResource(const std::string& file_name, Block* data)
     resource = m_pBundleManager->loadBundle(name.c_str(), data);
   } else if (extension.compare("krmesh") == 0) {
     resource = m_pMeshManager->loadMesh(name.c_str(), data);
-  } else if (extension.compare("krscene") == 0) {
+  } else if (extension.compare("krscene") == 0 || extension.compare("krscenebin") == 0) {
     resource = m_pSceneManager->loadScene(name.c_str(), data);
   } else if (extension.compare("kranimation") == 0) {
     resource = m_pAnimationManager->loadAnimation(name.c_str(), data);
@@ -489,6 +490,20 @@ KrResult KRContext::createScene(const KrCreateSceneInfo* createSceneInfo)
   return KR_SUCCESS;
 }
 
+KrResult KRContext::setSceneFormat(const KrSetSceneFormatInfo* setSceneFormatInfo)
+{
+  if (setSceneFormatInfo->format < 0 || setSceneFormatInfo->format >= KR_SCENE_FORMAT_MAX_ENUM) {
+    return KR_ERROR_OUT_OF_BOUNDS;
+  }
+  KRScene* scene = nullptr;
+  KrResult res = getMappedResource<KRScene>(setSceneFormatInfo->sceneHandle, &scene);
+  if (res != KR_SUCCESS) {
+    return res;
+  }
+  scene->setBinaryFormat(setSceneFormatInfo->format == KR_SCENE_FORMAT_BINARY);
+  return KR_SUCCESS;
+}
+
 KrResult KRContext::createBundle(const KrCreateBundleInfo* createBundleInfo)
 {
   if (createBundleInfo->resourceHandle < 0 || createBundleInfo->resourceHandle >= m_resourceMapSize) {
@@ -548,6 +563,52 @@ KrResult KRContext::compileAllShaders(const KrCompileAllShadersInfo* pCompileAll
   return KR_ERROR_SHADER_COMPILE_FAILED;
 }
 
+KrResult KRContext::compressAnimationCurve(const KrCompressAnimationCurveInfo* pCompressAnimationCurveInfo)
+{
+  if (pCompressAnimationCurveInfo->tolerance < 0.0f) {
+    return KR_ERROR_OUT_OF_BOUNDS;
+  }
+  KRAnimationCurve* curve = nullptr;
+  KrResult res = getMappedResource<KRAnimationCurve>(pCompressAnimationCurveInfo->resourceHandle, &curve);
+  if (res != KR_SUCCESS) {
+    return res;
+  }
+  if (!curve->compress(pCompressAnimationCurveInfo->tolerance)) {
+    // An active animation is sampling the curve data
+    return KR_ERROR_RESOURCE_IN_USE;
+  }
+  return KR_SUCCESS;
+}
+
+KrResult KRContext::compressTexture(const KrCompressTextureInfo* pCompressTextureInfo)
+{
+  if (pCompressTextureInfo->format < 0 || pCompressTextureInfo->format >= KR_TEXTURE_COMPRESSION_FORMAT_MAX_ENUM ||
+    pCompressTextureInfo->quality < 0 || pCompressTextureInfo->quality >= KR_TEXTURE_COMPRESSION_QUALITY_MAX_ENUM) {
+    return KR_ERROR_OUT_OF_BOUNDS;
+  }
+  KRTexture* texture = nullptr;
+  KrResult res = getMappedResource<KRTexture>(pCompressTextureInfo->resourceHandle, &texture);
+  if (res != KR_SUCCESS) {
+    return res;
+  }
+  if (!m_pTextureManager->canReplaceTextures()) {
+    // Materials and in-flight frames may reference the texture once rendering starts
+    return KR_ERROR_RESOURCE_IN_USE;
+  }
+  KRTexture* compressed_texture = m_pTextureManager->compressTexture(texture, pCompressTextureInfo->format, pCompressTextureInfo->quality, pCompressTextureInfo->premultiplyAlpha);
+  if (compressed_texture == nullptr) {
+    // Already compressed, or not in a format that can be compressed
+    return KR_ERROR_INCORRECT_TYPE;
+  }
+  // The original texture has been deleted; remap every handle to it
+  for (size_t i = 0; i < m_resourceMapSize; i++) {
+    if (m_resourceMap[i] == texture) {
+      m_resourceMap[i] = compressed_texture;
+    }
+  }
+  return KR_SUCCESS;
+}
+
 KrResult KRContext::saveResource(const KrSaveResourceInfo* saveResourceInfo)
 {
   KRResource* resource = nullptr;
@@ -567,6 +628,7 @@ void KRContext::startFrame(float deltaTime)
   m_pAnimationManager->startFrame(deltaTime);
   m_pSoundManager->startFrame(deltaTime);
   m_pMeshManager->startFrame(deltaTime);
+  m_pPipelineManager->startFrame(deltaTime);
 }
 
 void KRContext::endFrame(float deltaTime)
@@ -709,12 +771,63 @@ void KRContext::receivedMemoryWarning()
 
 KrResult KRContext::findNodeByName(const KrFindNodeByNameInfo* pFindNodeByNameInfo)
 {
-  return KR_ERROR_NOT_IMPLEMENTED;
+  KRScene* scene = nullptr;
+  KrResult res = getMappedResource<KRScene>(pFindNodeByNameInfo->sceneHandle, &scene);
+  if (res != KR_SUCCESS) {
+    return res;
+  }
+  if (pFindNodeByNameInfo->nodeHandle <= KR_NULL_HANDLE || pFindNodeByNameInfo->nodeHandle >= m_nodeMapSize) {
+    return KR_ERROR_OUT_OF_BOUNDS;
+  }
+  if (pFindNodeByNameInfo->pName == nullptr) {
+    return KR_ERROR_NOT_FOUND;
+  }
+
+  std::vector<KRNode*> matches;
+  scene->findAll<KRNode>(pFindNodeByNameInfo->pName, matches);
+  if (matches.empty()) {
+    return KR_ERROR_NOT_FOUND;
+  }
+  if (matches.size() > 1) {
+    return KR_ERROR_AMBIGUOUS_MATCH;
+  }
+  scene->setNodeHandle(pFindNodeByNameInfo->nodeHandle, matches.front());
+  return KR_SUCCESS;
 }
 
 KrResult KRContext::findAdjacentNodes(const KrFindAdjacentNodesInfo* pFindAdjacentNodesInfo)
 {
-  return KR_ERROR_NOT_IMPLEMENTED;
+  KRScene* scene = nullptr;
+  KrResult res = getMappedResource<KRScene>(pFindAdjacentNodesInfo->sceneHandle, &scene);
+  if (res != KR_SUCCESS) {
+    return res;
+  }
+  KRNode* node = nullptr;
+  res = getMappedNode(pFindAdjacentNodesInfo->nodeHandle, scene, &node);
+  if (res != KR_SUCCESS) {
+    return res;
+  }
+
+  // Adjacent nodes are only mapped to handles that are not KR_NULL_HANDLE.
+  // Handles are un-mapped when there is no adjacent node in that position.
+  const std::pair<KrSceneNodeMapIndex, KRNode*> adjacentNodes[] = {
+    { pFindAdjacentNodesInfo->parentNodeHandle, node->getParent() },
+    { pFindAdjacentNodesInfo->priorNodeHandle, node->m_previousNode },
+    { pFindAdjacentNodesInfo->nextNodeHandle, node->m_nextNode },
+    { pFindAdjacentNodesInfo->firstChildNodeHandle, node->m_firstChildNode },
+    { pFindAdjacentNodesInfo->lastChildNodeHandle, node->m_lastChildNode }
+  };
+  for (const auto& adjacent : adjacentNodes) {
+    if (adjacent.first < KR_NULL_HANDLE || adjacent.first >= m_nodeMapSize) {
+      return KR_ERROR_OUT_OF_BOUNDS;
+    }
+  }
+  for (const auto& adjacent : adjacentNodes) {
+    if (adjacent.first != KR_NULL_HANDLE) {
+      scene->setNodeHandle(adjacent.first, adjacent.second);
+    }
+  }
+  return KR_SUCCESS;
 }
 
 KrResult KRContext::setNodeLocalTransform(const KrSetNodeLocalTransformInfo* pSetNodeLocalTransform)
@@ -743,14 +856,10 @@ KrResult KRContext::getMappedNode(KrSceneNodeMapIndex sceneNodeHandle, KRScene*
   if (sceneNodeHandle < 0 || sceneNodeHandle >= m_nodeMapSize) {
     return KR_ERROR_OUT_OF_BOUNDS;
   }
-  if (sceneNodeHandle == KR_NULL_HANDLE) {
-    *node = scene->getRootNode();
-  } else {
-    // TODO - Handle node deletions by deleting nodes from m_nodeMap
-    *node = m_nodeMap[sceneNodeHandle];
-    if (*node == nullptr) {
-      return KR_ERROR_NOT_FOUND;
-    }
+  // Handles of deleted nodes are released by KRScene
+  *node = scene->getNodeByHandle(sceneNodeHandle);
+  if (*node == nullptr) {
+    return KR_ERROR_NOT_FOUND;
   }
   return KR_SUCCESS;
 }
@@ -762,7 +871,7 @@ KrResult KRContext::createNode(const KrCreateNodeInfo* pCreateNodeInfo)
   if (res != KR_SUCCESS) {
     return res;
   }
-  if (pCreateNodeInfo->newNodeHandle < 0 || pCreateNodeInfo->newNodeHandle >= m_nodeMapSize) {
+  if (pCreateNodeInfo->newNodeHandle <= KR_NULL_HANDLE || pCreateNodeInfo->newNodeHandle >= m_nodeMapSize) {
     return KR_ERROR_OUT_OF_BOUNDS;
   }
   KRNode* relativeNode = nullptr;
@@ -804,6 +913,7 @@ KrResult KRContext::createNode(const KrCreateNodeInfo* pCreateNodeInfo)
       return KR_ERROR_NOT_IMPLEMENTED;
     }
   }
+  scene->setNodeHandle(pCreateNodeInfo->newNodeHandle, newNode);
   return KR_SUCCESS;
 }
 
@@ -53,6 +53,7 @@
 class KRAudioManager;
 class KRPresentationThread;
 class KRStreamerThread;
+class KRThreadPool;
 class KRDeviceManager;
 class KRUniformBufferManager;
 class KRSurfaceManager;
@@ -87,8 +88,11 @@ public:
   KrResult saveResource(const KrSaveResourceInfo* saveResourceInfo);
 
   KrResult compileAllShaders(const KrCompileAllShadersInfo* pCompileAllShadersInfo);
+  KrResult compressAnimationCurve(const KrCompressAnimationCurveInfo* pCompressAnimationCurveInfo);
+  KrResult compressTexture(const KrCompressTextureInfo* pCompressTextureInfo);
 
   KrResult createScene(const KrCreateSceneInfo* createSceneInfo);
+  KrResult setSceneFormat(const KrSetSceneFormatInfo* setSceneFormatInfo);
   KrResult findNodeByName(const KrFindNodeByNameInfo* pFindNodeByNameInfo);
   KrResult findAdjacentNodes(const KrFindAdjacentNodesInfo* pFindAdjacentNodesInfo);
   KrResult setNodeLocalTransform(const KrSetNodeLocalTransformInfo* pSetNodeLocalTransform);
@@ -140,6 +144,7 @@ public:
   KRSurfaceManager* getSurfaceManager();
   KRDeviceManager* getDeviceManager();
   KRUniformBufferManager* getUniformBufferManager();
+  KRThreadPool* getThreadPool();
 
   void startFrame(float deltaTime);
   void endFrame(float deltaTime);
@@ -198,7 +203,7 @@ private:
   KRResource** m_resourceMap;
   size_t m_resourceMapSize;
 
-  KRNode** m_nodeMap;
+  // Node handles are mapped per-scene, by KRScene
   size_t m_nodeMapSize;
 
   long m_current_frame; // TODO - Does this need to be atomic?
@@ -220,6 +225,7 @@ private:
 
 
   std::unique_ptr<KRStreamerThread> m_streamerThread;
+  std::unique_ptr<KRThreadPool> m_threadPool;
   std::unique_ptr<KRPresentationThread> m_presentationThread;
 
   unordered_map<KrSurfaceMapIndex, KrSurfaceHandle> m_surfaceHandleMap;
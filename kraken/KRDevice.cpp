@@ -47,12 +47,24 @@ KRDevice::KRDevice(KRContext& context, const VkPhysicalDevice& device)
   , m_computeQueue(VK_NULL_HANDLE)
   , m_transferFamilyQueueIndex(0)
   , m_transferQueue(VK_NULL_HANDLE)
+  , m_sparseResidency(false)
+  , m_timelineSemaphore(false)
+  , m_descriptorIndexing(false)
+  , m_maxBindlessTextures(0)
   , m_graphicsCommandPool(VK_NULL_HANDLE)
   , m_computeCommandPool(VK_NULL_HANDLE)
   , m_allocator(VK_NULL_HANDLE)
   , m_streamingStagingBuffer{}
   , m_graphicsStagingBuffer{}
-  , m_descriptorPool(VK_NULL_HANDLE)
+  , m_graphicsStagingBufferLimit(0)
+  , m_frameIndex(0)
+  , m_streamingSemaphore(VK_NULL_HANDLE)
+  , m_streamingSemaphoreValue(0)
+  , m_graphicsSemaphore(VK_NULL_HANDLE)
+  , m_graphicsSemaphoreValue(0)
+  , m_computeSemaphore(VK_NULL_HANDLE)
+  , m_computeSemaphoreValue(0)
+  , m_streamingUpdatesInPlace(false)
 {
 
 }
@@ -78,13 +90,28 @@ void KRDevice::StagingBufferInfo::destroy(VmaAllocator& allocator)
 
 void KRDevice::destroy()
 {
-  if (m_descriptorPool != VK_NULL_HANDLE) {
-    vkDestroyDescriptorPool(m_logicalDevice, m_descriptorPool, nullptr);
-    m_descriptorPool = VK_NULL_HANDLE;
+  for (VkDescriptorPool descriptorPool : m_descriptorPools) {
+    vkDestroyDescriptorPool(m_logicalDevice, descriptorPool, nullptr);
   }
+  m_descriptorPools.clear();
   m_streamingStagingBuffer.destroy(m_allocator);
   m_graphicsStagingBuffer.destroy(m_allocator);
 
+  if (m_streamingSemaphore != VK_NULL_HANDLE) {
+    vkDestroySemaphore(m_logicalDevice, m_streamingSemaphore, nullptr);
+    m_streamingSemaphore = VK_NULL_HANDLE;
+  }
+
+  if (m_graphicsSemaphore != VK_NULL_HANDLE) {
+    vkDestroySemaphore(m_logicalDevice, m_graphicsSemaphore, nullptr);
+    m_graphicsSemaphore = VK_NULL_HANDLE;
+  }
+
+  if (m_computeSemaphore != VK_NULL_HANDLE) {
+    vkDestroySemaphore(m_logicalDevice, m_computeSemaphore, nullptr);
+    m_computeSemaphore = VK_NULL_HANDLE;
+  }
+
   if (m_graphicsCommandPool != VK_NULL_HANDLE) {
     vkDestroyCommandPool(m_logicalDevice, m_graphicsCommandPool, nullptr);
     m_graphicsCommandPool = VK_NULL_HANDLE;
@@ -135,6 +162,40 @@ bool KRDevice::getAndCheckDeviceCapabilities(const std::vector<const char*>& dev
     // Anisotropy feature required
     return false;
   }
+
+  // Optional, used by the bindless texture and material tables
+  m_descriptorIndexing = false;
+  m_maxBindlessTextures = 0;
+  m_timelineSemaphore = false;
+  if (m_deviceProperties.apiVersion >= VK_API_VERSION_1_2) {
+    VkPhysicalDeviceVulkan12Features features12{};
+    features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    VkPhysicalDeviceFeatures2 features2{};
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features2.pNext = &features12;
+    vkGetPhysicalDeviceFeatures2(m_device, &features2);
+
+    VkPhysicalDeviceVulkan12Properties properties12{};
+    properties12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+    VkPhysicalDeviceProperties2 properties2{};
+    properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties2.pNext = &properties12;
+    vkGetPhysicalDeviceProperties2(m_device, &properties2);
+
+    // Optional, required by virtual textures to order page binds against rendering
+    m_timelineSemaphore = features12.timelineSemaphore;
+
+    m_descriptorIndexing = features12.runtimeDescriptorArray
+      && features12.descriptorBindingPartiallyBound
+      && features12.descriptorBindingSampledImageUpdateAfterBind
+      && features12.shaderSampledImageArrayNonUniformIndexing;
+    if (m_descriptorIndexing) {
+      // Combined image samplers count against both the sampler and sampled image limits
+      m_maxBindlessTextures = std::min(
+        std::min(properties12.maxPerStageDescriptorUpdateAfterBindSampledImages, properties12.maxDescriptorSetUpdateAfterBindSampledImages),
+        std::min(properties12.maxPerStageDescriptorUpdateAfterBindSamplers, properties12.maxDescriptorSetUpdateAfterBindSamplers));
+    }
+  }
   return true;
 }
 
@@ -242,6 +303,10 @@ bool KRDevice::selectQueueFamilies()
   m_computeFamilyQueueIndex = computeFamilyQueue;
   m_transferFamilyQueueIndex = transferFamilyQueue;
 
+  // Virtual textures bind their pages from the streamer thread, which owns the transfer queue
+  m_sparseResidency = m_deviceFeatures.sparseBinding && m_deviceFeatures.sparseResidencyImage2D && m_timelineSemaphore
+    && (queueFamilies[transferFamilyQueue].queueFlags & VK_QUEUE_SPARSE_BINDING_BIT);
+
   return true;
 }
 
@@ -275,7 +340,25 @@ bool KRDevice::initDeviceAndQueues(const std::vector<const char*>& deviceExtensi
   deviceCreateInfo.queueCreateInfoCount = queueCount;
   VkPhysicalDeviceFeatures deviceFeatures{};
   deviceFeatures.samplerAnisotropy = VK_TRUE;
+  // Optional, used by the texture feedback pass
+  deviceFeatures.fragmentStoresAndAtomics = m_deviceFeatures.fragmentStoresAndAtomics;
+  // Optional, used by virtual textures
+  deviceFeatures.sparseBinding = m_sparseResidency;
+  deviceFeatures.sparseResidencyImage2D = m_sparseResidency;
   deviceCreateInfo.pEnabledFeatures = &deviceFeatures;
+  // Optional, used by the bindless texture and material tables
+  VkPhysicalDeviceVulkan12Features features12{};
+  features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+  if (m_descriptorIndexing) {
+    features12.runtimeDescriptorArray = VK_TRUE;
+    features12.descriptorBindingPartiallyBound = VK_TRUE;
+    features12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+    features12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+  }
+  features12.timelineSemaphore = m_timelineSemaphore;
+  if (m_descriptorIndexing || m_timelineSemaphore) {
+    deviceCreateInfo.pNext = &features12;
+  }
   deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
   deviceCreateInfo.ppEnabledExtensionNames = deviceExtensions.data();
   if (vkCreateDevice(m_device, &deviceCreateInfo, nullptr, &m_logicalDevice) != VK_SUCCESS) {
@@ -423,6 +506,7 @@ bool KRDevice::initStagingBuffers()
     )) {
     return false;
   }
+  m_graphicsStagingBufferLimit = m_graphicsStagingBuffer.size;
   return true;
 }
 
@@ -453,42 +537,88 @@ bool KRDevice::initStagingBuffer(VkDeviceSize size, StagingBufferInfo* info
 
 bool KRDevice::initDescriptorPool()
 {
-  // TODO - Vulkan Refactoring - These values need to be dynamic
-  // TODO - Perhaps we should dynamically creaate new pools as needed
-  const size_t kMaxDescriptorSets = 64;
+  // Sizes of each pool.  Pipelines cache a set for each combination of
+  // bindings they draw with, so further pools are created as needed.
+  const size_t kMaxDescriptorSets = 1024;
   const size_t kMaxUniformBufferDescriptors = 1024;
-  const size_t kMaxImageSamplerDescriptors = 1024;
+  const size_t kMaxImageSamplerDescriptors = 4096;
+  const size_t kMaxStorageBufferDescriptors = 1024;
 
-  VkDescriptorPoolSize poolSizes[2] = {};
+  VkDescriptorPoolSize poolSizes[3] = {};
   poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
   poolSizes[0].descriptorCount = static_cast<uint32_t>(kMaxUniformBufferDescriptors);
 
   poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
   poolSizes[1].descriptorCount = static_cast<uint32_t>(kMaxImageSamplerDescriptors);
 
+  poolSizes[2].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  poolSizes[2].descriptorCount = static_cast<uint32_t>(kMaxStorageBufferDescriptors);
+
   VkDescriptorPoolCreateInfo poolInfo{};
   poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-  poolInfo.poolSizeCount = 2;
+  // Sets are returned to their pool when the pipeline that owns them is destroyed
+  poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+  poolInfo.poolSizeCount = 3;
   poolInfo.pPoolSizes = poolSizes;
   poolInfo.maxSets = static_cast<uint32_t>(kMaxDescriptorSets);
 
-  if (vkCreateDescriptorPool(m_logicalDevice, &poolInfo, nullptr, &m_descriptorPool) != VK_SUCCESS) {
+  VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+  if (vkCreateDescriptorPool(m_logicalDevice, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+    return false;
+  }
+  m_descriptorPools.push_back(descriptorPool);
+  return true;
+}
+
+bool KRDevice::initSemaphores()
+{
+  if (!m_timelineSemaphore) {
+    return true;
+  }
+  VkSemaphoreTypeCreateInfo typeInfo{};
+  typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+  typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+  typeInfo.initialValue = 0;
+  VkSemaphoreCreateInfo semaphoreInfo{};
+  semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+  semaphoreInfo.pNext = &typeInfo;
+  if (vkCreateSemaphore(m_logicalDevice, &semaphoreInfo, nullptr, &m_streamingSemaphore) != VK_SUCCESS) {
+    return false;
+  }
+  if (vkCreateSemaphore(m_logicalDevice, &semaphoreInfo, nullptr, &m_graphicsSemaphore) != VK_SUCCESS) {
+    return false;
+  }
+  if (vkCreateSemaphore(m_logicalDevice, &semaphoreInfo, nullptr, &m_computeSemaphore) != VK_SUCCESS) {
     return false;
   }
   return true;
 }
 
-void KRDevice::createDescriptorSets(const std::vector<VkDescriptorSetLayout>& layouts, std::vector<VkDescriptorSet>& descriptorSets)
+bool KRDevice::createDescriptorSets(const std::vector<VkDescriptorSetLayout>& layouts, std::vector<VkDescriptorSet>& descriptorSets, VkDescriptorPool& descriptorPool)
 {
+  assert(layouts.size() == descriptorSets.size());
   VkDescriptorSetAllocateInfo allocInfo{};
   allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-  allocInfo.descriptorPool = m_descriptorPool;
+  allocInfo.descriptorPool = m_descriptorPools.back();
   allocInfo.descriptorSetCount = (uint32_t)descriptorSets.size();
   allocInfo.pSetLayouts = layouts.data();
-  if (vkAllocateDescriptorSets(m_logicalDevice, &allocInfo, descriptorSets.data()) != VK_SUCCESS) {
-    // TODO - Vulkan Refactoring - Error Handling
-    // In event of failure, should allocate an additional descriptor pool and try again
-    assert(false);
+  VkResult res = vkAllocateDescriptorSets(m_logicalDevice, &allocInfo, descriptorSets.data());
+  if (res == VK_ERROR_OUT_OF_POOL_MEMORY || res == VK_ERROR_FRAGMENTED_POOL) {
+    // The last pool is exhausted; continue allocating from a new one
+    if (!initDescriptorPool()) {
+      return false;
+    }
+    allocInfo.descriptorPool = m_descriptorPools.back();
+    res = vkAllocateDescriptorSets(m_logicalDevice, &allocInfo, descriptorSets.data());
+  }
+  descriptorPool = allocInfo.descriptorPool;
+  return res == VK_SUCCESS;
+}
+
+void KRDevice::destroyDescriptorSets(VkDescriptorPool descriptorPool, const std::vector<VkDescriptorSet>& descriptorSets)
+{
+  if (!descriptorSets.empty()) {
+    vkFreeDescriptorSets(m_logicalDevice, descriptorPool, (uint32_t)descriptorSets.size(), descriptorSets.data());
   }
 }
 
@@ -532,6 +662,11 @@ bool KRDevice::initialize(const std::vector<const char*>& deviceExtensions)
     return false;
   }
 
+  if (!initSemaphores()) {
+    destroy();
+    return false;
+  }
+
   return true;
 }
 
@@ -541,7 +676,7 @@ VmaAllocator KRDevice::getAllocator()
   return m_allocator;
 }
 
-void KRDevice::getQueueFamiliesForSharing(uint32_t* queueFamilyIndices, uint32_t* familyCount, VkSharingMode* sharingMode)
+void KRDevice::getQueueFamiliesForSharing(uint32_t* queueFamilyIndices, uint32_t* familyCount, VkSharingMode* sharingMode, bool compute)
 {
   *familyCount = 1;
   queueFamilyIndices[0] = m_graphicsFamilyQueueIndex;
@@ -549,6 +684,10 @@ void KRDevice::getQueueFamiliesForSharing(uint32_t* queueFamilyIndices, uint32_t
     queueFamilyIndices[1] = m_transferFamilyQueueIndex;
     (*familyCount)++;
   }
+  if (compute && m_computeFamilyQueueIndex != m_graphicsFamilyQueueIndex && m_computeFamilyQueueIndex != m_transferFamilyQueueIndex) {
+    queueFamilyIndices[*familyCount] = m_computeFamilyQueueIndex;
+    (*familyCount)++;
+  }
   if (*familyCount > 1) {
     *sharingMode = VK_SHARING_MODE_CONCURRENT;
   } else {
@@ -610,10 +749,11 @@ bool KRDevice::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemor
   bufferInfo.size = size;
   bufferInfo.usage = usage;
 
-  uint32_t queueFamilyIndices[2] = {};
+  // Storage buffers may also be read and written by the compute queue
+  uint32_t queueFamilyIndices[3] = {};
   bufferInfo.pQueueFamilyIndices = queueFamilyIndices;
   bufferInfo.queueFamilyIndexCount = 0;
-  getQueueFamiliesForSharing(queueFamilyIndices, &bufferInfo.queueFamilyIndexCount, &bufferInfo.sharingMode);
+  getQueueFamiliesForSharing(queueFamilyIndices, &bufferInfo.queueFamilyIndexCount, &bufferInfo.sharingMode, (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) != 0);
 
   VmaAllocationCreateInfo allocInfo = {};
   allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
@@ -764,8 +904,26 @@ void KRDevice::streamUpload(void* data, size_t size, VkBuffer destination)
   m_streamingStagingBuffer.usage += size;
 }
 
+void KRDevice::graphicsUploadStart(int frameIndex)
+{
+  // Each frame in flight uploads from its own region of the staging buffer.
+  // A region can be reused once the fence for its frame has been waited on.
+  size_t regionSize = m_graphicsStagingBuffer.size / KRENGINE_MAX_FRAMES_IN_FLIGHT;
+  m_graphicsStagingBuffer.usage = regionSize * frameIndex;
+  m_graphicsStagingBufferLimit = m_graphicsStagingBuffer.usage + regionSize;
+  m_frameIndex = frameIndex;
+}
+
+int KRDevice::getFrameIndex() const
+{
+  return m_frameIndex;
+}
+
 void KRDevice::graphicsUpload(VkCommandBuffer& commandBuffer, void* data, size_t size, VkBuffer destination)
 {
+  // If we hit this, then we need a larger staging buffer.
+  // TODO - Dynamically allocate more/larger staging buffers.
+  assert(m_graphicsStagingBuffer.usage + size <= m_graphicsStagingBufferLimit);
   memcpy((uint8_t*)m_graphicsStagingBuffer.data + m_graphicsStagingBuffer.usage, data, size);
 
   // TODO - Beneficial to batch many regions in a single call?
@@ -822,6 +980,11 @@ void KRDevice::streamUploadImpl(size_t size, VkImage destination, VkBufferImageC
     1, &barrier
   );
 
+  // Regions are read from the staging buffer relative to this upload
+  for (int i = 0; i < regionCount; i++) {
+    regions[i].bufferOffset += m_streamingStagingBuffer.usage;
+  }
+
   vkCmdCopyBufferToImage(
     m_transferCommandBuffers[0],
     m_streamingStagingBuffer.buffer,
@@ -853,6 +1016,204 @@ void KRDevice::streamUploadImpl(size_t size, VkImage destination, VkBufferImageC
   m_streamingStagingBuffer.usage += size;
 }
 
+void KRDevice::streamUpdate(void* data, size_t size, VkImage destination, VkImageLayout oldLayout, VkBufferImageCopy* regions, int regionCount)
+{
+  checkFlushStreamBuffer(size);
+
+  memcpy((uint8_t*)m_streamingStagingBuffer.data + m_streamingStagingBuffer.usage, data, size);
+
+  VkImageMemoryBarrier barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  barrier.oldLayout = oldLayout;
+  barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.image = destination;
+  barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  barrier.subresourceRange.baseMipLevel = 0;
+  barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+  barrier.subresourceRange.baseArrayLayer = 0;
+  barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+  barrier.srcAccessMask = 0;
+  barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+  vkCmdPipelineBarrier(
+    m_transferCommandBuffers[0],
+    VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+    0,
+    0, nullptr,
+    0, nullptr,
+    1, &barrier
+  );
+
+  // Regions are read from the staging buffer relative to this upload
+  for (int i = 0; i < regionCount; i++) {
+    regions[i].bufferOffset += m_streamingStagingBuffer.usage;
+  }
+
+  if (regionCount > 0) {
+    vkCmdCopyBufferToImage(
+      m_transferCommandBuffers[0],
+      m_streamingStagingBuffer.buffer,
+      destination,
+      VK_IMAGE_LAYOUT_GENERAL,
+      regionCount,
+      regions
+    );
+  }
+  m_streamingUpdatesInPlace = true;
+
+  barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+  barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+  vkCmdPipelineBarrier(
+    m_transferCommandBuffers[0],
+    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+    0,
+    0, nullptr,
+    0, nullptr,
+    1, &barrier
+  );
+
+  m_streamingStagingBuffer.usage += size;
+}
+
+bool KRDevice::bindSparse(const VkBindSparseInfo& bindInfo)
+{
+  // Frames submitted after the bind wait for it.  Sparse images are only
+  // created where timeline semaphores are supported.
+  VkBindSparseInfo signalBindInfo = bindInfo;
+  VkTimelineSemaphoreSubmitInfo timelineInfo{};
+  timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+  timelineInfo.pNext = bindInfo.pNext;
+  signalBindInfo.pNext = &timelineInfo;
+  signalBindInfo.signalSemaphoreCount = 1;
+  signalBindInfo.pSignalSemaphores = &m_streamingSemaphore;
+  {
+    std::lock_guard<std::mutex> lock(m_submitMutex);
+    uint64_t signalValue = m_streamingSemaphoreValue + 1;
+    timelineInfo.signalSemaphoreValueCount = 1;
+    timelineInfo.pSignalSemaphoreValues = &signalValue;
+    if (vkQueueBindSparse(m_transferQueue, 1, &signalBindInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+      return false;
+    }
+    m_streamingSemaphoreValue = signalValue;
+  }
+  return true;
+}
+
+VkResult KRDevice::submitGraphics(const VkSubmitInfo& submitInfo, VkFence fence)
+{
+  if (!m_timelineSemaphore) {
+    return vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, fence);
+  }
+
+  std::vector<VkSemaphore> waitSemaphores(submitInfo.pWaitSemaphores, submitInfo.pWaitSemaphores + submitInfo.waitSemaphoreCount);
+  std::vector<VkPipelineStageFlags> waitStages(submitInfo.pWaitDstStageMask, submitInfo.pWaitDstStageMask + submitInfo.waitSemaphoreCount);
+  std::vector<uint64_t> waitValues(submitInfo.waitSemaphoreCount, 0); // Ignored for binary semaphores
+  std::vector<VkSemaphore> signalSemaphores(submitInfo.pSignalSemaphores, submitInfo.pSignalSemaphores + submitInfo.signalSemaphoreCount);
+  std::vector<uint64_t> signalValues(submitInfo.signalSemaphoreCount, 0);
+
+  std::lock_guard<std::mutex> lock(m_submitMutex);
+  waitSemaphores.push_back(m_streamingSemaphore);
+  waitStages.push_back(VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+  waitValues.push_back(m_streamingSemaphoreValue);
+  waitSemaphores.push_back(m_computeSemaphore);
+  waitStages.push_back(VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+  waitValues.push_back(m_computeSemaphoreValue);
+  uint64_t frame = m_graphicsSemaphoreValue + 1;
+  signalSemaphores.push_back(m_graphicsSemaphore);
+  signalValues.push_back(frame);
+
+  VkTimelineSemaphoreSubmitInfo timelineInfo{};
+  timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+  timelineInfo.pNext = submitInfo.pNext;
+  timelineInfo.waitSemaphoreValueCount = (uint32_t)waitValues.size();
+  timelineInfo.pWaitSemaphoreValues = waitValues.data();
+  timelineInfo.signalSemaphoreValueCount = (uint32_t)signalValues.size();
+  timelineInfo.pSignalSemaphoreValues = signalValues.data();
+
+  VkSubmitInfo timelineSubmitInfo = submitInfo;
+  timelineSubmitInfo.pNext = &timelineInfo;
+  timelineSubmitInfo.waitSemaphoreCount = (uint32_t)waitSemaphores.size();
+  timelineSubmitInfo.pWaitSemaphores = waitSemaphores.data();
+  timelineSubmitInfo.pWaitDstStageMask = waitStages.data();
+  timelineSubmitInfo.signalSemaphoreCount = (uint32_t)signalSemaphores.size();
+  timelineSubmitInfo.pSignalSemaphores = signalSemaphores.data();
+
+  VkResult result = vkQueueSubmit(m_graphicsQueue, 1, &timelineSubmitInfo, fence);
+  if (result == VK_SUCCESS) {
+    m_graphicsSemaphoreValue = frame;
+  }
+  return result;
+}
+
+bool KRDevice::submitCompute(VkCommandBuffer commandBuffer)
+{
+  if (!m_timelineSemaphore) {
+    return false;
+  }
+
+  VkSubmitInfo submitInfo{};
+  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+  submitInfo.commandBufferCount = 1;
+  submitInfo.pCommandBuffers = &commandBuffer;
+  submitInfo.signalSemaphoreCount = 1;
+  submitInfo.pSignalSemaphores = &m_computeSemaphore;
+
+  std::lock_guard<std::mutex> lock(m_submitMutex);
+  // The compute work may read buffers uploaded by the streamer
+  VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+  uint64_t waitValue = m_streamingSemaphoreValue;
+  submitInfo.waitSemaphoreCount = 1;
+  submitInfo.pWaitSemaphores = &m_streamingSemaphore;
+  submitInfo.pWaitDstStageMask = &waitStage;
+  uint64_t signalValue = m_computeSemaphoreValue + 1;
+  VkTimelineSemaphoreSubmitInfo timelineInfo{};
+  timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+  timelineInfo.waitSemaphoreValueCount = 1;
+  timelineInfo.pWaitSemaphoreValues = &waitValue;
+  timelineInfo.signalSemaphoreValueCount = 1;
+  timelineInfo.pSignalSemaphoreValues = &signalValue;
+  submitInfo.pNext = &timelineInfo;
+  if (vkQueueSubmit(m_computeQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+    return false;
+  }
+  m_computeSemaphoreValue = signalValue;
+  return true;
+}
+
+uint64_t KRDevice::getGraphicsFramesSubmitted()
+{
+  std::lock_guard<std::mutex> lock(m_submitMutex);
+  return m_graphicsSemaphoreValue;
+}
+
+uint64_t KRDevice::getGraphicsFramesCompleted()
+{
+  uint64_t value = 0;
+  if (m_graphicsSemaphore != VK_NULL_HANDLE) {
+    vkGetSemaphoreCounterValue(m_logicalDevice, m_graphicsSemaphore, &value);
+  }
+  return value;
+}
+
+uint64_t KRDevice::getStreamingSubmitted()
+{
+  std::lock_guard<std::mutex> lock(m_submitMutex);
+  return m_streamingSemaphoreValue;
+}
+
+uint64_t KRDevice::getStreamingCompleted()
+{
+  uint64_t value = 0;
+  if (m_streamingSemaphore != VK_NULL_HANDLE) {
+    vkGetSemaphoreCounterValue(m_logicalDevice, m_streamingSemaphore, &value);
+  }
+  return value;
+}
+
 void KRDevice::streamEnd()
 {
   if (m_streamingStagingBuffer.usage == 0) {
@@ -872,8 +1233,38 @@ void KRDevice::streamEnd()
   submitInfo.commandBufferCount = 1;
   submitInfo.pCommandBuffers = &m_transferCommandBuffers[0];
 
-  vkQueueSubmit(m_transferQueue, 1, &submitInfo, VK_NULL_HANDLE);
+  if (m_timelineSemaphore) {
+    // Frames submitted after the transfer wait for it.  The transfer waits for
+    // the sparse binds submitted before it, which are not otherwise ordered
+    // against it, so pages are uploaded after they are bound.  Images updated
+    // in place, such as residency images, also wait for the frames submitted
+    // before it.
+    VkSemaphore waitSemaphores[2] = { m_streamingSemaphore, m_graphicsSemaphore };
+    VkPipelineStageFlags waitStages[2] = { VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT };
+    VkTimelineSemaphoreSubmitInfo timelineInfo{};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    submitInfo.pNext = &timelineInfo;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &m_streamingSemaphore;
+    submitInfo.waitSemaphoreCount = m_streamingUpdatesInPlace ? 2 : 1;
+    submitInfo.pWaitSemaphores = waitSemaphores;
+    submitInfo.pWaitDstStageMask = waitStages;
+
+    std::lock_guard<std::mutex> lock(m_submitMutex);
+    uint64_t waitValues[2] = { m_streamingSemaphoreValue, m_graphicsSemaphoreValue };
+    uint64_t signalValue = m_streamingSemaphoreValue + 1;
+    timelineInfo.waitSemaphoreValueCount = submitInfo.waitSemaphoreCount;
+    timelineInfo.pWaitSemaphoreValues = waitValues;
+    timelineInfo.signalSemaphoreValueCount = 1;
+    timelineInfo.pSignalSemaphoreValues = &signalValue;
+    if (vkQueueSubmit(m_transferQueue, 1, &submitInfo, VK_NULL_HANDLE) == VK_SUCCESS) {
+      m_streamingSemaphoreValue = signalValue;
+    }
+  } else {
+    vkQueueSubmit(m_transferQueue, 1, &submitInfo, VK_NULL_HANDLE);
+  }
   vkQueueWaitIdle(m_transferQueue);
 
   m_streamingStagingBuffer.started = false;
+  m_streamingUpdatesInPlace = false;
 }
@@ -75,12 +75,37 @@ public:
   void streamUpload(mimir::Block& data, VkBuffer destination);
   void streamUpload(void* data, size_t size, VkBuffer destination);
   void streamUpload(void* data, size_t size, VkImage destination, VkBufferImageCopy* regions, int regionCount);
+  // Uploads regions of an image that stays in VK_IMAGE_LAYOUT_GENERAL, keeping the rest of its contents
+  void streamUpdate(void* data, size_t size, VkImage destination, VkImageLayout oldLayout, VkBufferImageCopy* regions, int regionCount);
   void streamEnd();
-
+  // Queues a sparse bind on the transfer queue without waiting for it.  Memory
+  // unbound by it may be freed once getStreamingCompleted() reaches the value
+  // of getStreamingSubmitted() after the call.
+  bool bindSparse(const VkBindSparseInfo& bindInfo);
+  uint64_t getStreamingSubmitted();
+  uint64_t getStreamingCompleted();
+
+  // Where timeline semaphores are supported, graphics submissions wait for the
+  // binds and uploads the streamer has already submitted, and each signals its
+  // frame number.  Streamer transfers that update images in place wait for the
+  // frames already submitted, which may still be sampling them.
+  VkResult submitGraphics(const VkSubmitInfo& submitInfo, VkFence fence);
+  // Submits work to the compute queue that graphics submissions made after it
+  // wait for before reading vertex input.  Requires timeline semaphores.
+  bool submitCompute(VkCommandBuffer commandBuffer);
+  uint64_t getGraphicsFramesSubmitted();
+  uint64_t getGraphicsFramesCompleted();
+
+  void graphicsUploadStart(int frameIndex);
+  // Index of the frame in flight being recorded, whose fence has been waited on
+  int getFrameIndex() const;
   void graphicsUpload(VkCommandBuffer& commandBuffer, mimir::Block& data, VkBuffer destination);
   void graphicsUpload(VkCommandBuffer& commandBuffer, void* data, size_t size, VkBuffer destination);
 
-  void createDescriptorSets(const std::vector<VkDescriptorSetLayout>& layouts, std::vector<VkDescriptorSet>& descriptorSets);
+  // descriptorPool receives the pool the sets were allocated from, which must be
+  // passed when they are destroyed
+  bool createDescriptorSets(const std::vector<VkDescriptorSetLayout>& layouts, std::vector<VkDescriptorSet>& descriptorSets, VkDescriptorPool& descriptorPool);
+  void destroyDescriptorSets(VkDescriptorPool descriptorPool, const std::vector<VkDescriptorSet>& descriptorSets);
 
   VkPhysicalDevice m_device;
   VkDevice m_logicalDevice;
@@ -92,6 +117,12 @@ public:
   VkQueue m_computeQueue;
   uint32_t m_transferFamilyQueueIndex;
   VkQueue m_transferQueue;
+  bool m_sparseResidency; // Sparse images can be created and bound on the transfer queue
+  bool m_timelineSemaphore;
+  // Descriptor indexing is enabled for the bindless texture and material tables,
+  // which may hold up to m_maxBindlessTextures sampled images
+  bool m_descriptorIndexing;
+  uint32_t m_maxBindlessTextures;
   VkCommandPool m_graphicsCommandPool;
   VkCommandPool m_computeCommandPool;
   VkCommandPool m_transferCommandPool;
@@ -99,7 +130,9 @@ public:
   std::vector<VkCommandBuffer> m_computeCommandBuffers;
   std::vector<VkCommandBuffer> m_transferCommandBuffers;
   VmaAllocator m_allocator;
-  VkDescriptorPool m_descriptorPool;
+  // Descriptor sets are allocated linearly and never freed; pipelines recycle
+  // the sets they own.  A pool is added when the last one is exhausted.
+  std::vector<VkDescriptorPool> m_descriptorPools;
 
   struct StagingBufferInfo
   {
@@ -122,11 +155,28 @@ public:
   // This will be used for uploading assets procedurally generated while recording the graphics command buffer.
   // TODO - We should allocate at least two of these and double-buffer for increased CPU-GPU concurrency
   StagingBufferInfo m_graphicsStagingBuffer;
+  size_t m_graphicsStagingBufferLimit;
 
-  void getQueueFamiliesForSharing(uint32_t* queueFamilyIndices, uint32_t* familyCount, VkSharingMode* sharingMode);
+  // Up to three queue families, including the compute queue's if compute is true
+  void getQueueFamiliesForSharing(uint32_t* queueFamilyIndices, uint32_t* familyCount, VkSharingMode* sharingMode, bool compute = false);
 private:
   void checkFlushStreamBuffer(size_t size);
 
+  int m_frameIndex;
+
+  // Timeline semaphores ordering the streamer's transfers and compute work
+  // against the graphics queue.  The values are the last submitted, guarded by
+  // m_submitMutex so that each queue only waits on work that has already been
+  // submitted to the others.
+  VkSemaphore m_streamingSemaphore;
+  uint64_t m_streamingSemaphoreValue;
+  VkSemaphore m_graphicsSemaphore;
+  uint64_t m_graphicsSemaphoreValue;
+  VkSemaphore m_computeSemaphore;
+  uint64_t m_computeSemaphoreValue;
+  std::mutex m_submitMutex;
+  bool m_streamingUpdatesInPlace;
+
   // Initialization helper functions
   bool getAndCheckDeviceCapabilities(const std::vector<const char*>& deviceExtensions);
   bool selectQueueFamilies();
@@ -141,5 +191,6 @@ private:
 #endif // KRENGINE_DEBUG_GPU_LABELS
   );
   bool initDescriptorPool();
+  bool initSemaphores();
   void streamUploadImpl(size_t size, VkImage destination, VkBufferImageCopy* regions, int regionCount);
 };
@@ -121,10 +121,22 @@ using std::stack;
 using std::queue;
 
 
-#if !defined(__i386__) && defined(__arm__)
+#if (!defined(__i386__) && defined(__arm__)) || defined(__aarch64__) || defined(_M_ARM64)
 #define KRAKEN_USE_ARM_NEON
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define KRAKEN_USE_SSE2
+#endif
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+#define KRAKEN_USE_SSSE3
+#endif
+
+#if defined(__AVX2__)
+#define KRAKEN_USE_AVX2
+#endif
+
 
 #include <unordered_map>
 using std::unordered_map;
@@ -109,4 +109,73 @@ bool tryJson(simdjson::error_code error)
   return error == simdjson::SUCCESS;
 };
 
+uint16_t FloatToHalf(float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  uint32_t sign = (bits >> 16) & 0x8000;
+  int exponent = (int)((bits >> 23) & 0xff) - 127 + 15;
+  uint32_t mantissa = bits & 0x007fffff;
+
+  if (((bits >> 23) & 0xff) == 0xff) {
+    // Infinity or NaN
+    return (uint16_t)(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+  }
+  if (exponent >= 0x1f) {
+    // Too large to represent; clamp to infinity
+    return (uint16_t)(sign | 0x7c00);
+  }
+  if (exponent <= 0) {
+    if (exponent < -10) {
+      // Too small to represent; flush to zero
+      return (uint16_t)sign;
+    }
+    // Subnormal half
+    mantissa |= 0x00800000;
+    int shift = 14 - exponent;
+    uint32_t half_mantissa = mantissa >> shift;
+    uint32_t remainder = mantissa & ((1u << shift) - 1);
+    uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half_mantissa & 1))) {
+      half_mantissa++;
+    }
+    return (uint16_t)(sign | half_mantissa);
+  }
+
+  // Round to nearest even.  A carry out of the mantissa correctly increments the exponent.
+  uint32_t half = sign | ((uint32_t)exponent << 10) | (mantissa >> 13);
+  uint32_t remainder = mantissa & 0x1fff;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+    half++;
+  }
+  return (uint16_t)half;
+}
+
+float HalfToFloat(uint16_t value)
+{
+  uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+  uint32_t exponent = (value >> 10) & 0x1f;
+  uint32_t mantissa = value & 0x3ff;
+  uint32_t bits;
+  if (exponent == 0x1f) {
+    // Infinity or NaN
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  } else if (exponent != 0) {
+    bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+  } else if (mantissa == 0) {
+    bits = sign;
+  } else {
+    // Subnormal half; normalize it
+    exponent = 127 - 15 + 1;
+    while ((mantissa & 0x400) == 0) {
+      mantissa <<= 1;
+      exponent--;
+    }
+    bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+  }
+  float result;
+  memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
 } // namespace kraken
@@ -54,6 +54,10 @@ const hydra::AABB getXMLAttribute(const std::string& base_name, ::tinyxml2::XMLE
 bool tryJsonRequired(simdjson::error_code error);
 bool tryJson(simdjson::error_code error);
 
+// Half precision float helpers
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t value);
+
 } // namespace kraken
 
 namespace simdjson {
@@ -0,0 +1,194 @@
+//
+//  KRNodeRegistry.cpp
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+#include "KREngine-common.h"
+
+#include "KRNodeRegistry.h"
+#include "nodes/KRPointLight.h"
+#include "nodes/KRDirectionalLight.h"
+#include "nodes/KRSpotLight.h"
+#include "nodes/KRModel.h"
+#include "nodes/KRAudioSource.h"
+#include "nodes/KRCollider.h"
+#include "nodes/KRParticleSystem.h"
+
+KRNodeRegistry::KRNodeRegistry(Kind kind)
+  : m_kind(kind)
+{
+}
+
+KRNodeRegistry::~KRNodeRegistry()
+{
+}
+
+KRNodeRegistry::NodeType KRNodeRegistry::GetNodeType(KRNode* node)
+{
+  if (dynamic_cast<KRPointLight*>(node)) {
+    return NodeType::point_light;
+  } else if (dynamic_cast<KRDirectionalLight*>(node)) {
+    return NodeType::directional_light;
+  } else if (dynamic_cast<KRSpotLight*>(node)) {
+    return NodeType::spot_light;
+  } else if (dynamic_cast<KRModel*>(node)) {
+    return NodeType::model;
+  } else if (dynamic_cast<KRAudioSource*>(node)) {
+    return NodeType::audio_source;
+  } else if (dynamic_cast<KRCollider*>(node)) {
+    return NodeType::collider;
+  } else if (dynamic_cast<KRParticleSystem*>(node)) {
+    return NodeType::particle_system;
+  }
+  return NodeType::none;
+}
+
+template<class T>
+void KRNodeRegistry::insert(std::vector<T*>& nodes, KRNode* node)
+{
+  node->m_registryIndex[(int)m_kind] = (uint32_t)nodes.size();
+  nodes.push_back(static_cast<T*>(node));
+}
+
+template<class T>
+void KRNodeRegistry::erase(std::vector<T*>& nodes, KRNode* node)
+{
+  // Only the index is used, as the node may be partially destroyed
+  uint32_t index = node->m_registryIndex[(int)m_kind];
+  uint32_t lastIndex = (uint32_t)nodes.size() - 1;
+  if (index != lastIndex) {
+    KRNode* last = nodes[lastIndex];
+    nodes[index] = nodes[lastIndex];
+    last->m_registryIndex[(int)m_kind] = index;
+  }
+  nodes.pop_back();
+  node->m_registryIndex[(int)m_kind] = kNotRegistered;
+}
+
+void KRNodeRegistry::add(KRNode* node)
+{
+  if (node->m_registryIndex[(int)m_kind] != kNotRegistered) {
+    return;
+  }
+  if (node->m_registryType == NodeType::unknown) {
+    node->m_registryType = GetNodeType(node);
+  }
+  switch (node->m_registryType) {
+  case NodeType::point_light:
+    insert(m_pointLights, node);
+    break;
+  case NodeType::directional_light:
+    insert(m_directionalLights, node);
+    break;
+  case NodeType::spot_light:
+    insert(m_spotLights, node);
+    break;
+  case NodeType::model:
+    insert(m_models, node);
+    break;
+  case NodeType::audio_source:
+    insert(m_audioSources, node);
+    break;
+  case NodeType::collider:
+    insert(m_colliders, node);
+    break;
+  case NodeType::particle_system:
+    insert(m_particleSystems, node);
+    break;
+  default:
+    break;
+  }
+}
+
+void KRNodeRegistry::remove(KRNode* node)
+{
+  if (node->m_registryIndex[(int)m_kind] == kNotRegistered) {
+    return;
+  }
+  switch (node->m_registryType) {
+  case NodeType::point_light:
+    erase(m_pointLights, node);
+    break;
+  case NodeType::directional_light:
+    erase(m_directionalLights, node);
+    break;
+  case NodeType::spot_light:
+    erase(m_spotLights, node);
+    break;
+  case NodeType::model:
+    erase(m_models, node);
+    break;
+  case NodeType::audio_source:
+    erase(m_audioSources, node);
+    break;
+  case NodeType::collider:
+    erase(m_colliders, node);
+    break;
+  case NodeType::particle_system:
+    erase(m_particleSystems, node);
+    break;
+  default:
+    break;
+  }
+}
+
+const std::vector<KRPointLight*>& KRNodeRegistry::getPointLights() const
+{
+  return m_pointLights;
+}
+
+const std::vector<KRDirectionalLight*>& KRNodeRegistry::getDirectionalLights() const
+{
+  return m_directionalLights;
+}
+
+const std::vector<KRSpotLight*>& KRNodeRegistry::getSpotLights() const
+{
+  return m_spotLights;
+}
+
+const std::vector<KRModel*>& KRNodeRegistry::getModels() const
+{
+  return m_models;
+}
+
+const std::vector<KRAudioSource*>& KRNodeRegistry::getAudioSources() const
+{
+  return m_audioSources;
+}
+
+const std::vector<KRCollider*>& KRNodeRegistry::getColliders() const
+{
+  return m_colliders;
+}
+
+const std::vector<KRParticleSystem*>& KRNodeRegistry::getParticleSystems() const
+{
+  return m_particleSystems;
+}
@@ -0,0 +1,104 @@
+//
+//  KRNodeRegistry.h
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+#pragma once
+
+#include "KREngine-common.h"
+
+class KRNode;
+class KRPointLight;
+class KRDirectionalLight;
+class KRSpotLight;
+class KRModel;
+class KRAudioSource;
+class KRCollider;
+class KRParticleSystem;
+
+// Nodes grouped by type, so that passes interested in one type of node can
+// visit only those nodes rather than casting every node they encounter.
+// Each type is kept in a flat array.  A node records its type, determined
+// once when it is first registered, and its position in the arrays that hold
+// it.  Nodes are removed by swapping in the last element, without a search
+// or a cast, so they can be removed from their destructor.
+class KRNodeRegistry
+{
+public:
+  // A node is held by at most one registry of each kind: its scene's, and
+  // that of the octree cell or outer node set that holds it.
+  enum class Kind
+  {
+    scene,
+    octree
+  };
+  static constexpr int kKindCount = 2;
+  static constexpr uint32_t kNotRegistered = 0xffffffff;
+
+  enum class NodeType : uint8_t
+  {
+    unknown, // Not yet registered
+    none, // Not of a registered type
+    point_light,
+    directional_light,
+    spot_light,
+    model,
+    audio_source,
+    collider,
+    particle_system
+  };
+
+  KRNodeRegistry(Kind kind);
+  ~KRNodeRegistry();
+
+  void add(KRNode* node);
+  void remove(KRNode* node);
+
+  const std::vector<KRPointLight*>& getPointLights() const;
+  const std::vector<KRDirectionalLight*>& getDirectionalLights() const;
+  const std::vector<KRSpotLight*>& getSpotLights() const;
+  const std::vector<KRModel*>& getModels() const;
+  const std::vector<KRAudioSource*>& getAudioSources() const;
+  const std::vector<KRCollider*>& getColliders() const;
+  const std::vector<KRParticleSystem*>& getParticleSystems() const;
+
+private:
+  Kind m_kind;
+  std::vector<KRPointLight*> m_pointLights;
+  std::vector<KRDirectionalLight*> m_directionalLights;
+  std::vector<KRSpotLight*> m_spotLights;
+  std::vector<KRModel*> m_models;
+  std::vector<KRAudioSource*> m_audioSources;
+  std::vector<KRCollider*> m_colliders;
+  std::vector<KRParticleSystem*> m_particleSystems;
+
+  static NodeType GetNodeType(KRNode* node);
+  template<class T> void insert(std::vector<T*>& nodes, KRNode* node);
+  template<class T> void erase(std::vector<T*>& nodes, KRNode* node);
+};
@@ -36,7 +36,7 @@
 
 using namespace hydra;
 
-KROctree::KROctree()
+KROctree::KROctree() : m_outerNodeRegistry(KRNodeRegistry::Kind::octree)
 {
   m_pRootNode = NULL;
 }
@@ -56,6 +56,7 @@ void KROctree::add(KRNode* pNode)
   } else if (nodeBounds == AABB::Infinite()) {
     // This item is infinitely large; we track it separately
     m_outerSceneNodes.insert(pNode);
+    m_outerNodeRegistry.add(pNode);
   } else {
     if (m_pRootNode == NULL) {
       // First item inserted, create a node large enough to fit it
@@ -82,10 +83,10 @@ void KROctree::add(KRNode* pNode)
 
 void KROctree::remove(KRNode* pNode)
 {
-  if (!m_outerSceneNodes.erase(pNode)) {
-    if (m_pRootNode) {
-      pNode->removeFromOctreeNodes();
-    }
+  if (m_outerSceneNodes.erase(pNode)) {
+    m_outerNodeRegistry.remove(pNode);
+  } else if (m_pRootNode) {
+    pNode->removeFromOctreeNodes();
   }
 
   shrink();
@@ -121,18 +122,16 @@ std::set<KRNode*>& KROctree::getOuterSceneNodes()
   return m_outerSceneNodes;
 }
 
+const KRNodeRegistry& KROctree::getOuterNodeRegistry() const
+{
+  return m_outerNodeRegistry;
+}
+
 
 bool KROctree::lineCast(const Vector3& v0, const Vector3& v1, HitInfo& hitinfo, unsigned int layer_mask)
 {
   bool hit_found = false;
-  std::vector<KRCollider*> outer_colliders;
-
-  for (std::set<KRNode*>::iterator outer_nodes_itr = m_outerSceneNodes.begin(); outer_nodes_itr != m_outerSceneNodes.end(); outer_nodes_itr++) {
-    KRCollider* collider = dynamic_cast<KRCollider*>(*outer_nodes_itr);
-    if (collider) {
-      outer_colliders.push_back(collider);
-    }
-  }
+  std::vector<KRCollider*> outer_colliders(m_outerNodeRegistry.getColliders().begin(), m_outerNodeRegistry.getColliders().end());
   for (std::vector<KRCollider*>::iterator itr = outer_colliders.begin(); itr != outer_colliders.end(); itr++) {
     if ((*itr)->lineCast(v0, v1, hitinfo, layer_mask)) hit_found = true;
   }
@@ -146,11 +145,8 @@ bool KROctree::lineCast(const Vector3& v0, const Vector3& v1, HitInfo& hitinfo,
 bool KROctree::rayCast(const Vector3& v0, const Vector3& dir, HitInfo& hitinfo, unsigned int layer_mask)
 {
   bool hit_found = false;
-  for (std::set<KRNode*>::iterator outer_nodes_itr = m_outerSceneNodes.begin(); outer_nodes_itr != m_outerSceneNodes.end(); outer_nodes_itr++) {
-    KRCollider* collider = dynamic_cast<KRCollider*>(*outer_nodes_itr);
-    if (collider) {
-      if (collider->rayCast(v0, dir, hitinfo, layer_mask)) hit_found = true;
-    }
+  for (KRCollider* collider : m_outerNodeRegistry.getColliders()) {
+    if (collider->rayCast(v0, dir, hitinfo, layer_mask)) hit_found = true;
   }
   if (m_pRootNode) {
     if (m_pRootNode->rayCast(v0, dir, hitinfo, layer_mask)) hit_found = true;
@@ -161,14 +157,7 @@ bool KROctree::rayCast(const Vector3& v0, const Vector3& dir, HitInfo& hitinfo,
 bool KROctree::sphereCast(const Vector3& v0, const Vector3& v1, float radius, HitInfo& hitinfo, unsigned int layer_mask)
 {
   bool hit_found = false;
-  std::vector<KRCollider*> outer_colliders;
-
-  for (std::set<KRNode*>::iterator outer_nodes_itr = m_outerSceneNodes.begin(); outer_nodes_itr != m_outerSceneNodes.end(); outer_nodes_itr++) {
-    KRCollider* collider = dynamic_cast<KRCollider*>(*outer_nodes_itr);
-    if (collider) {
-      outer_colliders.push_back(collider);
-    }
-  }
+  std::vector<KRCollider*> outer_colliders(m_outerNodeRegistry.getColliders().begin(), m_outerNodeRegistry.getColliders().end());
   for (std::vector<KRCollider*>::iterator itr = outer_colliders.begin(); itr != outer_colliders.end(); itr++) {
     if ((*itr)->sphereCast(v0, v1, radius, hitinfo, layer_mask)) hit_found = true;
   }
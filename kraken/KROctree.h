@@ -33,6 +33,7 @@
 
 #include "KREngine-common.h"
 #include "KROctreeNode.h"
+#include "KRNodeRegistry.h"
 
 class KRNode;
 
@@ -48,6 +49,7 @@ public:
 
   KROctreeNode* getRootNode();
   std::set<KRNode*>& getOuterSceneNodes();
+  const KRNodeRegistry& getOuterNodeRegistry() const;
 
   bool lineCast(const hydra::Vector3& v0, const hydra::Vector3& v1, hydra::HitInfo& hitinfo, unsigned int layer_mask);
   bool rayCast(const hydra::Vector3& v0, const hydra::Vector3& dir, hydra::HitInfo& hitinfo, unsigned int layer_mask);
@@ -74,6 +76,7 @@ public:
 private:
   KROctreeNode* m_pRootNode;
   std::set<KRNode*> m_outerSceneNodes;
+  KRNodeRegistry m_outerNodeRegistry;
 
   void shrink();
 };
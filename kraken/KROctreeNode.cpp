@@ -35,7 +35,7 @@
 
 using namespace hydra;
 
-KROctreeNode::KROctreeNode(KROctreeNode* parent, const AABB& bounds) : m_bounds(bounds)
+KROctreeNode::KROctreeNode(KROctreeNode* parent, const AABB& bounds) : m_bounds(bounds), m_nodeRegistry(KRNodeRegistry::Kind::octree)
 {
   m_parent = parent;
 
@@ -44,7 +44,7 @@ KROctreeNode::KROctreeNode(KROctreeNode* parent, const AABB& bounds) : m_bounds(
   }
 }
 
-KROctreeNode::KROctreeNode(KROctreeNode* parent, const AABB& bounds, int iChild, KROctreeNode* pChild) : m_bounds(bounds)
+KROctreeNode::KROctreeNode(KROctreeNode* parent, const AABB& bounds, int iChild, KROctreeNode* pChild) : m_bounds(bounds), m_nodeRegistry(KRNodeRegistry::Kind::octree)
 {
   // This constructor is used when expanding the octree and replacing the root node with a new root that encapsulates it
   m_parent = parent;
@@ -76,6 +76,7 @@ void KROctreeNode::add(KRNode* pNode)
   int iChild = getChildIndex(pNode);
   if (iChild == -1) {
     m_sceneNodes.insert(pNode);
+    m_nodeRegistry.add(pNode);
     pNode->addToOctreeNode(this);
   } else {
     if (m_children[iChild] == NULL) {
@@ -125,7 +126,9 @@ void KROctreeNode::trim()
 
 void KROctreeNode::remove(KRNode* pNode)
 {
-  m_sceneNodes.erase(pNode);
+  if (m_sceneNodes.erase(pNode)) {
+    m_nodeRegistry.remove(pNode);
+  }
 }
 
 void KROctreeNode::update(KRNode* pNode)
@@ -185,6 +188,11 @@ std::set<KRNode*>& KROctreeNode::getSceneNodes()
   return m_sceneNodes;
 }
 
+const KRNodeRegistry& KROctreeNode::getNodeRegistry() const
+{
+  return m_nodeRegistry;
+}
+
 
 bool KROctreeNode::lineCast(const Vector3& v0, const Vector3& v1, HitInfo& hitinfo, unsigned int layer_mask)
 {
@@ -194,11 +202,8 @@ bool KROctreeNode::lineCast(const Vector3& v0, const Vector3& v1, HitInfo& hitin
     hit_found = lineCast(v0, hitinfo.getPosition(), hitinfo, layer_mask);
   } else {
     if (getBounds().intersectsLine(v0, v1)) {
-      for (std::set<KRNode*>::iterator nodes_itr = m_sceneNodes.begin(); nodes_itr != m_sceneNodes.end(); nodes_itr++) {
-        KRCollider* collider = dynamic_cast<KRCollider*>(*nodes_itr);
-        if (collider) {
-          if (collider->lineCast(v0, v1, hitinfo, layer_mask)) hit_found = true;
-        }
+      for (KRCollider* collider : m_nodeRegistry.getColliders()) {
+        if (collider->lineCast(v0, v1, hitinfo, layer_mask)) hit_found = true;
       }
 
       for (int i = 0; i < 8; i++) {
@@ -222,11 +227,8 @@ bool KROctreeNode::rayCast(const Vector3& v0, const Vector3& dir, HitInfo& hitin
     hit_found = lineCast(v0, hitinfo.getPosition(), hitinfo, layer_mask); // Note: This is purposefully lineCast as opposed to RayCast
   } else {
     if (getBounds().intersectsRay(v0, dir)) {
-      for (std::set<KRNode*>::iterator nodes_itr = m_sceneNodes.begin(); nodes_itr != m_sceneNodes.end(); nodes_itr++) {
-        KRCollider* collider = dynamic_cast<KRCollider*>(*nodes_itr);
-        if (collider) {
-          if (collider->rayCast(v0, dir, hitinfo, layer_mask)) hit_found = true;
-        }
+      for (KRCollider* collider : m_nodeRegistry.getColliders()) {
+        if (collider->rayCast(v0, dir, hitinfo, layer_mask)) hit_found = true;
       }
 
       for (int i = 0; i < 8; i++) {
@@ -258,11 +260,8 @@ bool KROctreeNode::sphereCast(const Vector3& v0, const Vector3& v1, float radius
   // FINDME, TODO - Investigate AABB - swept sphere intersections or OBB - AABB intersections: "if(getBounds().intersectsSweptSphere(v0, v1, radius)) {"
   if (getBounds().intersects(swept_bounds)) {
 
-    for (std::set<KRNode*>::iterator nodes_itr = m_sceneNodes.begin(); nodes_itr != m_sceneNodes.end(); nodes_itr++) {
-      KRCollider* collider = dynamic_cast<KRCollider*>(*nodes_itr);
-      if (collider) {
-        if (collider->sphereCast(v0, v1, radius, hitinfo, layer_mask)) hit_found = true;
-      }
+    for (KRCollider* collider : m_nodeRegistry.getColliders()) {
+      if (collider->sphereCast(v0, v1, radius, hitinfo, layer_mask)) hit_found = true;
     }
 
     for (int i = 0; i < 8; i++) {
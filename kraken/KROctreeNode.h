@@ -33,6 +33,7 @@
 
 #include "KREngine-common.h"
 #include "hitinfo.h"
+#include "KRNodeRegistry.h"
 
 class KRNode;
 
@@ -45,6 +46,7 @@ public:
 
   KROctreeNode** getChildren();
   std::set<KRNode*>& getSceneNodes();
+  const KRNodeRegistry& getNodeRegistry() const;
 
   void add(KRNode* pNode);
   void remove(KRNode* pNode);
@@ -74,4 +76,5 @@ private:
   KROctreeNode* m_children[8];
 
   std::set<KRNode*>m_sceneNodes;
+  KRNodeRegistry m_nodeRegistry;
 };
@@ -41,6 +41,14 @@
 
 using namespace hydra;
 
+namespace {
+// Descriptor sets shared by every pipeline on a device, rather than reflected
+bool isBindlessSet(uint32_t set)
+{
+  return set == KRTextureManager::KRENGINE_BINDLESS_TEXTURE_SET || set == KRMaterialManager::KRENGINE_BINDLESS_MATERIAL_SET;
+}
+} // anonymous namespace
+
 KRPipeline::KRPipeline(KRContext& context, KrDeviceHandle deviceHandle, const KRRenderPass* renderPass, Vector2i viewport_size, Vector2i scissor_size, const PipelineInfo& info, const char* szKey, const std::vector<KRShader*>& shaders, uint32_t vertexAttributes, ModelFormat modelFormat)
   : KRContextObject(context)
   , m_deviceHandle(deviceHandle)
@@ -57,9 +65,12 @@ KRPipeline::KRPipeline(KRContext& context, KrDeviceHandle deviceHandle, const KR
   }
 
   m_descriptorSetLayout = nullptr;
+  m_emptyDescriptorSetLayout = nullptr;
+  m_bindless = false;
   m_pipelineLayout = nullptr;
   m_graphicsPipeline = nullptr;
-  m_descriptorSets.reserve(KRENGINE_MAX_FRAMES_IN_FLIGHT);
+  m_descriptorSet = VK_NULL_HANDLE;
+  m_descriptorSetCacheFrame = 0;
 
   // TODO - Handle device removal
 
@@ -86,6 +97,10 @@ KRPipeline::KRPipeline(KRContext& context, KrDeviceHandle deviceHandle, const KR
     KRMesh::KRENGINE_ATTRIB_TANGENT,
     KRMesh::KRENGINE_ATTRIB_TEXUVA,
     KRMesh::KRENGINE_ATTRIB_TEXUVB,
+    KRMesh::KRENGINE_ATTRIB_TANGENT,
+    KRMesh::KRENGINE_ATTRIB_TEXUVA,
+    KRMesh::KRENGINE_ATTRIB_TEXUVB,
+    KRMesh::KRENGINE_ATTRIB_BONEWEIGHTS,
   };
 
   uint32_t attribute_locations[KRMesh::KRENGINE_NUM_ATTRIBUTES] = {};
@@ -94,6 +109,11 @@ KRPipeline::KRPipeline(KRContext& context, KrDeviceHandle deviceHandle, const KR
   for (KRShader* shader : shaders) {
     const SpvReflectShaderModule* reflection = shader->getReflection();
     layout_binding_count += reflection->descriptor_binding_count;
+    for (uint32_t s = 0; s < reflection->descriptor_set_count; s++) {
+      if (isBindlessSet(reflection->descriptor_sets[s].set)) {
+        m_bindless = true;
+      }
+    }
   }
   uboLayoutBindings.reserve(layout_binding_count);
 
@@ -106,6 +126,9 @@ KRPipeline::KRPipeline(KRContext& context, KrDeviceHandle deviceHandle, const KR
     
     for (uint32_t b = 0; b < reflection->descriptor_binding_count; b++) {
       SpvReflectDescriptorBinding& binding_reflect = reflection->descriptor_bindings[b];
+      if (isBindlessSet(binding_reflect.set)) {
+        continue;
+      }
       VkDescriptorSetLayoutBinding& binding = uboLayoutBindings.emplace_back();
       memset(&binding, 0, sizeof(VkDescriptorSetLayoutBinding));
       binding.binding = binding_reflect.binding;
@@ -270,6 +293,10 @@ KRPipeline::KRPipeline(KRContext& context, KrDeviceHandle deviceHandle, const KR
     colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
     break;
   }
+  if (renderPass->getType() == RenderPassType::RENDER_PASS_TEXTURE_FEEDBACK) {
+    // The texture feedback pass only writes to its storage buffer
+    colorBlendAttachment.colorWriteMask = 0;
+  }
   colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
   colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
   colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
@@ -296,15 +323,31 @@ KRPipeline::KRPipeline(KRContext& context, KrDeviceHandle deviceHandle, const KR
     }
   }
 
+  VkDescriptorSetLayout setLayouts[3] = { m_descriptorSetLayout, VK_NULL_HANDLE, VK_NULL_HANDLE };
+  uint32_t setLayoutCount = uboLayoutBindings.size() ? 1 : 0;
+  if (m_bindless) {
+    // The bindless tables follow set 0, which is empty if the shaders have no
+    // per-draw descriptors
+    if (m_descriptorSetLayout == VK_NULL_HANDLE) {
+      VkDescriptorSetLayoutCreateInfo layoutInfo{};
+      layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+      if (vkCreateDescriptorSetLayout(device->m_logicalDevice, &layoutInfo, nullptr, &m_emptyDescriptorSetLayout) != VK_SUCCESS) {
+        // failed! TODO - Error handling
+      }
+      setLayouts[0] = m_emptyDescriptorSetLayout;
+    }
+    setLayouts[KRTextureManager::KRENGINE_BINDLESS_TEXTURE_SET] = getContext().getTextureManager()->getBindlessLayout(m_deviceHandle);
+    setLayouts[KRMaterialManager::KRENGINE_BINDLESS_MATERIAL_SET] = getContext().getMaterialManager()->getMaterialTableLayout(m_deviceHandle);
+    if (setLayouts[KRTextureManager::KRENGINE_BINDLESS_TEXTURE_SET] == VK_NULL_HANDLE || setLayouts[KRMaterialManager::KRENGINE_BINDLESS_MATERIAL_SET] == VK_NULL_HANDLE) {
+      KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Bindless tables are not supported by the device for pipeline: %s", m_szKey);
+    }
+    setLayoutCount = 3;
+  }
+
   VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
   pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-  if (uboLayoutBindings.size()) {
-    pipelineLayoutInfo.setLayoutCount = 1;
-    pipelineLayoutInfo.pSetLayouts = &m_descriptorSetLayout;
-  } else {
-    pipelineLayoutInfo.setLayoutCount = 0;
-    pipelineLayoutInfo.pSetLayouts = nullptr;
-  }
+  pipelineLayoutInfo.setLayoutCount = setLayoutCount;
+  pipelineLayoutInfo.pSetLayouts = setLayoutCount ? setLayouts : nullptr;
   pipelineLayoutInfo.pushConstantRangeCount = 0;
   pipelineLayoutInfo.pPushConstantRanges = nullptr;
 
@@ -410,6 +453,19 @@ KRPipeline::~KRPipeline()
   if (m_descriptorSetLayout) {
     // TODO: vkDestroyDescriptorSetLayout(device, m_descriptorSetLayout, nullptr);
   }
+  if (m_emptyDescriptorSetLayout) {
+    // TODO: vkDestroyDescriptorSetLayout(device, m_emptyDescriptorSetLayout, nullptr);
+  }
+
+  if (!m_descriptorSetPools.empty()) {
+    // Every set allocated by this pipeline, whether cached or free, is returned
+    // to its pool.  Pipelines are destroyed once the device is idle.
+    std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(m_deviceHandle);
+    for (auto itr = m_descriptorSetPools.begin(); itr != m_descriptorSetPools.end(); itr++) {
+      device->destroyDescriptorSets((*itr).first, (*itr).second);
+    }
+    m_descriptorSetPools.clear();
+  }
 
   if (getContext().getPipelineManager()->m_active_pipeline == this) {
     getContext().getPipelineManager()->m_active_pipeline = NULL;
@@ -490,6 +546,10 @@ void KRPipeline::initDescriptorSetStage(ShaderStage stage, const SpvReflectShade
   descriptorSets.reserve(reflection->descriptor_set_count);
   for (int i = 0; i < reflection->descriptor_set_count; i++) {
     SpvReflectDescriptorSet descriptorSet = reflection->descriptor_sets[i];
+    if (isBindlessSet(descriptorSet.set)) {
+      // Bound by bindBindlessDescriptorSets
+      continue;
+    }
     DescriptorSetInfo& descriptorSetInfo = descriptorSets.emplace_back();
     descriptorSetInfo.bindings.reserve(descriptorSet.binding_count);
     for (int j = 0; j < descriptorSet.binding_count; j++) {
@@ -501,17 +561,33 @@ void KRPipeline::initDescriptorSetStage(ShaderStage stage, const SpvReflectShade
         {
           ImageDescriptorInfo& imageInfo = descriptorQuery.emplace<ImageDescriptorInfo>();
           imageInfo.name = binding.name;
+          imageInfo.binding = binding.binding;
           imageInfo.texture = nullptr;
           imageInfo.sampler = nullptr;
+          // Samplers named "<map>_residency" are bound to the residency image of "<map>"
+          const std::string residencySuffix = "_residency";
+          imageInfo.residency = imageInfo.name.size() > residencySuffix.size()
+            && imageInfo.name.compare(imageInfo.name.size() - residencySuffix.size(), residencySuffix.size(), residencySuffix) == 0;
+          if (imageInfo.residency) {
+            imageInfo.name.resize(imageInfo.name.size() - residencySuffix.size());
+          }
         }
         break;
       case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
         {
           UniformBufferDescriptorInfo& bufferInfo = descriptorQuery.emplace<UniformBufferDescriptorInfo>();
           bufferInfo.name = binding.name;
+          bufferInfo.binding = binding.binding;
           bufferInfo.buffer = nullptr;
         }
         break;
+      case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+        {
+          StorageBufferDescriptorInfo& bufferInfo = descriptorQuery.emplace<StorageBufferDescriptorInfo>();
+          bufferInfo.name = binding.name;
+          bufferInfo.binding = binding.binding;
+        }
+        break;
       default:
         // Not supported
         // TODO - Error handling
@@ -533,7 +609,7 @@ bool KRPipeline::hasPushConstant(ShaderValue location) const
 }
 
 
-bool KRPipeline::setImageBindings(const std::vector<const KRReflectedObject*> objects)
+bool KRPipeline::setImageBindings(const std::vector<const KRReflectedObject*>& objects)
 {
   bool success = true;
 
@@ -548,7 +624,8 @@ bool KRPipeline::setImageBindings(const std::vector<const KRReflectedObject*> ob
           for (const KRReflectedObject* object : objects) {
             KRSampler* sampler = nullptr;
             if (object->getImageBinding(image->name, &binding, &sampler)) {
-              if (binding->isBound() && binding->get()->getStreamLevel() > kraken_stream_level::STREAM_LEVEL_OUT) {
+              if (binding->isBound() && binding->get()->getStreamLevel() > kraken_stream_level::STREAM_LEVEL_OUT
+                && (!image->residency || binding->get()->isVirtual())) {
                 image->texture = binding->get();
                 image->sampler = sampler;
                 found = true;
@@ -569,7 +646,7 @@ bool KRPipeline::setImageBindings(const std::vector<const KRReflectedObject*> ob
   return success;
 }
 
-bool KRPipeline::setPushConstants(const std::vector<const KRReflectedObject*> objects)
+bool KRPipeline::setPushConstants(const std::vector<const KRReflectedObject*>& objects)
 {
   bool success = true;
   for (StageInfo& stageInfo : m_stages) {
@@ -721,7 +798,10 @@ bool KRPipeline::bind(KRNode::RenderInfo& ri, const Matrix4& matModel)
     updateDescriptorBinding();
     updateDescriptorSets();
     bindDescriptorSets(ri.commandBuffer);
+    success = bindBindlessDescriptorSets(ri.commandBuffer);
+  }
 
+  if (success) {
     if (ri.pipeline != this) {
       vkCmdBindPipeline(ri.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline);
       ri.pipeline = this;
@@ -743,39 +823,143 @@ void KRPipeline::updateDescriptorSets()
   }
 
   std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(m_deviceHandle);
+  long current_frame = getContext().getCurrentFrame();
+
+  if (current_frame != m_descriptorSetCacheFrame) {
+    m_descriptorSetCacheFrame = current_frame;
+    trimDescriptorSetCache();
+  }
+
+  // Draws that bind the same resources as an earlier draw reuse its set
+  buildDescriptorSetKey(m_descriptorSetKey);
+  size_t hash = 0;
+  for (uint64_t value : m_descriptorSetKey) {
+    hash ^= std::hash<uint64_t>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+
+  auto itr = m_descriptorSetCache.find(hash);
+  if (itr != m_descriptorSetCache.end() && (*itr).second.key == m_descriptorSetKey) {
+    (*itr).second.lastFrameUsed = current_frame;
+    m_descriptorSet = (*itr).second.descriptorSet;
+    getContext().getPipelineManager()->addDescriptorSetBind(false);
+    return;
+  }
+
+  VkDescriptorSet descriptorSet = allocateDescriptorSet(*device);
+  if (descriptorSet == VK_NULL_HANDLE) {
+    m_descriptorSet = VK_NULL_HANDLE;
+    return;
+  }
+  writeDescriptorSet(*device, descriptorSet);
+
+  if (itr != m_descriptorSetCache.end()) {
+    // A hash collision replaces the older entry
+    m_freeDescriptorSets.push_back(std::make_pair((*itr).second.descriptorSet, (*itr).second.lastFrameUsed));
+  }
+  DescriptorSetCacheEntry& entry = m_descriptorSetCache[hash];
+  entry.key = m_descriptorSetKey;
+  entry.descriptorSet = descriptorSet;
+  entry.lastFrameUsed = current_frame;
+  m_descriptorSet = descriptorSet;
+
+  getContext().getPipelineManager()->addDescriptorSetBind(true);
+}
 
-  // If the descriptor sets are not yet allocted, create them
-  if (m_descriptorSets.size() == 0) {
-    int descriptorSetCount = 0;
-    for (int stage = 0; stage < static_cast<size_t>(ShaderStage::ShaderStageCount); stage++) {
-      const StageInfo& stageInfo = m_stages[stage];
-      descriptorSetCount += stageInfo.descriptorSets.size();
+void KRPipeline::buildDescriptorSetKey(std::vector<uint64_t>& key)
+{
+  // Texture handle serials change whenever a texture's views are replaced, so
+  // sets referencing destroyed views are never matched
+  key.clear();
+  for (int stage = 0; stage < static_cast<size_t>(ShaderStage::ShaderStageCount); stage++) {
+    StageInfo& stageInfo = m_stages[stage];
+    for (DescriptorSetInfo& descriptorSetInfo : stageInfo.descriptorSets) {
+      for (DescriptorBinding& binding : descriptorSetInfo.bindings) {
+        UniformBufferDescriptorInfo* buffer = std::get_if<UniformBufferDescriptorInfo>(&binding);
+        ImageDescriptorInfo* image = std::get_if<ImageDescriptorInfo>(&binding);
+        StorageBufferDescriptorInfo* storageBuffer = std::get_if<StorageBufferDescriptorInfo>(&binding);
+        if (buffer) {
+          key.push_back(buffer->binding);
+          key.push_back((uint64_t)buffer->buffer->getBuffer());
+        } else if (image) {
+          key.push_back(image->binding);
+          key.push_back((uint64_t)(uintptr_t)image->texture);
+          key.push_back((uint64_t)image->texture->getHandleSerial());
+          key.push_back((uint64_t)image->sampler->getSampler(m_deviceHandle));
+        } else if (storageBuffer) {
+          // Each frame in flight records feedback to its own slice of the buffer
+          VkDescriptorBufferInfo bufferInfo{};
+          getContext().getTextureManager()->getFeedbackBuffer(m_deviceHandle, bufferInfo);
+          key.push_back(storageBuffer->binding);
+          key.push_back((uint64_t)bufferInfo.buffer);
+          key.push_back((uint64_t)bufferInfo.offset);
+        }
+      }
     }
-    m_descriptorSets.resize(KRENGINE_MAX_FRAMES_IN_FLIGHT * descriptorSetCount, VK_NULL_HANDLE);
-    std::vector<VkDescriptorSetLayout> layouts(KRENGINE_MAX_FRAMES_IN_FLIGHT, m_descriptorSetLayout);
-    device->createDescriptorSets(layouts, m_descriptorSets);
   }
+}
 
-  // Update the descriptor sets
-  // TODO - We should only do this when the descriptors have changed
+VkDescriptorSet KRPipeline::allocateDescriptorSet(KRDevice& device)
+{
+  long current_frame = getContext().getCurrentFrame();
+  for (auto itr = m_freeDescriptorSets.begin(); itr != m_freeDescriptorSets.end(); itr++) {
+    if ((*itr).second + KRENGINE_MAX_FRAMES_IN_FLIGHT < current_frame) {
+      VkDescriptorSet descriptorSet = (*itr).first;
+      *itr = m_freeDescriptorSets.back();
+      m_freeDescriptorSets.pop_back();
+      return descriptorSet;
+    }
+  }
 
-  int descriptorSetCount = m_descriptorSets.size() / KRENGINE_MAX_FRAMES_IN_FLIGHT;
-  int descriptorSetStart = (getContext().getCurrentFrame() % KRENGINE_MAX_FRAMES_IN_FLIGHT) * descriptorSetCount;
-  int descriptorSetIndex = descriptorSetStart;
+  std::vector<VkDescriptorSetLayout> layouts(1, m_descriptorSetLayout);
+  std::vector<VkDescriptorSet> descriptorSets(1, VK_NULL_HANDLE);
+  VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+  if (!device.createDescriptorSets(layouts, descriptorSets, descriptorPool)) {
+    KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Failed to allocate descriptor set for pipeline: %s", m_szKey);
+    return VK_NULL_HANDLE;
+  }
+  m_descriptorSetPools[descriptorPool].push_back(descriptorSets[0]);
+  return descriptorSets[0];
+}
+
+void KRPipeline::trimDescriptorSetCache()
+{
+  // Sets not drawn with recently are returned to the free list, bounding the
+  // cache as streamed textures replace their views
+  const long KRENGINE_DESCRIPTOR_SET_EXPIRY_FRAMES = 30;
+  long current_frame = getContext().getCurrentFrame();
+  for (auto itr = m_descriptorSetCache.begin(); itr != m_descriptorSetCache.end();) {
+    if ((*itr).second.lastFrameUsed + KRENGINE_DESCRIPTOR_SET_EXPIRY_FRAMES < current_frame) {
+      m_freeDescriptorSets.push_back(std::make_pair((*itr).second.descriptorSet, (*itr).second.lastFrameUsed));
+      itr = m_descriptorSetCache.erase(itr);
+    } else {
+      itr++;
+    }
+  }
+}
 
+void KRPipeline::writeDescriptorSet(KRDevice& device, VkDescriptorSet descriptorSet)
+{
   std::vector<VkWriteDescriptorSet> descriptorWrites;
   std::vector<VkDescriptorBufferInfo> buffers;
   std::vector<VkDescriptorImageInfo> images;
 
+  // The writes point into buffers and images, which must not be reallocated
+  size_t bindingCount = 0;
+  for (const StageInfo& stageInfo : m_stages) {
+    for (const DescriptorSetInfo& descriptorSetInfo : stageInfo.descriptorSets) {
+      bindingCount += descriptorSetInfo.bindings.size();
+    }
+  }
+  buffers.reserve(bindingCount);
+  images.reserve(bindingCount);
+
   for (int stage = 0; stage < static_cast<size_t>(ShaderStage::ShaderStageCount); stage++) {
     StageInfo& stageInfo = m_stages[stage];
     for (DescriptorSetInfo& descriptorSetInfo : stageInfo.descriptorSets) {
-      VkDescriptorSet descriptorSet = m_descriptorSets[descriptorSetIndex++];
-
-      int bindingIndex = 0;
       for (DescriptorBinding& binding : descriptorSetInfo.bindings) {
         UniformBufferDescriptorInfo* buffer = std::get_if<UniformBufferDescriptorInfo>(&binding);
         ImageDescriptorInfo* image = std::get_if<ImageDescriptorInfo>(&binding);
+        StorageBufferDescriptorInfo* storageBuffer = std::get_if<StorageBufferDescriptorInfo>(&binding);
         if (buffer) {
           VkDescriptorBufferInfo& bufferInfo = buffers.emplace_back(VkDescriptorBufferInfo{});
           bufferInfo.buffer = buffer->buffer->getBuffer();
@@ -785,52 +969,78 @@ void KRPipeline::updateDescriptorSets()
           VkWriteDescriptorSet& descriptorWrite = descriptorWrites.emplace_back(VkWriteDescriptorSet{});
           descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
           descriptorWrite.dstSet = descriptorSet;
-          descriptorWrite.dstBinding = bindingIndex;
+          descriptorWrite.dstBinding = buffer->binding;
           descriptorWrite.dstArrayElement = 0;
           descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
           descriptorWrite.descriptorCount = 1;
           descriptorWrite.pBufferInfo = &bufferInfo;
         } else if (image) {
           VkDescriptorImageInfo& imageInfo = images.emplace_back(VkDescriptorImageInfo{});
-          imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-          imageInfo.imageView = image->texture->getFullImageView(m_deviceHandle);
+          if (image->residency) {
+            imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+            imageInfo.imageView = image->texture->getResidencyImageView(m_deviceHandle);
+          } else {
+            imageInfo.imageLayout = image->texture->getImageLayout(m_deviceHandle);
+            imageInfo.imageView = image->texture->getFullImageView(m_deviceHandle);
+          }
           imageInfo.sampler = image->sampler->getSampler(m_deviceHandle);
 
           VkWriteDescriptorSet& descriptorWrite = descriptorWrites.emplace_back(VkWriteDescriptorSet{});
           descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
           descriptorWrite.dstSet = descriptorSet;
-          descriptorWrite.dstBinding = bindingIndex++;
+          descriptorWrite.dstBinding = image->binding;
           descriptorWrite.dstArrayElement = 0;
           descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
           descriptorWrite.descriptorCount = 1;
           descriptorWrite.pImageInfo = &imageInfo;
+        } else if (storageBuffer) {
+          // The texture feedback buffer is the only storage buffer bound to pipelines
+          VkDescriptorBufferInfo& bufferInfo = buffers.emplace_back(VkDescriptorBufferInfo{});
+          getContext().getTextureManager()->getFeedbackBuffer(m_deviceHandle, bufferInfo);
+
+          VkWriteDescriptorSet& descriptorWrite = descriptorWrites.emplace_back(VkWriteDescriptorSet{});
+          descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+          descriptorWrite.dstSet = descriptorSet;
+          descriptorWrite.dstBinding = storageBuffer->binding;
+          descriptorWrite.dstArrayElement = 0;
+          descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+          descriptorWrite.descriptorCount = 1;
+          descriptorWrite.pBufferInfo = &bufferInfo;
         } else {
           // TODO - Error Handling
           assert(false);
         }
-        bindingIndex++;
       }
     }
   }
 
   if (!descriptorWrites.empty()) {
-    vkUpdateDescriptorSets(device->m_logicalDevice, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+    vkUpdateDescriptorSets(device.m_logicalDevice, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
   }
 }
 
 void KRPipeline::bindDescriptorSets(VkCommandBuffer& commandBuffer)
 {
-  if (m_descriptorSets.empty()) {
+  if (m_descriptorSet == VK_NULL_HANDLE) {
     return;
   }
-  int descriptorSetCount = (int)m_descriptorSets.size() / KRENGINE_MAX_FRAMES_IN_FLIGHT;
-  int startDescriptorSet = (getContext().getCurrentFrame() % KRENGINE_MAX_FRAMES_IN_FLIGHT) * descriptorSetCount;
-  VkDescriptorSet descriptorSet = m_descriptorSets[startDescriptorSet];
-  if (descriptorSet == VK_NULL_HANDLE) {
-    return;
+  vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1, &m_descriptorSet, 0, nullptr);
+}
+
+bool KRPipeline::bindBindlessDescriptorSets(VkCommandBuffer& commandBuffer)
+{
+  if (!m_bindless) {
+    return true;
   }
-  // TODO - Vulkan Refactoring - Support multiple descriptor set binding
-  vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, descriptorSetCount, &descriptorSet, 0, nullptr);
+  // The texture table and this frame's slice of the material table
+  VkDescriptorSet descriptorSets[2];
+  uint32_t materialOffset = 0;
+  descriptorSets[0] = getContext().getTextureManager()->getBindlessDescriptorSet(m_deviceHandle);
+  if (descriptorSets[0] == VK_NULL_HANDLE || !getContext().getMaterialManager()->getMaterialTable(m_deviceHandle, descriptorSets[1], materialOffset)) {
+    return false;
+  }
+  vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, KRTextureManager::KRENGINE_BINDLESS_TEXTURE_SET, 2, descriptorSets, 1, &materialOffset);
+  return true;
 }
 
 const char* KRPipeline::getKey() const
@@ -221,8 +221,8 @@ public:
 
   static const size_t kPushConstantCount = static_cast<size_t>(ShaderValue::NUM_SHADER_VALUES);
 
-  bool setImageBindings(const std::vector<const KRReflectedObject*> objects);
-  bool setPushConstants(const std::vector<const KRReflectedObject*> objects);
+  bool setImageBindings(const std::vector<const KRReflectedObject*>& objects);
+  bool setPushConstants(const std::vector<const KRReflectedObject*>& objects);
   bool hasPushConstant(ShaderValue location) const;
   void setPushConstant(ShaderValue location, float value);
   void setPushConstant(ShaderValue location, int value);
@@ -234,6 +234,7 @@ public:
 
   VkPipeline& getPipeline();
   void bindDescriptorSets(VkCommandBuffer& commandBuffer);
+  bool bindBindlessDescriptorSets(VkCommandBuffer& commandBuffer);
 
 private:
   void updateDescriptorBinding();
@@ -255,15 +256,25 @@ private:
     KRTexture* texture;
     KRSampler* sampler;
     std::string name;
+    uint32_t binding;
+    // Bound to the residency image of a virtual texture rather than the texture itself
+    bool residency;
   };
 
   struct UniformBufferDescriptorInfo
   {
     KRUniformBuffer* buffer;
     std::string name;
+    uint32_t binding;
   };
 
-  typedef std::variant<ImageDescriptorInfo, UniformBufferDescriptorInfo> DescriptorBinding;
+  struct StorageBufferDescriptorInfo
+  {
+    std::string name;
+    uint32_t binding;
+  };
+
+  typedef std::variant<ImageDescriptorInfo, UniformBufferDescriptorInfo, StorageBufferDescriptorInfo> DescriptorBinding;
   typedef std::vector<DescriptorBinding> DescriptorSetBinding;
 
   struct DescriptorSetInfo
@@ -285,11 +296,38 @@ private:
   char m_szKey[256];
 
   VkDescriptorSetLayout m_descriptorSetLayout;
+  // Shaders reading the bindless texture and material tables are laid out with
+  // m_emptyDescriptorSetLayout in set 0 if they have no per-draw descriptors
+  bool m_bindless;
+  VkDescriptorSetLayout m_emptyDescriptorSetLayout;
   VkPipelineLayout m_pipelineLayout;
   VkPipeline m_graphicsPipeline;
-  std::vector<VkDescriptorSet> m_descriptorSets;
   KrDeviceHandle m_deviceHandle;
 
+  // Descriptor sets are written once for each combination of bound resources,
+  // then reused by every draw and frame that binds the same resources.  The
+  // bindings of all stages share the single set of m_descriptorSetLayout.
+  struct DescriptorSetCacheEntry
+  {
+    std::vector<uint64_t> key;
+    VkDescriptorSet descriptorSet;
+    long lastFrameUsed;
+  };
+  std::unordered_map<size_t, DescriptorSetCacheEntry> m_descriptorSetCache;
+  // Sets evicted from the cache, with the last frame that used them.  They are
+  // rewritten only once no frame in flight can reference them.
+  std::vector<std::pair<VkDescriptorSet, long>> m_freeDescriptorSets;
+  // Every set allocated, by the pool it was allocated from
+  std::unordered_map<VkDescriptorPool, std::vector<VkDescriptorSet>> m_descriptorSetPools;
+  std::vector<uint64_t> m_descriptorSetKey;
+  VkDescriptorSet m_descriptorSet;
+  long m_descriptorSetCacheFrame;
+
+  void buildDescriptorSetKey(std::vector<uint64_t>& key);
+  VkDescriptorSet allocateDescriptorSet(KRDevice& device);
+  void writeDescriptorSet(KRDevice& device, VkDescriptorSet descriptorSet);
+  void trimDescriptorSetCache();
+
   void initPushConstantStage(ShaderStage stage, const SpvReflectShaderModule* reflection);
   void initDescriptorSetStage(ShaderStage stage, const SpvReflectShaderModule* reflection);
 };
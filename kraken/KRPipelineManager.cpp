@@ -48,6 +48,10 @@ using namespace std;
 KRPipelineManager::KRPipelineManager(KRContext& context) : KRContextObject(context)
 {
   m_active_pipeline = NULL;
+  m_descriptorSetBinds = 0;
+  m_descriptorSetWrites = 0;
+  m_descriptorSetBindsLastFrame = 0;
+  m_descriptorSetWritesLastFrame = 0;
 #ifndef ANDROID
   bool success = glslang::InitializeProcess();
   if (success) {
@@ -65,6 +69,32 @@ KRPipelineManager::~KRPipelineManager()
 #endif // ANDROID
 }
 
+void KRPipelineManager::startFrame(float deltaTime)
+{
+  m_descriptorSetBindsLastFrame = m_descriptorSetBinds;
+  m_descriptorSetWritesLastFrame = m_descriptorSetWrites;
+  m_descriptorSetBinds = 0;
+  m_descriptorSetWrites = 0;
+}
+
+void KRPipelineManager::addDescriptorSetBind(bool written)
+{
+  m_descriptorSetBinds++;
+  if (written) {
+    m_descriptorSetWrites++;
+  }
+}
+
+long KRPipelineManager::getDescriptorSetBindsLastFrame() const
+{
+  return m_descriptorSetBindsLastFrame;
+}
+
+long KRPipelineManager::getDescriptorSetWritesLastFrame() const
+{
+  return m_descriptorSetWritesLastFrame;
+}
+
 KRPipeline* KRPipelineManager::getPipeline(KRSurface& surface, const PipelineInfo& info)
 {
   std::pair<std::string, std::vector<int> > key;
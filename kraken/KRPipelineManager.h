@@ -60,9 +60,20 @@ public:
 
   size_t getPipelineHandlesUsed();
 
+  void startFrame(float deltaTime);
+  void addDescriptorSetBind(bool written);
+  // Descriptor set activity of the last completed frame
+  long getDescriptorSetBindsLastFrame() const;
+  long getDescriptorSetWritesLastFrame() const; // Calls to vkUpdateDescriptorSets
+
   KRPipeline* m_active_pipeline;
 
 private:
   typedef std::map<std::pair<std::string, std::vector<int> >, KRPipeline*> PipelineMap;
   PipelineMap m_pipelines;
+
+  long m_descriptorSetBinds;
+  long m_descriptorSetWrites;
+  long m_descriptorSetBindsLastFrame;
+  long m_descriptorSetWritesLastFrame;
 };
@@ -148,6 +148,7 @@ void KRPresentationThread::renderFrame()
     // Only reset the fence once we know we'll submit work,
     // avoiding a deadlock on swapchain recreation.
     vkResetFences(device.m_logicalDevice, 1, &surface.m_inFlightFences[m_currentFrame]);
+    device.graphicsUploadStart(m_currentFrame);
 
     // TODO - this will break with more than one surface...  Expect to refactor this out
     VkCommandBuffer commandBuffer = device.m_graphicsCommandBuffers[m_currentFrame];
@@ -191,7 +192,7 @@ void KRPresentationThread::renderFrame()
     submitInfo.signalSemaphoreCount = 1;
     submitInfo.pSignalSemaphores = signalSemaphores;
 
-    if (vkQueueSubmit(device.m_graphicsQueue, 1, &submitInfo, surface.m_inFlightFences[m_currentFrame]) != VK_SUCCESS) {
+    if (device.submitGraphics(submitInfo, surface.m_inFlightFences[m_currentFrame]) != VK_SUCCESS) {
       m_activeState = PresentThreadState::error;
       // TODO - Add error handling...
     }
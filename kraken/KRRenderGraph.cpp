@@ -170,12 +170,25 @@ void KRRenderGraph::render(VkCommandBuffer &commandBuffer, KRSurface& surface, K
   ri.surface = &surface;
 
   for(KRRenderPass* pass : m_renderPasses) {
+    bool feedbackPass = pass->getType() == RenderPassType::RENDER_PASS_TEXTURE_FEEDBACK;
+    if (feedbackPass && (camera == nullptr || !camera->settings.texture_feedback_enable)) {
+      continue;
+    }
     ri.renderPass = pass;
     pass->begin(commandBuffer, surface);
     if (camera) {
       camera->render(ri);
     }
     pass->end(commandBuffer);
+
+    if (feedbackPass) {
+      // The texture manager reads the feedback on the host once this frame's fence is signalled
+      VkMemoryBarrier barrier{};
+      barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+      barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+      barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+      vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
   }
 }
 
@@ -140,6 +140,14 @@ KrResult KRRenderGraphDeferred::initialize(KRSurface &surface)
 
   info.colorAttachments[1] = {};
 
+  // ----====---- Texture Feedback ----====----
+  info.colorAttachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+  info.type = RenderPassType::RENDER_PASS_TEXTURE_FEEDBACK;
+#if KRENGINE_DEBUG_GPU_LABELS
+  strncpy(info.debugLabel, "Texture Feedback", KRENGINE_DEBUG_GPU_LABEL_MAX_LEN);
+#endif
+  addRenderPass(*surface.getDevice(), info);
+
   // ----====---- Transparent Geometry, Forward Rendering ----====----
   info.depthAttachment.id = attachment_compositeDepth;
   info.depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
@@ -109,6 +109,17 @@ KrResult KRRenderGraphForward::initialize(KRSurface &surface)
 #endif
   addRenderPass(*surface.getDevice(), info);
 
+  // ----====---- Texture Feedback ----====----
+  // Records the finest mip level sampled from each material texture.
+  // The depth of the opaque geometry is tested, so hidden surfaces are not recorded.
+  info.depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+  info.colorAttachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+  info.type = RenderPassType::RENDER_PASS_TEXTURE_FEEDBACK;
+#if KRENGINE_DEBUG_GPU_LABELS
+  strncpy(info.debugLabel, "Texture Feedback", KRENGINE_DEBUG_GPU_LABEL_MAX_LEN);
+#endif
+  addRenderPass(*surface.getDevice(), info);
+
   // ----====---- Transparent Geometry, Forward Rendering ----====----
   info.depthAttachment.id = attachment_compositeDepth;
   info.depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
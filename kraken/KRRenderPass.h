@@ -51,6 +51,7 @@ enum RenderPassType : uint8_t
   RENDER_PASS_POST_COMPOSITE,
   RENDER_PASS_DEBUG_OVERLAYS,
   RENDER_PASS_BLACK_FRAME,
+  RENDER_PASS_TEXTURE_FEEDBACK,
 };
 
 #define RENDER_PASS_ATTACHMENT_MAX_COUNT 16
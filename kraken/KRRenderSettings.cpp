@@ -94,6 +94,9 @@ KRRenderSettings::KRRenderSettings()
 
   dust_particle_intensity = 0.25f;
   dust_particle_enable = false;
+  skinning_prepass_enable = false;
+  texture_feedback_enable = false;
+  bindless_enable = false;
 
   m_lodBias = 0.0f;
 
@@ -161,6 +164,9 @@ KRRenderSettings& KRRenderSettings::operator=(const KRRenderSettings& s)
 
   dust_particle_intensity = s.dust_particle_intensity;
   dust_particle_enable = s.dust_particle_enable;
+  skinning_prepass_enable = s.skinning_prepass_enable;
+  texture_feedback_enable = s.texture_feedback_enable;
+  bindless_enable = s.bindless_enable;
   perspective_nearz = s.perspective_nearz;
   perspective_farz = s.perspective_farz;
   debug_display = s.debug_display;
@@ -105,6 +105,9 @@ public:
 
   float dust_particle_intensity;
   bool dust_particle_enable;
+  bool skinning_prepass_enable; // Skin each visible model once per frame on the compute queue, rather than in every pass
+  bool texture_feedback_enable; // Stream material textures at the finest level sampled by the GPU
+  bool bindless_enable; // Draw materials from the bindless texture and material tables, where supported
   float perspective_nearz;
   float perspective_farz;
 
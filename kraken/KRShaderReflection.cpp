@@ -202,6 +202,14 @@ const char* SHADER_VALUE_NAMES[] = {
     "rim_color", // PushConstant::rim_color
     "rim_power", // PushConstant::rim_power
     "fade_color", // PushConstant::fade_color
+    "material_baseColor_map_feedback", // PushConstant::material_baseColor_map_feedback
+    "material_baseColor_map_dimensions", // PushConstant::material_baseColor_map_dimensions
+    "material_normal_map_feedback", // PushConstant::material_normal_map_feedback
+    "material_normal_map_dimensions", // PushConstant::material_normal_map_dimensions
+    "material_baseColor_map_regions", // PushConstant::material_baseColor_map_regions
+    "material_normal_map_regions", // PushConstant::material_normal_map_regions
+    "material_index", // PushConstant::material_index
+    "material_baseColor_map_cached", // PushConstant::material_baseColor_map_cached
 };
 
 bool IsShaderValueName(int index, const char* szName)
@@ -188,6 +188,18 @@ enum class ShaderValue : uint8_t
   diffusetexture,
   speculartexture,
   reflectioncubetexture,
+  reflectiontexture,
+  normaltexture,
+  diffusetexture_scale,
+  speculartexture_scale,
+  reflectiontexture_scale,
+  normaltexture_scale,
+  ambienttexture_scale,
+  diffusetexture_offset,
+  speculartexture_offset,
+  reflectiontexture_offset,
+  normaltexture_offset,
+  ambienttexture_offset,
   shadow_mvp1,
   shadow_mvp2,
   shadow_mvp3,
@@ -214,6 +226,14 @@ enum class ShaderValue : uint8_t
   rim_color,
   rim_power,
   fade_color,
+  material_baseColor_map_feedback,
+  material_baseColor_map_dimensions,
+  material_normal_map_feedback,
+  material_normal_map_dimensions,
+  material_baseColor_map_regions,
+  material_normal_map_regions,
+  material_index,
+  material_baseColor_map_cached,
   NUM_SHADER_VALUES
 };
 
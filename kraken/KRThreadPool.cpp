@@ -0,0 +1,186 @@
+//
+//  KRThreadPool.cpp
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+#include "KREngine-common.h"
+
+#include "KRThreadPool.h"
+
+namespace {
+// Set on worker threads so that nested parallelFor calls run inline rather
+// than waiting on workers that may all be busy with the enclosing job
+thread_local const KRThreadPool* t_workerPool = nullptr;
+} // namespace
+
+KRThreadPool::KRThreadPool()
+  : m_stop(false)
+  , m_running(false)
+{
+}
+
+KRThreadPool::~KRThreadPool()
+{
+  stop();
+}
+
+void KRThreadPool::start()
+{
+  if (m_running) {
+    return;
+  }
+  m_running = true;
+  m_stop = false;
+
+  // The calling thread also processes work, so one fewer worker is needed
+  unsigned int threadCount = std::thread::hardware_concurrency();
+  if (threadCount > 1) {
+    threadCount--;
+  } else {
+    threadCount = 0;
+  }
+  for (unsigned int i = 0; i < threadCount; i++) {
+    m_threads.push_back(std::thread(&KRThreadPool::run, this));
+  }
+}
+
+void KRThreadPool::stop()
+{
+  if (!m_running) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_workAvailable.notify_all();
+  for (std::thread& thread : m_threads) {
+    thread.join();
+  }
+  m_threads.clear();
+  m_running = false;
+}
+
+size_t KRThreadPool::getThreadCount() const
+{
+  return m_threads.size() + 1;
+}
+
+void KRThreadPool::parallelFor(size_t count, size_t minBatchSize, const RangeFunction& fn)
+{
+  if (count == 0) {
+    return;
+  }
+  size_t batchSize = std::max<size_t>(minBatchSize, 1);
+  batchSize = std::max(batchSize, (count + getThreadCount() * 4 - 1) / (getThreadCount() * 4));
+  if (m_threads.empty() || count <= batchSize || t_workerPool == this) {
+    fn(0, count);
+    return;
+  }
+
+  Job job;
+  job.function = &fn;
+  job.count = count;
+  job.batchSize = batchSize;
+  job.nextIndex = 0;
+  job.activeWorkers = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_jobs.push_back(&job);
+  }
+  m_workAvailable.notify_all();
+
+  processBatches(job);
+
+  // All batches have been claimed.  Stop more workers from picking up the
+  // job, then wait for the ones still processing it.
+  std::unique_lock<std::mutex> lock(m_mutex);
+  auto itr = std::find(m_jobs.begin(), m_jobs.end(), &job);
+  if (itr != m_jobs.end()) {
+    m_jobs.erase(itr);
+  }
+  m_workComplete.wait(lock, [&job] { return job.activeWorkers == 0; });
+}
+
+void KRThreadPool::processBatches(Job& job)
+{
+  while (true) {
+    size_t begin = job.nextIndex.fetch_add(job.batchSize);
+    if (begin >= job.count) {
+      break;
+    }
+    (*job.function)(begin, std::min(begin + job.batchSize, job.count));
+  }
+}
+
+void KRThreadPool::run()
+{
+#if defined(ANDROID)
+  // TODO - Set thread names on Android
+#elif defined(_WIN32) || defined(_WIN64)
+  // TODO - Set thread names on windows
+#else
+  pthread_setname_np("Kraken - Worker");
+#endif
+
+  t_workerPool = this;
+
+  while (true) {
+    Job* job = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while (job == nullptr) {
+        m_workAvailable.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+        if (m_stop) {
+          return;
+        }
+        // Jobs whose batches have all been claimed only need their caller
+        job = m_jobs.front();
+        if (job->nextIndex >= job->count) {
+          m_jobs.pop_front();
+          job = nullptr;
+        }
+      }
+      job->activeWorkers++;
+    }
+
+    processBatches(*job);
+
+    bool lastWorker = false;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      job->activeWorkers--;
+      lastWorker = job->activeWorkers == 0;
+    }
+    if (lastWorker) {
+      // Several callers may be waiting on different jobs
+      m_workComplete.notify_all();
+    }
+  }
+}
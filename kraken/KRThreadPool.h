@@ -0,0 +1,89 @@
+//
+//  KRThreadPool.h
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+#pragma once
+
+#include "KREngine-common.h"
+
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+
+// Persistent worker threads used to split per-frame work, such as transform
+// updates, across cores.  parallelFor blocks until all of the work has
+// completed, with the calling thread processing batches alongside the workers.
+class KRThreadPool
+{
+public:
+  typedef std::function<void(size_t begin, size_t end)> RangeFunction;
+
+  KRThreadPool();
+  ~KRThreadPool();
+
+  void start();
+  void stop();
+
+  size_t getThreadCount() const;
+
+  // Calls fn for consecutive ranges covering [0, count).  Ranges are at
+  // least minBatchSize long, so small jobs run inline on the calling thread.
+  // Jobs from different threads, such as the streamer, run concurrently; each
+  // caller works on its own job while the workers help.  Calls made from
+  // within a job on a worker thread run inline.
+  void parallelFor(size_t count, size_t minBatchSize, const RangeFunction& fn);
+
+private:
+  // State of one parallelFor call, owned by the calling thread's stack.
+  // activeWorkers is guarded by m_mutex.
+  struct Job
+  {
+    const RangeFunction* function;
+    size_t count;
+    size_t batchSize;
+    std::atomic<size_t> nextIndex;
+    size_t activeWorkers;
+  };
+
+  void run();
+  static void processBatches(Job& job);
+
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_workAvailable;
+  std::condition_variable m_workComplete;
+  bool m_stop;
+  bool m_running;
+
+  // Jobs with batches that have not yet been claimed, oldest first
+  std::deque<Job*> m_jobs;
+};
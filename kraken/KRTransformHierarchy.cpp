@@ -0,0 +1,280 @@
+//
+//  KRTransformHierarchy.cpp
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+#include "KREngine-common.h"
+
+#include "KRTransformHierarchy.h"
+#include "KRThreadPool.h"
+#include "nodes/KRNode.h"
+
+using namespace hydra;
+
+namespace {
+// Minimum number of transforms processed by each worker thread
+const size_t kMinBatchSize = 256;
+const uint32_t kUnknownDepth = 0xffffffff;
+} // anonymous namespace
+
+KRTransformHierarchy::KRTransformHierarchy()
+  : m_orderDirty(true)
+  , m_updating(false)
+{
+}
+
+KRTransformHierarchy::~KRTransformHierarchy()
+{
+}
+
+uint32_t KRTransformHierarchy::add(KRNode* node)
+{
+  uint32_t index = (uint32_t)m_nodes.size();
+  m_nodes.push_back(node);
+  m_parents.push_back(kNoParent);
+  m_localMatrices.push_back(Matrix4());
+  m_worldMatrices.push_back(Matrix4());
+  m_versions.push_back(0);
+  m_flags.push_back(FLAG_DIRTY);
+  m_orderDirty = true;
+  return index;
+}
+
+void KRTransformHierarchy::remove(uint32_t index)
+{
+  // The entry is released when the arrays are next sorted
+  m_nodes[index] = nullptr;
+  m_parents[index] = kNoParent;
+  m_flags[index] = 0;
+  m_orderDirty = true;
+}
+
+void KRTransformHierarchy::setParent(uint32_t index, uint32_t parentIndex)
+{
+  if (m_parents[index] != parentIndex) {
+    m_parents[index] = parentIndex;
+    m_flags[index] |= FLAG_DIRTY;
+    m_orderDirty = true;
+  }
+}
+
+void KRTransformHierarchy::invalidate(uint32_t index)
+{
+  assert(!m_updating);
+  m_flags[index] |= FLAG_DIRTY;
+}
+
+bool KRTransformHierarchy::isStale(uint32_t index) const
+{
+  for (uint32_t i = index; i != kNoParent; i = m_parents[i]) {
+    if (m_flags[i] & (FLAG_DIRTY | FLAG_PARENT_DIRTY)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void KRTransformHierarchy::calculate(uint32_t index)
+{
+  const KRNode* node = m_nodes[index];
+  uint32_t parent = m_parents[index];
+  uint8_t flags = m_flags[index];
+
+  if (flags & FLAG_DIRTY) {
+    bool scaleCompensated = node->isScaleCompensated();
+    m_localMatrices[index] = node->calculateLocalMatrix(scaleCompensated);
+    if (scaleCompensated) {
+      flags |= FLAG_SCALE_COMPENSATED;
+    } else {
+      flags &= ~FLAG_SCALE_COMPENSATED;
+    }
+  }
+
+  if (parent == kNoParent) {
+    m_worldMatrices[index] = m_localMatrices[index];
+  } else if (flags & FLAG_SCALE_COMPENSATED) {
+    m_worldMatrices[index] = node->calculateScaleCompensatedModelMatrix(m_localMatrices[index], m_worldMatrices[parent]);
+  } else {
+    m_worldMatrices[index] = m_localMatrices[index] * m_worldMatrices[parent];
+  }
+
+  m_versions[index]++;
+  m_flags[index] = flags & ~(FLAG_DIRTY | FLAG_PARENT_DIRTY);
+}
+
+const Matrix4& KRTransformHierarchy::getModelMatrix(uint32_t index)
+{
+  if (!isStale(index)) {
+    return m_worldMatrices[index];
+  }
+  // The lazy recalculation below writes to shared ancestors, so must not
+  // race with the worker threads of update().
+  assert(!m_updating);
+
+  // Recalculate the stale part of the chain of ancestors, starting from the root.
+  // Other children of recalculated nodes are flagged, so that they are
+  // recalculated when next requested or by the next update().
+  m_chain.clear();
+  for (uint32_t i = index; i != kNoParent; i = m_parents[i]) {
+    m_chain.push_back(i);
+  }
+  for (auto itr = m_chain.rbegin(); itr != m_chain.rend(); ++itr) {
+    uint32_t i = *itr;
+    if ((m_flags[i] & (FLAG_DIRTY | FLAG_PARENT_DIRTY)) == 0) {
+      continue;
+    }
+    calculate(i);
+    m_flags[i] |= FLAG_CHANGED;
+    for (KRNode* child = m_nodes[i]->m_firstChildNode; child != nullptr; child = child->m_nextNode) {
+      m_flags[child->m_transformIndex] |= FLAG_PARENT_DIRTY;
+    }
+  }
+  return m_worldMatrices[index];
+}
+
+uint32_t KRTransformHierarchy::getVersion(uint32_t index)
+{
+  getModelMatrix(index);
+  return m_versions[index];
+}
+
+void KRTransformHierarchy::sortByDepth()
+{
+  size_t count = m_nodes.size();
+
+  // Find the depth of each node, walking up only until reaching an
+  // ancestor with a known depth
+  std::vector<uint32_t> depths(count, kUnknownDepth);
+  std::vector<uint32_t> depthCounts;
+  for (uint32_t i = 0; i < count; i++) {
+    if (m_nodes[i] == nullptr || depths[i] != kUnknownDepth) {
+      continue;
+    }
+    m_chain.clear();
+    uint32_t j = i;
+    while (j != kNoParent && depths[j] == kUnknownDepth) {
+      m_chain.push_back(j);
+      j = m_parents[j];
+    }
+    uint32_t depth = j == kNoParent ? 0 : depths[j] + 1;
+    for (auto itr = m_chain.rbegin(); itr != m_chain.rend(); ++itr) {
+      depths[*itr] = depth;
+      if (depthCounts.size() <= depth) {
+        depthCounts.resize(depth + 1, 0);
+      }
+      depthCounts[depth]++;
+      depth++;
+    }
+  }
+
+  // Counting sort by depth, preserving the existing order within each depth
+  m_depthStart.resize(depthCounts.size() + 1);
+  uint32_t start = 0;
+  for (size_t depth = 0; depth < depthCounts.size(); depth++) {
+    m_depthStart[depth] = start;
+    start += depthCounts[depth];
+  }
+  m_depthStart[depthCounts.size()] = start;
+  uint32_t liveCount = start;
+
+  std::vector<uint32_t> newIndices(count, kNoParent);
+  std::vector<uint32_t> cursors(m_depthStart.begin(), m_depthStart.end() - 1);
+  for (uint32_t i = 0; i < count; i++) {
+    if (m_nodes[i] != nullptr) {
+      newIndices[i] = cursors[depths[i]]++;
+    }
+  }
+
+  std::vector<KRNode*> nodes(liveCount);
+  std::vector<uint32_t> parents(liveCount);
+  std::vector<Matrix4> localMatrices(liveCount);
+  std::vector<Matrix4> worldMatrices(liveCount);
+  std::vector<uint32_t> versions(liveCount);
+  std::vector<uint8_t> flags(liveCount);
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t newIndex = newIndices[i];
+    if (newIndex == kNoParent) {
+      continue;
+    }
+    nodes[newIndex] = m_nodes[i];
+    parents[newIndex] = m_parents[i] == kNoParent ? kNoParent : newIndices[m_parents[i]];
+    localMatrices[newIndex] = m_localMatrices[i];
+    worldMatrices[newIndex] = m_worldMatrices[i];
+    versions[newIndex] = m_versions[i];
+    flags[newIndex] = m_flags[i];
+    m_nodes[i]->m_transformIndex = newIndex;
+  }
+  m_nodes.swap(nodes);
+  m_parents.swap(parents);
+  m_localMatrices.swap(localMatrices);
+  m_worldMatrices.swap(worldMatrices);
+  m_versions.swap(versions);
+  m_flags.swap(flags);
+
+  m_orderDirty = false;
+}
+
+void KRTransformHierarchy::update(KRThreadPool& threadPool)
+{
+  if (m_orderDirty) {
+    sortByDepth();
+  }
+
+  // Each depth only reads the results of the depth above it, so the
+  // transforms within a depth can be calculated in parallel.
+  m_updating = true;
+  for (size_t depth = 0; depth + 1 < m_depthStart.size(); depth++) {
+    uint32_t depthStart = m_depthStart[depth];
+    threadPool.parallelFor(m_depthStart[depth + 1] - depthStart, kMinBatchSize, [this, depthStart](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        uint32_t index = depthStart + (uint32_t)i;
+        uint32_t parent = m_parents[index];
+        if ((m_flags[index] & (FLAG_DIRTY | FLAG_PARENT_DIRTY)) || (parent != kNoParent && (m_flags[parent] & FLAG_UPDATED))) {
+          calculate(index);
+          m_flags[index] |= FLAG_UPDATED;
+        }
+      }
+    });
+  }
+  m_updating = false;
+
+  // Notify the nodes whose world matrices have changed.  This updates the
+  // bounds and octree, so is done on this thread.  Children are visited
+  // before their parents so that the parent's flags are still available.
+  for (size_t i = m_nodes.size(); i > 0; i--) {
+    uint32_t index = (uint32_t)i - 1;
+    if ((m_flags[index] & (FLAG_UPDATED | FLAG_CHANGED)) == 0) {
+      continue;
+    }
+    uint32_t parent = m_parents[index];
+    bool parentUpdated = parent != kNoParent && (m_flags[parent] & (FLAG_UPDATED | FLAG_CHANGED));
+    m_nodes[index]->transformUpdated(parentUpdated);
+    m_flags[index] &= ~(FLAG_UPDATED | FLAG_CHANGED);
+  }
+}
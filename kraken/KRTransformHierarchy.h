@@ -0,0 +1,106 @@
+//
+//  KRTransformHierarchy.h
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+#pragma once
+
+#include "KREngine-common.h"
+
+class KRNode;
+class KRThreadPool;
+
+// Stores the transforms of every node in a scene as parallel arrays, sorted
+// by depth in the node hierarchy so that parents always precede their
+// children.  Changing a node's local transform only marks its own entry as
+// dirty.  World matrices are recalculated once per frame by update(), which
+// processes one depth at a time and splits each depth across worker threads.
+// getModelMatrix() recalculates only the ancestors of the requested node,
+// allowing matrices to be read between updates.  It writes to the entries
+// of those ancestors, so like the rest of this class it may only be called
+// from the thread that calls update(), and never from a parallel pass over
+// the nodes.
+class KRTransformHierarchy
+{
+public:
+  static constexpr uint32_t kNoParent = 0xffffffff;
+
+  KRTransformHierarchy();
+  ~KRTransformHierarchy();
+
+  uint32_t add(KRNode* node);
+  void remove(uint32_t index);
+  void setParent(uint32_t index, uint32_t parentIndex);
+
+  // Called when the local transform of a node has changed
+  void invalidate(uint32_t index);
+
+  const hydra::Matrix4& getModelMatrix(uint32_t index);
+
+  // Incremented each time the world matrix is recalculated, allowing values
+  // derived from it to be cached.  The transform is brought up to date first.
+  uint32_t getVersion(uint32_t index);
+
+  void update(KRThreadPool& threadPool);
+
+private:
+  enum
+  {
+    // The local transform has changed
+    FLAG_DIRTY = 0x01,
+    // The parent's world matrix was recalculated outside of update()
+    FLAG_PARENT_DIRTY = 0x02,
+    // The world matrix was recalculated by the current update()
+    FLAG_UPDATED = 0x04,
+    // The world matrix was recalculated by getModelMatrix() since the last update()
+    FLAG_CHANGED = 0x08,
+    // The node is scale compensated and parented to a bone
+    FLAG_SCALE_COMPENSATED = 0x10
+  };
+
+  void sortByDepth();
+  void calculate(uint32_t index);
+  bool isStale(uint32_t index) const;
+
+  std::vector<KRNode*> m_nodes;
+  std::vector<uint32_t> m_parents;
+  std::vector<hydra::Matrix4> m_localMatrices;
+  std::vector<hydra::Matrix4> m_worldMatrices;
+  std::vector<uint32_t> m_versions;
+  std::vector<uint8_t> m_flags;
+
+  // Index of the first entry at each depth, followed by the entry count.
+  // Only valid while m_orderDirty is false.
+  std::vector<uint32_t> m_depthStart;
+  bool m_orderDirty;
+  // True while update() is calculating transforms on worker threads
+  bool m_updating;
+
+  std::vector<uint32_t> m_chain;
+};
@@ -162,6 +162,22 @@ KrResult KrCompileAllShaders(const KrCompileAllShadersInfo* pCompileAllShadersIn
   return sContext->compileAllShaders(pCompileAllShadersInfo);
 }
 
+KrResult KrCompressAnimationCurve(const KrCompressAnimationCurveInfo* pCompressAnimationCurveInfo)
+{
+  if (!sContext) {
+    return KR_ERROR_NOT_INITIALIZED;
+  }
+  return sContext->compressAnimationCurve(pCompressAnimationCurveInfo);
+}
+
+KrResult KrCompressTexture(const KrCompressTextureInfo* pCompressTextureInfo)
+{
+  if (!sContext) {
+    return KR_ERROR_NOT_INITIALIZED;
+  }
+  return sContext->compressTexture(pCompressTextureInfo);
+}
+
 KrResult KrCreateScene(const KrCreateSceneInfo* pCreateSceneInfo)
 {
   if (!sContext) {
@@ -170,6 +186,14 @@ KrResult KrCreateScene(const KrCreateSceneInfo* pCreateSceneInfo)
   return sContext->createScene(pCreateSceneInfo);
 }
 
+KrResult KrSetSceneFormat(const KrSetSceneFormatInfo* pSetSceneFormatInfo)
+{
+  if (!sContext) {
+    return KR_ERROR_NOT_INITIALIZED;
+  }
+  return sContext->setSceneFormat(pSetSceneFormatInfo);
+}
+
 KrResult KrFindNodeByName(const KrFindNodeByNameInfo* pFindNodeByNameInfo)
 {
   if (!sContext) {
@@ -59,23 +59,13 @@ std::string KRAmbientZone::getElementName()
   return "ambient_zone";
 }
 
-tinyxml2::XMLElement* KRAmbientZone::saveXML(tinyxml2::XMLNode* parent)
+void KRAmbientZone::visitProperties(KRNodePropertyVisitor& visitor)
 {
-  tinyxml2::XMLElement* e = KRNode::saveXML(parent);
-  m_zone.save(e);
-  m_ambient.save(e);
-  m_ambient_gain.save(e);
-  m_gradient_distance.save(e);
-  return e;
-}
-
-void KRAmbientZone::loadXML(tinyxml2::XMLElement* e)
-{
-  KRNode::loadXML(e);
-  m_zone.load(e);
-  m_gradient_distance.load(e);
-  m_ambient.load(e);
-  m_ambient_gain.load(e);
+  KRNode::visitProperties(visitor);
+  m_zone.visit(visitor);
+  m_gradient_distance.visit(visitor);
+  m_ambient.visit(visitor);
+  m_ambient_gain.visit(visitor);
 }
 
 KRAudioSample* KRAmbientZone::getAmbient()
@@ -46,8 +46,7 @@ public:
   KRAmbientZone(KRScene& scene, std::string name);
   virtual ~KRAmbientZone() override;
   virtual std::string getElementName() override;
-  virtual tinyxml2::XMLElement* saveXML(tinyxml2::XMLNode* parent) override;
-  virtual void loadXML(tinyxml2::XMLElement* e) override;
+  virtual void visitProperties(KRNodePropertyVisitor& visitor) override;
 
   void render(RenderInfo& ri) override;
 
@@ -77,36 +77,19 @@ std::string KRAudioSource::getElementName()
   return "audio_source";
 }
 
-tinyxml2::XMLElement* KRAudioSource::saveXML(tinyxml2::XMLNode* parent)
-{
-  tinyxml2::XMLElement* e = KRNode::saveXML(parent);
-  m_sample.save(e);
-  m_gain.save(e);
-  m_pitch.save(e);
-  m_looping.save(e);
-  m_is3d.save(e);
-  m_referenceDistance.save(e);
-  m_reverb.save(e);
-  m_rolloffFactor.save(e);
-  m_enable_occlusion.save(e);
-  m_enable_obstruction.save(e);
-  return e;
-}
-
-void KRAudioSource::loadXML(tinyxml2::XMLElement* e)
-{
-  m_sample.load(e);
-  m_gain.load(e);
-  m_pitch.load(e);
-  m_looping.load(e);
-  m_is3d.load(e);
-  m_referenceDistance.load(e);
-  m_reverb.load(e);
-  m_rolloffFactor.load(e);
-  m_enable_obstruction.load(e);
-  m_enable_occlusion.load(e);
-
-  KRNode::loadXML(e);
+void KRAudioSource::visitProperties(KRNodePropertyVisitor& visitor)
+{
+  KRNode::visitProperties(visitor);
+  m_sample.visit(visitor);
+  m_gain.visit(visitor);
+  m_pitch.visit(visitor);
+  m_looping.visit(visitor);
+  m_is3d.visit(visitor);
+  m_referenceDistance.visit(visitor);
+  m_reverb.visit(visitor);
+  m_rolloffFactor.visit(visitor);
+  m_enable_obstruction.visit(visitor);
+  m_enable_occlusion.visit(visitor);
 }
 
 void KRAudioSource::prime()
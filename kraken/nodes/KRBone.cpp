@@ -55,18 +55,6 @@ std::string KRBone::getElementName()
   return "bone";
 }
 
-tinyxml2::XMLElement* KRBone::saveXML(tinyxml2::XMLNode* parent)
-{
-  tinyxml2::XMLElement* e = KRNode::saveXML(parent);
-
-  return e;
-}
-
-void KRBone::loadXML(tinyxml2::XMLElement* e)
-{
-  KRNode::loadXML(e);
-}
-
 AABB KRBone::getBounds()
 {
   return AABB::Create(-Vector3::One(), Vector3::One(), getModelMatrix()); // Only required for bone debug visualization
@@ -44,8 +44,6 @@ public:
   KRBone(KRScene& scene, std::string name);
   virtual ~KRBone();
   virtual std::string getElementName() override;
-  virtual tinyxml2::XMLElement* saveXML(tinyxml2::XMLNode* parent) override;
-  virtual void loadXML(tinyxml2::XMLElement* e) override;
   virtual hydra::AABB getBounds() override;
 
   void render(RenderInfo& ri) override;
@@ -91,7 +91,7 @@ KRCamera::KRCamera(KRScene& scene, std::string name)
 
   m_fade_color = Vector4::Zero();
 
-  m_debug_text_vbo_data.init(m_pContext->getMeshManager(), &m_debug_text_vertices, nullptr, (1 << KRMesh::KRENGINE_ATTRIB_VERTEX) | (1 << KRMesh::KRENGINE_ATTRIB_TEXUVA), true, KRMeshManager::KRVBOData::IMMEDIATE
+  m_debug_text_vbo_data.init(m_pContext->getMeshManager(), &m_debug_text_vertices, nullptr, VK_INDEX_TYPE_UINT16, (1 << KRMesh::KRENGINE_ATTRIB_VERTEX) | (1 << KRMesh::KRENGINE_ATTRIB_TEXUVA), true, KRMeshManager::KRVBOData::IMMEDIATE
 #if KRENGINE_DEBUG_GPU_LABELS
     , "Debug Text"
 #endif
@@ -108,21 +108,11 @@ std::string KRCamera::getElementName()
   return "camera";
 }
 
-tinyxml2::XMLElement* KRCamera::saveXML(tinyxml2::XMLNode* parent)
+void KRCamera::visitProperties(KRNodePropertyVisitor& visitor)
 {
-  tinyxml2::XMLElement* e = KRNode::saveXML(parent);
-  m_skyBox.save(e);
-  m_surfaceHandle.save(e);
-
-  return e;
-}
-
-
-void KRCamera::loadXML(tinyxml2::XMLElement* e)
-{
-  KRNode::loadXML(e);
-  m_skyBox.load(e);
-  m_surfaceHandle.load(e);
+  KRNode::visitProperties(visitor);
+  m_skyBox.visit(visitor);
+  m_surfaceHandle.visit(visitor);
 }
 
 void KRCamera::setSkyBox(const std::string& skyBox)
@@ -251,6 +241,10 @@ void KRCamera::renderFrame(VkCommandBuffer& commandBuffer, KRSurface& compositeS
 
   scene.updateOctree(m_viewport);
 
+  if (settings.skinning_prepass_enable) {
+    scene.skinModels(compositeSurface.m_deviceHandle, m_viewport);
+  }
+
   renderGraph.render(commandBuffer, compositeSurface, this);
 }
 
@@ -655,6 +649,10 @@ std::string KRCamera::getDebugText()
     if (fps > 0) {
       stream << "FPS\t" << fps;
     }
+    stream << "\nLOD Nodes\t" << getScene().getLODNodesVisited();
+    KRPipelineManager* pipelineManager = m_pContext->getPipelineManager();
+    stream << "\nDescriptor Binds\t" << pipelineManager->getDescriptorSetBindsLastFrame();
+    stream << "\nDescriptor Writes\t" << pipelineManager->getDescriptorSetWritesLastFrame();
   }
   break;
 
@@ -791,6 +789,9 @@ std::string KRCamera::getDebugText()
       case RenderPassType::RENDER_PASS_SHADOWMAP:
         stream << "shadow";
         break;
+      case RenderPassType::RENDER_PASS_TEXTURE_FEEDBACK:
+        stream << "feedback";
+        break;
       default:
         // Suppress warnings
         break;
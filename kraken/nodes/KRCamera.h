@@ -71,8 +71,7 @@ public:
 
 
   virtual std::string getElementName() override;
-  virtual tinyxml2::XMLElement* saveXML(tinyxml2::XMLNode* parent) override;
-  virtual void loadXML(tinyxml2::XMLElement* e) override;
+  virtual void visitProperties(KRNodePropertyVisitor& visitor) override;
 
   std::string getDebugText();
 
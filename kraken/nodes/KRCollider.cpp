@@ -70,21 +70,12 @@ std::string KRCollider::getElementName()
   return "collider";
 }
 
-tinyxml2::XMLElement* KRCollider::saveXML(tinyxml2::XMLNode* parent)
+void KRCollider::visitProperties(KRNodePropertyVisitor& visitor)
 {
-  tinyxml2::XMLElement* e = KRNode::saveXML(parent);
-  m_model.save(e);
-  m_layer_mask.save(e);
-  m_audio_occlusion.save(e);
-  return e;
-}
-
-void KRCollider::loadXML(tinyxml2::XMLElement* e)
-{
-  KRNode::loadXML(e);
-  m_model.load(e);
-  m_layer_mask.load(e);
-  m_audio_occlusion.load(e);
+  KRNode::visitProperties(visitor);
+  m_model.visit(visitor);
+  m_layer_mask.visit(visitor);
+  m_audio_occlusion.visit(visitor);
 }
 
 void KRCollider::loadModel()
@@ -222,7 +213,7 @@ void KRCollider::render(RenderInfo& ri)
 
       KRPipeline* pShader = getContext().getPipelineManager()->getPipeline(*ri.surface, info);
 
-      if (pShader && pShader->bind(ri, getModelMatrix())) {
+      if (pShader && pShader->bind(ri, m_model.val.get()->getPositionDequantization() * getModelMatrix())) {
         m_model.val.get()->renderNoMaterials(ri.commandBuffer, ri.renderPass, getName(), "visualize_overlay", 1.0f);
       }
 
@@ -57,8 +57,7 @@ public:
   virtual ~KRCollider();
 
   virtual std::string getElementName() override;
-  virtual tinyxml2::XMLElement* saveXML(tinyxml2::XMLNode* parent) override;
-  virtual void loadXML(tinyxml2::XMLElement* e) override;
+  virtual void visitProperties(KRNodePropertyVisitor& visitor) override;
   virtual hydra::AABB getBounds() override;
 
   bool lineCast(const hydra::Vector3& v0, const hydra::Vector3& v1, hydra::HitInfo& hitinfo, unsigned int layer_mask);
@@ -61,6 +61,11 @@ std::string KRDirectionalLight::getElementName()
   return "directional_light";
 }
 
+void KRDirectionalLight::appendToLightLists(std::vector<KRDirectionalLight*>& directional_lights, std::vector<KRSpotLight*>& spot_lights, std::vector<KRPointLight*>& point_lights)
+{
+  directional_lights.push_back(this);
+}
+
 Vector3 KRDirectionalLight::getWorldLightDirection() const
 {
   return Matrix4::Dot(getWorldRotation().rotationMatrix(), getLocalLightDirection());
@@ -48,6 +48,7 @@ public:
   hydra::Vector3 getViewSpaceLightDirection(const hydra::Matrix4 & viewMatrix) const;
 
   virtual void render(RenderInfo& ri) override;
+  virtual void appendToLightLists(std::vector<KRDirectionalLight*>& directional_lights, std::vector<KRSpotLight*>& spot_lights, std::vector<KRPointLight*>& point_lights) override;
   virtual hydra::AABB getBounds() override;
 
 protected:
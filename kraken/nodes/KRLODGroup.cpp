@@ -48,6 +48,12 @@ void KRLODGroup::InitNodeInfo(KrNodeInfo* nodeInfo)
 
 KRLODGroup::KRLODGroup(KRScene& scene, std::string name) : KRNode(scene, name)
 {
+  m_cachedLODVisibility = LOD_VISIBILITY_HIDDEN;
+  m_cachedLODVisibilityValid = false;
+  m_cachedCameraPosition = Vector3::Zero();
+  m_cachedStableDistance = 0.0f;
+  m_cachedLODBias = 0.0f;
+  m_cachedTransformVersion = 0;
 }
 
 KRLODGroup::~KRLODGroup()
@@ -58,26 +64,16 @@ std::string KRLODGroup::getElementName()
   return "lod_group";
 }
 
-tinyxml2::XMLElement* KRLODGroup::saveXML(tinyxml2::XMLNode* parent)
+void KRLODGroup::visitProperties(KRNodePropertyVisitor& visitor)
 {
-  tinyxml2::XMLElement* e = KRNode::saveXML(parent);
-  m_min_distance.save(e);
-  m_max_distance.save(e);
-  m_reference.save(e);
-  m_use_world_units.save(e);
-  return e;
+  KRNode::visitProperties(visitor);
+  m_min_distance.visit(visitor);
+  m_max_distance.visit(visitor);
+  m_reference.visit(visitor);
+  m_use_world_units.visit(visitor);
+  m_cachedLODVisibilityValid = false;
 }
 
-void KRLODGroup::loadXML(tinyxml2::XMLElement* e)
-{
-  KRNode::loadXML(e);
-  m_min_distance.load(e);
-  m_max_distance.load(e);
-  m_reference.load(e);
-  m_use_world_units.load(e);
-}
-
-
 const AABB& KRLODGroup::getReference() const
 {
   return m_reference;
@@ -86,11 +82,47 @@ const AABB& KRLODGroup::getReference() const
 void KRLODGroup::setReference(const AABB& reference)
 {
   m_reference = reference;
+  m_cachedLODVisibilityValid = false;
 }
 
-KRNode::LodVisibility KRLODGroup::calcLODVisibility(const KRViewport& viewport)
+bool KRLODGroup::hasUniformScale() const
 {
+  const Matrix4& model_matrix = getModelMatrix();
+  float x = Matrix4::DotNoTranslate(model_matrix, Vector3::Create(1.0f, 0.0f, 0.0f)).sqrMagnitude();
+  float y = Matrix4::DotNoTranslate(model_matrix, Vector3::Create(0.0f, 1.0f, 0.0f)).sqrMagnitude();
+  float z = Matrix4::DotNoTranslate(model_matrix, Vector3::Create(0.0f, 0.0f, 1.0f)).sqrMagnitude();
+  float min_scale = std::min(x, std::min(y, z));
+  float max_scale = std::max(x, std::max(y, z));
+  return max_scale - min_scale <= max_scale * 0.001f;
+}
+
+KRNode::LodVisibility KRLODGroup::getCachedLODVisibility(const KRViewport& viewport)
+{
+  Vector3 camera_position = viewport.getCameraPosition();
+  float lod_bias = viewport.getLODBias();
+  uint32_t transform_version = getTransformVersion();
+  if (!m_cachedLODVisibilityValid
+    || lod_bias != m_cachedLODBias
+    || transform_version != m_cachedTransformVersion
+    || (camera_position - m_cachedCameraPosition).sqrMagnitude() >= m_cachedStableDistance * m_cachedStableDistance) {
+    m_cachedLODVisibility = calcLODVisibility(viewport, &m_cachedStableDistance);
+    m_cachedCameraPosition = camera_position;
+    m_cachedLODBias = lod_bias;
+    m_cachedTransformVersion = transform_version;
+    m_cachedLODVisibilityValid = true;
+  }
+  return m_cachedLODVisibility;
+}
+
+KRNode::LodVisibility KRLODGroup::calcLODVisibility(const KRViewport& viewport, float* stable_distance)
+{
+  if (stable_distance) {
+    *stable_distance = 0.0f;
+  }
   if (m_min_distance == 0 && m_max_distance == 0) {
+    if (stable_distance) {
+      *stable_distance = std::numeric_limits<float>::max();
+    }
     return LOD_VISIBILITY_VISIBLE;
   } else {
     float lod_bias = viewport.getLODBias();
@@ -118,6 +150,27 @@ KRNode::LodVisibility KRLODGroup::calcLODVisibility(const KRViewport& viewport)
 
     float sqr_min_visible_distance = m_min_distance * m_min_distance;
     float sqr_max_visible_distance = m_max_distance * m_max_distance;
+
+    if (stable_distance && m_use_world_units && hasUniformScale()) {
+      // Find the nearest of the thresholds compared against below.  With a
+      // uniform scale, moving the camera by d changes the distance by at most d.
+      float distance = sqrtf(sqr_distance);
+      float stable = std::numeric_limits<float>::max();
+      auto addThreshold = [distance, &stable](float sqr_threshold) {
+        if (sqr_threshold > 0.0f) {
+          stable = std::min(stable, fabsf(distance - sqrtf(sqr_threshold)));
+        }
+      };
+      if (m_min_distance != 0) {
+        addThreshold(sqr_min_visible_distance);
+        addThreshold(sqr_min_visible_distance - sqr_prestream_distance);
+      }
+      if (m_max_distance != 0) {
+        addThreshold(sqr_max_visible_distance);
+        addThreshold(sqr_max_visible_distance + sqr_prestream_distance);
+      }
+      *stable_distance = stable / lod_bias;
+    }
     if ((sqr_distance >= sqr_min_visible_distance || m_min_distance == 0) && (sqr_distance < sqr_max_visible_distance || m_max_distance == 0)) {
       return LOD_VISIBILITY_VISIBLE;
     } else if ((sqr_distance >= sqr_min_visible_distance - sqr_prestream_distance || m_min_distance == 0) && (sqr_distance < sqr_max_visible_distance + sqr_prestream_distance || m_max_distance == 0)) {
@@ -141,16 +194,19 @@ float KRLODGroup::getMaxDistance()
 void KRLODGroup::setMinDistance(float min_distance)
 {
   m_min_distance = min_distance;
+  m_cachedLODVisibilityValid = false;
 }
 
 void KRLODGroup::setMaxDistance(float max_distance)
 {
   m_max_distance = max_distance;
+  m_cachedLODVisibilityValid = false;
 }
 
 void KRLODGroup::setUseWorldUnits(bool use_world_units)
 {
   m_use_world_units = use_world_units;
+  m_cachedLODVisibilityValid = false;
 }
 
 bool KRLODGroup::getUseWorldUnits() const
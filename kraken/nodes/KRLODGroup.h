@@ -41,8 +41,7 @@ public:
   KRLODGroup(KRScene& scene, std::string name);
   virtual ~KRLODGroup();
   virtual std::string getElementName();
-  virtual tinyxml2::XMLElement* saveXML(tinyxml2::XMLNode* parent);
-  virtual void loadXML(tinyxml2::XMLElement* e);
+  virtual void visitProperties(KRNodePropertyVisitor& visitor) override;
 
   float getMinDistance();
   float getMaxDistance();
@@ -54,9 +53,22 @@ public:
   void setUseWorldUnits(bool use_world_units);
   bool getUseWorldUnits() const;
 
-  LodVisibility calcLODVisibility(const KRViewport& viewport);
+  // stable_distance, if provided, receives the distance the camera can move
+  // before the result could change.
+  LodVisibility calcLODVisibility(const KRViewport& viewport, float* stable_distance = nullptr);
+  // Returns the last result of calcLODVisibility while it remains valid
+  LodVisibility getCachedLODVisibility(const KRViewport& viewport);
 
 private:
+  bool hasUniformScale() const;
+
+  LodVisibility m_cachedLODVisibility;
+  bool m_cachedLODVisibilityValid;
+  hydra::Vector3 m_cachedCameraPosition;
+  float m_cachedStableDistance;
+  float m_cachedLODBias;
+  uint32_t m_cachedTransformVersion;
+
   KRNODE_PROPERTY(float, m_min_distance, 0.f, "min_distance");
   KRNODE_PROPERTY(float, m_max_distance, 0.f, "max_distance");
   KRNODE_PROPERTY(hydra::AABB, m_reference, hydra::AABB({ 0.f, 0.f, 0.f, 0.f, 0.f, 0.f}), "reference"); // Point of reference, used for distance calculation.  Usually set to the bounding box center
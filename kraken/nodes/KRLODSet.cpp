@@ -42,75 +42,34 @@ void KRLODSet::InitNodeInfo(KrNodeInfo* nodeInfo)
 
 KRLODSet::KRLODSet(KRScene& scene, std::string name) : KRNode(scene, name)
 {
-
+  scene.notify_lodSetCreate(this);
 }
 
 KRLODSet::~KRLODSet()
-{}
-
-std::string KRLODSet::getElementName()
 {
-  return "lod_set";
+  getScene().notify_lodSetDestroy(this);
 }
 
-tinyxml2::XMLElement* KRLODSet::saveXML(tinyxml2::XMLNode* parent)
-{
-  tinyxml2::XMLElement* e = KRNode::saveXML(parent);
-
-  return e;
-}
-
-void KRLODSet::loadXML(tinyxml2::XMLElement* e)
+std::string KRLODSet::getElementName()
 {
-  KRNode::loadXML(e);
+  return "lod_set";
 }
 
-
 void KRLODSet::updateLODVisibility(const KRViewport& viewport)
 {
-  if (m_lod_visible >= LOD_VISIBILITY_PRESTREAM) {
-    /*
-    // FINDME, TODO, HACK - Disabled streamer delayed LOD load due to performance issues:
-    KRLODGroup *new_active_lod_group = NULL;
-    */
-
-    // Upgrade and downgrade LOD groups as needed
-    
-    for (KRNode* childNode = m_firstChildNode; childNode != nullptr; childNode = childNode->m_nextNode) {
-      KRLODGroup* lod_group = dynamic_cast<KRLODGroup*>(childNode);
-      assert(lod_group != NULL);
-      LodVisibility group_lod_visibility = std::min(lod_group->calcLODVisibility(viewport), m_lod_visible);
-      /*
-      // FINDME, TODO, HACK - Disabled streamer delayed LOD load due to performance issues:
-        if(group_lod_visibility == LOD_VISIBILITY_VISIBLE) {
-            new_active_lod_group = lod_group;
-        }
-        */
-      lod_group->setLODVisibility(group_lod_visibility);
-    }
-
-    /*
-    // FINDME, TODO, HACK - Disabled streamer delayed LOD load due to performance issues:
-    bool streamer_ready = false;
-    if(new_active_lod_group == NULL) {
-        streamer_ready = true;
-    } else if(new_active_lod_group->getStreamLevel(viewport) >= kraken_stream_level::STREAM_LEVEL_IN_LQ) {
-        streamer_ready = true;
-    }
-    */
-    bool streamer_ready = true;
-
-    if (streamer_ready) {
-      // Upgrade and downgrade LOD groups as needed
-      for (KRNode* childNode = m_firstChildNode; childNode != nullptr; childNode = childNode->m_nextNode) {
-        KRLODGroup* lod_group = dynamic_cast<KRLODGroup*>(childNode);
-        assert(lod_group != NULL);
-        LodVisibility group_lod_visibility = std::min(lod_group->calcLODVisibility(viewport), m_lod_visible);
-        lod_group->setLODVisibility(group_lod_visibility);
-      }
-    }
+  if (m_lod_visible < LOD_VISIBILITY_PRESTREAM) {
+    return;
+  }
 
-    KRNode::updateLODVisibility(viewport);
+  // FINDME, TODO, HACK - Streamer delayed LOD load is disabled due to performance issues,
+  // so LOD groups are upgraded and downgraded immediately.
+  // Nested LOD sets are updated separately by KRScene.
+  for (KRNode* childNode = m_firstChildNode; childNode != nullptr; childNode = childNode->m_nextNode) {
+    KRLODGroup* lod_group = dynamic_cast<KRLODGroup*>(childNode);
+    assert(lod_group != NULL);
+    getScene().notify_lodNodeVisit();
+    LodVisibility group_lod_visibility = std::min(lod_group->getCachedLODVisibility(viewport), m_lod_visible);
+    lod_group->setLODVisibility(group_lod_visibility);
   }
 }
 
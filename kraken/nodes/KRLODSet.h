@@ -43,10 +43,9 @@ public:
   KRLODSet(KRScene& scene, std::string name);
   virtual ~KRLODSet();
   virtual std::string getElementName();
-  virtual tinyxml2::XMLElement* saveXML(tinyxml2::XMLNode* parent);
-  virtual void loadXML(tinyxml2::XMLElement* e);
 
-  virtual void updateLODVisibility(const KRViewport& viewport);
+  // Called by KRScene for each LOD set once per frame
+  void updateLODVisibility(const KRViewport& viewport);
 
   virtual void setLODVisibility(LodVisibility lod_visibility);
 
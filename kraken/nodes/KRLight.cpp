@@ -86,38 +86,20 @@ KRLight::~KRLight()
   allocateShadowBuffers(0);
 }
 
-tinyxml2::XMLElement* KRLight::saveXML(tinyxml2::XMLNode* parent)
+void KRLight::visitProperties(KRNodePropertyVisitor& visitor)
 {
-  tinyxml2::XMLElement* e = KRNode::saveXML(parent);
-  m_intensity.save(e);
-  m_color.save(e);
-  m_decayStart.save(e);
-  m_flareSize.save(e);
-  m_flareOcclusionSize.save(e);
-  m_casts_shadow.save(e);
-  m_light_shafts.save(e);
-  m_dust_particle_density.save(e);
-  m_dust_particle_size.save(e);
-  m_dust_particle_intensity.save(e);
-  m_flareTexture.save(e);
-  return e;
-}
-
-void KRLight::loadXML(tinyxml2::XMLElement* e)
-{
-  KRNode::loadXML(e);
-
-  m_color.load(e);
-  m_intensity.load(e);
-  m_decayStart.load(e);
-  m_flareSize.load(e);
-  m_flareOcclusionSize.load(e);
-  m_casts_shadow.load(e);
-  m_light_shafts.load(e);
-  m_dust_particle_density.load(e);
-  m_dust_particle_size.load(e);
-  m_dust_particle_intensity.load(e);
-  m_flareTexture.load(e);
+  KRNode::visitProperties(visitor);
+  m_color.visit(visitor);
+  m_intensity.visit(visitor);
+  m_decayStart.visit(visitor);
+  m_flareSize.visit(visitor);
+  m_flareOcclusionSize.visit(visitor);
+  m_casts_shadow.visit(visitor);
+  m_light_shafts.visit(visitor);
+  m_dust_particle_density.visit(visitor);
+  m_dust_particle_size.visit(visitor);
+  m_dust_particle_intensity.visit(visitor);
+  m_flareTexture.visit(visitor);
 }
 
 void KRLight::setFlareTexture(std::string flare_texture)
@@ -201,18 +183,7 @@ void KRLight::render(RenderInfo& ri)
         std::vector<KRDirectionalLight*> this_directional_light;
         std::vector<KRSpotLight*> this_spot_light;
         std::vector<KRPointLight*> this_point_light;
-        KRDirectionalLight* directional_light = dynamic_cast<KRDirectionalLight*>(this);
-        KRSpotLight* spot_light = dynamic_cast<KRSpotLight*>(this);
-        KRPointLight* point_light = dynamic_cast<KRPointLight*>(this);
-        if (directional_light) {
-          this_directional_light.push_back(directional_light);
-        }
-        if (spot_light) {
-          this_spot_light.push_back(spot_light);
-        }
-        if (point_light) {
-          this_point_light.push_back(point_light);
-        }
+        appendToLightLists(this_directional_light, this_spot_light, this_point_light);
         
         PipelineInfo info{};
         std::string shader_name("dust_particle");
@@ -248,18 +219,7 @@ void KRLight::render(RenderInfo& ri)
     std::vector<KRDirectionalLight*> this_directional_light;
     std::vector<KRSpotLight*> this_spot_light;
     std::vector<KRPointLight*> this_point_light;
-    KRDirectionalLight* directional_light = dynamic_cast<KRDirectionalLight*>(this);
-    KRSpotLight* spot_light = dynamic_cast<KRSpotLight*>(this);
-    KRPointLight* point_light = dynamic_cast<KRPointLight*>(this);
-    if (directional_light) {
-      this_directional_light.push_back(directional_light);
-    }
-    if (spot_light) {
-      this_spot_light.push_back(spot_light);
-    }
-    if (point_light) {
-      this_point_light.push_back(point_light);
-    }
+    appendToLightLists(this_directional_light, this_spot_light, this_point_light);
 
     int slice_count = (int)(ri.camera->settings.volumetric_environment_quality * 495.0) + 5;
 
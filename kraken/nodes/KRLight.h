@@ -50,8 +50,7 @@ public:
 
   virtual ~KRLight();
   virtual std::string getElementName() override = 0;
-  virtual tinyxml2::XMLElement* saveXML(tinyxml2::XMLNode* parent) override;
-  virtual void loadXML(tinyxml2::XMLElement* e) override;
+  virtual void visitProperties(KRNodePropertyVisitor& visitor) override;
 
   void setIntensity(float intensity);
   float getIntensity() const;
@@ -68,6 +67,9 @@ public:
   virtual void getResourceBindings(std::list<KRResourceBinding*>& bindings) override;
   virtual void render(RenderInfo& ri) override;
 
+  // Appends this light to the list matching its type
+  virtual void appendToLightLists(std::vector<KRDirectionalLight*>& directional_lights, std::vector<KRSpotLight*>& spot_lights, std::vector<KRPointLight*>& point_lights) = 0;
+
   int getShadowBufferCount();
   int* getShadowTextures();
   KRViewport* getShadowViewports();
@@ -52,18 +52,6 @@ std::string KRLocator::getElementName()
   return "locator";
 }
 
-tinyxml2::XMLElement* KRLocator::saveXML(tinyxml2::XMLNode* parent)
-{
-  tinyxml2::XMLElement* e = KRNode::saveXML(parent);
-
-  return e;
-}
-
-void KRLocator::loadXML(tinyxml2::XMLElement* e)
-{
-  KRNode::loadXML(e);
-}
-
 unordered_map<std::string, int>& KRLocator::getUserIntAttributes()
 {
   return m_userIntAttributes;
@@ -42,8 +42,6 @@ public:
   KRLocator(KRScene& scene, std::string name);
   virtual ~KRLocator();
   virtual std::string getElementName();
-  virtual tinyxml2::XMLElement* saveXML(tinyxml2::XMLNode* parent);
-  virtual void loadXML(tinyxml2::XMLElement* e);
   unordered_map<std::string, int>& getUserIntAttributes();
   unordered_map<std::string, double>& getUserDoubleAttributes();
   unordered_map<std::string, bool>& getUserBoolAttributes();
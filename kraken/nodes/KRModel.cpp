@@ -57,6 +57,7 @@ void KRModel::InitNodeInfo(KrNodeInfo* nodeInfo)
 KRModel::KRModel(KRScene& scene, std::string name)
   : KRNode(scene, name)
 {
+  m_bonePaletteFrames.fill(-1);
   m_boundsCachedMat.c[0] = -1.0f;
   m_boundsCachedMat.c[1] = -1.0f;
   m_boundsCachedMat.c[2] = -1.0f;
@@ -120,41 +121,21 @@ std::string KRModel::getElementName()
   return "model";
 }
 
-void KRModel::loadXML(tinyxml2::XMLElement* e)
+void KRModel::visitProperties(KRNodePropertyVisitor& visitor)
 {
-  KRNode::loadXML(e);
-  m_faces_camera.load(e);
-  m_min_lod_coverage.load(e);
-  m_receivesShadow.load(e);
-  m_rim_power.load(e);
-  m_rim_color.load(e);
-
-  m_meshes[0].load(e);
-  for (int lod = 1; lod < KRModel::kMeshLODCount; lod++) {
-    char attribName[8];
-    snprintf(attribName, 8, "mesh%i", lod);
-    m_meshes[lod].load(e, attribName);
-  }
-
-  m_lightMap.load(e);
-}
-
-tinyxml2::XMLElement* KRModel::saveXML(tinyxml2::XMLNode* parent)
-{
-  tinyxml2::XMLElement* e = KRNode::saveXML(parent);
-  m_meshes[0].load(e);
+  KRNode::visitProperties(visitor);
+  m_meshes[0].visit(visitor);
   for (int lod = 1; lod < kMeshLODCount; lod++) {
     char attribName[8];
     snprintf(attribName, 8, "mesh%i", lod);
-    m_meshes[lod].load(e, attribName);
+    m_meshes[lod].visit(visitor, attribName);
   }
-  m_lightMap.save(e);
-  m_min_lod_coverage.save(e);
-  m_receivesShadow.save(e);
-  m_faces_camera.save(e);
-  m_rim_color.save(e);
-  m_rim_power.save(e);
-  return e;
+  m_faces_camera.visit(visitor);
+  m_min_lod_coverage.visit(visitor);
+  m_receivesShadow.visit(visitor);
+  m_rim_power.visit(visitor);
+  m_rim_color.visit(visitor);
+  m_lightMap.visit(visitor);
 }
 
 void KRModel::setRimColor(const Vector3& rim_color)
@@ -203,7 +184,7 @@ void KRModel::loadModel()
       int bone_count = model->getBoneCount();
       bool all_bones_found = true;
       for (int bone_index = 0; bone_index < bone_count; bone_index++) {
-        KRBone* matching_bone = dynamic_cast<KRBone*>(getScene().getRootNode()->find<KRNode>(model->getBoneName(bone_index)));
+        KRBone* matching_bone = getScene().find<KRBone>(model->getBoneName(bone_index));
         if (matching_bone) {
           model_bones.push_back(matching_bone);
         } else {
@@ -230,6 +211,10 @@ void KRModel::loadModel()
   }
   
   if (meshChanged) {
+    m_bonePaletteFrames.fill(-1);
+    for (std::unique_ptr<KRMesh::SkinnedVertices>& skinned : m_skinnedVertices) {
+      skinned.reset();
+    }
     getScene().notify_sceneGraphModify(this);
     invalidateBounds();
   }
@@ -257,24 +242,9 @@ void KRModel::render(KRNode::RenderInfo& ri)
 
     float lod_coverage = ri.viewport->coverage(getBounds()); // This also checks the view frustrum culling
     if (lod_coverage > m_min_lod_coverage) {
-      // ---===--- Select the best LOD model based on screen coverage ---===---
-      int bestLOD = -1;
-      KRMesh* pModel = nullptr;
-      for (int lod = 0; lod < kMeshLODCount; lod++) {
-        if (m_meshes[lod].val.isBound()) {
-          KRMesh* pLODModel = m_meshes[lod].val.get();
-
-          if ((float)pLODModel->getLODCoverage() / 100.0f > lod_coverage) {
-            if(bestLOD == -1 || pLODModel->getLODCoverage() < pModel->getLODCoverage()) {
-              pModel = pLODModel;
-              bestLOD = lod;
-              continue;
-            }
-          }
-        }
-      }
-
-      if (pModel) {
+      int bestLOD = selectLOD(lod_coverage);
+      if (bestLOD != -1) {
+        KRMesh* pModel = m_meshes[bestLOD].val.get();
         Matrix4 matModel = getModelMatrix();
         if (m_faces_camera) {
           Vector3 model_center = Matrix4::Dot(matModel, Vector3::Zero());
@@ -282,10 +252,89 @@ void KRModel::render(KRNode::RenderInfo& ri)
           matModel = Quaternion::Create(Vector3::Forward(), Vector3::Normalize(camera_pos - model_center)).rotationMatrix() * matModel;
         }
 
-        pModel->render(ri, getName(), matModel, m_lightMap.val.get(), m_bones[bestLOD], lod_coverage);
+        KRMesh::SkinnedVertices* skinned = m_skinnedVertices[bestLOD].get();
+        if (skinned && skinned->frame == getContext().getCurrentFrame() && skinned->deviceHandle == ri.surface->m_deviceHandle) {
+          // Already skinned by the skinning pre-pass; draw as static geometry
+          static const std::vector<Matrix4> noBones;
+          pModel->render(ri, getName(), matModel, m_lightMap.val.get(), noBones, lod_coverage, skinned);
+        } else {
+          pModel->render(ri, getName(), matModel, m_lightMap.val.get(), getBonePalette(bestLOD), lod_coverage);
+        }
+      }
+    }
+  }
+}
+
+int KRModel::selectLOD(float lod_coverage)
+{
+  // ---===--- Select the best LOD model based on screen coverage ---===---
+  int bestLOD = -1;
+  KRMesh* pModel = nullptr;
+  for (int lod = 0; lod < kMeshLODCount; lod++) {
+    if (m_meshes[lod].val.isBound()) {
+      KRMesh* pLODModel = m_meshes[lod].val.get();
+
+      if ((float)pLODModel->getLODCoverage() / 100.0f > lod_coverage) {
+        if (bestLOD == -1 || pLODModel->getLODCoverage() < pModel->getLODCoverage()) {
+          pModel = pLODModel;
+          bestLOD = lod;
+          continue;
+        }
       }
     }
   }
+  return bestLOD;
+}
+
+bool KRModel::skin(KrDeviceHandle deviceHandle, const KRViewport& viewport)
+{
+  loadModel();
+
+  float lod_coverage = viewport.coverage(getBounds());
+  if (lod_coverage <= m_min_lod_coverage) {
+    return false;
+  }
+  int lod = selectLOD(lod_coverage);
+  if (lod == -1 || m_bones[lod].empty()) {
+    return false;
+  }
+  KRMesh* mesh = m_meshes[lod].val.get();
+  if (!mesh->canSkin()) {
+    return false;
+  }
+
+  std::unique_ptr<KRMesh::SkinnedVertices>& skinned = m_skinnedVertices[lod];
+  if (skinned && skinned->deviceHandle != deviceHandle) {
+    skinned.reset();
+  }
+  if (!skinned) {
+    skinned = std::make_unique<KRMesh::SkinnedVertices>();
+    if (!mesh->initSkinnedVertices(deviceHandle, *skinned)) {
+      skinned.reset();
+      return false;
+    }
+  }
+
+  if (!mesh->isReady() || !mesh->skin(getBonePalette(lod), lod_coverage, *skinned)) {
+    return false;
+  }
+  skinned->frame = getContext().getCurrentFrame();
+  return true;
+}
+
+const std::vector<Matrix4>& KRModel::getBonePalette(int lod)
+{
+  long frame = getContext().getCurrentFrame();
+  if (m_bonePaletteFrames[lod] != frame) {
+    const std::vector<KRBone*>& bones = m_bones[lod];
+    std::vector<Matrix4>& palette = m_bonePalettes[lod];
+    palette.resize(bones.size());
+    for (size_t i = 0; i < bones.size(); i++) {
+      palette[i] = bones[i]->getInverseBindPoseMatrix() * bones[i]->getActivePoseMatrix();
+    }
+    m_bonePaletteFrames[lod] = frame;
+  }
+  return m_bonePalettes[lod];
 }
 
 void KRModel::getResourceBindings(std::list<KRResourceBinding*>& bindings)
@@ -59,8 +59,7 @@ public:
   KrResult update(const KrNodeInfo* nodeInfo) override;
 
   virtual std::string getElementName() override;
-  virtual tinyxml2::XMLElement* saveXML(tinyxml2::XMLNode* parent) override;
-  virtual void loadXML(tinyxml2::XMLElement* e) override;
+  virtual void visitProperties(KRNodePropertyVisitor& visitor) override;
 
   virtual void render(KRNode::RenderInfo& ri) override;
   virtual void getResourceBindings(std::list<KRResourceBinding*>& bindings) override;
@@ -78,6 +77,9 @@ public:
 
   virtual kraken_stream_level getStreamLevel(const KRViewport& viewport) override;
 
+  // Records the skinning pre-pass dispatches for the LOD visible in viewport
+  bool skin(KrDeviceHandle deviceHandle, const KRViewport& viewport);
+
 private:
 
   KRNODE_PROPERTY_ARRAY(KRMeshBinding, m_meshes, "", "mesh", kMeshLODCount);
@@ -89,10 +91,17 @@ private:
   KRNODE_PROPERTY(hydra::Vector3, m_rim_color, hydra::Vector3({ 0.f, 0.f, 0.f }), "rim_color");
 
   std::array<std::vector<KRBone*>, kMeshLODCount> m_bones; // Connects model to set of bones
+  // Skinning matrices for m_bones, shared by all of the passes that render a frame
+  std::array<std::vector<hydra::Matrix4>, kMeshLODCount> m_bonePalettes;
+  std::array<long, kMeshLODCount> m_bonePaletteFrames;
+  // Vertices skinned by the skinning pre-pass, drawn in place of the mesh's own vertices
+  std::array<std::unique_ptr<KRMesh::SkinnedVertices>, kMeshLODCount> m_skinnedVertices;
   hydra::Matrix4 m_boundsCachedMat;
   hydra::AABB m_boundsCached;
 
   void loadModel();
+  int selectLOD(float lod_coverage);
+  const std::vector<hydra::Matrix4>& getBonePalette(int lod);
   
 
 private:
@@ -50,6 +50,132 @@ using namespace hydra;
 #include "KRReverbZone.h"
 #include "KRSprite.h"
 
+namespace {
+
+class KRNodeXMLReader : public KRNodePropertyVisitor
+{
+public:
+  KRNodeXMLReader(tinyxml2::XMLElement* e)
+    : m_element(e)
+  {
+  }
+
+  void visit(const char* name, int& val, int defaultVal) override
+  {
+    if (m_element->QueryIntAttribute(name, &val) != tinyxml2::XML_SUCCESS) {
+      val = defaultVal;
+    }
+  }
+
+  void visit(const char* name, unsigned int& val, unsigned int defaultVal) override
+  {
+    if (m_element->QueryUnsignedAttribute(name, &val) != tinyxml2::XML_SUCCESS) {
+      val = defaultVal;
+    }
+  }
+
+  void visit(const char* name, float& val, float defaultVal) override
+  {
+    if (m_element->QueryFloatAttribute(name, &val) != tinyxml2::XML_SUCCESS) {
+      val = defaultVal;
+    }
+  }
+
+  void visit(const char* name, bool& val, bool defaultVal) override
+  {
+    if (m_element->QueryBoolAttribute(name, &val) != tinyxml2::XML_SUCCESS) {
+      val = defaultVal;
+    }
+  }
+
+  void visit(const char* name, Vector3& val, const Vector3& defaultVal) override
+  {
+    val = kraken::getXMLAttribute(name, m_element, defaultVal);
+  }
+
+  void visit(const char* name, AABB& val, const AABB& defaultVal) override
+  {
+    val = kraken::getXMLAttribute(name, m_element, defaultVal);
+  }
+
+  void visit(const char* name, std::string& val, const std::string& defaultVal) override
+  {
+    const char* szValue = m_element->Attribute(name);
+    if (szValue) {
+      val = szValue;
+    } else {
+      val = defaultVal;
+    }
+  }
+
+  void visit(const char* name, KRResourceBinding& val) override
+  {
+    const char* szValue = m_element->Attribute(name);
+    if (szValue) {
+      val.set(szValue);
+    } else {
+      val.clear();
+    }
+  }
+
+private:
+  tinyxml2::XMLElement* m_element;
+};
+
+class KRNodeXMLWriter : public KRNodePropertyVisitor
+{
+public:
+  KRNodeXMLWriter(tinyxml2::XMLElement* e)
+    : m_element(e)
+  {
+  }
+
+  void visit(const char* name, int& val, int defaultVal) override
+  {
+    m_element->SetAttribute(name, val);
+  }
+
+  void visit(const char* name, unsigned int& val, unsigned int defaultVal) override
+  {
+    m_element->SetAttribute(name, val);
+  }
+
+  void visit(const char* name, float& val, float defaultVal) override
+  {
+    m_element->SetAttribute(name, val);
+  }
+
+  void visit(const char* name, bool& val, bool defaultVal) override
+  {
+    m_element->SetAttribute(name, val ? "true" : "false");
+  }
+
+  void visit(const char* name, Vector3& val, const Vector3& defaultVal) override
+  {
+    kraken::setXMLAttribute(name, m_element, val, defaultVal);
+  }
+
+  void visit(const char* name, AABB& val, const AABB& defaultVal) override
+  {
+    kraken::setXMLAttribute(name, m_element, val, defaultVal);
+  }
+
+  void visit(const char* name, std::string& val, const std::string& defaultVal) override
+  {
+    m_element->SetAttribute(name, val.c_str());
+  }
+
+  void visit(const char* name, KRResourceBinding& val) override
+  {
+    m_element->SetAttribute(name, val.getName().c_str());
+  }
+
+private:
+  tinyxml2::XMLElement* m_element;
+};
+
+} // anonymous namespace
+
 /* static */
 void KRNode::InitNodeInfo(KrNodeInfo* nodeInfo)
 {
@@ -67,7 +193,9 @@ void KRNode::InitNodeInfo(KrNodeInfo* nodeInfo)
 
 KrResult KRNode::update(const KrNodeInfo* nodeInfo)
 {
-  // TODO - Implement name changes
+  if (nodeInfo->pName && m_name.compare(nodeInfo->pName) != 0) {
+    setName(nodeInfo->pName);
+  }
 
   if (nodeInfo->translate != m_localTranslation ||
       nodeInfo->scale != m_localScale ||
@@ -121,22 +249,29 @@ KRNode::KRNode(KRScene& scene, std::string name) : KRContextObject(scene.getCont
   m_lastChildNode = nullptr;
 
   m_pScene = &scene;
-  m_modelMatrixValid = false;
+  m_transformIndex = scene.getTransformHierarchy().add(this);
   m_inverseModelMatrixValid = false;
   m_bindPoseMatrixValid = false;
   m_activePoseMatrixValid = false;
   m_inverseBindPoseMatrixValid = false;
-  m_modelMatrix = Matrix4();
+  m_inverseModelMatrixVersion = 0;
+  m_activePoseMatrixVersion = 0;
   m_bindPoseMatrix = Matrix4();
   m_activePoseMatrix = Matrix4();
   m_lod_visible = LOD_VISIBILITY_HIDDEN;
   m_scale_compensation = false;
+  m_registryType = KRNodeRegistry::NodeType::unknown;
+  for (int i = 0; i < KRNodeRegistry::kKindCount; i++) {
+    m_registryIndex[i] = KRNodeRegistry::kNotRegistered;
+  }
   m_boundsValid = false;
 
   m_lastRenderFrame = -1000;
   for (int i = 0; i < KRENGINE_NODE_ATTRIBUTE_COUNT; i++) {
     m_animation_mask[i] = false;
   }
+
+  scene.notify_nodeCreate(this);
 }
 
 void KRNode::makeOrphan()
@@ -161,6 +296,16 @@ void KRNode::makeOrphan()
   m_parentNode = nullptr;
   m_nextNode = nullptr;
   m_previousNode = nullptr;
+  parentChanged();
+}
+
+void KRNode::parentChanged()
+{
+  KRTransformHierarchy& transforms = getScene().getTransformHierarchy();
+  transforms.setParent(m_transformIndex, m_parentNode ? m_parentNode->m_transformIndex : KRTransformHierarchy::kNoParent);
+  invalidateModelMatrix();
+  invalidateBindPoseMatrix();
+  getScene().notify_sceneGraphReparent(this);
 }
 
 KRNode::~KRNode()
@@ -179,6 +324,8 @@ KRNode::~KRNode()
   m_behaviors.clear();
 
   getScene().notify_sceneGraphDelete(this);
+  getScene().notify_nodeDestroy(this);
+  getScene().getTransformHierarchy().remove(m_transformIndex);
 }
 
 void KRNode::setScaleCompensation(bool scale_compensation)
@@ -221,6 +368,7 @@ void KRNode::appendChild(KRNode* child)
     child->m_previousNode = m_lastChildNode;
     m_lastChildNode = child;
   }
+  child->parentChanged();
   child->setLODVisibility(m_lod_visible); // Child node inherits LOD visibility status from parent
 }
 
@@ -236,6 +384,7 @@ void KRNode::prependChild(KRNode* child)
     child->m_nextNode = m_firstChildNode;
     m_firstChildNode = child;
   }
+  child->parentChanged();
   child->setLODVisibility(m_lod_visible); // Child node inherits LOD visibility status from parent
 }
 void KRNode::insertBefore(KRNode* child)
@@ -247,6 +396,7 @@ void KRNode::insertBefore(KRNode* child)
   child->m_previousNode = m_previousNode;
   m_previousNode = child;
 
+  child->parentChanged();
   child->setLODVisibility(m_lod_visible); // Child node inherits LOD visibility status from parent
 }
 void KRNode::insertAfter(KRNode* child)
@@ -259,6 +409,7 @@ void KRNode::insertAfter(KRNode* child)
   child->m_nextNode = m_nextNode;
   m_nextNode = child;
 
+  child->parentChanged();
   child->setLODVisibility(m_lod_visible); // Child node inherits LOD visibility status from parent
 }
 
@@ -268,15 +419,8 @@ tinyxml2::XMLElement* KRNode::saveXML(tinyxml2::XMLNode* parent)
   tinyxml2::XMLElement* e = doc->NewElement(getElementName().c_str());
   tinyxml2::XMLNode* n = parent->InsertEndChild(e);
   e->SetAttribute("name", m_name.c_str());
-  m_localTranslation.save(e);
-  m_localScale.save(e);
-  m_localRotation.save(e);
-  m_rotationOffset.save(e);
-  m_scalingOffset.save(e);
-  m_rotationPivot.save(e);
-  m_scalingPivot.save(e);
-  m_preRotation.save(e);
-  m_postRotation.save(e);
+  KRNodeXMLWriter writer(e);
+  visitProperties(writer);
 
   for (KRNode* child = m_firstChildNode; child != nullptr; child = child->m_nextNode) {
     child->saveXML(n);
@@ -343,33 +487,10 @@ KrResult KRNode::createNode(const KrCreateNodeInfo* pCreateNodeInfo, KRScene* sc
 
 void KRNode::loadXML(tinyxml2::XMLElement* e)
 {
-  m_name = e->Attribute("name");
-  m_localTranslation.load(e);
-  m_localScale = kraken::getXMLAttribute("scale", e, Vector3::One());
-  m_localRotation.load(e);
-  m_preRotation.load(e);
-  m_postRotation.load(e);
-  m_rotationOffset.load(e);
-  m_scalingOffset.load(e);
-  m_rotationPivot.load(e);
-  m_scalingPivot.load(e);
-
-  m_initialLocalTranslation = m_localTranslation;
-  m_initialLocalScale = m_localScale;
-  m_initialLocalRotation = m_localRotation;
-
-  m_initialRotationOffset = m_rotationOffset;
-  m_initialScalingOffset = m_scalingOffset;
-  m_initialRotationPivot = m_rotationPivot;
-  m_initialScalingPivot = m_scalingPivot;
-  m_initialPreRotation = m_preRotation;
-  m_initialPostRotation = m_postRotation;
-
-  m_bindPoseMatrixValid = false;
-  m_activePoseMatrixValid = false;
-  m_inverseBindPoseMatrixValid = false;
-  m_modelMatrixValid = false;
-  m_inverseModelMatrixValid = false;
+  setName(e->Attribute("name"));
+  KRNodeXMLReader reader(e);
+  visitProperties(reader);
+  propertiesLoaded();
 
   for (tinyxml2::XMLElement* child_element = e->FirstChildElement(); child_element != NULL; child_element = child_element->NextSiblingElement()) {
     const char* szElementName = child_element->Name();
@@ -389,6 +510,39 @@ void KRNode::loadXML(tinyxml2::XMLElement* e)
   }
 }
 
+void KRNode::visitProperties(KRNodePropertyVisitor& visitor)
+{
+  m_localTranslation.visit(visitor);
+  m_localScale.visit(visitor);
+  m_localRotation.visit(visitor);
+  m_rotationOffset.visit(visitor);
+  m_scalingOffset.visit(visitor);
+  m_rotationPivot.visit(visitor);
+  m_scalingPivot.visit(visitor);
+  m_preRotation.visit(visitor);
+  m_postRotation.visit(visitor);
+}
+
+void KRNode::propertiesLoaded()
+{
+  m_initialLocalTranslation = m_localTranslation;
+  m_initialLocalScale = m_localScale;
+  m_initialLocalRotation = m_localRotation;
+
+  m_initialRotationOffset = m_rotationOffset;
+  m_initialScalingOffset = m_scalingOffset;
+  m_initialRotationPivot = m_rotationPivot;
+  m_initialScalingPivot = m_scalingPivot;
+  m_initialPreRotation = m_preRotation;
+  m_initialPostRotation = m_postRotation;
+
+  m_bindPoseMatrixValid = false;
+  m_activePoseMatrixValid = false;
+  m_inverseBindPoseMatrixValid = false;
+  m_inverseModelMatrixValid = false;
+  getScene().getTransformHierarchy().invalidate(m_transformIndex);
+}
+
 void KRNode::setLocalTranslation(const Vector3& v, bool set_original)
 {
   m_localTranslation = v;
@@ -602,9 +756,21 @@ std::string KRNode::getElementName()
 
 KRNode* KRNode::LoadXML(KRScene& scene, tinyxml2::XMLElement* e)
 {
-  KRNode* new_node = NULL;
-  const char* szElementName = e->Name();
   const char* szName = e->Attribute("name");
+  if (szName == NULL) {
+    return NULL;
+  }
+  KRNode* new_node = CreateFromElementName(scene, e->Name(), szName);
+  if (new_node) {
+    new_node->loadXML(e);
+  }
+
+  return new_node;
+}
+
+KRNode* KRNode::CreateFromElementName(KRScene& scene, const char* szElementName, const char* szName)
+{
+  KRNode* new_node = NULL;
   if (strcmp(szElementName, "node") == 0) {
     new_node = new KRNode(scene, szName);
   } else if (strcmp(szElementName, "lod_set") == 0) {
@@ -624,7 +790,7 @@ KRNode* KRNode::LoadXML(KRScene& scene, tinyxml2::XMLElement* e)
   } else if (strcmp(szElementName, "model") == 0) {
     new_node = new KRModel(scene, szName);
   } else if (strcmp(szElementName, "collider") == 0) {
-    new_node = new KRCollider(scene, szName, e->Attribute("mesh"), 65535, 1.0f);
+    new_node = new KRCollider(scene, szName);
   } else if (strcmp(szElementName, "bone") == 0) {
     new_node = new KRBone(scene, szName);
   } else if (strcmp(szElementName, "locator") == 0) {
@@ -639,10 +805,6 @@ KRNode* KRNode::LoadXML(KRScene& scene, tinyxml2::XMLElement* e)
     new_node = new KRCamera(scene, szName);
   }
 
-  if (new_node) {
-    new_node->loadXML(e);
-  }
-
   return new_node;
 }
 
@@ -693,6 +855,30 @@ const std::string& KRNode::getName() const
   return m_name;
 }
 
+void KRNode::setName(const std::string& name)
+{
+  if (m_name != name) {
+    std::string previousName = m_name;
+    m_name = name;
+    getScene().notify_nodeRename(this, previousName);
+  }
+}
+
+void KRNode::findByName(const std::string& name, std::vector<KRNode*>& matches)
+{
+  std::vector<KRNode*> namedNodes;
+  getScene().findAll<KRNode>(name, namedNodes);
+  for (KRNode* node : namedNodes) {
+    // Only return nodes within this node's subtree
+    for (KRNode* ancestor = node; ancestor != nullptr; ancestor = ancestor->m_parentNode) {
+      if (ancestor == this) {
+        matches.push_back(node);
+        break;
+      }
+    }
+  }
+}
+
 KRScene& KRNode::getScene()
 {
   return *m_pScene;
@@ -721,14 +907,22 @@ AABB KRNode::getBounds()
 
 void KRNode::invalidateModelMatrix()
 {
-  m_modelMatrixValid = false;
+  // Descendants are recalculated by KRTransformHierarchy, which calls
+  // transformUpdated() for each node it updates.
   m_activePoseMatrixValid = false;
   m_inverseModelMatrixValid = false;
-  for (KRNode* child = m_firstChildNode; child != nullptr; child = child->m_nextNode) {
-    child->invalidateModelMatrix();
-  }
-
+  getScene().getTransformHierarchy().invalidate(m_transformIndex);
   invalidateBounds();
+}
+
+void KRNode::transformUpdated(bool parentUpdated)
+{
+  if (parentUpdated) {
+    // The parent will invalidate the bounds of its own ancestors
+    m_boundsValid = false;
+  } else {
+    invalidateBounds();
+  }
   getScene().notify_sceneGraphModify(this);
 }
 
@@ -741,65 +935,49 @@ void KRNode::invalidateBindPoseMatrix()
   }
 }
 
-const Matrix4& KRNode::getModelMatrix() const
+bool KRNode::isScaleCompensated() const
 {
+  return getScaleCompensation() && dynamic_cast<KRBone*>(m_parentNode) != nullptr;
+}
 
-  if (!m_modelMatrixValid) {
-    m_modelMatrix = Matrix4();
-
-    bool parent_is_bone = false;
-    if (dynamic_cast<KRBone*>(m_parentNode)) {
-      parent_is_bone = true;
-    }
-
-    if (getScaleCompensation() && parent_is_bone) {
-
-
-      // WorldTransform = ParentWorldTransform * T * Roff * Rp * Rpre * R * Rpost * Rp-1 * Soff * Sp * S * Sp-1
-      m_modelMatrix = Matrix4::Translation(-m_scalingPivot.val)
-        * Matrix4::Scaling(m_localScale)
-        * Matrix4::Translation(m_scalingPivot)
-        * Matrix4::Translation(m_scalingOffset)
-        * Matrix4::Translation(-m_rotationPivot.val)
-        //* (Quaternion(m_postRotation) * Quaternion(m_localRotation) * Quaternion(m_preRotation)).rotationMatrix()
-        * Matrix4::Rotation(m_postRotation)
-        * Matrix4::Rotation(m_localRotation)
-        * Matrix4::Rotation(m_preRotation)
-        * Matrix4::Translation(m_rotationPivot)
-        * Matrix4::Translation(m_rotationOffset);
-
-      if (m_parentNode) {
-
-        m_modelMatrix.rotate(m_parentNode->getWorldRotation());
-        m_modelMatrix.translate(Matrix4::Dot(m_parentNode->getModelMatrix(), m_localTranslation));
-      } else {
-        m_modelMatrix.translate(m_localTranslation);
-      }
-    } else {
+Matrix4 KRNode::calculateLocalMatrix(bool scale_compensated) const
+{
+  // WorldTransform = ParentWorldTransform * T * Roff * Rp * Rpre * R * Rpost * Rp-1 * Soff * Sp * S * Sp-1
+  Matrix4 localMatrix = Matrix4::Translation(-m_scalingPivot.val)
+    * Matrix4::Scaling(m_localScale)
+    * Matrix4::Translation(m_scalingPivot)
+    * Matrix4::Translation(m_scalingOffset)
+    * Matrix4::Translation(-m_rotationPivot.val)
+    //* (Quaternion(m_postRotation) * Quaternion(m_localRotation) * Quaternion(m_preRotation)).rotationMatrix()
+    * Matrix4::Rotation(m_postRotation)
+    * Matrix4::Rotation(m_localRotation)
+    * Matrix4::Rotation(m_preRotation)
+    * Matrix4::Translation(m_rotationPivot)
+    * Matrix4::Translation(m_rotationOffset);
 
-      // WorldTransform = ParentWorldTransform * T * Roff * Rp * Rpre * R * Rpost * Rp-1 * Soff * Sp * S * Sp-1
-      m_modelMatrix = Matrix4::Translation(-m_scalingPivot.val)
-        * Matrix4::Scaling(m_localScale)
-        * Matrix4::Translation(m_scalingPivot)
-        * Matrix4::Translation(m_scalingOffset)
-        * Matrix4::Translation(-m_rotationPivot.val)
-        //* (Quaternion(m_postRotation) * Quaternion(m_localRotation) * Quaternion(m_preRotation)).rotationMatrix()
-        * Matrix4::Rotation(m_postRotation)
-        * Matrix4::Rotation(m_localRotation)
-        * Matrix4::Rotation(m_preRotation)
-        * Matrix4::Translation(m_rotationPivot)
-        * Matrix4::Translation(m_rotationOffset)
-        * Matrix4::Translation(m_localTranslation);
+  if (!scale_compensated) {
+    localMatrix = localMatrix * Matrix4::Translation(m_localTranslation);
+  }
+  return localMatrix;
+}
 
-      if (m_parentNode) {
-        m_modelMatrix *= m_parentNode->getModelMatrix();
-      }
-    }
+Matrix4 KRNode::calculateScaleCompensatedModelMatrix(const Matrix4& localMatrix, const Matrix4& parentModelMatrix) const
+{
+  // The parent's scale is not inherited
+  Matrix4 modelMatrix = localMatrix;
+  modelMatrix.rotate(m_parentNode->getWorldRotation());
+  modelMatrix.translate(Matrix4::Dot(parentModelMatrix, m_localTranslation));
+  return modelMatrix;
+}
 
-    m_modelMatrixValid = true;
+const Matrix4& KRNode::getModelMatrix() const
+{
+  return m_pScene->getTransformHierarchy().getModelMatrix(m_transformIndex);
+}
 
-  }
-  return m_modelMatrix;
+uint32_t KRNode::getTransformVersion() const
+{
+  return m_pScene->getTransformHierarchy().getVersion(m_transformIndex);
 }
 
 const Matrix4& KRNode::getBindPoseMatrix() const
@@ -863,8 +1041,9 @@ const Matrix4& KRNode::getBindPoseMatrix() const
 
 const Matrix4& KRNode::getActivePoseMatrix() const
 {
-
-  if (!m_activePoseMatrixValid) {
+  // The active pose depends on the same transforms as the model matrix
+  uint32_t version = m_pScene->getTransformHierarchy().getVersion(m_transformIndex);
+  if (!m_activePoseMatrixValid || m_activePoseMatrixVersion != version) {
     m_activePoseMatrix = Matrix4();
 
     bool parent_is_bone = false;
@@ -913,6 +1092,7 @@ const Matrix4& KRNode::getActivePoseMatrix() const
     }
 
     m_activePoseMatrixValid = true;
+    m_activePoseMatrixVersion = version;
 
   }
   return m_activePoseMatrix;
@@ -948,8 +1128,11 @@ const Quaternion KRNode::getActivePoseWorldRotation() const
 
 const Matrix4& KRNode::getInverseModelMatrix() const
 {
-  if (!m_inverseModelMatrixValid) {
+  uint32_t version = m_pScene->getTransformHierarchy().getVersion(m_transformIndex);
+  if (!m_inverseModelMatrixValid || m_inverseModelMatrixVersion != version) {
     m_inverseModelMatrix = Matrix4::Invert(getModelMatrix());
+    m_inverseModelMatrixValid = true;
+    m_inverseModelMatrixVersion = version;
   }
   return m_inverseModelMatrix;
 }
@@ -982,100 +1165,65 @@ bool KRNode::hasPhysics()
 
 void KRNode::SetAttribute(node_attribute_type attrib, float v)
 {
-  if (m_animation_mask[attrib]) return;
+  SetAttributes(&attrib, &v, 1);
+}
 
+void KRNode::SetAttributes(const node_attribute_type* attribs, const float* values, size_t count)
+{
   const float DEGREES_TO_RAD = (float)M_PI / 180.0f;
 
-  //printf("%s - ", m_name.c_str());
-  switch (attrib) {
-  case KRENGINE_NODE_ATTRIBUTE_TRANSLATE_X:
-    setLocalTranslation(Vector3::Create(v, m_localTranslation.val.y, m_localTranslation.val.z));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_TRANSLATE_Y:
-    setLocalTranslation(Vector3::Create(m_localTranslation.val.x, v, m_localTranslation.val.z));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_TRANSLATE_Z:
-    setLocalTranslation(Vector3::Create(m_localTranslation.val.x, m_localTranslation.val.y, v));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_SCALE_X:
-    setLocalScale(Vector3::Create(v, m_localScale.val.y, m_localScale.val.z));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_SCALE_Y:
-    setLocalScale(Vector3::Create(m_localScale.val.x, v, m_localScale.val.z));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_SCALE_Z:
-    setLocalScale(Vector3::Create(m_localScale.val.x, m_localScale.val.y, v));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_ROTATE_X:
-    setLocalRotation(Vector3::Create(v * DEGREES_TO_RAD, m_localRotation.val.y, m_localRotation.val.z));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_ROTATE_Y:
-    setLocalRotation(Vector3::Create(m_localRotation.val.x, v * DEGREES_TO_RAD, m_localRotation.val.z));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_ROTATE_Z:
-    setLocalRotation(Vector3::Create(m_localRotation.val.x, m_localRotation.val.y, v * DEGREES_TO_RAD));
-    break;
+  // Attributes are enumerated as x, y, z triples in this order
+  Vector3* properties[] = {
+    &m_localTranslation.val,
+    &m_localScale.val,
+    &m_localRotation.val,
+    &m_preRotation.val,
+    &m_postRotation.val,
+    &m_rotationPivot.val,
+    &m_scalingPivot.val,
+    &m_rotationOffset.val,
+    &m_scalingOffset.val
+  };
+  const int kPropertyCount = sizeof(properties) / sizeof(properties[0]);
+  const int kFirstRotationProperty = 2;
+  const int kLastRotationProperty = 4;
+
+  float components[kPropertyCount][3];
+  for (int i = 0; i < kPropertyCount; i++) {
+    components[i][0] = properties[i]->x;
+    components[i][1] = properties[i]->y;
+    components[i][2] = properties[i]->z;
+  }
 
+  uint32_t changedProperties = 0;
+  for (size_t i = 0; i < count; i++) {
+    node_attribute_type attrib = attribs[i];
+    if (attrib == KRENGINE_NODE_ATTRIBUTE_NONE || attrib >= KRENGINE_NODE_ATTRIBUTE_COUNT || m_animation_mask[attrib]) {
+      continue;
+    }
+    int property = (attrib - KRENGINE_NODE_ATTRIBUTE_TRANSLATE_X) / 3;
+    int component = (attrib - KRENGINE_NODE_ATTRIBUTE_TRANSLATE_X) % 3;
+    float v = values[i];
+    if (property >= kFirstRotationProperty && property <= kLastRotationProperty) {
+      v *= DEGREES_TO_RAD;
+    }
+    if (components[property][component] != v) {
+      components[property][component] = v;
+      changedProperties |= 1 << property;
+    }
+  }
 
-  case KRENGINE_NODE_ATTRIBUTE_PRE_ROTATION_X:
-    setPreRotation(Vector3::Create(v * DEGREES_TO_RAD, m_preRotation.val.y, m_preRotation.val.z));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_PRE_ROTATION_Y:
-    setPreRotation(Vector3::Create(m_preRotation.val.x, v * DEGREES_TO_RAD, m_preRotation.val.z));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_PRE_ROTATION_Z:
-    setPreRotation(Vector3::Create(m_preRotation.val.x, m_preRotation.val.y, v * DEGREES_TO_RAD));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_POST_ROTATION_X:
-    setPostRotation(Vector3::Create(v * DEGREES_TO_RAD, m_postRotation.val.y, m_postRotation.val.z));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_POST_ROTATION_Y:
-    setPostRotation(Vector3::Create(m_postRotation.val.x, v * DEGREES_TO_RAD, m_postRotation.val.z));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_POST_ROTATION_Z:
-    setPostRotation(Vector3::Create(m_postRotation.val.x, m_postRotation.val.y, v * DEGREES_TO_RAD));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_ROTATION_PIVOT_X:
-    setRotationPivot(Vector3::Create(v, m_rotationPivot.val.y, m_rotationPivot.val.z));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_ROTATION_PIVOT_Y:
-    setRotationPivot(Vector3::Create(m_rotationPivot.val.x, v, m_rotationPivot.val.z));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_ROTATION_PIVOT_Z:
-    setRotationPivot(Vector3::Create(m_rotationPivot.val.x, m_rotationPivot.val.y, v));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_SCALE_PIVOT_X:
-    setScalingPivot(Vector3::Create(v, m_scalingPivot.val.y, m_scalingPivot.val.z));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_SCALE_PIVOT_Y:
-    setScalingPivot(Vector3::Create(m_scalingPivot.val.x, v, m_scalingPivot.val.z));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_SCALE_PIVOT_Z:
-    setScalingPivot(Vector3::Create(m_scalingPivot.val.x, m_scalingPivot.val.y, v));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_ROTATE_OFFSET_X:
-    setRotationOffset(Vector3::Create(v, m_rotationOffset.val.y, m_rotationOffset.val.z));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_ROTATE_OFFSET_Y:
-    setRotationOffset(Vector3::Create(m_rotationOffset.val.x, v, m_rotationOffset.val.z));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_ROTATE_OFFSET_Z:
-    setRotationOffset(Vector3::Create(m_rotationOffset.val.x, m_rotationOffset.val.y, v));
-    break;
-  case KRENGINE_NODE_SCALE_OFFSET_X:
-    setScalingOffset(Vector3::Create(v, m_scalingOffset.val.y, m_scalingOffset.val.z));
-    break;
-  case KRENGINE_NODE_SCALE_OFFSET_Y:
-    setScalingOffset(Vector3::Create(m_scalingOffset.val.x, v, m_scalingOffset.val.z));
-    break;
-  case KRENGINE_NODE_SCALE_OFFSET_Z:
-    setScalingOffset(Vector3::Create(m_scalingOffset.val.x, m_scalingOffset.val.y, v));
-    break;
-  case KRENGINE_NODE_ATTRIBUTE_NONE:
-  case KRENGINE_NODE_ATTRIBUTE_COUNT:
-    // Suppress warnings
-    break;
+  if (changedProperties == 0) {
+    // Unchanged channels do not invalidate the transform
+    return;
+  }
+
+  for (int i = 0; i < kPropertyCount; i++) {
+    if (changedProperties & (1 << i)) {
+      *properties[i] = Vector3::Create(components[i][0], components[i][1], components[i][2]);
+    }
   }
+  invalidateModelMatrix();
 }
 
 void KRNode::setAnimationEnabled(node_attribute_type attrib, bool enable)
@@ -1111,18 +1259,10 @@ void KRNode::addToOctreeNode(KROctreeNode* octree_node)
   m_octree_nodes.insert(octree_node);
 }
 
-void KRNode::updateLODVisibility(const KRViewport& viewport)
-{
-  if (m_lod_visible >= LOD_VISIBILITY_PRESTREAM) {
-    for (KRNode* child = m_firstChildNode; child != nullptr; child = child->m_nextNode) {
-      child->updateLODVisibility(viewport);
-    }
-  }
-}
-
 void KRNode::setLODVisibility(KRNode::LodVisibility lod_visibility)
 {
   if (m_lod_visible != lod_visibility) {
+    getScene().notify_lodNodeVisit();
     if (m_lod_visible == LOD_VISIBILITY_HIDDEN && lod_visibility >= LOD_VISIBILITY_PRESTREAM) {
       getScene().notify_sceneGraphCreate(this);
     } else if (m_lod_visible >= LOD_VISIBILITY_PRESTREAM && lod_visibility == LOD_VISIBILITY_HIDDEN) {
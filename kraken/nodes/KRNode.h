@@ -132,11 +132,19 @@ public:
   virtual tinyxml2::XMLElement* saveXML(tinyxml2::XMLNode* parent);
 
   static KRNode* LoadXML(KRScene& scene, tinyxml2::XMLElement* e);
+  static KRNode* CreateFromElementName(KRScene& scene, const char* szElementName, const char* szName);
   static KrResult createNode(const KrCreateNodeInfo* pCreateNodeInfo, KRScene* scene, KRNode** node);
   virtual void loadXML(tinyxml2::XMLElement* e);
 
+  // Enumerates the KRNodeProperty members of the node.  Subclasses with
+  // properties override this and call their superclass first.
+  virtual void visitProperties(KRNodePropertyVisitor& visitor);
+  // Called once properties have been loaded from any scene format
+  void propertiesLoaded();
+
   virtual std::string getElementName();
   const std::string& getName() const;
+  void setName(const std::string& name);
 
   void appendChild(KRNode* child);
   void prependChild(KRNode* child);
@@ -200,6 +208,8 @@ public:
   const hydra::Matrix4& getBindPoseMatrix() const;
   const hydra::Matrix4& getActivePoseMatrix() const;
   const hydra::Matrix4& getInverseBindPoseMatrix() const;
+  // Changes whenever the model matrix changes
+  uint32_t getTransformVersion() const;
 
   enum node_attribute_type
   {
@@ -235,6 +245,9 @@ public:
   };
 
   void SetAttribute(node_attribute_type attrib, float v);
+  // Applies several attributes at once, invalidating the transform only once
+  // and only if a value changed.  Later entries override earlier ones.
+  void SetAttributes(const node_attribute_type* attribs, const float* values, size_t count);
 
   KRScene& getScene();
 
@@ -246,7 +259,6 @@ public:
   virtual void physicsUpdate(float deltaTime);
   virtual bool hasPhysics();
 
-  virtual void updateLODVisibility(const KRViewport& viewport);
   LodVisibility getLODVisibility();
 
   void setScaleCompensation(bool scale_compensation);
@@ -295,21 +307,34 @@ protected:
   bool m_animation_mask[KRENGINE_NODE_ATTRIBUTE_COUNT];
 
 private:
+  friend class KRTransformHierarchy;
+  friend class KRNodeRegistry;
+
   void makeOrphan();
+  void parentChanged();
   long m_lastRenderFrame;
   void invalidateModelMatrix();
   void invalidateBindPoseMatrix();
+
+  // Used by KRTransformHierarchy to calculate the model matrix
+  bool isScaleCompensated() const;
+  hydra::Matrix4 calculateLocalMatrix(bool scale_compensated) const;
+  hydra::Matrix4 calculateScaleCompensatedModelMatrix(const hydra::Matrix4& localMatrix, const hydra::Matrix4& parentModelMatrix) const;
+  void transformUpdated(bool parentUpdated);
+  uint32_t m_transformIndex;
+
   // Members are mutable to enable lazy calculation from const accessors
-  mutable hydra::Matrix4 m_modelMatrix;
   mutable hydra::Matrix4 m_inverseModelMatrix;
   mutable hydra::Matrix4 m_bindPoseMatrix;
   mutable hydra::Matrix4 m_activePoseMatrix;
   mutable hydra::Matrix4 m_inverseBindPoseMatrix;
-  mutable bool m_modelMatrixValid;
   mutable bool m_inverseModelMatrixValid;
   mutable bool m_bindPoseMatrixValid;
   mutable bool m_activePoseMatrixValid;
   mutable bool m_inverseBindPoseMatrixValid;
+  // KRTransformHierarchy versions the inverse model and active pose matrices were calculated from
+  mutable uint32_t m_inverseModelMatrixVersion;
+  mutable uint32_t m_activePoseMatrixVersion;
 
   hydra::AABB m_bounds;
   bool m_boundsValid;
@@ -319,6 +344,9 @@ private:
   KRScene* m_pScene;
 
   std::set<KROctreeNode*> m_octree_nodes;
+  // Used by KRNodeRegistry
+  KRNodeRegistry::NodeType m_registryType;
+  uint32_t m_registryIndex[KRNodeRegistry::kKindCount];
   bool m_scale_compensation;
 
   std::set<KRBehavior*> m_behaviors;
@@ -357,18 +385,15 @@ public:
     return NULL;
   }
 
+  // Returns the nodes named "name" in this node's subtree, using the KRScene name index
+  void findByName(const std::string& name, std::vector<KRNode*>& matches);
+
   template <class T> T* find(const std::string& name)
   {
-    // TODO - KRScene should maintain a global node-name map for rapid searching
-    T* match = dynamic_cast<T*>(this);
-    if (match) {
-      if (name.compare(match->getName()) == 0) {
-        return match;
-      }
-    }
-
-    for (KRNode* child = m_firstChildNode; child != nullptr; child = child->m_nextNode) {
-      match = child->find<T>(name);
+    std::vector<KRNode*> matches;
+    findByName(name, matches);
+    for (KRNode* node : matches) {
+      T* match = dynamic_cast<T*>(node);
       if (match) {
         return match;
       }
@@ -33,6 +33,24 @@
 
 #include "resources/KRResourceBinding.h"
 
+// KRNodePropertyVisitor is implemented by each serializer of KRNode properties.
+// Nodes enumerate their properties once, in KRNode::visitProperties, and every
+// scene format is derived from that enumeration.
+class KRNodePropertyVisitor
+{
+public:
+  virtual ~KRNodePropertyVisitor() {}
+
+  virtual void visit(const char* name, int& val, int defaultVal) = 0;
+  virtual void visit(const char* name, unsigned int& val, unsigned int defaultVal) = 0;
+  virtual void visit(const char* name, float& val, float defaultVal) = 0;
+  virtual void visit(const char* name, bool& val, bool defaultVal) = 0;
+  virtual void visit(const char* name, hydra::Vector3& val, const hydra::Vector3& defaultVal) = 0;
+  virtual void visit(const char* name, hydra::AABB& val, const hydra::AABB& defaultVal) = 0;
+  virtual void visit(const char* name, std::string& val, const std::string& defaultVal) = 0;
+  virtual void visit(const char* name, KRResourceBinding& val) = 0;
+};
+
 template <typename T, class config>
 class KRNodeProperty
 {
@@ -60,69 +78,24 @@ public:
     return val;
   }
 
-  void save(tinyxml2::XMLElement* element) const
-  {
-    save(element, config::name);
-  }
-
-  void save(tinyxml2::XMLElement* element, const char* attributeName) const
-  {
-    if constexpr (std::is_same<T, bool>::value) {
-      element->SetAttribute(attributeName, val ? "true" : "false");
-    } else if constexpr (std::is_same<T, hydra::Vector3>::value) {
-      kraken::setXMLAttribute(attributeName, element, val, config::defaultVal);
-    } else if constexpr (std::is_same<T, hydra::AABB>::value) {
-      kraken::setXMLAttribute(attributeName, element, val, config::defaultVal);
-    } else if constexpr (std::is_same<T, std::string>::value) {
-      element->SetAttribute(attributeName, val.c_str());
-    } else if constexpr (std::is_base_of<KRResourceBinding, T>::value) {
-      element->SetAttribute(attributeName, val.getName().c_str());
-    } else {
-      element->SetAttribute(attributeName, val);
-    }
-  }
-
-  void load(tinyxml2::XMLElement* element)
+  void visit(KRNodePropertyVisitor& visitor)
   {
-    load(element, config::name);
+    visit(visitor, config::name);
   }
 
-  void load(tinyxml2::XMLElement* element, const char* attributeName)
+  void visit(KRNodePropertyVisitor& visitor, const char* propertyName)
   {
-    if constexpr (std::is_same<T, int>::value) {
-      if (element->QueryIntAttribute(attributeName, &val) != tinyxml2::XML_SUCCESS) {
-        val = config::defaultVal;
-      }
-    } else if constexpr (std::is_same<T, unsigned int>::value) {
-      if (element->QueryUnsignedAttribute(attributeName, &val) != tinyxml2::XML_SUCCESS) {
-        val = config::defaultVal;
-      }
-    } else if constexpr (std::is_same<T, float>::value) {
-      if (element->QueryFloatAttribute(attributeName, &val) != tinyxml2::XML_SUCCESS) {
-        val = config::defaultVal;
-      }
-    } else if constexpr (std::is_same<T, bool>::value) {
-      if (element->QueryBoolAttribute(attributeName, &val) != tinyxml2::XML_SUCCESS) {
-        val = config::defaultVal;
-      }
-    } else if constexpr (std::is_same<T, hydra::Vector3>::value) {
-      val = kraken::getXMLAttribute(attributeName, element, config::defaultVal);
-    } else if constexpr (std::is_same<T, hydra::AABB>::value) {
-      val = kraken::getXMLAttribute(attributeName, element, config::defaultVal);
+    if constexpr (std::is_base_of<KRResourceBinding, T>::value) {
+      visitor.visit(propertyName, val);
     } else if constexpr (std::is_same<T, std::string>::value) {
-      const char* name = element->Attribute(attributeName);
-      if (name) {
-        val = name;
-      } else {
-        val = config::defaultVal;
-      }
-    } else if constexpr (std::is_base_of<KRResourceBinding, T>::value) {
-      const char* name = element->Attribute(attributeName);
-      if (name) {
-        val.set(name);
-      } else {
-        val.clear();
-      }
+      visitor.visit(propertyName, val, std::string(config::defaultVal));
+    } else if constexpr (std::is_same<T, int>::value
+      || std::is_same<T, unsigned int>::value
+      || std::is_same<T, float>::value
+      || std::is_same<T, bool>::value
+      || std::is_same<T, hydra::Vector3>::value
+      || std::is_same<T, hydra::AABB>::value) {
+      visitor.visit(propertyName, val, static_cast<T>(config::defaultVal));
     } else {
       static_assert(false, "Typename not implemented.");
     }
@@ -40,14 +40,3 @@ KRParticleSystem::~KRParticleSystem()
 
 }
 
-void KRParticleSystem::loadXML(tinyxml2::XMLElement* e)
-{
-
-}
-
-tinyxml2::XMLElement* KRParticleSystem::saveXML(tinyxml2::XMLNode* parent)
-{
-  tinyxml2::XMLElement* e = KRNode::saveXML(parent);
-  return e;
-}
-
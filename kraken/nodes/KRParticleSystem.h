@@ -39,8 +39,6 @@ public:
   virtual ~KRParticleSystem();
 
   virtual std::string getElementName() override = 0;
-  virtual void loadXML(tinyxml2::XMLElement* e) override;
-  virtual tinyxml2::XMLElement* saveXML(tinyxml2::XMLNode* parent) override;
 
   virtual hydra::AABB getBounds() override = 0;
 
@@ -52,18 +52,6 @@ std::string KRParticleSystemNewtonian::getElementName()
   return "newtonian_particles";
 }
 
-void KRParticleSystemNewtonian::loadXML(tinyxml2::XMLElement* e)
-{
-  KRParticleSystem::loadXML(e);
-}
-
-tinyxml2::XMLElement* KRParticleSystemNewtonian::saveXML(tinyxml2::XMLNode* parent)
-{
-  tinyxml2::XMLElement* e = KRParticleSystem::saveXML(parent);
-  return e;
-}
-
-
 AABB KRParticleSystemNewtonian::getBounds()
 {
   return AABB::Create(-Vector3::One(), Vector3::One(), getModelMatrix());
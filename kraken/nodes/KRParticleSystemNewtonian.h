@@ -40,8 +40,6 @@ public:
   virtual ~KRParticleSystemNewtonian();
 
   virtual std::string getElementName() override;
-  virtual void loadXML(tinyxml2::XMLElement* e) override;
-  virtual tinyxml2::XMLElement* saveXML(tinyxml2::XMLNode* parent) override;
 
 
   virtual hydra::AABB getBounds() override;
@@ -64,6 +64,11 @@ std::string KRPointLight::getElementName()
   return "point_light";
 }
 
+void KRPointLight::appendToLightLists(std::vector<KRDirectionalLight*>& directional_lights, std::vector<KRSpotLight*>& spot_lights, std::vector<KRPointLight*>& point_lights)
+{
+  point_lights.push_back(this);
+}
+
 AABB KRPointLight::getBounds()
 {
   float influence_radius = m_decayStart - sqrt(m_intensity * 0.01f) / sqrt(KRLIGHT_MIN_INFLUENCE);
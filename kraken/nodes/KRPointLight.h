@@ -44,6 +44,7 @@ public:
   virtual hydra::AABB getBounds() override;
 
   virtual void render(RenderInfo& ri) override;
+  virtual void appendToLightLists(std::vector<KRDirectionalLight*>& directional_lights, std::vector<KRSpotLight*>& spot_lights, std::vector<KRPointLight*>& point_lights) override;
 
 protected:
   bool getShaderValue(ShaderValue value, float* output) const override;
@@ -57,24 +57,13 @@ std::string KRReverbZone::getElementName()
   return "reverb_zone";
 }
 
-tinyxml2::XMLElement* KRReverbZone::saveXML(tinyxml2::XMLNode* parent)
+void KRReverbZone::visitProperties(KRNodePropertyVisitor& visitor)
 {
-  tinyxml2::XMLElement* e = KRNode::saveXML(parent);
-  m_zone.save(e);
-  m_reverb.save(e);
-  m_reverb_gain.save(e);
-  m_gradient_distance.save(e);
-  return e;
-}
-
-void KRReverbZone::loadXML(tinyxml2::XMLElement* e)
-{
-  KRNode::loadXML(e);
-
-  m_zone.load(e);
-  m_gradient_distance.load(e);
-  m_reverb.load(e);
-  m_reverb_gain.load(e);
+  KRNode::visitProperties(visitor);
+  m_zone.visit(visitor);
+  m_gradient_distance.visit(visitor);
+  m_reverb.visit(visitor);
+  m_reverb_gain.visit(visitor);
 }
 
 KRAudioSample* KRReverbZone::getReverb()
@@ -45,8 +45,7 @@ public:
   KRReverbZone(KRScene& scene, std::string name);
   virtual ~KRReverbZone();
   virtual std::string getElementName() override;
-  virtual tinyxml2::XMLElement* saveXML(tinyxml2::XMLNode* parent) override;
-  virtual void loadXML(tinyxml2::XMLElement* e) override;
+  virtual void visitProperties(KRNodePropertyVisitor& visitor) override;
 
   void render(RenderInfo& ri) override;
 
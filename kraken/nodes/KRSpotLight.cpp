@@ -56,20 +56,16 @@ std::string KRSpotLight::getElementName()
   return "spot_light";
 }
 
-tinyxml2::XMLElement* KRSpotLight::saveXML(tinyxml2::XMLNode* parent)
+void KRSpotLight::appendToLightLists(std::vector<KRDirectionalLight*>& directional_lights, std::vector<KRSpotLight*>& spot_lights, std::vector<KRPointLight*>& point_lights)
 {
-  tinyxml2::XMLElement* e = KRLight::saveXML(parent);
-  m_innerAngle.save(e);
-  m_outerAngle.save(e);
-  return e;
+  spot_lights.push_back(this);
 }
 
-void KRSpotLight::loadXML(tinyxml2::XMLElement* e)
+void KRSpotLight::visitProperties(KRNodePropertyVisitor& visitor)
 {
-  KRLight::loadXML(e);
-
-  m_innerAngle.load(e);
-  m_outerAngle.load(e);
+  KRLight::visitProperties(visitor);
+  m_innerAngle.visit(visitor);
+  m_outerAngle.visit(visitor);
 }
 
 float KRSpotLight::getInnerAngle()
@@ -42,9 +42,9 @@ public:
   virtual ~KRSpotLight();
 
   virtual std::string getElementName();
-  virtual tinyxml2::XMLElement* saveXML(tinyxml2::XMLNode* parent);
-  virtual void loadXML(tinyxml2::XMLElement* e);
+  virtual void visitProperties(KRNodePropertyVisitor& visitor) override;
   virtual hydra::AABB getBounds();
+  virtual void appendToLightLists(std::vector<KRDirectionalLight*>& directional_lights, std::vector<KRSpotLight*>& spot_lights, std::vector<KRPointLight*>& point_lights) override;
 
   float getInnerAngle();
   float getOuterAngle();
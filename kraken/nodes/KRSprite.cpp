@@ -67,20 +67,11 @@ std::string KRSprite::getElementName()
   return "sprite";
 }
 
-tinyxml2::XMLElement* KRSprite::saveXML(tinyxml2::XMLNode* parent)
+void KRSprite::visitProperties(KRNodePropertyVisitor& visitor)
 {
-  tinyxml2::XMLElement* e = KRNode::saveXML(parent);
-  m_spriteTexture.save(e);
-  m_spriteAlpha.save(e);
-  return e;
-}
-
-void KRSprite::loadXML(tinyxml2::XMLElement* e)
-{
-  KRNode::loadXML(e);
-
-  m_spriteTexture.load(e);
-  m_spriteAlpha.load(e);
+  KRNode::visitProperties(visitor);
+  m_spriteTexture.visit(visitor);
+  m_spriteAlpha.visit(visitor);
 }
 
 void KRSprite::setSpriteTexture(std::string sprite_texture)
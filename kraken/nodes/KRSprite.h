@@ -45,8 +45,7 @@ public:
 
   virtual ~KRSprite();
   virtual std::string getElementName() override;
-  virtual tinyxml2::XMLElement* saveXML(tinyxml2::XMLNode* parent) override;
-  virtual void loadXML(tinyxml2::XMLElement* e) override;
+  virtual void visitProperties(KRNodePropertyVisitor& visitor) override;
 
   void setSpriteTexture(std::string sprite_texture);
   void setSpriteAlpha(float alpha);
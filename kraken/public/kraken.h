@@ -54,6 +54,7 @@ typedef enum
   KR_ERROR_VULKAN_DEPTHBUFFER,
   KR_ERROR_NO_DEVICE,
   KR_ERROR_SHADER_COMPILE_FAILED,
+  KR_ERROR_RESOURCE_IN_USE,
   KR_ERROR_UNEXPECTED = 0x10000000,
   KR_RESULT_MAX_ENUM = 0x7FFFFFFF
 } KrResult;
@@ -76,8 +77,11 @@ typedef enum
   KR_STRUCTURE_TYPE_MOVE_TO_BUNDLE,
 
   KR_STRUCTURE_TYPE_COMPILE_ALL_SHADERS,
+  KR_STRUCTURE_TYPE_COMPRESS_ANIMATION_CURVE,
+  KR_STRUCTURE_TYPE_COMPRESS_TEXTURE,
 
   KR_STRUCTURE_TYPE_CREATE_SCENE = 0x00020000,
+  KR_STRUCTURE_TYPE_SET_SCENE_FORMAT,
 
   KR_STRUCTURE_TYPE_FIND_NODE_BY_NAME = 0x00030000,
   KR_STRUCTURE_TYPE_FIND_ADJACENT_NODES,
@@ -117,6 +121,33 @@ typedef enum
   KR_SCENE_NODE_INSERT_MAX_ENUM
 } KrSceneNodeInsertLocation;
 
+typedef enum
+{
+  KR_SCENE_FORMAT_XML = 0,
+  KR_SCENE_FORMAT_BINARY,
+  KR_SCENE_FORMAT_MAX_ENUM
+} KrSceneFormat;
+
+typedef enum
+{
+  // BC1 for opaque textures and BC3 for textures with transparency, or BC7 for KR_TEXTURE_COMPRESSION_QUALITY_HIGH
+  KR_TEXTURE_COMPRESSION_FORMAT_AUTO = 0,
+  KR_TEXTURE_COMPRESSION_FORMAT_BC1,
+  KR_TEXTURE_COMPRESSION_FORMAT_BC3,
+  // Red and green channels only, for tangent space normal maps
+  KR_TEXTURE_COMPRESSION_FORMAT_BC5,
+  KR_TEXTURE_COMPRESSION_FORMAT_BC7,
+  KR_TEXTURE_COMPRESSION_FORMAT_MAX_ENUM
+} KrTextureCompressionFormat;
+
+typedef enum
+{
+  KR_TEXTURE_COMPRESSION_QUALITY_FAST = 0,
+  KR_TEXTURE_COMPRESSION_QUALITY_NORMAL,
+  KR_TEXTURE_COMPRESSION_QUALITY_HIGH,
+  KR_TEXTURE_COMPRESSION_QUALITY_MAX_ENUM
+} KrTextureCompressionQuality;
+
 typedef int KrResourceMapIndex;
 typedef int KrSceneNodeMapIndex;
 typedef int KrSurfaceMapIndex;
@@ -210,6 +241,26 @@ typedef struct
   KrResourceMapIndex logHandle;
 } KrCompileAllShadersInfo;
 
+typedef struct
+{
+  KrStructureType sType;
+  KrResourceMapIndex resourceHandle;
+  float tolerance;
+} KrCompressAnimationCurveInfo;
+
+// Replaces an uncompressed texture with a block compressed texture with a
+// full mip chain.  Textures should be compressed before they are bound to
+// materials.  Resources that are not uncompressed textures return
+// KR_ERROR_INCORRECT_TYPE.
+typedef struct
+{
+  KrStructureType sType;
+  KrResourceMapIndex resourceHandle;
+  KrTextureCompressionFormat format;
+  KrTextureCompressionQuality quality;
+  bool premultiplyAlpha;
+} KrCompressTextureInfo;
+
 typedef struct
 {
   KrStructureType sType;
@@ -217,6 +268,13 @@ typedef struct
   KrResourceMapIndex resourceHandle;
 } KrCreateSceneInfo;
 
+typedef struct
+{
+  KrStructureType sType;
+  KrResourceMapIndex sceneHandle;
+  KrSceneFormat format;
+} KrSetSceneFormatInfo;
+
 typedef struct
 {
   KrStructureType sType;
@@ -442,8 +500,11 @@ KrResult KrMoveToBundle(const KrMoveToBundleInfo* pMoveToBundleInfo);
 KrResult KrInitNodeInfo(KrNodeInfo* pNodeInfo, KrStructureType nodeType);
 
 KrResult KrCompileAllShaders(const KrCompileAllShadersInfo* pCompileAllShadersInfo);
+KrResult KrCompressAnimationCurve(const KrCompressAnimationCurveInfo* pCompressAnimationCurveInfo);
+KrResult KrCompressTexture(const KrCompressTextureInfo* pCompressTextureInfo);
 
 KrResult KrCreateScene(const KrCreateSceneInfo* pCreateSceneInfo);
+KrResult KrSetSceneFormat(const KrSetSceneFormatInfo* pSetSceneFormatInfo);
 KrResult KrFindNodeByName(const KrFindNodeByNameInfo* pFindNodeByNameInfo);
 KrResult KrFindAdjacentNodes(const KrFindAdjacentNodesInfo* pFindAdjacentNodesInfo);
 KrResult KrSetNodeLocalTransform(const KrSetNodeLocalTransformInfo* pSetNodeLocalTransform);
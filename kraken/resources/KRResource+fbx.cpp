@@ -1277,6 +1277,7 @@ void LoadMesh(KRContext& context, FbxScene* pFbxScene, FbxGeometryConverter* pGe
 {
   KRMesh::mesh_info mi;
   mi.format = ModelFormat::KRENGINE_MODEL_FORMAT_TRIANGLES;
+  mi.quantize = true;
 
   typedef struct
   {
@@ -355,6 +355,7 @@ KRMesh* KRResource::LoadObj(KRContext& context, const std::string& path)
 //        std::vector<std::pair<int, int> > vertex_index_bases;
 
     mi.format = ModelFormat::KRENGINE_MODEL_FORMAT_TRIANGLES;
+    mi.quantize = true;
     new_mesh->LoadData(mi, true, false);
   }
 
@@ -45,6 +45,9 @@ KRAnimation::KRAnimation(KRContext& context, std::string name) : KRResource(cont
   m_local_time = 0.0f;
   m_duration = 0.0f;
   m_start_time = 0.0f;
+  m_bindingsValid = false;
+  m_unresolvedTargets = false;
+  m_reachedEnd = false;
 }
 KRAnimation::~KRAnimation()
 {
@@ -61,6 +64,7 @@ std::string KRAnimation::getExtension()
 void KRAnimation::addLayer(KRAnimationLayer* layer)
 {
   m_layers[layer->getName()] = layer;
+  unbindAttributes();
 }
 
 bool KRAnimation::save(Block& data)
@@ -140,6 +144,13 @@ KRAnimationLayer* KRAnimation::getLayer(const char* szName)
 }
 
 void KRAnimation::update(float deltaTime)
+{
+  _resolveTargets();
+  evaluate(deltaTime);
+  apply();
+}
+
+void KRAnimation::evaluate(float deltaTime)
 {
   if (m_playing) {
     m_local_time += deltaTime;
@@ -151,24 +162,95 @@ void KRAnimation::update(float deltaTime)
   } else if (m_local_time > m_duration) {
     m_local_time = m_duration;
     m_playing = false;
+    m_reachedEnd = true;
+  }
+
+  // Sample every channel into the pose buffer
+  float time = m_local_time + m_start_time;
+  size_t channel_count = m_channels.size();
+  KRAnimationCurve::Sampler* channels = m_channels.data();
+  float* pose = m_pose.data();
+  for (size_t i = 0; i < channel_count; i++) {
+    pose[i] = KRAnimationCurve::Sample(channels[i], time * channels[i].frame_rate);
+  }
+}
+
+void KRAnimation::apply()
+{
+  if (m_reachedEnd) {
+    m_reachedEnd = false;
     getContext().getAnimationManager()->updateActiveAnimations(this);
   }
 
+  // Apply the pose, one node at a time
+  for (const TargetBinding& target : m_targets) {
+    target.target->SetAttributes(&m_channelAttributes[target.first_channel], &m_pose[target.first_channel], target.channel_count);
+  }
+}
+
+void KRAnimation::bindAttributes()
+{
+  unbindAttributes();
+
+  // Group the channels by target node, preserving the order of attributes
+  // so that later layers continue to override earlier ones.
+  // TODO - Currently only a single layer supported per animation -- need to either implement combining of multiple layers or ask the FBX sdk to bake all layers into one
+  std::vector<KRNode*> target_order;
+  unordered_map<KRNode*, std::vector<KRAnimationAttribute*> > target_attributes;
   for (unordered_map<std::string, KRAnimationLayer*>::iterator layer_itr = m_layers.begin(); layer_itr != m_layers.end(); layer_itr++) {
     KRAnimationLayer* layer = (*layer_itr).second;
     for (std::vector<KRAnimationAttribute*>::iterator attribute_itr = layer->getAttributes().begin(); attribute_itr != layer->getAttributes().end(); attribute_itr++) {
       KRAnimationAttribute* attribute = *attribute_itr;
-
-
-      // TODO - Currently only a single layer supported per animation -- need to either implement combining of multiple layers or ask the FBX sdk to bake all layers into one
       KRAnimationCurve* curve = attribute->getCurve();
+      if (curve == NULL || curve->getFrameCount() <= 0) {
+        continue;
+      }
       KRNode* target = attribute->getTarget();
-      KRNode::node_attribute_type attribute_type = attribute->getTargetAttribute();
-
-      if (curve != NULL && target != NULL) {
-        target->SetAttribute(attribute_type, curve->getValue(m_local_time + m_start_time));
+      if (target == NULL) {
+        // Looked up again by _resolveTargets()
+        m_unresolvedTargets = true;
+        continue;
+      }
+      std::vector<KRAnimationAttribute*>& attributes = target_attributes[target];
+      if (attributes.empty()) {
+        target_order.push_back(target);
       }
+      attributes.push_back(attribute);
+    }
+  }
+
+  for (KRNode* target : target_order) {
+    TargetBinding target_binding;
+    target_binding.target = target;
+    target_binding.first_channel = m_channels.size();
+    for (KRAnimationAttribute* attribute : target_attributes[target]) {
+      KRAnimationCurve* curve = attribute->getCurve();
+      KRAnimationCurve::Sampler channel;
+      curve->_getSampler(channel);
+      m_channels.push_back(channel);
+      m_channelAttributes.push_back(attribute->getTargetAttribute());
     }
+    target_binding.channel_count = m_channels.size() - target_binding.first_channel;
+    m_targets.push_back(target_binding);
+  }
+  m_pose.resize(m_channels.size());
+  m_bindingsValid = true;
+}
+
+void KRAnimation::unbindAttributes()
+{
+  m_channels.clear();
+  m_channelAttributes.clear();
+  m_targets.clear();
+  m_pose.clear();
+  m_bindingsValid = false;
+  m_unresolvedTargets = false;
+}
+
+void KRAnimation::_resolveTargets()
+{
+  if (!m_bindingsValid || m_unresolvedTargets) {
+    bindAttributes();
   }
 }
 
@@ -312,6 +394,7 @@ KRAnimation* KRAnimation::split(const std::string& name, float start_time, float
 
 void KRAnimation::deleteCurves()
 {
+  unbindAttributes();
   for (unordered_map<std::string, KRAnimationLayer*>::iterator layer_itr = m_layers.begin(); layer_itr != m_layers.end(); layer_itr++) {
     KRAnimationLayer* layer = (*layer_itr).second;
     for (std::vector<KRAnimationAttribute*>::iterator attribute_itr = layer->getAttributes().begin(); attribute_itr != layer->getAttributes().end(); attribute_itr++) {
@@ -333,10 +416,14 @@ void KRAnimation::_lockData()
       }
     }
   }
+  // Resolve the bindings now, so that evaluate() does not need to look up
+  // curves and nodes on a worker thread
+  bindAttributes();
 }
 
 void KRAnimation::_unlockData()
 {
+  unbindAttributes();
   for (unordered_map<std::string, KRAnimationLayer*>::iterator layer_itr = m_layers.begin(); layer_itr != m_layers.end(); layer_itr++) {
     KRAnimationLayer* layer = (*layer_itr).second;
     for (std::vector<KRAnimationAttribute*>::iterator attribute_itr = layer->getAttributes().begin(); attribute_itr != layer->getAttributes().end(); attribute_itr++) {
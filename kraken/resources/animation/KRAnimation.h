@@ -36,6 +36,7 @@
 #include "block.h"
 #include "resources/KRResource.h"
 #include "KRAnimationLayer.h"
+#include "nodes/KRNode.h"
 
 
 class KRAnimation : public KRResource
@@ -60,6 +61,11 @@ public:
   void Play();
   void Stop();
   void update(float deltaTime);
+  // update() split in two, so that animations can be evaluated concurrently.
+  // evaluate() only modifies the animation; apply() writes the pose to the nodes.
+  // The attributes must first be bound on the main thread by _resolveTargets().
+  void evaluate(float deltaTime);
+  void apply();
   float getTime();
   void setTime(float time);
   float getDuration();
@@ -73,8 +79,33 @@ public:
 
   void _lockData();
   void _unlockData();
+  // Binds the attributes if they are not yet bound, and targets that could not
+  // be found when they were bound, such as nodes added to the scene after the
+  // animation started.  Main thread only, before evaluate().
+  void _resolveTargets();
 
 private:
+  void bindAttributes();
+  void unbindAttributes();
+
+  // A run of consecutive channels in m_channels that animate the same node
+  struct TargetBinding
+  {
+    KRNode* target;
+    size_t first_channel;
+    size_t channel_count;
+  };
+
+  // Resolved while the curve data is locked, so that update() does not need
+  // to look up curves and nodes or lock curve data for every attribute.
+  bool m_bindingsValid;
+  bool m_unresolvedTargets;
+  bool m_reachedEnd;
+  std::vector<KRAnimationCurve::Sampler> m_channels;
+  std::vector<KRNode::node_attribute_type> m_channelAttributes;
+  std::vector<TargetBinding> m_targets;
+  std::vector<float> m_pose;
+
   unordered_map<std::string, KRAnimationLayer*> m_layers;
   bool m_auto_play;
   bool m_loop;
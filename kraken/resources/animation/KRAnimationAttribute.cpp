@@ -256,7 +256,7 @@ void KRAnimationAttribute::setCurveName(const std::string& curve_name)
 KRNode* KRAnimationAttribute::getTarget()
 {
   if (m_target == NULL) {
-    m_target = getContext().getSceneManager()->getFirstScene()->getRootNode()->find<KRNode>(m_target_name); // FINDME, HACK! - This won't work with multiple scenes in a context; we should move the animations out of KRAnimationManager and attach them to the parent nodes of the animated KRNode's
+    m_target = getContext().getSceneManager()->getFirstScene()->find<KRNode>(m_target_name); // FINDME, HACK! - This won't work with multiple scenes in a context; we should move the animations out of KRAnimationManager and attach them to the parent nodes of the animated KRNode's
   }
   if (m_target == NULL) {
     KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Kraken - Animation attribute could not find object: %s", m_target_name.c_str());
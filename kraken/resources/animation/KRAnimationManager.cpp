@@ -31,6 +31,8 @@
 
 #include "KRAnimationManager.h"
 #include "KRAnimation.h"
+#include "KRContext.h"
+#include "KRThreadPool.h"
 
 KRAnimationManager::KRAnimationManager(KRContext& context) : KRResourceManager(context)
 {
@@ -71,10 +73,21 @@ void KRAnimationManager::startFrame(float deltaTime)
 
   m_animationsToUpdate.clear();
 
-  for (std::set<KRAnimation*>::iterator active_animations_itr = m_activeAnimations.begin(); active_animations_itr != m_activeAnimations.end(); active_animations_itr++) {
-    KRAnimation* animation = *active_animations_itr;
-    animation->update(deltaTime);
+  for (KRAnimation* animation : m_activeAnimations) {
+    animation->_resolveTargets();
   }
+
+  // Animations are evaluated in parallel, then applied to their nodes serially
+  m_updatingAnimations.assign(m_activeAnimations.begin(), m_activeAnimations.end());
+  m_pContext->getThreadPool()->parallelFor(m_updatingAnimations.size(), 1, [this, deltaTime](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      m_updatingAnimations[i]->evaluate(deltaTime);
+    }
+  });
+  for (KRAnimation* animation : m_updatingAnimations) {
+    animation->apply();
+  }
+  m_updatingAnimations.clear();
 }
 
 void KRAnimationManager::endFrame(float deltaTime)
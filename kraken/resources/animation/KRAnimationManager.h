@@ -65,5 +65,6 @@ private:
   unordered_map<std::string, KRAnimation*> m_animations;
   set<KRAnimation*> m_activeAnimations;
   set<KRAnimation*> m_animationsToUpdate;
+  std::vector<KRAnimation*> m_updatingAnimations;
 };
 
@@ -35,13 +35,107 @@
 
 using namespace mimir;
 
+namespace {
+const char* kDenseCurveTag = "KRCURVE1.0     ";
+const char* kCompressedCurveTag = "KRCURVE2.0     ";
+
+float EvaluateSegment(const KRAnimationCurve::Key& k0, const KRAnimationCurve::Key& k1, float frame)
+{
+  float duration = k1.frame - k0.frame;
+  float t = (frame - k0.frame) / duration;
+  switch (k0.interpolation) {
+  case KRAnimationCurve::Interpolation::kConstant:
+    return k0.value;
+  case KRAnimationCurve::Interpolation::kLinear:
+    return k0.value + (k1.value - k0.value) * t;
+  case KRAnimationCurve::Interpolation::kHermite:
+  default:
+  {
+    float t2 = t * t;
+    float t3 = t2 * t;
+    return (2.0f * t3 - 3.0f * t2 + 1.0f) * k0.value
+      + (t3 - 2.0f * t2 + t) * duration * k0.slope
+      + (-2.0f * t3 + 3.0f * t2) * k1.value
+      + (t3 - t2) * duration * k1.slope;
+  }
+  }
+}
+
+// Returns true if every frame between the keys is within tolerance of the segment
+bool SegmentFits(const std::vector<float>& values, KRAnimationCurve::Key k0, const KRAnimationCurve::Key& k1, KRAnimationCurve::Interpolation interpolation, float tolerance)
+{
+  k0.interpolation = interpolation;
+  int first = (int)k0.frame;
+  int last = (int)k1.frame;
+  if (interpolation == KRAnimationCurve::Interpolation::kConstant && fabsf(k1.value - k0.value) > tolerance) {
+    return false;
+  }
+  for (int frame = first + 1; frame < last; frame++) {
+    if (fabsf(EvaluateSegment(k0, k1, (float)frame) - values[frame]) > tolerance) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Greedily extends each segment for as long as some interpolation keeps it within tolerance.
+// Slopes are estimated from the neighbouring frames.
+void FitKeys(const std::vector<float>& values, float tolerance, std::vector<KRAnimationCurve::Key>& keys)
+{
+  int frame_count = (int)values.size();
+  auto make_key = [&](int frame) {
+    KRAnimationCurve::Key key;
+    key.frame = (float)frame;
+    key.value = values[frame];
+    int prev = frame > 0 ? frame - 1 : frame;
+    int next = frame < frame_count - 1 ? frame + 1 : frame;
+    key.slope = (values[next] - values[prev]) / (float)(next - prev);
+    key.interpolation = KRAnimationCurve::Interpolation::kConstant;
+    return key;
+  };
+
+  const KRAnimationCurve::Interpolation interpolations[] = {
+    KRAnimationCurve::Interpolation::kConstant,
+    KRAnimationCurve::Interpolation::kLinear,
+    KRAnimationCurve::Interpolation::kHermite
+  };
+
+  keys.push_back(make_key(0));
+  int start = 0;
+  while (start < frame_count - 1) {
+    // A segment spanning a single frame is reproduced exactly by linear interpolation
+    int end = start + 1;
+    KRAnimationCurve::Interpolation best = SegmentFits(values, keys.back(), make_key(end), KRAnimationCurve::Interpolation::kConstant, tolerance) ? KRAnimationCurve::Interpolation::kConstant : KRAnimationCurve::Interpolation::kLinear;
+    for (int next = end + 1; next < frame_count; next++) {
+      KRAnimationCurve::Key next_key = make_key(next);
+      bool fits = false;
+      for (KRAnimationCurve::Interpolation interpolation : interpolations) {
+        if (SegmentFits(values, keys.back(), next_key, interpolation, tolerance)) {
+          best = interpolation;
+          fits = true;
+          break;
+        }
+      }
+      if (!fits) {
+        break;
+      }
+      end = next;
+    }
+    keys.back().interpolation = best;
+    keys.push_back(make_key(end));
+    start = end;
+  }
+}
+} // namespace
+
 KRAnimationCurve::KRAnimationCurve(KRContext& context, const std::string& name) : KRResource(context, name)
 {
+  m_lockCount = 0;
   m_pData = new Block();
   m_pData->expand(sizeof(animation_curve_header));
   m_pData->lock();
   animation_curve_header* header = (animation_curve_header*)m_pData->getStart();
-  strcpy(header->szTag, "KRCURVE1.0     ");
+  strcpy(header->szTag, kDenseCurveTag);
   header->frame_rate = 30.0f;
   header->frame_start = 0;
   header->frame_count = 0;
@@ -98,11 +192,19 @@ int KRAnimationCurve::getFrameCount()
   return frame_count;
 }
 
-void KRAnimationCurve::setFrameCount(int frame_count)
+bool KRAnimationCurve::setFrameCount(int frame_count)
 {
+  if (!decompress()) {
+    return false;
+  }
   m_pData->lock();
   int prev_frame_count = getFrameCount();
   if (frame_count != prev_frame_count) {
+    if (isLocked()) {
+      // Resizing may move the data that animations are sampling
+      m_pData->unlock();
+      return false;
+    }
     float fill_value = 0.0f;
     if (prev_frame_count > 0) {
       fill_value = getValue(prev_frame_count - 1);
@@ -115,6 +217,7 @@ void KRAnimationCurve::setFrameCount(int frame_count)
     ((animation_curve_header*)m_pData->getStart())->frame_count = frame_count;
   }
   m_pData->unlock();
+  return true;
 }
 
 float KRAnimationCurve::getFrameRate()
@@ -150,21 +253,18 @@ void KRAnimationCurve::setFrameStart(int frame_number)
 float KRAnimationCurve::getValue(int frame_number)
 {
   m_pData->lock();
-  //printf("frame_number: %i\n", frame_number);
-  int clamped_frame = frame_number - getFrameStart();
-  if (clamped_frame < 0) {
-    clamped_frame = 0;
-  } else if (clamped_frame >= getFrameCount()) {
-    clamped_frame = getFrameCount() - 1;
-  }
-  float* frame_data = (float*)((char*)m_pData->getStart() + sizeof(animation_curve_header));
-  float v = frame_data[clamped_frame];
+  Sampler sampler;
+  _getSampler(sampler);
+  float v = Sample(sampler, (float)frame_number);
   m_pData->unlock();
   return v;
 }
 
-void KRAnimationCurve::setValue(int frame_number, float value)
+bool KRAnimationCurve::setValue(int frame_number, float value)
 {
+  if (!decompress()) {
+    return false;
+  }
   m_pData->lock();
   int clamped_frame = frame_number - getFrameStart();
   if (clamped_frame >= 0 && clamped_frame < getFrameCount()) {
@@ -172,18 +272,153 @@ void KRAnimationCurve::setValue(int frame_number, float value)
     frame_data[clamped_frame] = value;
   }
   m_pData->unlock();
+  return true;
 }
 
 float KRAnimationCurve::getValue(float local_time)
 {
-  // TODO - Need to add interpolation for time values between frames.
-  //        Must consider looping animations when determining which two frames to interpolate between.
+  // TODO - Must consider looping animations when determining which two frames to interpolate between.
   m_pData->lock();
-  float v = getValue((int)(local_time * getFrameRate()));
+  Sampler sampler;
+  _getSampler(sampler);
+  float v = Sample(sampler, local_time * sampler.frame_rate);
   m_pData->unlock();
   return v;
 }
 
+float KRAnimationCurve::Sample(Sampler& sampler, float frame)
+{
+  float f = frame - (float)sampler.frame_start;
+  int count = sampler.count;
+
+  if (sampler.keys == nullptr) {
+    // Dense curve; interpolate linearly between frames
+    const float* frames = sampler.frames;
+    if (f <= 0.0f) {
+      return frames[0];
+    }
+    int i = (int)f;
+    if (i >= count - 1) {
+      return frames[count - 1];
+    }
+    return frames[i] + (frames[i + 1] - frames[i]) * (f - (float)i);
+  }
+
+  const Key* keys = sampler.keys;
+  if (f <= keys[0].frame) {
+    return keys[0].value;
+  }
+  if (f >= keys[count - 1].frame) {
+    return keys[count - 1].value;
+  }
+
+  // Find the segment containing the frame.  During playback this is usually
+  // the segment found last time, or one shortly after it.
+  int k = sampler.cursor;
+  if (k < 0 || k >= count - 1 || keys[k].frame > f) {
+    k = (int)(std::upper_bound(keys, keys + count, f, [](float frame, const Key& key) {
+      return frame < key.frame;
+    }) - keys) - 1;
+  } else {
+    while (keys[k + 1].frame <= f) {
+      k++;
+    }
+  }
+  sampler.cursor = k;
+  return EvaluateSegment(keys[k], keys[k + 1], f);
+}
+
+bool KRAnimationCurve::compress(float tolerance)
+{
+  if (isCompressed()) {
+    return true;
+  }
+  if (isLocked()) {
+    return false;
+  }
+
+  m_pData->lock();
+  animation_curve_header header = *(animation_curve_header*)m_pData->getStart();
+  const float* frame_data = (const float*)((char*)m_pData->getStart() + sizeof(animation_curve_header));
+  std::vector<float> values(frame_data, frame_data + header.frame_count);
+  m_pData->unlock();
+
+  if (header.frame_count < 2) {
+    return true;
+  }
+
+  std::vector<Key> keys;
+  FitKeys(values, tolerance, keys);
+
+  size_t dense_size = sizeof(animation_curve_header) + sizeof(float) * header.frame_count;
+  size_t compressed_size = sizeof(animation_curve_keys_header) + sizeof(Key) * keys.size();
+  if (compressed_size >= dense_size) {
+    return true;
+  }
+
+  Block* data = new Block();
+  data->expand(compressed_size);
+  data->lock();
+  animation_curve_keys_header* keys_header = (animation_curve_keys_header*)data->getStart();
+  keys_header->header = header;
+  strcpy(keys_header->header.szTag, kCompressedCurveTag);
+  keys_header->key_count = (int32_t)keys.size();
+  memcpy((char*)data->getStart() + sizeof(animation_curve_keys_header), keys.data(), sizeof(Key) * keys.size());
+  data->unlock();
+  replaceData(data);
+  return true;
+}
+
+bool KRAnimationCurve::decompress()
+{
+  if (!isCompressed()) {
+    return true;
+  }
+  if (isLocked()) {
+    return false;
+  }
+
+  m_pData->lock();
+  animation_curve_header header = *(animation_curve_header*)m_pData->getStart();
+  Sampler sampler;
+  _getSampler(sampler);
+
+  Block* data = new Block();
+  data->expand(sizeof(animation_curve_header) + sizeof(float) * header.frame_count);
+  data->lock();
+  animation_curve_header* dense_header = (animation_curve_header*)data->getStart();
+  *dense_header = header;
+  strcpy(dense_header->szTag, kDenseCurveTag);
+  float* frame_data = (float*)((char*)data->getStart() + sizeof(animation_curve_header));
+  for (int frame = 0; frame < header.frame_count; frame++) {
+    frame_data[frame] = Sample(sampler, (float)(header.frame_start + frame));
+  }
+  data->unlock();
+  m_pData->unlock();
+  replaceData(data);
+  return true;
+}
+
+bool KRAnimationCurve::isCompressed()
+{
+  m_pData->lock();
+  bool compressed = strncmp(((animation_curve_header*)m_pData->getStart())->szTag, kCompressedCurveTag, sizeof(animation_curve_header::szTag)) == 0;
+  m_pData->unlock();
+  return compressed;
+}
+
+bool KRAnimationCurve::isLocked()
+{
+  return m_lockCount > 0;
+}
+
+void KRAnimationCurve::replaceData(Block* data)
+{
+  m_pData->unload();
+  delete m_pData;
+  m_pData = data;
+}
+
 bool KRAnimationCurve::valueChanges(float start_time, float duration)
 {
   m_pData->lock();
@@ -237,9 +472,28 @@ KRAnimationCurve* KRAnimationCurve::split(const std::string& name, int start_fra
 void KRAnimationCurve::_lockData()
 {
   m_pData->lock();
+  m_lockCount++;
 }
 
 void KRAnimationCurve::_unlockData()
 {
+  m_lockCount--;
   m_pData->unlock();
 }
+
+void KRAnimationCurve::_getSampler(Sampler& sampler)
+{
+  animation_curve_header* header = (animation_curve_header*)m_pData->getStart();
+  sampler.frame_start = header->frame_start;
+  sampler.frame_rate = header->frame_rate;
+  sampler.cursor = 0;
+  if (strncmp(header->szTag, kCompressedCurveTag, sizeof(header->szTag)) == 0) {
+    sampler.frames = nullptr;
+    sampler.keys = (const Key*)((char*)m_pData->getStart() + sizeof(animation_curve_keys_header));
+    sampler.count = ((animation_curve_keys_header*)header)->key_count;
+  } else {
+    sampler.frames = (const float*)((char*)m_pData->getStart() + sizeof(animation_curve_header));
+    sampler.keys = nullptr;
+    sampler.count = header->frame_count;
+  }
+}
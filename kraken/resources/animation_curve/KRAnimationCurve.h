@@ -40,6 +40,35 @@ class KRAnimationCurve : public KRResource
 {
 
 public:
+  enum class Interpolation : uint32_t
+  {
+    kConstant,
+    kLinear,
+    kHermite
+  };
+
+  // A key of a compressed curve.  Frames are relative to the curve's frame start.
+  // The interpolation applies to the segment that starts at this key.
+  typedef struct
+  {
+    float frame;
+    float value;
+    float slope; // Change in value per frame
+    Interpolation interpolation;
+  } Key;
+
+  // Evaluates a curve without locking its data.
+  // Only valid while the curve data is locked with _lockData().
+  typedef struct
+  {
+    const float* frames; // Dense curves
+    const Key* keys; // Compressed curves
+    int count;
+    int frame_start;
+    float frame_rate;
+    int cursor; // Segment found by the last evaluation, for sequential playback
+  } Sampler;
+
   KRAnimationCurve(KRContext& context, const std::string& name);
   virtual ~KRAnimationCurve();
 
@@ -53,10 +82,20 @@ public:
   int getFrameStart();
   void setFrameStart(int frame_number);
   int getFrameCount();
-  void setFrameCount(int frame_count);
+  bool setFrameCount(int frame_count);
   float getValue(float local_time);
   float getValue(int frame_number);
-  void setValue(int frame_number, float value);
+  bool setValue(int frame_number, float value);
+
+  // Replaces the per-frame values with interpolated keys, keeping every frame
+  // within tolerance of its original value.  The curve is left uncompressed
+  // if that would not save space.  Modifying the values of a compressed curve
+  // decompresses it.  These replace the curve data, so they fail and return
+  // false while an animation has the data locked.
+  bool compress(float tolerance);
+  bool decompress();
+  bool isCompressed();
+  bool isLocked();
 
 
   static KRAnimationCurve* Load(KRContext& context, const std::string& name, mimir::Block* data);
@@ -69,9 +108,14 @@ public:
 
   void _lockData();
   void _unlockData();
+  void _getSampler(Sampler& sampler);
+
+  // Returns the value at a fractional frame number
+  static float Sample(Sampler& sampler, float frame);
 
 private:
   mimir::Block* m_pData;
+  int m_lockCount;
 
   typedef struct
   {
@@ -81,5 +125,13 @@ private:
     int32_t frame_count;
   } animation_curve_header;
 
+  typedef struct
+  {
+    animation_curve_header header;
+    int32_t key_count;
+  } animation_curve_keys_header;
+
+  void replaceData(mimir::Block* data);
+
 };
 
@@ -409,7 +409,10 @@ KRMaterial::KRMaterial(KRContext& context, std::string name, mimir::Block* data)
 
 KRMaterial::~KRMaterial()
 {
-
+  KRMaterialManager* materialManager = getContext().getMaterialManager();
+  if (m_bindlessSlot != -1 && materialManager) {
+    materialManager->releaseMaterialSlot(m_bindlessSlot);
+  }
 }
 
 std::string KRMaterial::getExtension()
@@ -743,8 +746,12 @@ kraken_stream_level KRMaterial::getStreamLevel()
   return stream_level;
 }
 
-bool KRMaterial::bind(KRNode::RenderInfo& ri, ModelFormat modelFormat, __uint32_t vertexAttributes, CullMode cullMode, const std::vector<KRBone*>& bones, const std::vector<Matrix4>& bind_poses, const Matrix4& matModel, KRTexture* pLightMap, float lod_coverage)
+bool KRMaterial::bind(KRNode::RenderInfo& ri, ModelFormat modelFormat, __uint32_t vertexAttributes, CullMode cullMode, const std::vector<Matrix4>& bone_palette, const Matrix4& matModel, KRTexture* pLightMap, float lod_coverage)
 {
+  if (ri.renderPass->getType() == RENDER_PASS_TEXTURE_FEEDBACK) {
+    return bindFeedback(ri, modelFormat, vertexAttributes, cullMode, matModel);
+  }
+
   bool bLightMap = pLightMap && ri.camera->settings.bEnableLightMap;
 
   Vector2 default_scale = Vector2::One();
@@ -760,12 +767,21 @@ bool KRMaterial::bind(KRNode::RenderInfo& ri, ModelFormat modelFormat, __uint32_
 
   PipelineInfo info{};
   std::string shader_name("object");
+  if (bDiffuseMap && bone_palette.empty() && !bLightMap && m_baseColorMap.texture.get()->isVirtual()) {
+    // Virtual base color maps are sampled through their residency or
+    // indirection image, so only resident pages are read
+    shader_name = "object_virtual";
+  } else if (ri.camera->settings.bindless_enable && bone_palette.empty() && !bLightMap && updateBindlessRecord(ri.surface->m_deviceHandle)) {
+    // Where the device supports descriptor indexing, the material's textures and
+    // parameters are read from the bindless tables rather than per-draw descriptors
+    shader_name = "object_bindless";
+  }
   info.shader_name = &shader_name;
   info.pCamera = ri.camera;
   info.point_lights = &ri.point_lights;
   info.directional_lights = &ri.directional_lights;
   info.spot_lights = &ri.spot_lights;
-  info.bone_count = (int)bones.size();
+  info.bone_count = (int)bone_palette.size();
   info.renderPass = ri.renderPass;
   info.bDiffuseMap = bDiffuseMap;
   info.bNormalMap = bNormalMap;
@@ -792,39 +808,141 @@ bool KRMaterial::bind(KRNode::RenderInfo& ri, ModelFormat modelFormat, __uint32_
     return false;
   }
 
-  // Bind bones
+  // Bind bones.  The palette is calculated once per frame by the model.
   if (pShader->hasPushConstant(ShaderValue::bone_transforms)) {
-    float bone_mats[256 * 16];
-    float* bone_mat_component = bone_mats;
-    for (int bone_index = 0; bone_index < bones.size(); bone_index++) {
-      KRBone* bone = bones[bone_index];
-
-      //                Vector3 initialRotation = bone->getInitialLocalRotation();
-      //                Vector3 rotation = bone->getLocalRotation();
-      //                Vector3 initialTranslation = bone->getInitialLocalTranslation();
-      //                Vector3 translation = bone->getLocalTranslation();
-      //                Vector3 initialScale = bone->getInitialLocalScale();
-      //                Vector3 scale = bone->getLocalScale();
-      //                
-                  //printf("%s - delta rotation: %.4f %.4f %.4f\n", bone->getName().c_str(), (rotation.x - initialRotation.x) * 180.0 / M_PI, (rotation.y - initialRotation.y) * 180.0 / M_PI, (rotation.z - initialRotation.z) * 180.0 / M_PI);
-                  //printf("%s - delta translation: %.4f %.4f %.4f\n", bone->getName().c_str(), translation.x - initialTranslation.x, translation.y - initialTranslation.y, translation.z - initialTranslation.z);
-      //                printf("%s - delta scale: %.4f %.4f %.4f\n", bone->getName().c_str(), scale.x - initialScale.x, scale.y - initialScale.y, scale.z - initialScale.z);
-
-      Matrix4 skin_bone_bind_pose = bind_poses[bone_index];
-      Matrix4 active_mat = bone->getActivePoseMatrix();
-      Matrix4 inv_bind_mat = bone->getInverseBindPoseMatrix();
-      Matrix4 inv_bind_mat2 = Matrix4::Invert(bind_poses[bone_index]);
-      Matrix4 t = (inv_bind_mat * active_mat);
-      Matrix4 t2 = inv_bind_mat2 * bone->getModelMatrix();
-      for (int i = 0; i < 16; i++) {
-        *bone_mat_component++ = t[i];
-      }
+    pShader->setPushConstant(ShaderValue::bone_transforms, bone_palette.data(), bone_palette.size());
+  }
+
+  bool success = true;
+  ri.reflectedObjects.push_back(this);
+  if (!pShader->bind(ri, matModel)) {
+    success = false;
+  }
+  ri.reflectedObjects.pop_back();
+  return success;
+}
+
+namespace {
+Vector2 getMapDimensions(const KRMaterial::TextureMap& map)
+{
+  if (!map.texture.isBound()) {
+    return Vector2::Zero();
+  }
+  Vector3i dimensions = map.texture.get()->getDimensions();
+  return Vector2::Create((float)dimensions.x, (float)dimensions.y);
+}
+
+void setMapTransform(const KRMaterial::TextureMap& map, float* transform)
+{
+  transform[0] = map.scale.x;
+  transform[1] = map.scale.y;
+  transform[2] = map.offset.x;
+  transform[3] = map.offset.y;
+}
+
+int getBindlessTexture(KRTextureManager* textureManager, KrDeviceHandle deviceHandle, const KRMaterial::TextureMap& map)
+{
+  if (map.texture.isBound() && textureManager->updateBindlessSlot(deviceHandle, map.texture.get())) {
+    return map.texture.get()->getBindlessSlot();
+  }
+  // Maps that are not yet streamed in are not sampled
+  return -1;
+}
+} // anonymous namespace
+
+bool KRMaterial::updateBindlessRecord(KrDeviceHandle deviceHandle)
+{
+  KRTextureManager* textureManager = getContext().getTextureManager();
+  KRMaterialManager* materialManager = getContext().getMaterialManager();
+  if (textureManager->getBindlessLayout(deviceHandle) == VK_NULL_HANDLE) {
+    return false;
+  }
+
+  // Materials with maps that the bindless texture table can not hold, such as
+  // virtual textures, are drawn with per-draw descriptors
+  const TextureMap* maps[] = { &m_baseColorMap, &m_normalMap, &m_emissiveMap, &m_occlusionMap, &m_metalicRoughnessMap };
+  for (const TextureMap* map : maps) {
+    if (map->texture.isBound() && !textureManager->requestBindlessSlot(map->texture.get())) {
+      return false;
     }
-    if (pShader->hasPushConstant(ShaderValue::bone_transforms)) {
-      pShader->setPushConstant(ShaderValue::bone_transforms, (Matrix4*)bone_mats, bones.size());
+  }
+
+  if (m_bindlessSlot == -1) {
+    m_bindlessSlot = materialManager->requestMaterialSlot(this);
+    if (m_bindlessSlot == -1) {
+      return false;
     }
   }
 
+  KRMaterialManager::MaterialRecord* record = nullptr;
+  if (!materialManager->getMaterialRecord(deviceHandle, m_bindlessSlot, &record)) {
+    return false;
+  }
+  if (record == nullptr) {
+    // Already written for this frame
+    return true;
+  }
+
+  record->baseColorFactor[0] = m_baseColorFactor.x;
+  record->baseColorFactor[1] = m_baseColorFactor.y;
+  record->baseColorFactor[2] = m_baseColorFactor.z;
+  record->baseColorFactor[3] = m_baseColorFactor.w;
+  record->emissiveFactor[0] = m_emissiveFactor.x;
+  record->emissiveFactor[1] = m_emissiveFactor.y;
+  record->emissiveFactor[2] = m_emissiveFactor.z;
+  record->normalScale = m_normalScale;
+  record->metalicFactor = m_metalicFactor;
+  record->roughnessFactor = m_roughnessFactor;
+  record->occlusionStrength = m_occlusionStrength;
+  record->alphaCutoff = m_alphaCutoff;
+  setMapTransform(m_baseColorMap, record->baseColorTransform);
+  setMapTransform(m_normalMap, record->normalTransform);
+  setMapTransform(m_emissiveMap, record->emissiveTransform);
+  setMapTransform(m_occlusionMap, record->occlusionTransform);
+  setMapTransform(m_metalicRoughnessMap, record->metalicRoughnessTransform);
+  record->baseColorTexture = getBindlessTexture(textureManager, deviceHandle, m_baseColorMap);
+  record->normalTexture = getBindlessTexture(textureManager, deviceHandle, m_normalMap);
+  record->emissiveTexture = getBindlessTexture(textureManager, deviceHandle, m_emissiveMap);
+  record->occlusionTexture = getBindlessTexture(textureManager, deviceHandle, m_occlusionMap);
+  record->metalicRoughnessTexture = getBindlessTexture(textureManager, deviceHandle, m_metalicRoughnessMap);
+  record->alphaMode = (int32_t)m_alphaMode;
+  return true;
+}
+
+bool KRMaterial::bindFeedback(KRNode::RenderInfo& ri, ModelFormat modelFormat, __uint32_t vertexAttributes, CullMode cullMode, const Matrix4& matModel)
+{
+  // Only opaque surfaces are recorded, as the feedback pass does not write depth
+  if (m_alphaMode == KRMATERIAL_ALPHA_MODE_BLEND) {
+    return false;
+  }
+
+  KRTextureManager* textureManager = getContext().getTextureManager();
+  bool hasSlot = false;
+  if (m_baseColorMap.texture.isBound()) {
+    hasSlot |= textureManager->requestFeedbackSlot(m_baseColorMap.texture.get());
+  }
+  if (m_normalMap.texture.isBound()) {
+    hasSlot |= textureManager->requestFeedbackSlot(m_normalMap.texture.get());
+  }
+  VkDescriptorBufferInfo bufferInfo{};
+  if (!hasSlot || !textureManager->getFeedbackBuffer(ri.surface->m_deviceHandle, bufferInfo)) {
+    return false;
+  }
+
+  PipelineInfo info{};
+  std::string shader_name("texture_feedback");
+  info.shader_name = &shader_name;
+  info.pCamera = ri.camera;
+  info.renderPass = ri.renderPass;
+  info.rasterMode = RasterMode::kOpaqueNoDepthWrite;
+  info.modelFormat = modelFormat;
+  info.vertexAttributes = vertexAttributes;
+  info.cullMode = cullMode;
+  KRPipeline* pShader = getContext().getPipelineManager()->getPipeline(*ri.surface, info);
+  if (pShader == nullptr) {
+    return false;
+  }
+
   bool success = true;
   ri.reflectedObjects.push_back(this);
   if (!pShader->bind(ri, matModel)) {
@@ -834,6 +952,34 @@ bool KRMaterial::bind(KRNode::RenderInfo& ri, ModelFormat modelFormat, __uint32_
   return success;
 }
 
+bool KRMaterial::getShaderValue(ShaderValue value, int32_t* output) const
+{
+  switch (value) {
+    case ShaderValue::material_baseColor_map_feedback:
+      *output = m_baseColorMap.texture.isBound() ? m_baseColorMap.texture.get()->getFeedbackSlot() : -1;
+      return true;
+    case ShaderValue::material_normal_map_feedback:
+      *output = m_normalMap.texture.isBound() ? m_normalMap.texture.get()->getFeedbackSlot() : -1;
+      return true;
+    case ShaderValue::material_baseColor_map_regions:
+      // Virtual textures also record the level sampled in each region
+      *output = m_baseColorMap.texture.isBound() && m_baseColorMap.texture.get()->isVirtual() ? KRTexture::KRENGINE_TEXTURE_FEEDBACK_REGION_GRID : 0;
+      return true;
+    case ShaderValue::material_normal_map_regions:
+      *output = m_normalMap.texture.isBound() && m_normalMap.texture.get()->isVirtual() ? KRTexture::KRENGINE_TEXTURE_FEEDBACK_REGION_GRID : 0;
+      return true;
+    case ShaderValue::material_index:
+      *output = m_bindlessSlot;
+      return true;
+    case ShaderValue::material_baseColor_map_cached:
+      // Virtual textures sampled through a page cache rather than a sparse image
+      *output = m_baseColorMap.texture.isBound() && m_baseColorMap.texture.get()->isPageCached() ? 1 : 0;
+      return true;
+    default:
+      return false;
+  }
+}
+
 bool KRMaterial::getShaderValue(ShaderValue value, float* output) const
 {
   switch (value) {
@@ -948,6 +1094,12 @@ bool KRMaterial::getShaderValue(ShaderValue value, hydra::Vector2* output) const
     case ShaderValue::material_normal_map_offset:
       *output = m_normalMap.offset;
       return true;
+    case ShaderValue::material_baseColor_map_dimensions:
+      *output = getMapDimensions(m_baseColorMap);
+      return true;
+    case ShaderValue::material_normal_map_dimensions:
+      *output = getMapDimensions(m_normalMap);
+      return true;
     case ShaderValue::material_emissive_map_scale:
       *output = m_emissiveMap.scale;
       return true;
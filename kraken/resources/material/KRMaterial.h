@@ -130,7 +130,7 @@ public:
 
   bool isTransparent();
   
-  bool bind(KRNode::RenderInfo& ri, ModelFormat modelFormat, __uint32_t vertexAttributes, CullMode cullMode, const std::vector<KRBone*>& bones, const std::vector<hydra::Matrix4>& bind_poses, const hydra::Matrix4& matModel, KRTexture* pLightMap, float lod_coverage = 0.0f);
+  bool bind(KRNode::RenderInfo& ri, ModelFormat modelFormat, __uint32_t vertexAttributes, CullMode cullMode, const std::vector<hydra::Matrix4>& bone_palette, const hydra::Matrix4& matModel, KRTexture* pLightMap, float lod_coverage = 0.0f);
 
   bool needsVertexTangents();
 
@@ -183,6 +183,13 @@ public:
   float m_transmissionFactor = 0.f;
 
 private:
+  // Slot of the material in the bindless material table, or -1
+  int m_bindlessSlot{ -1 };
+  bool updateBindlessRecord(KrDeviceHandle deviceHandle);
+
+  bool bindFeedback(KRNode::RenderInfo& ri, ModelFormat modelFormat, __uint32_t vertexAttributes, CullMode cullMode, const hydra::Matrix4& matModel);
+
+  bool getShaderValue(ShaderValue value, int32_t* output) const final;
   bool getShaderValue(ShaderValue value, float* output) const final;
   bool getShaderValue(ShaderValue value, hydra::Vector2* output) const final;
   bool getShaderValue(ShaderValue value, hydra::Vector3* output) const final;
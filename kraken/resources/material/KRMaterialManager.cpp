@@ -31,6 +31,7 @@
 
 #include "KREngine-common.h"
 #include "KRMaterialManager.h"
+#include "KRContext.h"
 
 using namespace mimir;
 using namespace hydra;
@@ -43,7 +44,7 @@ KRMaterialManager::KRMaterialManager(KRContext& context, KRTextureManager* pText
 
 KRMaterialManager::~KRMaterialManager()
 {
-
+  destroyMaterialTables();
 }
 
 KRResource* KRMaterialManager::loadResource(const std::string& name, const std::string& extension, Block* data)
@@ -299,3 +300,192 @@ KRMaterial* KRMaterialManager::loadMtl(Block* data)
   delete data;
   return pMaterial;
 }
+
+int KRMaterialManager::requestMaterialSlot(KRMaterial* material)
+{
+  int slot;
+  if (!m_freeMaterialSlots.empty()) {
+    slot = m_freeMaterialSlots.back();
+    m_freeMaterialSlots.pop_back();
+  } else if ((int)m_bindlessMaterials.size() < KRENGINE_BINDLESS_MATERIAL_SLOTS) {
+    slot = (int)m_bindlessMaterials.size();
+    m_bindlessMaterials.push_back(nullptr);
+  } else {
+    return -1;
+  }
+  m_bindlessMaterials[slot] = material;
+  return slot;
+}
+
+void KRMaterialManager::releaseMaterialSlot(int slot)
+{
+  // Frames in flight read their own slices, so the slot can be written by
+  // another material immediately
+  m_bindlessMaterials[slot] = nullptr;
+  m_freeMaterialSlots.push_back(slot);
+  for (auto itr = m_materialTables.begin(); itr != m_materialTables.end(); itr++) {
+    (*itr).second.recordFrames[slot] = -1;
+  }
+}
+
+bool KRMaterialManager::getMaterialRecord(KrDeviceHandle deviceHandle, int slot, MaterialRecord** record)
+{
+  MaterialTable* table = getBindlessTable(deviceHandle);
+  if (table == nullptr) {
+    return false;
+  }
+  long current_frame = getContext().getCurrentFrame();
+  if (table->recordFrames[slot] == current_frame) {
+    *record = nullptr;
+    return true;
+  }
+  table->recordFrames[slot] = current_frame;
+  std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(deviceHandle);
+  __uint8_t* slice = table->data + device->getFrameIndex() * table->sliceSize;
+  *record = (MaterialRecord*)slice + slot;
+  return true;
+}
+
+VkDescriptorSetLayout KRMaterialManager::getMaterialTableLayout(KrDeviceHandle deviceHandle)
+{
+  MaterialTable* table = getBindlessTable(deviceHandle);
+  if (table == nullptr) {
+    return VK_NULL_HANDLE;
+  }
+  return table->layout;
+}
+
+bool KRMaterialManager::getMaterialTable(KrDeviceHandle deviceHandle, VkDescriptorSet& descriptorSet, uint32_t& offset)
+{
+  MaterialTable* table = getBindlessTable(deviceHandle);
+  if (table == nullptr) {
+    return false;
+  }
+  // Slices are selected by the device's frame in flight, whose fence has been waited on
+  std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(deviceHandle);
+  descriptorSet = table->descriptorSet;
+  offset = (uint32_t)(device->getFrameIndex() * table->sliceSize);
+  return true;
+}
+
+KRMaterialManager::MaterialTable* KRMaterialManager::getBindlessTable(KrDeviceHandle deviceHandle)
+{
+  auto itr = m_materialTables.find(deviceHandle);
+  if (itr != m_materialTables.end()) {
+    return &(*itr).second;
+  }
+
+  std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(deviceHandle);
+  if (!device->m_descriptorIndexing) {
+    // Bindless materials can not be drawn on this device
+    return nullptr;
+  }
+
+  MaterialTable table{};
+  // Each slice starts at an offset that can be bound dynamically
+  VkDeviceSize alignment = std::max(device->m_deviceProperties.limits.minStorageBufferOffsetAlignment, (VkDeviceSize)1);
+  table.sliceSize = KRENGINE_BINDLESS_MATERIAL_SLOTS * sizeof(MaterialRecord);
+  table.sliceSize = (table.sliceSize + alignment - 1) / alignment * alignment;
+
+  if (!device->createBuffer(
+    table.sliceSize * KRENGINE_MAX_FRAMES_IN_FLIGHT,
+    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+    &table.buffer,
+    &table.allocation
+#if KRENGINE_DEBUG_GPU_LABELS
+    , "Bindless Materials"
+#endif
+  )) {
+    KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Unable to allocate bindless material buffer.");
+    return nullptr;
+  }
+  if (vmaMapMemory(device->getAllocator(), table.allocation, (void**)&table.data) != VK_SUCCESS) {
+    vmaDestroyBuffer(device->getAllocator(), table.buffer, table.allocation);
+    KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Unable to map bindless material buffer.");
+    return nullptr;
+  }
+
+  VkDescriptorSetLayoutBinding binding{};
+  binding.binding = 0;
+  binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+  binding.descriptorCount = 1;
+  binding.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+
+  VkDescriptorSetLayoutCreateInfo layoutInfo{};
+  layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  layoutInfo.bindingCount = 1;
+  layoutInfo.pBindings = &binding;
+  if (vkCreateDescriptorSetLayout(device->m_logicalDevice, &layoutInfo, nullptr, &table.layout) != VK_SUCCESS) {
+    vmaUnmapMemory(device->getAllocator(), table.allocation);
+    vmaDestroyBuffer(device->getAllocator(), table.buffer, table.allocation);
+    KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Unable to create bindless material descriptor set layout.");
+    return nullptr;
+  }
+
+  VkDescriptorPoolSize poolSize{};
+  poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+  poolSize.descriptorCount = 1;
+
+  VkDescriptorPoolCreateInfo poolInfo{};
+  poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  poolInfo.poolSizeCount = 1;
+  poolInfo.pPoolSizes = &poolSize;
+  poolInfo.maxSets = 1;
+  if (vkCreateDescriptorPool(device->m_logicalDevice, &poolInfo, nullptr, &table.pool) != VK_SUCCESS) {
+    vkDestroyDescriptorSetLayout(device->m_logicalDevice, table.layout, nullptr);
+    vmaUnmapMemory(device->getAllocator(), table.allocation);
+    vmaDestroyBuffer(device->getAllocator(), table.buffer, table.allocation);
+    KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Unable to create bindless material descriptor pool.");
+    return nullptr;
+  }
+
+  VkDescriptorSetAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  allocInfo.descriptorPool = table.pool;
+  allocInfo.descriptorSetCount = 1;
+  allocInfo.pSetLayouts = &table.layout;
+  if (vkAllocateDescriptorSets(device->m_logicalDevice, &allocInfo, &table.descriptorSet) != VK_SUCCESS) {
+    vkDestroyDescriptorPool(device->m_logicalDevice, table.pool, nullptr);
+    vkDestroyDescriptorSetLayout(device->m_logicalDevice, table.layout, nullptr);
+    vmaUnmapMemory(device->getAllocator(), table.allocation);
+    vmaDestroyBuffer(device->getAllocator(), table.buffer, table.allocation);
+    KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Unable to allocate bindless material descriptor set.");
+    return nullptr;
+  }
+
+  // The set is written once; draws select this frame's slice with a dynamic offset
+  VkDescriptorBufferInfo bufferInfo{};
+  bufferInfo.buffer = table.buffer;
+  bufferInfo.offset = 0;
+  bufferInfo.range = table.sliceSize;
+
+  VkWriteDescriptorSet descriptorWrite{};
+  descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+  descriptorWrite.dstSet = table.descriptorSet;
+  descriptorWrite.dstBinding = 0;
+  descriptorWrite.dstArrayElement = 0;
+  descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+  descriptorWrite.descriptorCount = 1;
+  descriptorWrite.pBufferInfo = &bufferInfo;
+  vkUpdateDescriptorSets(device->m_logicalDevice, 1, &descriptorWrite, 0, nullptr);
+
+  table.recordFrames.resize(KRENGINE_BINDLESS_MATERIAL_SLOTS, -1);
+  itr = m_materialTables.insert(std::pair<KrDeviceHandle, MaterialTable>(deviceHandle, table)).first;
+  return &(*itr).second;
+}
+
+void KRMaterialManager::destroyMaterialTables()
+{
+  for (auto itr = m_materialTables.begin(); itr != m_materialTables.end(); itr++) {
+    MaterialTable& table = (*itr).second;
+    std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice((*itr).first);
+    // TODO - Validate that device has not been lost
+    vkDestroyDescriptorPool(device->m_logicalDevice, table.pool, nullptr);
+    vkDestroyDescriptorSetLayout(device->m_logicalDevice, table.layout, nullptr);
+    VmaAllocator allocator = device->getAllocator();
+    vmaUnmapMemory(allocator, table.allocation);
+    vmaDestroyBuffer(allocator, table.buffer, table.allocation);
+  }
+  m_materialTables.clear();
+}
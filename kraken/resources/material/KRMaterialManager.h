@@ -58,9 +58,70 @@ public:
 
   unordered_map<std::string, KRMaterial*>& getMaterials();
 
+  // Bindless materials: the parameters of each material drawn with the bindless
+  // texture table are written to a record in a host visible storage buffer, at a
+  // slot that is stable for the life of the material.  The buffer is bound to
+  // descriptor set KRENGINE_BINDLESS_MATERIAL_SET, with a dynamic offset selecting
+  // the slice of the frame being recorded.
+  static const int KRENGINE_BINDLESS_MATERIAL_SLOTS = 4096;
+  static const uint32_t KRENGINE_BINDLESS_MATERIAL_SET = 2;
+
+  // Matches the std430 layout of struct Material in object_bindless.frag
+  struct MaterialRecord
+  {
+    float baseColorFactor[4];
+    float emissiveFactor[3];
+    float normalScale;
+    float metalicFactor;
+    float roughnessFactor;
+    float occlusionStrength;
+    float alphaCutoff;
+    // Scale in xy and offset in zw, for each map
+    float baseColorTransform[4];
+    float normalTransform[4];
+    float emissiveTransform[4];
+    float occlusionTransform[4];
+    float metalicRoughnessTransform[4];
+    // Slots in the bindless texture table, or -1 for unbound maps
+    int32_t baseColorTexture;
+    int32_t normalTexture;
+    int32_t emissiveTexture;
+    int32_t occlusionTexture;
+    int32_t metalicRoughnessTexture;
+    int32_t alphaMode;
+    int32_t padding[2];
+  };
+
+  int requestMaterialSlot(KRMaterial* material);
+  void releaseMaterialSlot(int slot);
+  // Returns the slot's record in this frame's slice, or nullptr in record if it
+  // has already been written this frame
+  bool getMaterialRecord(KrDeviceHandle deviceHandle, int slot, MaterialRecord** record);
+  VkDescriptorSetLayout getMaterialTableLayout(KrDeviceHandle deviceHandle);
+  bool getMaterialTable(KrDeviceHandle deviceHandle, VkDescriptorSet& descriptorSet, uint32_t& offset);
+
 private:
   unordered_map<std::string, KRMaterial*> m_materials;
   KRTextureManager* m_pTextureManager;
   KRPipelineManager* m_pPipelineManager;
 
+  struct MaterialTable
+  {
+    VkBuffer buffer;
+    VmaAllocation allocation;
+    __uint8_t* data;
+    VkDeviceSize sliceSize;
+    VkDescriptorSetLayout layout;
+    VkDescriptorPool pool;
+    VkDescriptorSet descriptorSet;
+    // Frame in which each slot was last written
+    std::vector<long> recordFrames;
+  };
+  unordered_map<KrDeviceHandle, MaterialTable> m_materialTables;
+  std::vector<KRMaterial*> m_bindlessMaterials;
+  std::vector<int> m_freeMaterialSlots;
+
+  MaterialTable* getBindlessTable(KrDeviceHandle deviceHandle);
+  void destroyMaterialTables();
+
 };
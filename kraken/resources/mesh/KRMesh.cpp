@@ -38,6 +38,7 @@
 #include "KRPipelineManager.h"
 #include "KRContext.h"
 #include "KRRenderPass.h"
+#include "KRThreadPool.h"
 #include "../3rdparty/forsyth/forsyth.h"
 
 using namespace mimir;
@@ -51,6 +52,7 @@ KRMesh::KRMesh(KRContext& context, std::string name) : KRResource(context, name)
   m_pData = NULL;
   m_pMetaData = NULL;
   m_pIndexBaseData = NULL;
+  m_pMeshletData = NULL;
   m_constant = false;
 }
 
@@ -62,6 +64,7 @@ KRMesh::KRMesh(KRContext& context, std::string name, Block* data) : KRResource(c
   m_pData = NULL;
   m_pMetaData = NULL;
   m_pIndexBaseData = NULL;
+  m_pMeshletData = NULL;
   m_constant = false;
 
   loadPack(data);
@@ -104,6 +107,11 @@ void KRMesh::releaseData()
 {
   m_hasTransparency = false;
   m_submeshes.clear();
+  if (m_pMeshletData) {
+    m_pMeshletData->unlock();
+    delete m_pMeshletData;
+    m_pMeshletData = NULL;
+  }
   if (m_pIndexBaseData) {
     m_pIndexBaseData->unlock();
     delete m_pIndexBaseData;
@@ -147,9 +155,14 @@ void KRMesh::loadPack(Block* data)
   m_pMetaData = m_pData->getSubBlock(0, sizeof(pack_header) + sizeof(pack_material) * ph.submesh_count + sizeof(pack_bone) * ph.bone_count);
   m_pMetaData->lock();
 
-  m_pIndexBaseData = m_pData->getSubBlock(sizeof(pack_header) + sizeof(pack_material) * ph.submesh_count + sizeof(pack_bone) * ph.bone_count + KRALIGN(2 * ph.index_count), ph.index_base_count * 8);
+  m_pIndexBaseData = m_pData->getSubBlock(sizeof(pack_header) + sizeof(pack_material) * ph.submesh_count + sizeof(pack_bone) * ph.bone_count + KRALIGN(IndexSize(ph) * ph.index_count), ph.index_base_count * 8);
   m_pIndexBaseData->lock();
 
+  if (ph.meshlet_count > 0) {
+    m_pMeshletData = m_pData->getSubBlock(MeshletDataOffset(ph), sizeof(pack_meshlet) * ph.meshlet_count);
+    m_pMeshletData->lock();
+  }
+
   m_extents = ph.extents;
 
   updateAttributeOffsets();
@@ -232,7 +245,7 @@ kraken_stream_level KRMesh::getStreamLevel()
 }
 
 
-void KRMesh::render(KRNode::RenderInfo& ri, const std::string& object_name, const Matrix4& matModel, KRTexture* pLightMap, const std::vector<KRBone*>& bones, float lod_coverage)
+void KRMesh::render(KRNode::RenderInfo& ri, const std::string& object_name, const Matrix4& matModel, KRTexture* pLightMap, const std::vector<Matrix4>& bone_palette, float lod_coverage, SkinnedVertices* skinned)
 {
   //fprintf(stderr, "Rendering model: %s\n", m_name.c_str());
   if (ri.renderPass->getType() != RenderPassType::RENDER_PASS_ADDITIVE_PARTICLES && ri.renderPass->getType() != RenderPassType::RENDER_PASS_PARTICLE_OCCLUSION && ri.renderPass->getType() != RenderPassType::RENDER_PASS_VOLUMETRIC_EFFECTS_ADDITIVE) {
@@ -240,13 +253,26 @@ void KRMesh::render(KRNode::RenderInfo& ri, const std::string& object_name, cons
       getSubmeshes();
       getMaterials();
 
+      // Quantized positions are transformed back to model space by the pipeline
+      Matrix4 matVertexModel = getPositionDequantization() * matModel;
+
+      // Meshlet bounds are in model space, so skinned meshes are drawn whole
+      bool cull_meshlets = m_pMeshletData != NULL && skinned == nullptr && bone_palette.empty();
+      auto renderSubmeshCulled = [&](int iSubmesh, const std::string& material_name, bool cull_backfaces) {
+        if (cull_meshlets) {
+          renderSubmeshMeshlets(ri, iSubmesh, object_name, material_name, matModel, cull_backfaces, lod_coverage);
+        } else {
+          renderSubmesh(ri.commandBuffer, iSubmesh, ri.renderPass, object_name, material_name, lod_coverage, skinned);
+        }
+      };
+
       int cSubmeshes = (int)m_submeshes.size();
       if (ri.renderPass->getType() == RenderPassType::RENDER_PASS_SHADOWMAP) {
         for (int iSubmesh = 0; iSubmesh < cSubmeshes; iSubmesh++) {
           KRMaterial* pMaterial = m_materials[iSubmesh].get();
           if (pMaterial && !pMaterial->isTransparent()) {
             // Exclude transparent and semi-transparent meshes from shadow maps
-            renderSubmesh(ri.commandBuffer, iSubmesh, ri.renderPass, object_name, pMaterial->getName(), lod_coverage);
+            renderSubmeshCulled(iSubmesh, pMaterial->getName(), false);
           }
         }
       } else {
@@ -255,17 +281,12 @@ void KRMesh::render(KRNode::RenderInfo& ri, const std::string& object_name, cons
 
           if (pMaterial) {
             if ((!pMaterial->isTransparent() && ri.renderPass->getType() != RenderPassType::RENDER_PASS_FORWARD_TRANSPARENT) || (pMaterial->isTransparent() && ri.renderPass->getType() == RenderPassType::RENDER_PASS_FORWARD_TRANSPARENT)) {
-              std::vector<Matrix4> bone_bind_poses;
-              for (int i = 0; i < (int)bones.size(); i++) {
-                bone_bind_poses.push_back(getBoneBindPose(i)); 
-              }
-
               switch (pMaterial->getAlphaMode()) {
               case KRMaterial::KRMATERIAL_ALPHA_MODE_OPAQUE: // Non-transparent materials
               case KRMaterial::KRMATERIAL_ALPHA_MODE_TEST: // Alpha in diffuse texture is interpreted as punch-through when < 0.5
-                if (pMaterial->bind(ri, getModelFormat(), getVertexAttributes(), CullMode::kCullBack, bones, bone_bind_poses, matModel, pLightMap, lod_coverage))
+                if (pMaterial->bind(ri, getModelFormat(), getVertexAttributes(), CullMode::kCullBack, bone_palette, matVertexModel, pLightMap, lod_coverage))
                 {
-                  renderSubmesh(ri.commandBuffer, iSubmesh, ri.renderPass, object_name, pMaterial->getName(), lod_coverage);
+                  renderSubmeshCulled(iSubmesh, pMaterial->getName(), true);
                 }
                 break;
               case KRMaterial::KRMATERIAL_ALPHA_MODE_BLEND: // Blended Alpha
@@ -273,16 +294,16 @@ void KRMesh::render(KRNode::RenderInfo& ri, const std::string& object_name, cons
                   // Blended alpha rendered in two passes.  First pass renders backfaces; second pass renders frontfaces.
                   // 
                   // Render back faces before front faces
-                  if (pMaterial->bind(ri, getModelFormat(), getVertexAttributes(), CullMode::kCullFront, bones, bone_bind_poses, matModel, pLightMap, lod_coverage))
+                  if (pMaterial->bind(ri, getModelFormat(), getVertexAttributes(), CullMode::kCullFront, bone_palette, matVertexModel, pLightMap, lod_coverage))
                   {
-                    renderSubmesh(ri.commandBuffer, iSubmesh, ri.renderPass, object_name, pMaterial->getName(), lod_coverage);
+                    renderSubmeshCulled(iSubmesh, pMaterial->getName(), false);
                   }
                 }
 
                 // Render front faces
-                if (pMaterial->bind(ri, getModelFormat(), getVertexAttributes(), CullMode::kCullBack, bones, bone_bind_poses, matModel, pLightMap, lod_coverage))
+                if (pMaterial->bind(ri, getModelFormat(), getVertexAttributes(), CullMode::kCullBack, bone_palette, matVertexModel, pLightMap, lod_coverage))
                 {
-                  renderSubmesh(ri.commandBuffer, iSubmesh, ri.renderPass, object_name, pMaterial->getName(), lod_coverage);
+                  renderSubmeshCulled(iSubmesh, pMaterial->getName(), true);
                 }
                 break;
               }
@@ -326,6 +347,17 @@ void KRMesh::getSubmeshes()
       strncpy(mesh.szMaterialName, pPackMaterial->szName, KRENGINE_MAX_NAME_LENGTH);
       mesh.szMaterialName[KRENGINE_MAX_NAME_LENGTH - 1] = '\0';
       //fprintf(stderr, "Submesh material: \"%s\"\n", mesh->szMaterialName);
+      mesh.first_meshlet = 0;
+      mesh.meshlet_count = 0;
+    }
+
+    pack_meshlet* meshlets = getMeshlets();
+    for (int iMeshlet = 0; iMeshlet < pHeader->meshlet_count; iMeshlet++) {
+      Submesh& mesh = m_submeshes[meshlets[iMeshlet].submesh];
+      if (mesh.meshlet_count == 0) {
+        mesh.first_meshlet = iMeshlet;
+      }
+      mesh.meshlet_count++;
     }
     createDataBlocks(m_constant ? KRMeshManager::KRVBOData::CONSTANT : KRMeshManager::KRVBOData::STREAMING);
   }
@@ -356,8 +388,8 @@ void KRMesh::createDataBlocks(KRMeshManager::KRVBOData::vbo_type t)
 
         if ((int)mesh.vertex_data_blocks.size() <= vbo_index) {
           Block* vertex_data_block = m_pData->getSubBlock(vertex_data_offset + start_vertex_offset * m_vertex_size, vertex_count * m_vertex_size);
-          Block* index_data_block = m_pData->getSubBlock(index_data_offset + start_index_offset * 2, index_count * 2);
-          mesh.vbo_data_blocks.emplace_back(std::make_shared<KRMeshManager::KRVBOData>(getContext().getMeshManager(), vertex_data_block, index_data_block, vertex_attrib_flags, true, t
+          Block* index_data_block = m_pData->getSubBlock(index_data_offset + start_index_offset * getIndexSize(), index_count * getIndexSize());
+          mesh.vbo_data_blocks.emplace_back(std::make_shared<KRMeshManager::KRVBOData>(getContext().getMeshManager(), vertex_data_block, index_data_block, getIndexType(), vertex_attrib_flags, true, t
 #if KRENGINE_DEBUG_GPU_LABELS
             , m_lodBaseName.c_str()
 #endif
@@ -386,7 +418,7 @@ void KRMesh::createDataBlocks(KRMeshManager::KRVBOData::vbo_type t)
         if ((int)mesh.vertex_data_blocks.size() <= vbo_index) {
           Block* index_data_block = NULL;
           Block* vertex_data_block = m_pData->getSubBlock(vertex_data_offset + iBuffer * MAX_VBO_SIZE * vertex_size, vertex_size * cBufferVertexes);
-          mesh.vbo_data_blocks.emplace_back(std::make_shared<KRMeshManager::KRVBOData>(getContext().getMeshManager(), vertex_data_block, index_data_block, vertex_attrib_flags, true, t
+          mesh.vbo_data_blocks.emplace_back(std::make_shared<KRMeshManager::KRVBOData>(getContext().getMeshManager(), vertex_data_block, index_data_block, getIndexType(), vertex_attrib_flags, true, t
 #if KRENGINE_DEBUG_GPU_LABELS
             , m_lodBaseName.c_str()
 #endif
@@ -420,6 +452,330 @@ void KRMesh::renderNoMaterials(VkCommandBuffer& commandBuffer, const KRRenderPas
   }
 }
 
+void KRMesh::renderSubmeshMeshlets(KRNode::RenderInfo& ri, int iSubmesh, const std::string& object_name, const std::string& material_name, const Matrix4& matModel, bool cullBackfaces, float lodCoverage)
+{
+  getSubmeshes();
+
+  Submesh& mesh = m_submeshes[iSubmesh];
+  pack_meshlet* meshlets = getMeshlets() + mesh.first_meshlet;
+
+  // Bounding spheres are scaled by the largest axis scale of the model matrix
+  float scale = sqrtf(std::max(std::max(
+    Matrix4::DotNoTranslate(matModel, Vector3::Create(1.0f, 0.0f, 0.0f)).sqrMagnitude(),
+    Matrix4::DotNoTranslate(matModel, Vector3::Create(0.0f, 1.0f, 0.0f)).sqrMagnitude()),
+    Matrix4::DotNoTranslate(matModel, Vector3::Create(0.0f, 0.0f, 1.0f)).sqrMagnitude()));
+  const Vector3& camera_position = ri.viewport->getCameraPosition();
+
+  // Visible meshlets that are adjacent in the index buffer are merged into a single draw
+  int bound_vbo = -1;
+  int draw_first_index = 0;
+  int draw_index_count = 0;
+  auto flush = [&]() {
+    if (draw_index_count > 0) {
+      vkCmdDrawIndexed(ri.commandBuffer, draw_index_count, 1, draw_first_index, 0, 0);
+      m_pContext->getMeshManager()->log_draw_call(ri.renderPass->getType(), object_name, material_name, draw_index_count);
+      draw_index_count = 0;
+    }
+  };
+
+  for (int iMeshlet = 0; iMeshlet < mesh.meshlet_count; iMeshlet++) {
+    const pack_meshlet& meshlet = meshlets[iMeshlet];
+
+    Vector3 center = Matrix4::Dot(matModel, meshlet.center);
+    float radius = meshlet.radius * scale;
+    Vector3 extent = Vector3::Create(radius, radius, radius);
+    if (!ri.viewport->visible(AABB::Create(center - extent, center + extent))) {
+      continue;
+    }
+    if (cullBackfaces && meshlet.cone_cutoff < 1.0f) {
+      Vector3 cone_axis = Vector3::Normalize(Matrix4::DotNoTranslate(matModel, meshlet.cone_axis));
+      Vector3 view = center - camera_position;
+      if (Vector3::Dot(view, cone_axis) >= meshlet.cone_cutoff * view.magnitude() + radius) {
+        continue;
+      }
+    }
+
+    if (meshlet.vbo_index != bound_vbo) {
+      flush();
+      KRMeshManager::KRVBOData& vbo_data_block = *mesh.vbo_data_blocks[meshlet.vbo_index];
+      assert(vbo_data_block.isVBOReady());
+      m_pContext->getMeshManager()->bindVBO(ri.commandBuffer, &vbo_data_block, lodCoverage);
+      bound_vbo = meshlet.vbo_index;
+    }
+    if (draw_index_count > 0 && draw_first_index + draw_index_count == meshlet.first_index) {
+      draw_index_count += meshlet.index_count;
+    } else {
+      flush();
+      draw_first_index = meshlet.first_index;
+      draw_index_count = meshlet.index_count;
+    }
+  }
+  flush();
+}
+
+void KRMesh::buildMeshlets()
+{
+  const int kMaxMeshletVertices = 64;
+  const int kMaxMeshletTriangles = 124;
+
+  m_pData->lock();
+
+  pack_header* header = getHeader();
+  bool has_normals = has_vertex_attribute(KRENGINE_ATTRIB_NORMAL) || has_vertex_attribute(KRENGINE_ATTRIB_NORMAL_SHORT);
+  int index_size = getIndexSize();
+  unsigned char* index_data = (unsigned char*)getIndexData();
+  auto getIndex = [&](int index) -> int {
+    if (index_size == 4) {
+      return (int)((__uint32_t*)index_data)[index];
+    }
+    return (int)((__uint16_t*)index_data)[index];
+  };
+
+  std::vector<pack_meshlet> meshlets;
+  std::vector<int> meshlet_vertices;
+  std::vector<Vector3> meshlet_normals; // One per triangle
+
+  // Completes the meshlet covering the indexes from first_index up to, but not including, end_index
+  auto addMeshlet = [&](int submesh, int vbo_index, int first_index, int end_index) {
+    pack_meshlet& meshlet = meshlets.emplace_back();
+    memset(&meshlet, 0, sizeof(pack_meshlet));
+    meshlet.submesh = submesh;
+    meshlet.vbo_index = vbo_index;
+    meshlet.first_index = first_index;
+    meshlet.index_count = end_index - first_index;
+
+    AABB bounds = AABB::Create(getVertexPosition(meshlet_vertices[0]), getVertexPosition(meshlet_vertices[0]));
+    for (int vertex : meshlet_vertices) {
+      bounds.encapsulate(getVertexPosition(vertex));
+    }
+    meshlet.center = bounds.center();
+    meshlet.radius = 0.0f;
+    for (int vertex : meshlet_vertices) {
+      meshlet.radius = std::max(meshlet.radius, (getVertexPosition(vertex) - meshlet.center).magnitude());
+    }
+
+    // The cone contains the normals of all of the meshlet's triangles.  Meshlets whose
+    // triangles face too many directions are never culled as backfacing.
+    meshlet.cone_axis = Vector3::Zero();
+    meshlet.cone_cutoff = 1.0f;
+    if (has_normals) {
+      for (const Vector3& normal : meshlet_normals) {
+        meshlet.cone_axis += normal;
+      }
+      if (meshlet.cone_axis.sqrMagnitude() > 0.0f) {
+        meshlet.cone_axis.normalize();
+        float min_dot = 1.0f;
+        for (const Vector3& normal : meshlet_normals) {
+          min_dot = std::min(min_dot, Vector3::Dot(normal, meshlet.cone_axis));
+        }
+        if (min_dot > 0.1f) {
+          meshlet.cone_cutoff = sqrtf(1.0f - min_dot * min_dot);
+        }
+      }
+    }
+    meshlet_vertices.clear();
+    meshlet_normals.clear();
+  };
+
+  for (int iSubmesh = 0; iSubmesh < header->submesh_count; iSubmesh++) {
+    int cVertexes = getSubmesh(iSubmesh)->vertex_count;
+    int index_group = getSubmesh(iSubmesh)->index_group;
+    int index_group_offset = getSubmesh(iSubmesh)->index_group_offset;
+    int vbo_index = 0;
+    while (cVertexes > 0) {
+      int start_index_offset, start_vertex_offset, index_count, vertex_count;
+      getIndexedRange(index_group++, start_index_offset, start_vertex_offset, index_count, vertex_count);
+
+      int draw_count = cVertexes;
+      if (draw_count > index_count - index_group_offset) draw_count = index_count - index_group_offset;
+
+      // Greedily add triangles in index order until the meshlet is full, keeping
+      // each meshlet a contiguous range of the index buffer
+      int first_index = index_group_offset;
+      int end_index = index_group_offset + draw_count - draw_count % 3;
+      for (int index = first_index; index < end_index; index += 3) {
+        int triangle[3];
+        int new_vertex_count = 0;
+        for (int i = 0; i < 3; i++) {
+          triangle[i] = getIndex(start_index_offset + index + i) + start_vertex_offset;
+          if (std::find(meshlet_vertices.begin(), meshlet_vertices.end(), triangle[i]) == meshlet_vertices.end()) {
+            new_vertex_count++;
+          }
+        }
+        if ((int)meshlet_vertices.size() + new_vertex_count > kMaxMeshletVertices || (int)meshlet_normals.size() == kMaxMeshletTriangles) {
+          addMeshlet(iSubmesh, vbo_index, first_index, index);
+          first_index = index;
+        }
+        for (int i = 0; i < 3; i++) {
+          if (std::find(meshlet_vertices.begin(), meshlet_vertices.end(), triangle[i]) == meshlet_vertices.end()) {
+            meshlet_vertices.push_back(triangle[i]);
+          }
+        }
+
+        // The face normal is oriented to agree with the vertex normals, rather than relying on winding order
+        Vector3 p0 = getVertexPosition(triangle[0]);
+        Vector3 normal = Vector3::Cross(getVertexPosition(triangle[1]) - p0, getVertexPosition(triangle[2]) - p0);
+        if (normal.sqrMagnitude() > 0.0f) {
+          normal.normalize();
+          if (has_normals && Vector3::Dot(normal, getVertexNormal(triangle[0]) + getVertexNormal(triangle[1]) + getVertexNormal(triangle[2])) < 0.0f) {
+            normal = -normal;
+          }
+        }
+        meshlet_normals.push_back(normal);
+      }
+      if (!meshlet_normals.empty()) {
+        addMeshlet(iSubmesh, vbo_index, first_index, end_index);
+      }
+
+      cVertexes -= draw_count;
+      index_group_offset = 0;
+      vbo_index++;
+    }
+  }
+
+  // Rebuild the pack with the meshlets appended
+  pack_header ph = *header;
+  ph.meshlet_count = (__int32_t)meshlets.size();
+  size_t meshlet_data_offset = MeshletDataOffset(ph);
+  Block* data = new Block();
+  data->expand(meshlet_data_offset + sizeof(pack_meshlet) * meshlets.size());
+  data->lock();
+  memset(data->getStart(), 0, meshlet_data_offset);
+  m_pData->copy(data->getStart(), 0, std::min(meshlet_data_offset, (size_t)m_pData->getSize()));
+  memcpy(data->getStart(), &ph, sizeof(ph));
+  memcpy((unsigned char*)data->getStart() + meshlet_data_offset, meshlets.data(), sizeof(pack_meshlet) * meshlets.size());
+  data->unlock();
+  m_pData->unlock();
+
+  loadPack(data);
+}
+
+KRMesh::SkinnedVertices::SkinnedVertices()
+  : mesh(nullptr)
+  , deviceHandle(0)
+  , frame(-1)
+  , frameIndex(0)
+{
+}
+
+KRMesh::SkinnedVertices::~SkinnedVertices()
+{
+  if (mesh == nullptr) {
+    return;
+  }
+  KRMeshManager* meshManager = mesh->getContext().getMeshManager();
+  for (int i = 0; i < KRENGINE_MAX_FRAMES_IN_FLIGHT; i++) {
+    for (vector<KRMeshManager::SkinnedBuffer>& submesh_buffers : buffers[i]) {
+      for (KRMeshManager::SkinnedBuffer& buffer : submesh_buffers) {
+        meshManager->releaseSkinnedBuffer(deviceHandle, buffer);
+      }
+    }
+  }
+}
+
+bool KRMesh::canSkin() const
+{
+  // Packed normals and tangents are skinned in place, as they are normalized.
+  // Packed positions are not, as the skinned positions may fall outside of the
+  // range of the packed format.
+  return has_vertex_attribute(KRENGINE_ATTRIB_VERTEX)
+    && has_vertex_attribute(KRENGINE_ATTRIB_BONEINDEXES)
+    && (has_vertex_attribute(KRENGINE_ATTRIB_BONEWEIGHTS) || has_vertex_attribute(KRENGINE_ATTRIB_BONEWEIGHTS_BYTE));
+}
+
+bool KRMesh::initSkinnedVertices(KrDeviceHandle deviceHandle, SkinnedVertices& skinned)
+{
+  assert(skinned.mesh == nullptr);
+  getSubmeshes();
+
+  skinned.mesh = this;
+  skinned.deviceHandle = deviceHandle;
+  KRMeshManager* meshManager = getContext().getMeshManager();
+  for (int frameIndex = 0; frameIndex < KRENGINE_MAX_FRAMES_IN_FLIGHT; frameIndex++) {
+    for (Submesh& mesh : m_submeshes) {
+      vector<KRMeshManager::SkinnedBuffer>& submesh_buffers = skinned.buffers[frameIndex].emplace_back();
+      for (shared_ptr<KRMeshManager::KRVBOData>& vbo_data_block : mesh.vbo_data_blocks) {
+        KRMeshManager::SkinnedBuffer buffer{};
+        if (!meshManager->createSkinnedBuffer(deviceHandle, vbo_data_block->m_data->getSize(), buffer)) {
+          KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Unable to allocate skinned vertices for mesh: %s", m_lodBaseName.c_str());
+          return false;
+        }
+        submesh_buffers.push_back(buffer);
+      }
+    }
+  }
+  return true;
+}
+
+bool KRMesh::skin(const std::vector<Matrix4>& bone_palette, float lod_coverage, SkinnedVertices& skinned)
+{
+  assert(skinned.mesh == this);
+  KRMeshManager* meshManager = getContext().getMeshManager();
+  std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(skinned.deviceHandle);
+  int frameIndex = device->getFrameIndex();
+
+  VkDescriptorBufferInfo paletteInfo{};
+  if (!meshManager->skinningUploadPalette(skinned.deviceHandle, bone_palette, paletteInfo)) {
+    return false;
+  }
+
+  KRMeshManager::SkinningConstants constants{};
+  constants.vertex_stride = m_vertex_size / sizeof(uint32_t);
+  constants.position_offset = m_vertex_attribute_offset[KRENGINE_ATTRIB_VERTEX] / (int)sizeof(uint32_t);
+  constants.normal_offset = -1;
+  constants.tangent_offset = -1;
+  if (has_vertex_attribute(KRENGINE_ATTRIB_NORMAL)) {
+    constants.normal_offset = m_vertex_attribute_offset[KRENGINE_ATTRIB_NORMAL] / (int)sizeof(uint32_t);
+  } else if (has_vertex_attribute(KRENGINE_ATTRIB_NORMAL_SHORT)) {
+    constants.normal_offset = m_vertex_attribute_offset[KRENGINE_ATTRIB_NORMAL_SHORT] / (int)sizeof(uint32_t);
+    constants.flags |= KRMeshManager::SKINNING_NORMAL_SHORT;
+  }
+  if (has_vertex_attribute(KRENGINE_ATTRIB_TANGENT)) {
+    constants.tangent_offset = m_vertex_attribute_offset[KRENGINE_ATTRIB_TANGENT] / (int)sizeof(uint32_t);
+  } else if (has_vertex_attribute(KRENGINE_ATTRIB_TANGENT_SHORT)) {
+    constants.tangent_offset = m_vertex_attribute_offset[KRENGINE_ATTRIB_TANGENT_SHORT] / (int)sizeof(uint32_t);
+    constants.flags |= KRMeshManager::SKINNING_TANGENT_SHORT;
+  } else if (has_vertex_attribute(KRENGINE_ATTRIB_TANGENT_BYTE)) {
+    constants.tangent_offset = m_vertex_attribute_offset[KRENGINE_ATTRIB_TANGENT_BYTE] / (int)sizeof(uint32_t);
+    constants.flags |= KRMeshManager::SKINNING_TANGENT_BYTE;
+  }
+  constants.bone_index_offset = m_vertex_attribute_offset[KRENGINE_ATTRIB_BONEINDEXES] / (int)sizeof(uint32_t);
+  if (has_vertex_attribute(KRENGINE_ATTRIB_BONEWEIGHTS)) {
+    constants.bone_weight_offset = m_vertex_attribute_offset[KRENGINE_ATTRIB_BONEWEIGHTS] / (int)sizeof(uint32_t);
+  } else {
+    constants.bone_weight_offset = m_vertex_attribute_offset[KRENGINE_ATTRIB_BONEWEIGHTS_BYTE] / (int)sizeof(uint32_t);
+    constants.flags |= KRMeshManager::SKINNING_BONEWEIGHTS_BYTE;
+  }
+  constants.bone_count = (uint32_t)bone_palette.size();
+
+  for (size_t iSubmesh = 0; iSubmesh < m_submeshes.size(); iSubmesh++) {
+    Submesh& mesh = m_submeshes[iSubmesh];
+    for (size_t i = 0; i < mesh.vbo_data_blocks.size(); i++) {
+      KRMeshManager::KRVBOData& vbo_data_block = *mesh.vbo_data_blocks[i];
+      const KRMeshManager::SkinnedBuffer& buffer = skinned.buffers[frameIndex][iSubmesh][i];
+      vbo_data_block.requestResidency(lod_coverage);
+      constants.vertex_count = (uint32_t)(buffer.size / m_vertex_size);
+      if (!meshManager->skinningDispatch(skinned.deviceHandle, vbo_data_block.getVertexBuffer(), buffer, paletteInfo, constants)) {
+        return false;
+      }
+    }
+  }
+  skinned.frameIndex = frameIndex;
+  return true;
+}
+
+void KRMesh::bindSubmeshVBO(VkCommandBuffer& commandBuffer, int iSubmesh, int vbo_index, float lodCoverage, SkinnedVertices* skinned)
+{
+  KRMeshManager::KRVBOData& vbo_data_block = *m_submeshes[iSubmesh].vbo_data_blocks[vbo_index];
+  assert(vbo_data_block.isVBOReady());
+  if (skinned) {
+    VkBuffer vertexBuffer = skinned->buffers[skinned->frameIndex][iSubmesh][vbo_index].buffer;
+    m_pContext->getMeshManager()->bindSkinnedVBO(commandBuffer, &vbo_data_block, vertexBuffer, lodCoverage);
+  } else {
+    m_pContext->getMeshManager()->bindVBO(commandBuffer, &vbo_data_block, lodCoverage);
+  }
+}
+
 bool KRMesh::isReady() const
 {
   // TODO - This should be cached...
@@ -433,14 +789,13 @@ bool KRMesh::isReady() const
   return true;
 }
 
-void KRMesh::renderSubmesh(VkCommandBuffer& commandBuffer, int iSubmesh, const KRRenderPass* renderPass, const std::string& object_name, const std::string& material_name, float lodCoverage)
+void KRMesh::renderSubmesh(VkCommandBuffer& commandBuffer, int iSubmesh, const KRRenderPass* renderPass, const std::string& object_name, const std::string& material_name, float lodCoverage, SkinnedVertices* skinned)
 {
   getSubmeshes();
 
   Submesh& mesh = m_submeshes[iSubmesh];
   int cVertexes = mesh.vertex_count;
 
-  vector<shared_ptr<KRMeshManager::KRVBOData>>::iterator vbo_itr = mesh.vbo_data_blocks.begin();
   int vbo_index = 0;
   if (getModelFormat() == ModelFormat::KRENGINE_MODEL_FORMAT_INDEXED_TRIANGLES) {
 
@@ -451,10 +806,7 @@ void KRMesh::renderSubmesh(VkCommandBuffer& commandBuffer, int iSubmesh, const K
       int start_index_offset, start_vertex_offset, index_count, vertex_count;
       getIndexedRange(index_group++, start_index_offset, start_vertex_offset, index_count, vertex_count);
 
-      KRMeshManager::KRVBOData& vbo_data_block = **(vbo_itr++);
-      assert(vbo_data_block.isVBOReady());
-
-      m_pContext->getMeshManager()->bindVBO(commandBuffer, &vbo_data_block, lodCoverage);
+      bindSubmeshVBO(commandBuffer, iSubmesh, vbo_index++, lodCoverage, skinned);
 
       int vertex_draw_count = cVertexes;
       if (vertex_draw_count > index_count - index_group_offset) vertex_draw_count = index_count - index_group_offset;
@@ -473,9 +825,7 @@ void KRMesh::renderSubmesh(VkCommandBuffer& commandBuffer, int iSubmesh, const K
     while (cVertexes > 0) {
       int cBufferVertexes = iBuffer < cBuffers - 1 ? MAX_VBO_SIZE : cVertexes % MAX_VBO_SIZE;
 
-      KRMeshManager::KRVBOData& vbo_data_block = **vbo_itr++;
-      assert(vbo_data_block.isVBOReady());
-      m_pContext->getMeshManager()->bindVBO(commandBuffer, &vbo_data_block, lodCoverage);
+      bindSubmeshVBO(commandBuffer, iSubmesh, vbo_index++, lodCoverage, skinned);
 
 
       if (iVertex + cVertexes >= MAX_VBO_SIZE) {
@@ -525,19 +875,22 @@ void KRMesh::LoadData(const KRMesh::mesh_info& mi, bool calculate_normals, bool
   releaseData();
 
   // TODO, FINDME - These values should be passed as a parameter and set by GUI flags
-  bool use_short_vertexes = false;
+  // Quantized positions are relative to the mesh bounds.  Skinned positions are kept
+  // as floats, as the bone transforms are applied to positions in model space.
+  bool use_short_vertexes = mi.quantize && mi.bone_names.empty();
+  // Normals are not octahedral encoded, even when quantized.  Each encoding here
+  // maps to a Vulkan vertex format that the vertex fetch expands to the same
+  // shader input, while an octahedral normal needs a decode step in every vertex
+  // shader and in the skinning shader.  Shaders are not compiled in variants for
+  // the vertex layout, so the 16-bit snorm encoding is kept for all meshes.
   bool use_short_normals = true;
   bool use_short_tangents = true;
+  bool use_byte_tangents = mi.quantize;
   bool use_short_uva = true;
   bool use_short_uvb = true;
-
-  if (use_short_vertexes) {
-    for (std::vector<Vector3>::const_iterator itr = mi.vertices.begin(); itr != mi.vertices.end(); itr++) {
-      if (fabsf((*itr).x) > 1.0f || fabsf((*itr).y) > 1.0f || fabsf((*itr).z) > 1.0f) {
-        use_short_vertexes = false;
-      }
-    }
-  }
+  bool use_half_uva = mi.quantize;
+  bool use_half_uvb = mi.quantize;
+  bool use_byte_bone_weights = mi.quantize;
 
   if (use_short_uva) {
     for (std::vector<Vector2>::const_iterator itr = mi.uva.begin(); itr != mi.uva.end(); itr++) {
@@ -555,6 +908,24 @@ void KRMesh::LoadData(const KRMesh::mesh_info& mi, bool calculate_normals, bool
     }
   }
 
+  // UVs outside of the range of the 16-bit snorm encoding are stored as half floats,
+  // as long as the half floats remain precise to within 1/1024
+  if (use_half_uva) {
+    for (std::vector<Vector2>::const_iterator itr = mi.uva.begin(); itr != mi.uva.end(); itr++) {
+      if (fabsf((*itr).x) >= 2.0f || fabsf((*itr).y) >= 2.0f) {
+        use_half_uva = false;
+      }
+    }
+  }
+
+  if (use_half_uvb) {
+    for (std::vector<Vector2>::const_iterator itr = mi.uvb.begin(); itr != mi.uvb.end(); itr++) {
+      if (fabsf((*itr).x) >= 2.0f || fabsf((*itr).y) >= 2.0f) {
+        use_half_uvb = false;
+      }
+    }
+  }
+
   __int32_t vertex_attrib_flags = 0;
   if (mi.vertices.size()) {
     if (use_short_vertexes) {
@@ -571,7 +942,9 @@ void KRMesh::LoadData(const KRMesh::mesh_info& mi, bool calculate_normals, bool
     }
   }
   if (mi.tangents.size() || calculate_tangents) {
-    if (use_short_tangents) {
+    if (use_byte_tangents) {
+      vertex_attrib_flags += (1 << KRENGINE_ATTRIB_TANGENT_BYTE);
+    } else if (use_short_tangents) {
       vertex_attrib_flags += (1 << KRENGINE_ATTRIB_TANGENT_SHORT);
     } else {
       vertex_attrib_flags += (1 << KRENGINE_ATTRIB_TANGENT);
@@ -580,6 +953,8 @@ void KRMesh::LoadData(const KRMesh::mesh_info& mi, bool calculate_normals, bool
   if (mi.uva.size()) {
     if (use_short_uva) {
       vertex_attrib_flags += (1 << KRENGINE_ATTRIB_TEXUVA_SHORT);
+    } else if (use_half_uva) {
+      vertex_attrib_flags += (1 << KRENGINE_ATTRIB_TEXUVA_HALF);
     } else {
       vertex_attrib_flags += (1 << KRENGINE_ATTRIB_TEXUVA);
     }
@@ -587,12 +962,18 @@ void KRMesh::LoadData(const KRMesh::mesh_info& mi, bool calculate_normals, bool
   if (mi.uvb.size()) {
     if (use_short_uvb) {
       vertex_attrib_flags += (1 << KRENGINE_ATTRIB_TEXUVB_SHORT);
+    } else if (use_half_uvb) {
+      vertex_attrib_flags += (1 << KRENGINE_ATTRIB_TEXUVB_HALF);
     } else {
       vertex_attrib_flags += (1 << KRENGINE_ATTRIB_TEXUVB);
     }
   }
   if (mi.bone_names.size()) {
-    vertex_attrib_flags += (1 << KRENGINE_ATTRIB_BONEINDEXES) + (1 << KRENGINE_ATTRIB_BONEWEIGHTS);
+    if (use_byte_bone_weights) {
+      vertex_attrib_flags += (1 << KRENGINE_ATTRIB_BONEINDEXES) + (1 << KRENGINE_ATTRIB_BONEWEIGHTS_BYTE);
+    } else {
+      vertex_attrib_flags += (1 << KRENGINE_ATTRIB_BONEINDEXES) + (1 << KRENGINE_ATTRIB_BONEWEIGHTS);
+    }
   }
   size_t vertex_size = VertexSizeForAttributes(vertex_attrib_flags);
   size_t index_count = mi.vertex_indexes.size();
@@ -600,7 +981,15 @@ void KRMesh::LoadData(const KRMesh::mesh_info& mi, bool calculate_normals, bool
   size_t submesh_count = mi.submesh_lengths.size();
   size_t vertex_count = mi.vertices.size();
   size_t bone_count = mi.bone_names.size();
-  size_t new_file_size = sizeof(pack_header) + sizeof(pack_material) * submesh_count + sizeof(pack_bone) * bone_count + KRALIGN(2 * index_count) + KRALIGN(8 * index_base_count) + vertex_size * vertex_count;
+  // 16-bit indexes are used unless an index would not fit, to save bandwidth
+  size_t index_size = 2;
+  for (__uint32_t index : mi.vertex_indexes) {
+    if (index > 0xffff) {
+      index_size = 4;
+      break;
+    }
+  }
+  size_t new_file_size = sizeof(pack_header) + sizeof(pack_material) * submesh_count + sizeof(pack_bone) * bone_count + KRALIGN(index_size * index_count) + KRALIGN(8 * index_base_count) + vertex_size * vertex_count;
   m_pData = new Block();
   m_pMetaData = m_pData;
   m_pData->expand(new_file_size);
@@ -613,7 +1002,22 @@ void KRMesh::LoadData(const KRMesh::mesh_info& mi, bool calculate_normals, bool
   pHeader->bone_count = (__int32_t)bone_count;
   pHeader->index_count = (__int32_t)index_count;
   pHeader->index_base_count = (__int32_t)index_base_count;
+  pHeader->index_size = (__int32_t)index_size;
   pHeader->model_format = (__int32_t)mi.format;
+  if (use_short_vertexes && vertex_count > 0) {
+    // Positions are scaled uniformly, so that normals are unaffected by the dequantization
+    AABB bounds = AABB::Create(mi.vertices[0], mi.vertices[0]);
+    for (const Vector3& vertex : mi.vertices) {
+      bounds.encapsulate(vertex);
+    }
+    Vector3 center = bounds.center();
+    Vector3 size = bounds.size();
+    float scale = std::max(std::max(size.x, size.y), size.z) * 0.5f;
+    pHeader->position_offset[0] = center.x;
+    pHeader->position_offset[1] = center.y;
+    pHeader->position_offset[2] = center.z;
+    pHeader->position_scale = scale > 0.0f ? scale : 1.0f;
+  }
   strcpy(pHeader->szTag, "KROBJPACK1.2   ");
   updateAttributeOffsets();
 
@@ -645,6 +1049,21 @@ void KRMesh::LoadData(const KRMesh::mesh_info& mi, bool calculate_normals, bool
         setBoneIndex(iVertex, bone_weight_index, mi.bone_indexes[iVertex][bone_weight_index]);
         setBoneWeight(iVertex, bone_weight_index, mi.bone_weights[iVertex][bone_weight_index]);
       }
+      if (use_byte_bone_weights) {
+        // Give the rounding error to the largest weight, so that the weights still sum to 1
+        unsigned char* weights = (unsigned char*)(getVertexData(iVertex) + m_vertex_attribute_offset[KRENGINE_ATTRIB_BONEWEIGHTS_BYTE]);
+        int weight_sum = 0;
+        int largest_weight = 0;
+        for (int bone_weight_index = 0; bone_weight_index < KRENGINE_MAX_BONE_WEIGHTS_PER_VERTEX; bone_weight_index++) {
+          weight_sum += weights[bone_weight_index];
+          if (weights[bone_weight_index] > weights[largest_weight]) {
+            largest_weight = bone_weight_index;
+          }
+        }
+        if (weight_sum > 0) {
+          weights[largest_weight] = (unsigned char)std::clamp(weights[largest_weight] + 255 - weight_sum, 0, 255);
+        }
+      }
     }
     if (bFirstVertex) {
       bFirstVertex = false;
@@ -669,9 +1088,17 @@ void KRMesh::LoadData(const KRMesh::mesh_info& mi, bool calculate_normals, bool
 
   pHeader->extents = m_extents;
 
-  __uint16_t* index_data = getIndexData();
-  for (std::vector<__uint16_t>::const_iterator itr = mi.vertex_indexes.begin(); itr != mi.vertex_indexes.end(); itr++) {
-    *index_data++ = *itr;
+  if (mi.quantize) {
+    logQuantizationError(mi);
+  }
+
+  if (index_size == 4) {
+    memcpy(getIndexData(), mi.vertex_indexes.data(), index_count * sizeof(__uint32_t));
+  } else {
+    __uint16_t* index_data = (__uint16_t*)getIndexData();
+    for (std::vector<__uint32_t>::const_iterator itr = mi.vertex_indexes.begin(); itr != mi.vertex_indexes.end(); itr++) {
+      *index_data++ = (__uint16_t)*itr;
+    }
   }
 
   __uint32_t* index_base_data = getIndexBaseData();
@@ -743,7 +1170,7 @@ void KRMesh::LoadData(const KRMesh::mesh_info& mi, bool calculate_normals, bool
   m_pData->copy((void*)&ph, 0, sizeof(ph));
   m_pMetaData = m_pData->getSubBlock(0, sizeof(pack_header) + sizeof(pack_material) * ph.submesh_count + sizeof(pack_bone) * ph.bone_count);
   m_pMetaData->lock();
-  m_pIndexBaseData = m_pData->getSubBlock(sizeof(pack_header) + sizeof(pack_material) * ph.submesh_count + sizeof(pack_bone) * ph.bone_count + KRALIGN(2 * ph.index_count), ph.index_base_count * 8);
+  m_pIndexBaseData = m_pData->getSubBlock(sizeof(pack_header) + sizeof(pack_material) * ph.submesh_count + sizeof(pack_bone) * ph.bone_count + KRALIGN(IndexSize(ph) * ph.index_count), ph.index_base_count * 8);
   m_pIndexBaseData->lock();
 
   // ----
@@ -762,6 +1189,87 @@ const AABB& KRMesh::getExtents() const
   return m_extents;
 }
 
+Matrix4 KRMesh::getPositionDequantization() const
+{
+  // Transforms quantized positions in the vertex data to model space
+  pack_header* header = getHeader();
+  if (!has_vertex_attribute(KRENGINE_ATTRIB_VERTEX_SHORT) || header->position_scale == 0.0f) {
+    return Matrix4();
+  }
+  return Matrix4::Scaling(Vector3::Create(header->position_scale, header->position_scale, header->position_scale))
+    * Matrix4::Translation(Vector3::Create(header->position_offset[0], header->position_offset[1], header->position_offset[2]));
+}
+
+short KRMesh::QuantizeSnorm(float value, int max_value)
+{
+  return (short)std::clamp((int)lroundf(value * (float)max_value), -max_value, max_value);
+}
+
+void KRMesh::logQuantizationError(const mesh_info& mi)
+{
+  // Reports the memory saved by the quantized vertex encodings, and the largest error that they introduce
+  float position_error = 0.0f;
+  float normal_error = 0.0f;
+  float tangent_error = 0.0f;
+  float uva_error = 0.0f;
+  float uvb_error = 0.0f;
+  float bone_weight_error = 0.0f;
+  for (int iVertex = 0; iVertex < (int)mi.vertices.size(); iVertex++) {
+    position_error = std::max(position_error, (getVertexPosition(iVertex) - mi.vertices[iVertex]).magnitude());
+    if ((int)mi.normals.size() > iVertex) {
+      normal_error = std::max(normal_error, (getVertexNormal(iVertex) - Vector3::Normalize(mi.normals[iVertex])).magnitude());
+    }
+    if ((int)mi.tangents.size() > iVertex) {
+      tangent_error = std::max(tangent_error, (getVertexTangent(iVertex) - Vector3::Normalize(mi.tangents[iVertex])).magnitude());
+    }
+    if ((int)mi.uva.size() > iVertex) {
+      Vector2 uva = getVertexUVA(iVertex);
+      uva_error = std::max(uva_error, std::max(fabsf(uva.x - mi.uva[iVertex].x), fabsf(uva.y - mi.uva[iVertex].y)));
+    }
+    if ((int)mi.uvb.size() > iVertex) {
+      Vector2 uvb = getVertexUVB(iVertex);
+      uvb_error = std::max(uvb_error, std::max(fabsf(uvb.x - mi.uvb[iVertex].x), fabsf(uvb.y - mi.uvb[iVertex].y)));
+    }
+    if ((int)mi.bone_weights.size() > iVertex) {
+      for (int bone_weight_index = 0; bone_weight_index < KRENGINE_MAX_BONE_WEIGHTS_PER_VERTEX; bone_weight_index++) {
+        bone_weight_error = std::max(bone_weight_error, fabsf(getBoneWeight(iVertex, bone_weight_index) - mi.bone_weights[iVertex][bone_weight_index]));
+      }
+    }
+  }
+
+  static const vertex_attrib_t unquantized_attributes[KRENGINE_NUM_ATTRIBUTES] = {
+    KRENGINE_ATTRIB_VERTEX,
+    KRENGINE_ATTRIB_NORMAL,
+    KRENGINE_ATTRIB_TANGENT,
+    KRENGINE_ATTRIB_TEXUVA,
+    KRENGINE_ATTRIB_TEXUVB,
+    KRENGINE_ATTRIB_BONEINDEXES,
+    KRENGINE_ATTRIB_BONEWEIGHTS,
+    KRENGINE_ATTRIB_VERTEX,
+    KRENGINE_ATTRIB_NORMAL,
+    KRENGINE_ATTRIB_TANGENT,
+    KRENGINE_ATTRIB_TEXUVA,
+    KRENGINE_ATTRIB_TEXUVB,
+    KRENGINE_ATTRIB_TANGENT,
+    KRENGINE_ATTRIB_TEXUVA,
+    KRENGINE_ATTRIB_TEXUVB,
+    KRENGINE_ATTRIB_BONEWEIGHTS,
+  };
+  __int32_t unquantized_attrib_flags = 0;
+  for (int i = 0; i < KRENGINE_NUM_ATTRIBUTES; i++) {
+    if (has_vertex_attribute((vertex_attrib_t)i)) {
+      unquantized_attrib_flags |= (1 << unquantized_attributes[i]);
+    }
+  }
+  size_t unquantized_vertex_size = VertexSizeForAttributes(unquantized_attrib_flags);
+  size_t vertex_count = mi.vertices.size();
+
+  KRContext::Log(KRContext::LOG_LEVEL_INFORMATION, "Quantize vertices, %i bytes per vertex (%i unquantized), %i KB total (%i KB unquantized)",
+    m_vertex_size, (int)unquantized_vertex_size, (int)(m_vertex_size * vertex_count / 1024), (int)(unquantized_vertex_size * vertex_count / 1024));
+  KRContext::Log(KRContext::LOG_LEVEL_INFORMATION, "Quantize vertices, max error position: %f normal: %f tangent: %f uva: %f uvb: %f bone weight: %f",
+    position_error, normal_error, tangent_error, uva_error, uvb_error, bone_weight_error);
+}
+
 int KRMesh::getLODCoverage() const
 {
   return m_lodCoverage;
@@ -808,13 +1316,42 @@ unsigned char* KRMesh::getVertexData() const
 size_t KRMesh::getVertexDataOffset() const
 {
   pack_header* pHeader = getHeader();
-  return sizeof(pack_header) + sizeof(pack_material) * pHeader->submesh_count + sizeof(pack_bone) * pHeader->bone_count + KRALIGN(2 * pHeader->index_count) + KRALIGN(8 * pHeader->index_base_count);
+  return sizeof(pack_header) + sizeof(pack_material) * pHeader->submesh_count + sizeof(pack_bone) * pHeader->bone_count + KRALIGN(getIndexSize() * pHeader->index_count) + KRALIGN(8 * pHeader->index_base_count);
 }
 
-__uint16_t* KRMesh::getIndexData() const
+void* KRMesh::getIndexData() const
 {
+  return (unsigned char*)m_pData->getStart() + getIndexDataOffset();
+}
 
-  return (__uint16_t*)((unsigned char*)m_pData->getStart() + getIndexDataOffset());
+/* static */
+size_t KRMesh::MeshletDataOffset(const pack_header& header)
+{
+  return sizeof(pack_header) + sizeof(pack_material) * header.submesh_count + sizeof(pack_bone) * header.bone_count + KRALIGN(IndexSize(header) * header.index_count) + KRALIGN(8 * header.index_base_count) + KRALIGN(VertexSizeForAttributes(header.vertex_attrib_flags) * header.vertex_count);
+}
+
+KRMesh::pack_meshlet* KRMesh::getMeshlets() const
+{
+  if (m_pMeshletData == NULL) {
+    return NULL;
+  }
+  return (pack_meshlet*)m_pMeshletData->getStart();
+}
+
+/* static */
+int KRMesh::IndexSize(const pack_header& header)
+{
+  return header.index_size == 4 ? 4 : 2;
+}
+
+int KRMesh::getIndexSize() const
+{
+  return IndexSize(*getHeader());
+}
+
+VkIndexType KRMesh::getIndexType() const
+{
+  return getIndexSize() == 4 ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16;
 }
 
 size_t KRMesh::getIndexDataOffset() const
@@ -827,7 +1364,7 @@ __uint32_t* KRMesh::getIndexBaseData() const
 {
   if (m_pIndexBaseData == NULL) {
     pack_header* pHeader = getHeader();
-    return (__uint32_t*)((unsigned char*)m_pData->getStart() + sizeof(pack_header) + sizeof(pack_material) * pHeader->submesh_count + sizeof(pack_bone) * pHeader->bone_count + KRALIGN(2 * pHeader->index_count));
+    return (__uint32_t*)((unsigned char*)m_pData->getStart() + sizeof(pack_header) + sizeof(pack_material) * pHeader->submesh_count + sizeof(pack_bone) * pHeader->bone_count + KRALIGN(getIndexSize() * pHeader->index_count));
   } else {
     return (__uint32_t*)m_pIndexBaseData->getStart();
   }
@@ -856,6 +1393,16 @@ int KRMesh::getVertexCount(int submesh) const
   return getSubmesh(submesh)->vertex_count;
 }
 
+void KRMesh::_lockData()
+{
+  m_pData->lock();
+}
+
+void KRMesh::_unlockData()
+{
+  m_pData->unlock();
+}
+
 __uint32_t KRMesh::getVertexAttributes() const
 {
   pack_header* header = getHeader();
@@ -867,7 +1414,12 @@ Vector3 KRMesh::getVertexPosition(int index) const
 {
   if (has_vertex_attribute(KRENGINE_ATTRIB_VERTEX_SHORT)) {
     short* v = (short*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_VERTEX_SHORT]);
-    return Vector3::Create((float)v[0] / 32767.0f, (float)v[1] / 32767.0f, (float)v[2] / 32767.0f);
+    pack_header* header = getHeader();
+    float scale = header->position_scale != 0.0f ? header->position_scale : 1.0f;
+    return Vector3::Create(
+      header->position_offset[0] + (float)v[0] / 32767.0f * scale,
+      header->position_offset[1] + (float)v[1] / 32767.0f * scale,
+      header->position_offset[2] + (float)v[2] / 32767.0f * scale);
   } else if (has_vertex_attribute(KRENGINE_ATTRIB_VERTEX)) {
     return Vector3::Create((float*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_VERTEX]));
   } else {
@@ -889,7 +1441,10 @@ Vector3 KRMesh::getVertexNormal(int index) const
 
 Vector3 KRMesh::getVertexTangent(int index) const
 {
-  if (has_vertex_attribute(KRENGINE_ATTRIB_TANGENT_SHORT)) {
+  if (has_vertex_attribute(KRENGINE_ATTRIB_TANGENT_BYTE)) {
+    signed char* v = (signed char*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_TANGENT_BYTE]);
+    return Vector3::Create((float)v[0] / 127.0f, (float)v[1] / 127.0f, (float)v[2] / 127.0f);
+  } else if (has_vertex_attribute(KRENGINE_ATTRIB_TANGENT_SHORT)) {
     short* v = (short*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_TANGENT_SHORT]);
     return Vector3::Create((float)v[0] / 32767.0f, (float)v[1] / 32767.0f, (float)v[2] / 32767.0f);
   } else if (has_vertex_attribute(KRENGINE_ATTRIB_TANGENT)) {
@@ -904,6 +1459,9 @@ Vector2 KRMesh::getVertexUVA(int index) const
   if (has_vertex_attribute(KRENGINE_ATTRIB_TEXUVA_SHORT)) {
     short* v = (short*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_TEXUVA_SHORT]);
     return Vector2::Create((float)v[0] / 32767.0f, (float)v[1] / 32767.0f);
+  } else if (has_vertex_attribute(KRENGINE_ATTRIB_TEXUVA_HALF)) {
+    __uint16_t* v = (__uint16_t*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_TEXUVA_HALF]);
+    return Vector2::Create(kraken::HalfToFloat(v[0]), kraken::HalfToFloat(v[1]));
   } else if (has_vertex_attribute(KRENGINE_ATTRIB_TEXUVA)) {
     return Vector2::Create((float*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_TEXUVA]));
   } else {
@@ -916,6 +1474,9 @@ Vector2 KRMesh::getVertexUVB(int index) const
   if (has_vertex_attribute(KRENGINE_ATTRIB_TEXUVB_SHORT)) {
     short* v = (short*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_TEXUVB_SHORT]);
     return Vector2::Create((float)v[0] / 32767.0f, (float)v[1] / 32767.0f);
+  } else if (has_vertex_attribute(KRENGINE_ATTRIB_TEXUVB_HALF)) {
+    __uint16_t* v = (__uint16_t*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_TEXUVB_HALF]);
+    return Vector2::Create(kraken::HalfToFloat(v[0]), kraken::HalfToFloat(v[1]));
   } else if (has_vertex_attribute(KRENGINE_ATTRIB_TEXUVB)) {
     return Vector2::Create((float*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_TEXUVB]));
   } else {
@@ -927,9 +1488,11 @@ void KRMesh::setVertexPosition(int index, const Vector3& v)
 {
   if (has_vertex_attribute(KRENGINE_ATTRIB_VERTEX_SHORT)) {
     short* vert = (short*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_VERTEX_SHORT]);
-    vert[0] = (short)(v.x * 32767.0f);
-    vert[1] = (short)(v.y * 32767.0f);
-    vert[2] = (short)(v.z * 32767.0f);
+    pack_header* header = getHeader();
+    float scale = header->position_scale != 0.0f ? header->position_scale : 1.0f;
+    vert[0] = QuantizeSnorm((v.x - header->position_offset[0]) / scale, 32767);
+    vert[1] = QuantizeSnorm((v.y - header->position_offset[1]) / scale, 32767);
+    vert[2] = QuantizeSnorm((v.z - header->position_offset[2]) / scale, 32767);
   } else if (has_vertex_attribute(KRENGINE_ATTRIB_VERTEX)) {
     float* vert = (float*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_VERTEX]);
     vert[0] = v.x;
@@ -955,7 +1518,12 @@ void KRMesh::setVertexNormal(int index, const Vector3& v)
 
 void KRMesh::setVertexTangent(int index, const Vector3& v)
 {
-  if (has_vertex_attribute(KRENGINE_ATTRIB_TANGENT_SHORT)) {
+  if (has_vertex_attribute(KRENGINE_ATTRIB_TANGENT_BYTE)) {
+    signed char* vert = (signed char*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_TANGENT_BYTE]);
+    vert[0] = (signed char)QuantizeSnorm(v.x, 127);
+    vert[1] = (signed char)QuantizeSnorm(v.y, 127);
+    vert[2] = (signed char)QuantizeSnorm(v.z, 127);
+  } else if (has_vertex_attribute(KRENGINE_ATTRIB_TANGENT_SHORT)) {
     short* vert = (short*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_TANGENT_SHORT]);
     vert[0] = (short)(v.x * 32767.0f);
     vert[1] = (short)(v.y * 32767.0f);
@@ -974,6 +1542,10 @@ void KRMesh::setVertexUVA(int index, const Vector2& v)
     short* vert = (short*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_TEXUVA_SHORT]);
     vert[0] = (short)(v.x * 32767.0f);
     vert[1] = (short)(v.y * 32767.0f);
+  } else if (has_vertex_attribute(KRENGINE_ATTRIB_TEXUVA_HALF)) {
+    __uint16_t* vert = (__uint16_t*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_TEXUVA_HALF]);
+    vert[0] = kraken::FloatToHalf(v.x);
+    vert[1] = kraken::FloatToHalf(v.y);
   } else if (has_vertex_attribute(KRENGINE_ATTRIB_TEXUVA)) {
     float* vert = (float*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_TEXUVA]);
     vert[0] = v.x;
@@ -987,6 +1559,10 @@ void KRMesh::setVertexUVB(int index, const Vector2& v)
     short* vert = (short*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_TEXUVB_SHORT]);
     vert[0] = (short)(v.x * 32767.0f);
     vert[1] = (short)(v.y * 32767.0f);
+  } else if (has_vertex_attribute(KRENGINE_ATTRIB_TEXUVB_HALF)) {
+    __uint16_t* vert = (__uint16_t*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_TEXUVB_HALF]);
+    vert[0] = kraken::FloatToHalf(v.x);
+    vert[1] = kraken::FloatToHalf(v.y);
   } else if (has_vertex_attribute(KRENGINE_ATTRIB_TEXUVB)) {
     float* vert = (float*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_TEXUVB]);
     vert[0] = v.x;
@@ -1009,12 +1585,21 @@ void KRMesh::setBoneIndex(int index, int weight_index, int bone_index)
 
 float KRMesh::getBoneWeight(int index, int weight_index) const
 {
+  if (has_vertex_attribute(KRENGINE_ATTRIB_BONEWEIGHTS_BYTE)) {
+    unsigned char* vert = (unsigned char*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_BONEWEIGHTS_BYTE]);
+    return (float)vert[weight_index] / 255.0f;
+  }
   float* vert = (float*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_BONEWEIGHTS]);
   return vert[weight_index];
 }
 
 void KRMesh::setBoneWeight(int index, int weight_index, float bone_weight)
 {
+  if (has_vertex_attribute(KRENGINE_ATTRIB_BONEWEIGHTS_BYTE)) {
+    unsigned char* vert = (unsigned char*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_BONEWEIGHTS_BYTE]);
+    vert[weight_index] = (unsigned char)std::clamp((int)lroundf(bone_weight * 255.0f), 0, 255);
+    return;
+  }
   float* vert = (float*)(getVertexData(index) + m_vertex_attribute_offset[KRENGINE_ATTRIB_BONEWEIGHTS]);
   vert[weight_index] = bone_weight;
 }
@@ -1058,6 +1643,18 @@ size_t KRMesh::VertexSizeForAttributes(__int32_t vertex_attrib_flags)
   if (has_vertex_attribute(vertex_attrib_flags, KRENGINE_ATTRIB_TEXUVB_SHORT)) {
     data_size += sizeof(short) * 2;
   }
+  if (has_vertex_attribute(vertex_attrib_flags, KRENGINE_ATTRIB_TANGENT_BYTE)) {
+    data_size += 4; // Extra byte added in order to maintain 32-bit alignment
+  }
+  if (has_vertex_attribute(vertex_attrib_flags, KRENGINE_ATTRIB_TEXUVA_HALF)) {
+    data_size += sizeof(__uint16_t) * 2;
+  }
+  if (has_vertex_attribute(vertex_attrib_flags, KRENGINE_ATTRIB_TEXUVB_HALF)) {
+    data_size += sizeof(__uint16_t) * 2;
+  }
+  if (has_vertex_attribute(vertex_attrib_flags, KRENGINE_ATTRIB_BONEWEIGHTS_BYTE)) {
+    data_size += 4; // 4 bytes
+  }
   return data_size;
 }
 
@@ -1107,6 +1704,13 @@ VkFormat KRMesh::AttributeVulkanFormat(__int32_t vertex_attrib)
   case KRENGINE_ATTRIB_TEXUVA_SHORT:
   case KRENGINE_ATTRIB_TEXUVB_SHORT:
     return VK_FORMAT_R16G16_SNORM;
+  case KRENGINE_ATTRIB_TANGENT_BYTE:
+    return VK_FORMAT_R8G8B8A8_SNORM;
+  case KRENGINE_ATTRIB_TEXUVA_HALF:
+  case KRENGINE_ATTRIB_TEXUVB_HALF:
+    return VK_FORMAT_R16G16_SFLOAT;
+  case KRENGINE_ATTRIB_BONEWEIGHTS_BYTE:
+    return VK_FORMAT_R8G8B8A8_UNORM;
   }
   return VK_FORMAT_UNDEFINED;
 }
@@ -1319,13 +1923,13 @@ bool KRMesh::lineCast(const Vector3& v0, const Vector3& v1, HitInfo& hitinfo) co
 void KRMesh::convertToIndexed()
 {
   m_pData->lock();
-  char* szKey = new char[m_vertex_size * 2 + 1];
-
-  // Convert model to indexed vertices, identying vertexes with identical attributes and optimizing order of trianges for best usage post-vertex-transform cache on GPU
-  int vertex_index_offset = 0;
-  int vertex_index_base_start_vertex = 0;
 
+  // Convert model to indexed vertices, identying vertexes with identical attributes.  The order of the triangles is optimized for the GPU's post-transform vertex cache afterwards, by optimizeIndexes.
   mesh_info mi;
+  // Meshes that were quantized on import remain quantized
+  mi.quantize = has_vertex_attribute(KRENGINE_ATTRIB_VERTEX_SHORT) || has_vertex_attribute(KRENGINE_ATTRIB_TANGENT_BYTE)
+    || has_vertex_attribute(KRENGINE_ATTRIB_TEXUVA_HALF) || has_vertex_attribute(KRENGINE_ATTRIB_TEXUVB_HALF)
+    || has_vertex_attribute(KRENGINE_ATTRIB_BONEWEIGHTS_BYTE);
 
   int bone_count = getBoneCount();
   for (int bone_index = 0; bone_index < bone_count; bone_index++) {
@@ -1333,162 +1937,178 @@ void KRMesh::convertToIndexed()
     mi.bone_bind_poses.push_back(getBoneBindPose(bone_index));
   }
 
+  // Meshes with a submesh too large for 16-bit indexes use 32-bit indexes, giving
+  // each submesh its own index group so that it can be drawn with a single draw call.
+  // Smaller meshes keep 16-bit indexes, packing submeshes into groups of up to 0xffff vertices.
+  bool use_32bit_indexes = false;
+  for (int submesh_index = 0; submesh_index < getSubmeshCount(); submesh_index++) {
+    if (getVertexCount(submesh_index) > 0xffff) {
+      use_32bit_indexes = true;
+    }
+  }
+  int max_group_vertex_count = use_32bit_indexes ? std::numeric_limits<int>::max() : 0xffff;
+
+  // Vertices are welded within chunks of up to max_group_vertex_count source vertices.  The placement
+  // of the chunks and index groups depends only on the source vertex counts, so they are planned
+  // first and the chunks are then welded in parallel.
+  struct WeldChunk
+  {
+    int source_start;
+    int source_count;
+    std::vector<int> unique_vertices; // Source vertex of each welded vertex, in order of first use
+    std::vector<__uint32_t> indexes; // Welded vertex for each source vertex
+  };
+  std::vector<WeldChunk> chunks;
+  std::vector<size_t> index_group_chunks; // First chunk of each index group
+  int vertex_index_offset = 0;
+
   for (int submesh_index = 0; submesh_index < getSubmeshCount(); submesh_index++) {
     mi.material_names.push_back(getSubmesh(submesh_index)->szName);
 
     int vertexes_remaining = getVertexCount(submesh_index);
 
     int vertex_count = vertexes_remaining;
-    if (vertex_count > 0xffff) {
-      vertex_count = 0xffff;
+    if (vertex_count > max_group_vertex_count) {
+      vertex_count = max_group_vertex_count;
     }
 
-    if (submesh_index == 0 || vertex_index_offset + vertex_count > 0xffff) {
-      mi.vertex_index_bases.push_back(std::pair<int, int>((int)mi.vertex_indexes.size(), (int)mi.vertices.size()));
+    if (submesh_index == 0 || use_32bit_indexes || vertex_index_offset + vertex_count > 0xffff) {
+      index_group_chunks.push_back(chunks.size());
       vertex_index_offset = 0;
-      vertex_index_base_start_vertex = (int)mi.vertices.size();
     }
 
-    mi.submesh_starts.push_back((int)mi.vertex_index_bases.size() - 1 + (vertex_index_offset << 16));
+    mi.submesh_starts.push_back((int)index_group_chunks.size() - 1 + (vertex_index_offset << 16));
     mi.submesh_lengths.push_back(vertexes_remaining);
     int source_index = getSubmesh(submesh_index)->start_vertex;
 
-
     while (vertexes_remaining) {
+      WeldChunk& chunk = chunks.emplace_back();
+      chunk.source_start = source_index;
+      chunk.source_count = vertex_count;
+      source_index += vertex_count;
 
-      //typedef std::pair<std::vector<float>, std::vector<int> > vertex_key_t;
-      typedef std::string vertex_key_t;
-
-      unordered_map<vertex_key_t, int> prev_indexes = unordered_map<vertex_key_t, int>();
-
-      for (int i = 0; i < vertex_count; i++) {
-
-        Vector3 vertex_position = getVertexPosition(source_index);
-        Vector2 vertex_uva = getVertexUVA(source_index);
-        Vector2 vertex_uvb = getVertexUVB(source_index);
-        Vector3 vertex_normal = getVertexNormal(source_index);
-        Vector3 vertex_tangent = getVertexTangent(source_index);
-        std::vector<int> vertex_bone_indexes;
-        if (has_vertex_attribute(KRENGINE_ATTRIB_BONEINDEXES)) {
-          vertex_bone_indexes.push_back(getBoneIndex(source_index, 0));
-          vertex_bone_indexes.push_back(getBoneIndex(source_index, 1));
-          vertex_bone_indexes.push_back(getBoneIndex(source_index, 2));
-          vertex_bone_indexes.push_back(getBoneIndex(source_index, 3));
-        }
-        std::vector<float> vertex_bone_weights;
-        if (has_vertex_attribute(KRENGINE_ATTRIB_BONEWEIGHTS)) {
-          vertex_bone_weights.push_back(getBoneWeight(source_index, 0));
-          vertex_bone_weights.push_back(getBoneWeight(source_index, 1));
-          vertex_bone_weights.push_back(getBoneWeight(source_index, 2));
-          vertex_bone_weights.push_back(getBoneWeight(source_index, 3));
-        }
-
-
-
-        unsigned char* vertex_data = (unsigned char*)getVertexData(source_index);
-        for (int b = 0; b < m_vertex_size; b++) {
-          const char* szHex = "0123456789ABCDEF";
-          szKey[b * 2] = szHex[vertex_data[b] & 0x0f];
-          szKey[b * 2 + 1] = szHex[((vertex_data[b] & 0xf0) >> 4)];
-        }
-        szKey[m_vertex_size * 2] = '\0';
-
-        vertex_key_t vertex_key = szKey;
-        /*
+      vertexes_remaining -= vertex_count;
+      vertex_index_offset += vertex_count;
 
-         vertex_key_t vertex_key = std::make_pair(std::vector<float>(), std::vector<int>());
+      vertex_count = vertexes_remaining;
+      if (vertex_count > max_group_vertex_count) {
+        vertex_count = max_group_vertex_count;
+      }
 
-        if(has_vertex_attribute(KRENGINE_ATTRIB_VERTEX) || has_vertex_attribute(KRENGINE_ATTRIB_VERTEX_SHORT)) {
-            vertex_key.first.push_back(vertex_position.x);
-            vertex_key.first.push_back(vertex_position.y);
-            vertex_key.first.push_back(vertex_position.z);
-        }
-        if(has_vertex_attribute(KRENGINE_ATTRIB_NORMAL) || has_vertex_attribute(KRENGINE_ATTRIB_NORMAL_SHORT)) {
-            vertex_key.first.push_back(vertex_normal.x);
-            vertex_key.first.push_back(vertex_normal.y);
-            vertex_key.first.push_back(vertex_normal.z);
-        }
-        if(has_vertex_attribute(KRENGINE_ATTRIB_TEXUVA) || has_vertex_attribute(KRENGINE_ATTRIB_TEXUVA_SHORT)) {
-            vertex_key.first.push_back(vertex_uva.x);
-            vertex_key.first.push_back(vertex_uva.y);
-        }
-        if(has_vertex_attribute(KRENGINE_ATTRIB_TEXUVB) || has_vertex_attribute(KRENGINE_ATTRIB_TEXUVB_SHORT)) {
-            vertex_key.first.push_back(vertex_uvb.x);
-            vertex_key.first.push_back(vertex_uvb.y);
-        }
-        if(has_vertex_attribute(KRENGINE_ATTRIB_TANGENT) || has_vertex_attribute(KRENGINE_ATTRIB_TANGENT_SHORT)) {
-            vertex_key.first.push_back(vertex_tangent.x);
-            vertex_key.first.push_back(vertex_tangent.y);
-            vertex_key.first.push_back(vertex_tangent.z);
-        }
-        if(has_vertex_attribute(KRENGINE_ATTRIB_BONEINDEXES)) {
-            vertex_key.second.push_back(vertex_bone_indexes[0]);
-            vertex_key.second.push_back(vertex_bone_indexes[1]);
-            vertex_key.second.push_back(vertex_bone_indexes[2]);
-            vertex_key.second.push_back(vertex_bone_indexes[3]);
-        }
-        if(has_vertex_attribute(KRENGINE_ATTRIB_BONEWEIGHTS)) {
-            vertex_key.first.push_back(vertex_bone_weights[0]);
-            vertex_key.first.push_back(vertex_bone_weights[1]);
-            vertex_key.first.push_back(vertex_bone_weights[2]);
-            vertex_key.first.push_back(vertex_bone_weights[3]);
-        }
-        */
-        int found_index = -1;
-        if (prev_indexes.count(vertex_key) == 0) {
-          found_index = (int)mi.vertices.size() - vertex_index_base_start_vertex;
-          if (has_vertex_attribute(KRENGINE_ATTRIB_VERTEX) || has_vertex_attribute(KRENGINE_ATTRIB_VERTEX_SHORT)) {
-            mi.vertices.push_back(vertex_position);
-          }
-          if (has_vertex_attribute(KRENGINE_ATTRIB_NORMAL) || has_vertex_attribute(KRENGINE_ATTRIB_NORMAL_SHORT)) {
-            mi.normals.push_back(vertex_normal);
-          }
-          if (has_vertex_attribute(KRENGINE_ATTRIB_TANGENT) || has_vertex_attribute(KRENGINE_ATTRIB_TANGENT_SHORT)) {
-            mi.tangents.push_back(vertex_tangent);
-          }
-          if (has_vertex_attribute(KRENGINE_ATTRIB_TEXUVA) || has_vertex_attribute(KRENGINE_ATTRIB_TEXUVA_SHORT)) {
-            mi.uva.push_back(vertex_uva);
-          }
-          if (has_vertex_attribute(KRENGINE_ATTRIB_TEXUVB) || has_vertex_attribute(KRENGINE_ATTRIB_TEXUVB_SHORT)) {
-            mi.uvb.push_back(vertex_uvb);
-          }
-          if (has_vertex_attribute(KRENGINE_ATTRIB_BONEINDEXES)) {
-            mi.bone_indexes.push_back(vertex_bone_indexes);
+      if (vertex_index_offset + vertex_count > max_group_vertex_count) {
+        index_group_chunks.push_back(chunks.size());
+        vertex_index_offset = 0;
+      }
+    }
+  }
 
+  // Vertices are identical when all of their attribute bytes match.  Each chunk is
+  // welded with an open addressing hash table of welded vertices.
+  const unsigned char* vertex_data = getVertexData();
+  int vertex_size = m_vertex_size;
+  auto hashVertex = [vertex_size](const unsigned char* vertex) {
+    uint64_t hash = 14695981039346656037ull;
+    int i = 0;
+    for (; i + 4 <= vertex_size; i += 4) {
+      uint32_t word;
+      memcpy(&word, vertex + i, sizeof(word));
+      hash = (hash ^ word) * 1099511628211ull;
+    }
+    for (; i < vertex_size; i++) {
+      hash = (hash ^ vertex[i]) * 1099511628211ull;
+    }
+    // Mix the high bits into the low bits used to select a slot
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return hash;
+  };
+
+  getContext().getThreadPool()->parallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+    std::vector<int> table;
+    for (size_t chunk_index = begin; chunk_index < end; chunk_index++) {
+      WeldChunk& chunk = chunks[chunk_index];
+      size_t table_size = 16;
+      while (table_size < (size_t)chunk.source_count * 2) {
+        table_size <<= 1;
+      }
+      size_t mask = table_size - 1;
+      table.assign(table_size, -1);
+      chunk.indexes.reserve(chunk.source_count);
+
+      for (int source_index = chunk.source_start; source_index < chunk.source_start + chunk.source_count; source_index++) {
+        const unsigned char* vertex = vertex_data + (size_t)source_index * vertex_size;
+        size_t slot = hashVertex(vertex) & mask;
+        while (true) {
+          int welded_index = table[slot];
+          if (welded_index == -1) {
+            welded_index = (int)chunk.unique_vertices.size();
+            table[slot] = welded_index;
+            chunk.unique_vertices.push_back(source_index);
+            chunk.indexes.push_back(welded_index);
+            break;
           }
-          if (has_vertex_attribute(KRENGINE_ATTRIB_BONEWEIGHTS)) {
-            mi.bone_weights.push_back(vertex_bone_weights);
+          if (memcmp(vertex_data + (size_t)chunk.unique_vertices[welded_index] * vertex_size, vertex, vertex_size) == 0) {
+            chunk.indexes.push_back(welded_index);
+            break;
           }
-          prev_indexes[vertex_key] = found_index;
-        } else {
-          found_index = prev_indexes[vertex_key];
+          slot = (slot + 1) & mask;
         }
-
-        mi.vertex_indexes.push_back(found_index);
-        //fprintf(stderr, "Submesh: %6i  IndexBase: %3i  Index: %6i\n", submesh_index, vertex_index_bases.size(), found_index);
-
-        source_index++;
       }
+    }
+  });
 
-      vertexes_remaining -= vertex_count;
-      vertex_index_offset += vertex_count;
+  int vertex_index_base_start_vertex = 0;
+  size_t index_group = 0;
+  for (size_t chunk_index = 0; chunk_index <= chunks.size(); chunk_index++) {
+    while (index_group < index_group_chunks.size() && index_group_chunks[index_group] == chunk_index) {
+      mi.vertex_index_bases.push_back(std::pair<int, int>((int)mi.vertex_indexes.size(), (int)mi.vertices.size()));
+      vertex_index_base_start_vertex = (int)mi.vertices.size();
+      index_group++;
+    }
+    if (chunk_index == chunks.size()) {
+      break;
+    }
 
+    WeldChunk& chunk = chunks[chunk_index];
+    int first_vertex = (int)mi.vertices.size() - vertex_index_base_start_vertex;
+    for (__uint32_t index : chunk.indexes) {
+      mi.vertex_indexes.push_back(first_vertex + index);
+    }
 
-      vertex_count = vertexes_remaining;
-      if (vertex_count > 0xffff) {
-        vertex_count = 0xffff;
+    for (int source_index : chunk.unique_vertices) {
+      if (has_vertex_attribute(KRENGINE_ATTRIB_VERTEX) || has_vertex_attribute(KRENGINE_ATTRIB_VERTEX_SHORT)) {
+        mi.vertices.push_back(getVertexPosition(source_index));
       }
-
-      if (vertex_index_offset + vertex_count > 0xffff) {
-        mi.vertex_index_bases.push_back(std::pair<int, int>((int)mi.vertex_indexes.size(), (int)mi.vertices.size()));
-        vertex_index_offset = 0;
-        vertex_index_base_start_vertex = (int)mi.vertices.size();
+      if (has_vertex_attribute(KRENGINE_ATTRIB_NORMAL) || has_vertex_attribute(KRENGINE_ATTRIB_NORMAL_SHORT)) {
+        mi.normals.push_back(getVertexNormal(source_index));
+      }
+      if (has_vertex_attribute(KRENGINE_ATTRIB_TANGENT) || has_vertex_attribute(KRENGINE_ATTRIB_TANGENT_SHORT) || has_vertex_attribute(KRENGINE_ATTRIB_TANGENT_BYTE)) {
+        mi.tangents.push_back(getVertexTangent(source_index));
+      }
+      if (has_vertex_attribute(KRENGINE_ATTRIB_TEXUVA) || has_vertex_attribute(KRENGINE_ATTRIB_TEXUVA_SHORT) || has_vertex_attribute(KRENGINE_ATTRIB_TEXUVA_HALF)) {
+        mi.uva.push_back(getVertexUVA(source_index));
+      }
+      if (has_vertex_attribute(KRENGINE_ATTRIB_TEXUVB) || has_vertex_attribute(KRENGINE_ATTRIB_TEXUVB_SHORT) || has_vertex_attribute(KRENGINE_ATTRIB_TEXUVB_HALF)) {
+        mi.uvb.push_back(getVertexUVB(source_index));
+      }
+      if (has_vertex_attribute(KRENGINE_ATTRIB_BONEINDEXES)) {
+        std::vector<int> vertex_bone_indexes;
+        for (int weight_index = 0; weight_index < KRENGINE_MAX_BONE_WEIGHTS_PER_VERTEX; weight_index++) {
+          vertex_bone_indexes.push_back(getBoneIndex(source_index, weight_index));
+        }
+        mi.bone_indexes.push_back(vertex_bone_indexes);
+      }
+      if (has_vertex_attribute(KRENGINE_ATTRIB_BONEWEIGHTS) || has_vertex_attribute(KRENGINE_ATTRIB_BONEWEIGHTS_BYTE)) {
+        std::vector<float> vertex_bone_weights;
+        for (int weight_index = 0; weight_index < KRENGINE_MAX_BONE_WEIGHTS_PER_VERTEX; weight_index++) {
+          vertex_bone_weights.push_back(getBoneWeight(source_index, weight_index));
+        }
+        mi.bone_weights.push_back(vertex_bone_weights);
       }
     }
   }
 
-  delete[] szKey;
-
   KRContext::Log(KRContext::LOG_LEVEL_INFORMATION, "Convert to indexed, before: %i after: %i (%.2f%% saving)", getHeader()->vertex_count, mi.vertices.size(), ((float)getHeader()->vertex_count - (float)mi.vertices.size()) / (float)getHeader()->vertex_count * 100.0f);
 
   switch (getModelFormat()) {
@@ -1510,6 +2130,9 @@ void KRMesh::optimize()
 {
   switch (getModelFormat()) {
   case ModelFormat::KRENGINE_MODEL_FORMAT_INDEXED_TRIANGLES:
+    optimizeIndexes();
+    buildMeshlets();
+    break;
   case ModelFormat::KRENGINE_MODEL_FORMAT_INDEXED_STRIP:
     optimizeIndexes();
     break;
@@ -1540,9 +2163,6 @@ int KRMesh::getTriangleVertexIndex(int submesh, int index) const
   switch (getModelFormat()) {
   case ModelFormat::KRENGINE_MODEL_FORMAT_INDEXED_TRIANGLES:
   {
-    __uint16_t* index_data = getIndexData();
-
-
     int start_index_offset, start_vertex_offset, index_count, vertex_count;
     int index_group = getSubmesh(submesh)->index_group;
     int index_group_offset = getSubmesh(submesh)->index_group_offset;
@@ -1552,7 +2172,11 @@ int KRMesh::getTriangleVertexIndex(int submesh, int index) const
       remaining_vertices -= index_count;
       getIndexedRange(index_group++, start_index_offset, start_vertex_offset, index_count, vertex_count);
     }
-    return index_data[start_index_offset + remaining_vertices] + start_vertex_offset;
+    int index = start_index_offset + remaining_vertices;
+    if (getIndexSize() == 4) {
+      return ((__uint32_t*)getIndexData())[index] + start_vertex_offset;
+    }
+    return ((__uint16_t*)getIndexData())[index] + start_vertex_offset;
   }
   break;
   default:
@@ -1563,93 +2187,232 @@ int KRMesh::getTriangleVertexIndex(int submesh, int index) const
 
 void KRMesh::optimizeIndexes()
 {
-  // TODO - Re-enable this once crash with KRMeshSphere vertices is corrected
-  return;
-
-  m_pData->lock();
   // TODO - Implement optimization for indexed strips
-  if (getModelFormat() == ModelFormat::KRENGINE_MODEL_FORMAT_INDEXED_TRIANGLES) {
-
-    __uint16_t* new_indices = (__uint16_t*)malloc(0x10000 * sizeof(__uint16_t));
-    __uint16_t* vertex_mapping = (__uint16_t*)malloc(0x10000 * sizeof(__uint16_t));
-    unsigned char* new_vertex_data = (unsigned char*)malloc(m_vertex_size * 0x10000);
+  if (getModelFormat() != ModelFormat::KRENGINE_MODEL_FORMAT_INDEXED_TRIANGLES) {
+    return;
+  }
 
-    // FINDME, TODO, HACK - This will segfault if the KRData object is still mmap'ed to a read-only file.  Need to detach from the file before calling this function.  Currently, this function is only being used during the import process, so it isn't going to cause any problems for now.
+  const int kVertexCacheSize = 16; // FINDME, TODO - GPU post-transform vertex cache size of 16 should be configureable
 
-    pack_header* header = getHeader();
+  m_pData->lock();
 
-    __uint16_t* index_data = getIndexData();
-    // unsigned char *vertex_data = getVertexData(); // Uncomment when re-enabling Step 2 below
+  // FINDME, TODO, HACK - This will segfault if the KRData object is still mmap'ed to a read-only file.  Need to detach from the file before calling this function.  Currently, this function is only being used during the import process, so it isn't going to cause any problems for now.
 
-    for (int submesh_index = 0; submesh_index < header->submesh_count; submesh_index++) {
-      pack_material* submesh = getSubmesh(submesh_index);
-      int vertexes_remaining = submesh->vertex_count;
-      int index_group = getSubmesh(submesh_index)->index_group;
-      int index_group_offset = getSubmesh(submesh_index)->index_group_offset;
-      while (vertexes_remaining > 0) {
-        int start_index_offset, start_vertex_offset, index_count, vertex_count;
-        getIndexedRange(index_group++, start_index_offset, start_vertex_offset, index_count, vertex_count);
+  pack_header* header = getHeader();
+  int index_size = getIndexSize();
+  unsigned char* index_data = (unsigned char*)getIndexData();
+
+  std::vector<__uint32_t> indexes;
+  std::vector<__uint32_t> new_indexes;
+  std::vector<bool> vertex_used;
+  int triangle_count = 0;
+  int vertices_used = 0;
+  int transforms_before = 0;
+  int transforms_after = 0;
+
+  for (int submesh_index = 0; submesh_index < header->submesh_count; submesh_index++) {
+    int vertexes_remaining = getSubmesh(submesh_index)->vertex_count;
+    int index_group = getSubmesh(submesh_index)->index_group;
+    int index_group_offset = getSubmesh(submesh_index)->index_group_offset;
+    while (vertexes_remaining > 0) {
+      int start_index_offset, start_vertex_offset, index_count, vertex_count;
+      getIndexedRange(index_group++, start_index_offset, start_vertex_offset, index_count, vertex_count);
 
-        int vertexes_to_process = vertexes_remaining;
-        if (vertexes_to_process + index_group_offset > 0xffff) {
-          vertexes_to_process = 0xffff - index_group_offset;
+      // Only whole triangles within this index group are reordered
+      int vertexes_to_process = vertexes_remaining;
+      if (vertexes_to_process > index_count - index_group_offset) {
+        vertexes_to_process = index_count - index_group_offset;
+      }
+      int triangle_index_count = vertexes_to_process - vertexes_to_process % 3;
+      int first_index = start_index_offset + index_group_offset;
+
+      indexes.resize(triangle_index_count);
+      new_indexes.resize(triangle_index_count);
+      vertex_used.assign(vertex_count, false);
+      for (int i = 0; i < triangle_index_count; i++) {
+        if (index_size == 4) {
+          indexes[i] = ((__uint32_t*)index_data)[first_index + i];
+        } else {
+          indexes[i] = ((__uint16_t*)index_data)[first_index + i];
+        }
+        if (!vertex_used[indexes[i]]) {
+          vertex_used[indexes[i]] = true;
+          vertices_used++;
         }
+      }
+      transforms_before += SimulateVertexCache(indexes.data(), triangle_index_count, kVertexCacheSize);
 
-        __uint16_t* index_data_start = index_data + start_index_offset + index_group_offset;
+      // ----====---- Step 1: Optimize triangle drawing order to maximize use of the GPU's post-transform vertex cache ----====----
+      Forsyth::OptimizeFaces((const Forsyth::uint*)indexes.data(), triangle_index_count, vertex_count, (Forsyth::uint*)new_indexes.data(), kVertexCacheSize);
 
+      // ----====---- Step 2: Draw the outward facing clusters of triangles first to reduce overdraw ----====----
+      optimizeOverdraw(new_indexes, start_vertex_offset, kVertexCacheSize);
 
-        // ----====---- Step 1: Optimize triangle drawing order to maximize use of the GPU's post-transform vertex cache ----====----
-        Forsyth::OptimizeFaces(index_data_start, vertexes_to_process, vertex_count, new_indices, 16); // FINDME, TODO - GPU post-transform vertex cache size of 16 should be configureable
-        memcpy(index_data_start, new_indices, vertexes_to_process * sizeof(__uint16_t));
-        vertexes_remaining -= vertexes_to_process;
+      transforms_after += SimulateVertexCache(new_indexes.data(), triangle_index_count, kVertexCacheSize);
+      triangle_count += triangle_index_count / 3;
 
-        /*
+      for (int i = 0; i < triangle_index_count; i++) {
+        if (index_size == 4) {
+          ((__uint32_t*)index_data)[first_index + i] = new_indexes[i];
+        } else {
+          ((__uint16_t*)index_data)[first_index + i] = (__uint16_t)new_indexes[i];
+        }
+      }
 
-         unsigned char * vertex_data_start = vertex_data + start_vertex_offset;
+      vertexes_remaining -= vertexes_to_process;
+      index_group_offset = 0;
+    }
+  }
 
-        // ----====---- Step 2: Re-order the vertex data to maintain cache coherency ----====----
-        for(int i=0; i < vertex_count; i++) {
-            vertex_mapping[i] = i;
-        }
-        int new_vertex_index=0;
-        for(int index_number=0; index_number<index_count; index_number++) {
-            int prev_vertex_index = index_data_start[index_number];
-            if(prev_vertex_index > new_vertex_index) {
-                // Swap prev_vertex_index and new_vertex_index
-
-                for(int i=0; i < index_count; i++) {
-                    if(index_data_start[i] == prev_vertex_index) {
-                        index_data_start[i] = new_vertex_index;
-                    } else if(index_data_start[i] == new_vertex_index) {
-                        index_data_start[i] = prev_vertex_index;
-                    }
-                }
+  // ----====---- Step 3: Re-order the vertex data to match the order that the triangles fetch it ----====----
+  for (int index_group = 0; index_group < header->index_base_count; index_group++) {
+    optimizeVertexFetch(index_group);
+  }
 
-                int tmp = vertex_mapping[prev_vertex_index];
-                vertex_mapping[prev_vertex_index] = vertex_mapping[new_vertex_index];
-                vertex_mapping[new_vertex_index] = tmp;
+  if (triangle_count > 0 && vertices_used > 0) {
+    KRContext::Log(KRContext::LOG_LEVEL_INFORMATION, "Optimize indexes, ACMR before: %.3f after: %.3f, ATVR before: %.3f after: %.3f",
+      (float)transforms_before / (float)triangle_count, (float)transforms_after / (float)triangle_count,
+      (float)transforms_before / (float)vertices_used, (float)transforms_after / (float)vertices_used);
+  }
 
+  m_pData->unlock();
+}
 
-                new_vertex_index++;
-            }
-        }
+void KRMesh::optimizeOverdraw(std::vector<__uint32_t>& indexes, int start_vertex_offset, int cache_size)
+{
+  int triangle_count = (int)indexes.size() / 3;
 
-        for(int i=0; i < vertex_count; i++) {
-            memcpy(new_vertex_data + vertex_mapping[i] * m_vertex_size, vertex_data_start + i * m_vertex_size, m_vertex_size);
-        }
-        memcpy(vertex_data_start, new_vertex_data, vertex_count * m_vertex_size);
-         */
+  // The vertex cache optimized order is split into clusters wherever it starts
+  // over with a triangle that shares no vertices with the cache, so that
+  // reordering the clusters does not affect the vertex cache hit rate.
+  std::vector<int> triangle_misses;
+  SimulateVertexCache(indexes.data(), (int)indexes.size(), cache_size, &triangle_misses);
+  std::vector<int> cluster_starts;
+  for (int triangle = 0; triangle < triangle_count; triangle++) {
+    if (triangle == 0 || triangle_misses[triangle] == 3) {
+      cluster_starts.push_back(triangle);
+    }
+  }
+  if (cluster_starts.size() < 2) {
+    return;
+  }
+  cluster_starts.push_back(triangle_count);
+
+  bool has_normals = has_vertex_attribute(KRENGINE_ATTRIB_NORMAL) || has_vertex_attribute(KRENGINE_ATTRIB_NORMAL_SHORT);
+
+  // Face normals are scaled by twice the triangle area and oriented to agree with the vertex normals
+  std::vector<Vector3> face_normals(triangle_count);
+  std::vector<Vector3> face_centers(triangle_count);
+  Vector3 mesh_center = Vector3::Zero();
+  float mesh_area = 0.0f;
+  for (int triangle = 0; triangle < triangle_count; triangle++) {
+    int v0 = indexes[triangle * 3] + start_vertex_offset;
+    int v1 = indexes[triangle * 3 + 1] + start_vertex_offset;
+    int v2 = indexes[triangle * 3 + 2] + start_vertex_offset;
+    Vector3 p0 = getVertexPosition(v0);
+    Vector3 p1 = getVertexPosition(v1);
+    Vector3 p2 = getVertexPosition(v2);
+    Vector3 normal = Vector3::Cross(p1 - p0, p2 - p0);
+    if (has_normals && Vector3::Dot(normal, getVertexNormal(v0) + getVertexNormal(v1) + getVertexNormal(v2)) < 0.0f) {
+      normal = -normal;
+    }
+    face_normals[triangle] = normal;
+    face_centers[triangle] = (p0 + p1 + p2) / 3.0f;
+    float area = normal.magnitude();
+    mesh_center += face_centers[triangle] * area;
+    mesh_area += area;
+  }
+  if (mesh_area <= 0.0f) {
+    return;
+  }
+  mesh_center /= mesh_area;
+
+  // Clusters that face away from the center of the mesh are likely to occlude the others
+  std::vector<std::pair<float, int> > cluster_order;
+  for (int cluster = 0; cluster < (int)cluster_starts.size() - 1; cluster++) {
+    Vector3 cluster_center = Vector3::Zero();
+    Vector3 cluster_normal = Vector3::Zero();
+    float cluster_area = 0.0f;
+    for (int triangle = cluster_starts[cluster]; triangle < cluster_starts[cluster + 1]; triangle++) {
+      float area = face_normals[triangle].magnitude();
+      cluster_center += face_centers[triangle] * area;
+      cluster_normal += face_normals[triangle];
+      cluster_area += area;
+    }
+    float sort_key = 0.0f;
+    if (cluster_area > 0.0f && cluster_normal.sqrMagnitude() > 0.0f) {
+      cluster_center /= cluster_area;
+      cluster_normal.normalize();
+      sort_key = Vector3::Dot(cluster_center - mesh_center, cluster_normal);
+    }
+    cluster_order.push_back(std::make_pair(sort_key, cluster));
+  }
+  std::stable_sort(cluster_order.begin(), cluster_order.end(), [](const std::pair<float, int>& a, const std::pair<float, int>& b) {
+    return a.first > b.first;
+  });
 
+  std::vector<__uint32_t> new_indexes;
+  new_indexes.reserve(indexes.size());
+  for (const std::pair<float, int>& cluster : cluster_order) {
+    new_indexes.insert(new_indexes.end(), indexes.begin() + cluster_starts[cluster.second] * 3, indexes.begin() + cluster_starts[cluster.second + 1] * 3);
+  }
+  indexes.swap(new_indexes);
+}
 
+void KRMesh::optimizeVertexFetch(int index_group)
+{
+  int start_index_offset, start_vertex_offset, index_count, vertex_count;
+  getIndexedRange(index_group, start_index_offset, start_vertex_offset, index_count, vertex_count);
 
-        index_group_offset = 0;
-      }
+  int index_size = getIndexSize();
+  unsigned char* index_data = (unsigned char*)getIndexData();
+
+  // Vertices are numbered in the order that they are first used, followed by any unused vertices
+  std::vector<int> vertex_mapping(vertex_count, -1);
+  int new_vertex_count = 0;
+  for (int i = start_index_offset; i < start_index_offset + index_count; i++) {
+    int vertex = index_size == 4 ? (int)((__uint32_t*)index_data)[i] : (int)((__uint16_t*)index_data)[i];
+    if (vertex_mapping[vertex] == -1) {
+      vertex_mapping[vertex] = new_vertex_count++;
+    }
+    if (index_size == 4) {
+      ((__uint32_t*)index_data)[i] = vertex_mapping[vertex];
+    } else {
+      ((__uint16_t*)index_data)[i] = (__uint16_t)vertex_mapping[vertex];
     }
+  }
+  for (int vertex = 0; vertex < vertex_count; vertex++) {
+    if (vertex_mapping[vertex] == -1) {
+      vertex_mapping[vertex] = new_vertex_count++;
+    }
+  }
 
-    free(new_indices);
-    free(vertex_mapping);
-    free(new_vertex_data);
-  } // if(getModelFormat() == ModelFormat::KRENGINE_MODEL_FORMAT_INDEXED_TRIANGLES)
+  unsigned char* vertex_data = getVertexData(start_vertex_offset);
+  std::vector<unsigned char> new_vertex_data((size_t)vertex_count * m_vertex_size);
+  for (int vertex = 0; vertex < vertex_count; vertex++) {
+    memcpy(new_vertex_data.data() + (size_t)vertex_mapping[vertex] * m_vertex_size, vertex_data + (size_t)vertex * m_vertex_size, m_vertex_size);
+  }
+  memcpy(vertex_data, new_vertex_data.data(), new_vertex_data.size());
+}
 
-  m_pData->unlock();
+int KRMesh::SimulateVertexCache(const __uint32_t* indexes, int index_count, int cache_size, std::vector<int>* triangle_misses)
+{
+  // Simulates a FIFO post-transform vertex cache, returning the number of vertices transformed
+  std::vector<__int64_t> cache(cache_size, -1);
+  int cache_next = 0;
+  int misses = 0;
+  if (triangle_misses) {
+    triangle_misses->assign(index_count / 3, 0);
+  }
+  for (int i = 0; i < index_count; i++) {
+    if (std::find(cache.begin(), cache.end(), (__int64_t)indexes[i]) == cache.end()) {
+      cache[cache_next] = indexes[i];
+      cache_next = (cache_next + 1) % cache_size;
+      misses++;
+      if (triangle_misses) {
+        (*triangle_misses)[i / 3]++;
+      }
+    }
+  }
+  return misses;
 }
@@ -96,6 +96,10 @@ public:
     KRENGINE_ATTRIB_TANGENT_SHORT,
     KRENGINE_ATTRIB_TEXUVA_SHORT,
     KRENGINE_ATTRIB_TEXUVB_SHORT,
+    KRENGINE_ATTRIB_TANGENT_BYTE,
+    KRENGINE_ATTRIB_TEXUVA_HALF,
+    KRENGINE_ATTRIB_TEXUVB_HALF,
+    KRENGINE_ATTRIB_BONEWEIGHTS_BYTE,
     KRENGINE_NUM_ATTRIBUTES
   } vertex_attrib_t;
 
@@ -105,7 +109,7 @@ public:
   {
     ModelFormat format;
     std::vector<hydra::Vector3> vertices;
-    std::vector<__uint16_t> vertex_indexes;
+    std::vector<__uint32_t> vertex_indexes;
     std::vector<std::pair<int, int> > vertex_index_bases;
     std::vector<hydra::Vector2> uva;
     std::vector<hydra::Vector2> uvb;
@@ -118,9 +122,11 @@ public:
     std::vector<std::vector<int> > bone_indexes;
     std::vector<hydra::Matrix4> bone_bind_poses;
     std::vector<std::vector<float> > bone_weights;
+    bool quantize = false; // Select compact encodings for the vertex attributes
   } mesh_info;
 
-  void render(KRNode::RenderInfo& ri, const std::string& object_name, const hydra::Matrix4& matModel, KRTexture* pLightMap, const std::vector<KRBone*>& bones, float lod_coverage = 0.0f);
+  class SkinnedVertices;
+  void render(KRNode::RenderInfo& ri, const std::string& object_name, const hydra::Matrix4& matModel, KRTexture* pLightMap, const std::vector<hydra::Matrix4>& bone_palette, float lod_coverage = 0.0f, SkinnedVertices* skinned = nullptr);
 
   std::string m_lodBaseName;
 
@@ -141,6 +147,7 @@ public:
   float getMaxDimension();
 
   const hydra::AABB& getExtents() const;
+  hydra::Matrix4 getPositionDequantization() const;
 
   class Submesh
   {
@@ -160,6 +167,8 @@ public:
 
     int start_vertex;
     int vertex_count;
+    int first_meshlet;
+    int meshlet_count;
     char szMaterialName[KRENGINE_MAX_NAME_LENGTH];
     vector<mimir::Block*> vertex_data_blocks;
     vector<mimir::Block*> index_data_blocks;
@@ -169,6 +178,30 @@ public:
     vector<shared_ptr<KRMeshManager::KRVBOData>> vbo_data_blocks;
   };
 
+  // The mesh's vertices for a single model instance, skinned by a compute
+  // dispatch once per frame.  Every pass draws these as static geometry, rather
+  // than skinning again in the vertex shader.  Each frame in flight has its own
+  // buffers, as the previous frame may still be drawing while the next is skinned.
+  class SkinnedVertices
+  {
+  public:
+    SkinnedVertices();
+    ~SkinnedVertices();
+
+    KRMesh* mesh;
+    KrDeviceHandle deviceHandle;
+    long frame; // Frame last skinned
+    int frameIndex; // Frame in flight whose buffers were last skinned
+    // Per frame in flight and submesh, matching Submesh::vbo_data_blocks
+    vector<vector<KRMeshManager::SkinnedBuffer>> buffers[KRENGINE_MAX_FRAMES_IN_FLIGHT];
+  };
+
+  bool canSkin() const;
+  bool initSkinnedVertices(KrDeviceHandle deviceHandle, SkinnedVertices& skinned);
+  // Records the dispatches skinning the mesh for the frame being recorded,
+  // between KRMeshManager::skinningStart and skinningEnd
+  bool skin(const std::vector<hydra::Matrix4>& bone_palette, float lod_coverage, SkinnedVertices& skinned);
+
   typedef struct
   {
     union
@@ -190,6 +223,20 @@ public:
     float bind_pose[16];
   } pack_bone;
 
+  // A small cluster of a submesh's triangles, culled as a unit when rendering.
+  // Meshlets cover a contiguous range of indexes and are sorted by submesh.
+  typedef struct
+  {
+    int32_t submesh;
+    int32_t vbo_index; // Index of the submesh's VBO containing the meshlet
+    int32_t first_index; // Relative to the start of the VBO's indexes
+    int32_t index_count;
+    hydra::Vector3 center; // Bounding sphere, in model space
+    float radius;
+    hydra::Vector3 cone_axis; // Normal cone, in model space
+    float cone_cutoff; // 1.0 when the triangles face too many directions to be culled as backfacing
+  } pack_meshlet;
+
   int getLODCoverage() const;
   std::string getLODBaseName() const;
 
@@ -202,6 +249,11 @@ public:
   int getVertexCount(int submesh) const;
   __uint32_t getVertexAttributes() const;
 
+  // The vertex and index accessors below read the mesh data directly, and are
+  // only valid while it is locked with _lockData().
+  void _lockData();
+  void _unlockData();
+
   int getTriangleVertexIndex(int submesh, int index) const;
   hydra::Vector3 getVertexPosition(int index) const;
   hydra::Vector3 getVertexNormal(int index) const;
@@ -243,10 +295,19 @@ private:
   mimir::Block* m_pData;
   mimir::Block* m_pMetaData;
   mimir::Block* m_pIndexBaseData;
+  mimir::Block* m_pMeshletData;
 
   void getSubmeshes();
   void getMaterials();
-  void renderSubmesh(VkCommandBuffer& commandBuffer, int iSubmesh, const KRRenderPass* renderPass, const std::string& object_name, const std::string& material_name, float lodCoverage);
+  void renderSubmesh(VkCommandBuffer& commandBuffer, int iSubmesh, const KRRenderPass* renderPass, const std::string& object_name, const std::string& material_name, float lodCoverage, SkinnedVertices* skinned = nullptr);
+  void bindSubmeshVBO(VkCommandBuffer& commandBuffer, int iSubmesh, int vbo_index, float lodCoverage, SkinnedVertices* skinned);
+  void renderSubmeshMeshlets(KRNode::RenderInfo& ri, int iSubmesh, const std::string& object_name, const std::string& material_name, const hydra::Matrix4& matModel, bool cullBackfaces, float lodCoverage);
+  void buildMeshlets();
+  void optimizeOverdraw(std::vector<__uint32_t>& indexes, int start_vertex_offset, int cache_size);
+  void optimizeVertexFetch(int index_group);
+  void logQuantizationError(const mesh_info& mi);
+  static short QuantizeSnorm(float value, int max_value);
+  static int SimulateVertexCache(const __uint32_t* indexes, int index_count, int cache_size, std::vector<int>* triangle_misses = nullptr);
 
   static bool rayCast(const hydra::Vector3& start, const hydra::Vector3& dir, const hydra::Triangle3& tri, const hydra::Vector3& tri_n0, const hydra::Vector3& tri_n1, const hydra::Vector3& tri_n2, hydra::HitInfo& hitinfo);
   static bool sphereCast(const hydra::Matrix4& model_to_world, const hydra::Vector3& v0, const hydra::Vector3& v1, float radius, const hydra::Triangle3& tri, hydra::HitInfo& hitinfo);
@@ -270,7 +331,11 @@ private:
     hydra::AABB extents; // Axis aligned bounding box, in model's coordinate space
     int32_t index_count;
     int32_t index_base_count;
-    unsigned char reserved[444]; // Pad out to 512 bytes
+    int32_t index_size; // Bytes per index, either 2 or 4.  Packs written before 32-bit indexes were supported contain 0, meaning 2.
+    int32_t meshlet_count;
+    float position_offset[3]; // KRENGINE_ATTRIB_VERTEX_SHORT positions are scaled by position_scale, then offset by position_offset
+    float position_scale; // Packs written before positions were quantized contain 0, meaning 1
+    unsigned char reserved[420]; // Pad out to 512 bytes
   } pack_header;
 
   static_assert(sizeof(pack_header) == 512);
@@ -288,7 +353,12 @@ private:
   unsigned char* getVertexData() const;
   size_t getVertexDataOffset() const;
   unsigned char* getVertexData(int index) const;
-  __uint16_t* getIndexData() const;
+  void* getIndexData() const;
+  static int IndexSize(const pack_header& header);
+  static size_t MeshletDataOffset(const pack_header& header);
+  pack_meshlet* getMeshlets() const;
+  int getIndexSize() const;
+  VkIndexType getIndexType() const;
   size_t getIndexDataOffset() const;
   __uint32_t* getIndexBaseData() const;
   pack_header* getHeader() const;
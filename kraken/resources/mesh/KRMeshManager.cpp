@@ -83,7 +83,7 @@ void KRMeshManager::init()
   memcpy(KRENGINE_VBO_3D_CUBE_VERTICES.getStart(), _KRENGINE_VBO_3D_CUBE_VERTEX_DATA, sizeof(float) * 3 * 14);
   KRENGINE_VBO_3D_CUBE_VERTICES.unlock();
 
-  KRENGINE_VBO_DATA_3D_CUBE_VERTICES.init(this, &KRENGINE_VBO_3D_CUBE_VERTICES, nullptr, KRENGINE_VBO_3D_CUBE_ATTRIBS, false, KRVBOData::CONSTANT
+  KRENGINE_VBO_DATA_3D_CUBE_VERTICES.init(this, &KRENGINE_VBO_3D_CUBE_VERTICES, nullptr, VK_INDEX_TYPE_UINT16, KRENGINE_VBO_3D_CUBE_ATTRIBS, false, KRVBOData::CONSTANT
 #if KRENGINE_DEBUG_GPU_LABELS
     , "Cube Mesh [built-in]"
 #endif
@@ -104,7 +104,7 @@ void KRMeshManager::init()
   memcpy(KRENGINE_VBO_2D_SQUARE_VERTICES.getStart(), _KRENGINE_VBO_2D_SQUARE_VERTEX_DATA, sizeof(float) * 5 * 4);
   KRENGINE_VBO_2D_SQUARE_VERTICES.unlock();
 
-  KRENGINE_VBO_DATA_2D_SQUARE_VERTICES.init(this, &KRENGINE_VBO_2D_SQUARE_VERTICES, nullptr, KRENGINE_VBO_2D_SQUARE_ATTRIBS, false, KRVBOData::CONSTANT
+  KRENGINE_VBO_DATA_2D_SQUARE_VERTICES.init(this, &KRENGINE_VBO_2D_SQUARE_VERTICES, nullptr, VK_INDEX_TYPE_UINT16, KRENGINE_VBO_2D_SQUARE_ATTRIBS, false, KRVBOData::CONSTANT
 #if KRENGINE_DEBUG_GPU_LABELS
     , "Square Mesh [built-in]"
 #endif
@@ -118,6 +118,14 @@ KRMeshManager::~KRMeshManager()
     delete (*itr).second;
   }
   m_meshes.clear();
+
+  destroyRetiredSkinnedBuffers(true);
+  for (auto itr = m_skinningPipelines.begin(); itr != m_skinningPipelines.end(); itr++) {
+    std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice((*itr).first);
+    // TODO - Validate that device has not been lost
+    destroySkinningPipeline(*device, (*itr).second);
+  }
+  m_skinningPipelines.clear();
 }
 
 KRResource* KRMeshManager::loadResource(const std::string& name, const std::string& extension, Block* data)
@@ -194,9 +202,18 @@ void KRMeshManager::bindVBO(VkCommandBuffer& commandBuffer, KRVBOData* vbo_data,
   }
 }
 
+void KRMeshManager::bindSkinnedVBO(VkCommandBuffer& commandBuffer, KRVBOData* vbo_data, VkBuffer vertexBuffer, float lodCoverage)
+{
+  // The source vertices remain resident while they are skinned from
+  vbo_data->requestResidency(lodCoverage);
+  m_currentVBO = nullptr;
+  vbo_data->bind(commandBuffer, vertexBuffer);
+}
+
 void KRMeshManager::startFrame(float deltaTime)
 {
   m_memoryTransferredThisFrame = 0;
+  destroyRetiredSkinnedBuffers(false);
   if (m_draw_call_log_used) {
     // Only log draw calls on the next frame if the draw call log was used on last frame
     m_draw_call_log_used = false;
@@ -307,6 +324,290 @@ long KRMeshManager::getMemActive()
   return mem_active;
 }
 
+KRMeshManager::SkinningPipeline* KRMeshManager::getSkinningPipeline(KrDeviceHandle deviceHandle)
+{
+  auto itr = m_skinningPipelines.find(deviceHandle);
+  if (itr != m_skinningPipelines.end()) {
+    return (*itr).second.supported ? &(*itr).second : nullptr;
+  }
+
+  // Failures are remembered, so that models fall back to vertex shader
+  // skinning without retrying every frame
+  itr = m_skinningPipelines.insert(std::pair<KrDeviceHandle, SkinningPipeline>(deviceHandle, SkinningPipeline{})).first;
+  SkinningPipeline& skinning = (*itr).second;
+  skinning.frame = -1;
+
+  std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(deviceHandle);
+  if (!device->m_timelineSemaphore) {
+    // Graphics submissions can not wait for the compute queue on this device
+    return nullptr;
+  }
+
+  KRShader* shader = getContext().getShaderManager()->get("skinning.comp", "spv");
+  if (shader == nullptr) {
+    KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Shader not found: skinning.comp");
+    return nullptr;
+  }
+
+  VkDescriptorSetLayoutBinding bindings[3]{};
+  for (int i = 0; i < 3; i++) {
+    bindings[i].binding = i;
+    bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[i].descriptorCount = 1;
+    bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+  }
+  VkDescriptorSetLayoutCreateInfo layoutInfo{};
+  layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  layoutInfo.bindingCount = 3;
+  layoutInfo.pBindings = bindings;
+
+  VkPushConstantRange pushConstantRange{};
+  pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+  pushConstantRange.offset = 0;
+  pushConstantRange.size = sizeof(SkinningConstants);
+
+  VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+  pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+  pipelineLayoutInfo.setLayoutCount = 1;
+  pipelineLayoutInfo.pSetLayouts = &skinning.descriptorSetLayout;
+  pipelineLayoutInfo.pushConstantRangeCount = 1;
+  pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+  VkShaderModule shaderModule = VK_NULL_HANDLE;
+  bool success = vkCreateDescriptorSetLayout(device->m_logicalDevice, &layoutInfo, nullptr, &skinning.descriptorSetLayout) == VK_SUCCESS
+    && vkCreatePipelineLayout(device->m_logicalDevice, &pipelineLayoutInfo, nullptr, &skinning.pipelineLayout) == VK_SUCCESS
+    && shader->createShaderModule(device->m_logicalDevice, shaderModule);
+
+  if (success) {
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = shaderModule;
+    pipelineInfo.stage.pName = "main";
+    pipelineInfo.layout = skinning.pipelineLayout;
+    success = vkCreateComputePipelines(device->m_logicalDevice, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &skinning.pipeline) == VK_SUCCESS;
+    vkDestroyShaderModule(device->m_logicalDevice, shaderModule, nullptr);
+  }
+
+  // Each model dispatches once per vertex buffer, with its own descriptor set
+  VkDescriptorPoolSize poolSize{};
+  poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  poolSize.descriptorCount = KRENGINE_MAX_SKINNING_DISPATCHES * 3;
+  VkDescriptorPoolCreateInfo poolInfo{};
+  poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  poolInfo.poolSizeCount = 1;
+  poolInfo.pPoolSizes = &poolSize;
+  poolInfo.maxSets = KRENGINE_MAX_SKINNING_DISPATCHES;
+  for (int i = 0; success && i < KRENGINE_MAX_FRAMES_IN_FLIGHT; i++) {
+    success = vkCreateDescriptorPool(device->m_logicalDevice, &poolInfo, nullptr, &skinning.descriptorPools[i]) == VK_SUCCESS;
+  }
+
+  success = success && device->createBuffer(
+    KRENGINE_SKINNING_PALETTE_SIZE * KRENGINE_MAX_FRAMES_IN_FLIGHT,
+    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+    &skinning.paletteBuffer,
+    &skinning.paletteAllocation
+#if KRENGINE_DEBUG_GPU_LABELS
+    , "Skinning Bone Palette"
+#endif
+  );
+  success = success && vmaMapMemory(device->getAllocator(), skinning.paletteAllocation, (void**)&skinning.paletteData) == VK_SUCCESS;
+
+  if (!success) {
+    KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Unable to create skinning compute pipeline.");
+    destroySkinningPipeline(*device, skinning);
+    return nullptr;
+  }
+  skinning.supported = true;
+  return &skinning;
+}
+
+void KRMeshManager::destroySkinningPipeline(KRDevice& device, SkinningPipeline& skinning)
+{
+  VmaAllocator allocator = device.getAllocator();
+  if (skinning.paletteData) {
+    vmaUnmapMemory(allocator, skinning.paletteAllocation);
+  }
+  if (skinning.paletteBuffer != VK_NULL_HANDLE) {
+    vmaDestroyBuffer(allocator, skinning.paletteBuffer, skinning.paletteAllocation);
+  }
+  for (int i = 0; i < KRENGINE_MAX_FRAMES_IN_FLIGHT; i++) {
+    if (skinning.descriptorPools[i] != VK_NULL_HANDLE) {
+      vkDestroyDescriptorPool(device.m_logicalDevice, skinning.descriptorPools[i], nullptr);
+    }
+  }
+  if (skinning.pipeline != VK_NULL_HANDLE) {
+    vkDestroyPipeline(device.m_logicalDevice, skinning.pipeline, nullptr);
+  }
+  if (skinning.pipelineLayout != VK_NULL_HANDLE) {
+    vkDestroyPipelineLayout(device.m_logicalDevice, skinning.pipelineLayout, nullptr);
+  }
+  if (skinning.descriptorSetLayout != VK_NULL_HANDLE) {
+    vkDestroyDescriptorSetLayout(device.m_logicalDevice, skinning.descriptorSetLayout, nullptr);
+  }
+  skinning = SkinningPipeline{};
+  skinning.frame = -1;
+}
+
+bool KRMeshManager::skinningStart(KrDeviceHandle deviceHandle)
+{
+  SkinningPipeline* skinning = getSkinningPipeline(deviceHandle);
+  if (skinning == nullptr) {
+    return false;
+  }
+  long frame = getContext().getCurrentFrame();
+  if (skinning->frame == frame) {
+    // Already skinned for another camera; the skinned vertices do not depend on the view
+    return false;
+  }
+  skinning->frame = frame;
+  std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(deviceHandle);
+
+  // The fence of this frame in flight has been waited on.  Its last graphics
+  // submission waited for the compute work recorded with the same index, so
+  // the descriptor sets, palette range, and command buffer are free to reuse.
+  skinning->frameIndex = device->getFrameIndex();
+  skinning->commandBuffer = device->m_computeCommandBuffers[skinning->frameIndex];
+  skinning->paletteUsage = KRENGINE_SKINNING_PALETTE_SIZE * skinning->frameIndex;
+  skinning->paletteLimit = skinning->paletteUsage + KRENGINE_SKINNING_PALETTE_SIZE;
+  skinning->dispatchCount = 0;
+  vkResetDescriptorPool(device->m_logicalDevice, skinning->descriptorPools[skinning->frameIndex], 0);
+
+  VkCommandBufferBeginInfo beginInfo{};
+  beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  if (vkBeginCommandBuffer(skinning->commandBuffer, &beginInfo) != VK_SUCCESS) {
+    return false;
+  }
+  vkCmdBindPipeline(skinning->commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, skinning->pipeline);
+  return true;
+}
+
+bool KRMeshManager::skinningUploadPalette(KrDeviceHandle deviceHandle, const std::vector<hydra::Matrix4>& bone_palette, VkDescriptorBufferInfo& paletteInfo)
+{
+  assert(!bone_palette.empty());
+  SkinningPipeline* skinning = getSkinningPipeline(deviceHandle);
+  std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(deviceHandle);
+
+  VkDeviceSize alignment = device->m_deviceProperties.limits.minStorageBufferOffsetAlignment;
+  VkDeviceSize offset = (skinning->paletteUsage + alignment - 1) / alignment * alignment;
+  VkDeviceSize size = sizeof(hydra::Matrix4) * bone_palette.size();
+  if (offset + size > skinning->paletteLimit) {
+    // The remaining models are skinned in the vertex shader this frame
+    return false;
+  }
+  memcpy(skinning->paletteData + offset, bone_palette.data(), size);
+  skinning->paletteUsage = offset + size;
+
+  paletteInfo.buffer = skinning->paletteBuffer;
+  paletteInfo.offset = offset;
+  paletteInfo.range = size;
+  return true;
+}
+
+bool KRMeshManager::skinningDispatch(KrDeviceHandle deviceHandle, VkBuffer source, const SkinnedBuffer& destination, const VkDescriptorBufferInfo& paletteInfo, const SkinningConstants& constants)
+{
+  SkinningPipeline* skinning = getSkinningPipeline(deviceHandle);
+  std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(deviceHandle);
+
+  VkDescriptorSetAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  allocInfo.descriptorPool = skinning->descriptorPools[skinning->frameIndex];
+  allocInfo.descriptorSetCount = 1;
+  allocInfo.pSetLayouts = &skinning->descriptorSetLayout;
+  VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+  if (vkAllocateDescriptorSets(device->m_logicalDevice, &allocInfo, &descriptorSet) != VK_SUCCESS) {
+    // The pool is exhausted; the remaining models are skinned in the vertex shader
+    return false;
+  }
+
+  VkDescriptorBufferInfo bufferInfos[3]{};
+  bufferInfos[0].buffer = source;
+  bufferInfos[0].range = destination.size;
+  bufferInfos[1].buffer = destination.buffer;
+  bufferInfos[1].range = destination.size;
+  bufferInfos[2] = paletteInfo;
+
+  VkWriteDescriptorSet descriptorWrites[3]{};
+  for (int i = 0; i < 3; i++) {
+    descriptorWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[i].dstSet = descriptorSet;
+    descriptorWrites[i].dstBinding = i;
+    descriptorWrites[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    descriptorWrites[i].descriptorCount = 1;
+    descriptorWrites[i].pBufferInfo = &bufferInfos[i];
+  }
+  vkUpdateDescriptorSets(device->m_logicalDevice, 3, descriptorWrites, 0, nullptr);
+
+  vkCmdBindDescriptorSets(skinning->commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, skinning->pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+  vkCmdPushConstants(skinning->commandBuffer, skinning->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(SkinningConstants), &constants);
+  vkCmdDispatch(skinning->commandBuffer, (constants.vertex_count + 63) / 64, 1, 1);
+  skinning->dispatchCount++;
+  return true;
+}
+
+void KRMeshManager::skinningEnd(KrDeviceHandle deviceHandle)
+{
+  SkinningPipeline* skinning = getSkinningPipeline(deviceHandle);
+  std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(deviceHandle);
+
+  vkEndCommandBuffer(skinning->commandBuffer);
+  if (skinning->dispatchCount > 0 && !device->submitCompute(skinning->commandBuffer)) {
+    KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Unable to submit skinning compute work.");
+  }
+}
+
+bool KRMeshManager::createSkinnedBuffer(KrDeviceHandle deviceHandle, VkDeviceSize size, SkinnedBuffer& buffer)
+{
+  std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(deviceHandle);
+  buffer.size = size;
+  if (!device->createBuffer(
+    size,
+    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+    &buffer.buffer,
+    &buffer.allocation
+#if KRENGINE_DEBUG_GPU_LABELS
+    , "Skinned Vertices"
+#endif
+  )) {
+    return false;
+  }
+  m_vboMemUsed += (long)size;
+  return true;
+}
+
+void KRMeshManager::releaseSkinnedBuffer(KrDeviceHandle deviceHandle, const SkinnedBuffer& buffer)
+{
+  std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(deviceHandle);
+  RetiredSkinnedBuffer retired;
+  retired.deviceHandle = deviceHandle;
+  // The frame being recorded, which has not been submitted yet, may also draw it
+  retired.frame = device->getGraphicsFramesSubmitted() + 1;
+  retired.buffer = buffer;
+
+  std::lock_guard<std::mutex> lock(m_retiredSkinnedBuffersMutex);
+  m_retiredSkinnedBuffers.push_back(retired);
+}
+
+void KRMeshManager::destroyRetiredSkinnedBuffers(bool force)
+{
+  std::lock_guard<std::mutex> lock(m_retiredSkinnedBuffersMutex);
+  auto itr = m_retiredSkinnedBuffers.begin();
+  while (itr != m_retiredSkinnedBuffers.end()) {
+    std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice((*itr).deviceHandle);
+    if (!force && device->getGraphicsFramesCompleted() < (*itr).frame) {
+      itr++;
+      continue;
+    }
+    vmaDestroyBuffer(device->getAllocator(), (*itr).buffer.buffer, (*itr).buffer.allocation);
+    m_vboMemUsed -= (long)(*itr).buffer.size;
+    itr = m_retiredSkinnedBuffers.erase(itr);
+  }
+}
+
 void KRMeshManager::initVolumetricLightingVertexes()
 {
   if (m_volumetricLightingVertexData.getSize() == 0) {
@@ -347,7 +648,7 @@ void KRMeshManager::initVolumetricLightingVertexes()
 
     }
 
-    KRENGINE_VBO_DATA_VOLUMETRIC_LIGHTING.init(this, &m_volumetricLightingVertexData, nullptr, (1 << KRMesh::KRENGINE_ATTRIB_VERTEX), false, KRVBOData::CONSTANT
+    KRENGINE_VBO_DATA_VOLUMETRIC_LIGHTING.init(this, &m_volumetricLightingVertexData, nullptr, VK_INDEX_TYPE_UINT16, (1 << KRMesh::KRENGINE_ATTRIB_VERTEX), false, KRVBOData::CONSTANT
 #if KRENGINE_DEBUG_GPU_LABELS
       , "Volumetric Lighting Planes [built-in]"
 #endif
@@ -393,7 +694,7 @@ void KRMeshManager::initRandomParticles()
       iVertex++;
     }
 
-    KRENGINE_VBO_DATA_RANDOM_PARTICLES.init(this, &m_randomParticleVertexData, nullptr, (1 << KRMesh::KRENGINE_ATTRIB_VERTEX) | (1 << KRMesh::KRENGINE_ATTRIB_TEXUVA), false, KRVBOData::CONSTANT
+    KRENGINE_VBO_DATA_RANDOM_PARTICLES.init(this, &m_randomParticleVertexData, nullptr, VK_INDEX_TYPE_UINT16, (1 << KRMesh::KRENGINE_ATTRIB_VERTEX) | (1 << KRMesh::KRENGINE_ATTRIB_TEXUVA), false, KRVBOData::CONSTANT
 #if KRENGINE_DEBUG_GPU_LABELS
       , "Random Particles [built-in]"
 #endif
@@ -441,6 +742,7 @@ KRMeshManager::KRVBOData::KRVBOData()
   m_type = STREAMING;
   m_data = NULL;
   m_index_data = NULL;
+  m_index_type = VK_INDEX_TYPE_UINT16;
   m_vertex_attrib_flags = 0;
   m_size = 0;
 
@@ -450,7 +752,7 @@ KRMeshManager::KRVBOData::KRVBOData()
   memset(m_allocations, 0, sizeof(AllocationInfo) * KRENGINE_MAX_GPU_COUNT);
 }
 
-KRMeshManager::KRVBOData::KRVBOData(KRMeshManager* manager, Block* data, Block* index_data, int vertex_attrib_flags, bool static_vbo, vbo_type t
+KRMeshManager::KRVBOData::KRVBOData(KRMeshManager* manager, Block* data, Block* index_data, VkIndexType index_type, int vertex_attrib_flags, bool static_vbo, vbo_type t
 #if KRENGINE_DEBUG_GPU_LABELS
   , const char* debug_label
 #endif
@@ -460,14 +762,14 @@ KRMeshManager::KRVBOData::KRVBOData(KRMeshManager* manager, Block* data, Block*
   memset(m_allocations, 0, sizeof(AllocationInfo) * KRENGINE_MAX_GPU_COUNT);
   m_is_vbo_loaded = false;
   m_is_vbo_ready = false;
-  init(manager, data, index_data, vertex_attrib_flags, static_vbo, t
+  init(manager, data, index_data, index_type, vertex_attrib_flags, static_vbo, t
 #if KRENGINE_DEBUG_GPU_LABELS
     , debug_label
 #endif
   );
 }
 
-void KRMeshManager::KRVBOData::init(KRMeshManager* manager, Block* data, Block* index_data, int vertex_attrib_flags, bool static_vbo, vbo_type t
+void KRMeshManager::KRVBOData::init(KRMeshManager* manager, Block* data, Block* index_data, VkIndexType index_type, int vertex_attrib_flags, bool static_vbo, vbo_type t
 #if KRENGINE_DEBUG_GPU_LABELS
   , const char* debug_label
 #endif
@@ -481,6 +783,7 @@ void KRMeshManager::KRVBOData::init(KRMeshManager* manager, Block* data, Block*
   m_static_vbo = static_vbo;
   m_data = data;
   m_index_data = index_data;
+  m_index_type = index_type;
   m_vertex_attrib_flags = vertex_attrib_flags;
 
   m_size = m_data->getSize();
@@ -545,9 +848,14 @@ void KRMeshManager::KRVBOData::load(VkCommandBuffer& commandBuffer)
     snprintf(debug_label, KRENGINE_DEBUG_GPU_LABEL_MAX_LEN, "%s Vertices: %s", type_label, m_debugLabel);
 #endif // KRENGINE_DEBUG_GPU_LABELS
 
+    // Skinned vertices may also be read by the skinning compute pre-pass
+    VkBufferUsageFlags vertexUsage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    if (m_vertex_attrib_flags & (1 << KRMesh::KRENGINE_ATTRIB_BONEINDEXES)) {
+      vertexUsage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    }
     device.createBuffer(
       m_data->getSize(),
-      VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+      vertexUsage,
       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
       &allocation.vertex_buffer,
       &allocation.vertex_allocation
@@ -622,13 +930,17 @@ void KRMeshManager::KRVBOData::unload()
 
 void KRMeshManager::KRVBOData::bind(VkCommandBuffer& commandBuffer)
 {
-  VkBuffer vertexBuffers[] = { getVertexBuffer() };
+  bind(commandBuffer, getVertexBuffer());
+}
+
+void KRMeshManager::KRVBOData::bind(VkCommandBuffer& commandBuffer, VkBuffer vertexBuffer)
+{
+  VkBuffer vertexBuffers[] = { vertexBuffer };
   VkDeviceSize offsets[] = { 0 };
   vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
 
   if (m_index_data && m_index_data->getSize() > 0) {
-    // TODO - Support 32-bit index buffers
-    vkCmdBindIndexBuffer(commandBuffer, getIndexBuffer(), 0, VK_INDEX_TYPE_UINT16);
+    vkCmdBindIndexBuffer(commandBuffer, getIndexBuffer(), 0, m_index_type);
   }
 }
 
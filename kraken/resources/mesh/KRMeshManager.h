@@ -40,6 +40,7 @@
 
 class KRContext;
 class KRMesh;
+class KRDevice;
 enum RenderPassType : uint8_t;
 
 class KRMeshManager : public KRResourceManager
@@ -47,6 +48,9 @@ class KRMeshManager : public KRResourceManager
 public:
   static const int KRENGINE_MAX_VOLUMETRIC_PLANES = 500;
   static const int KRENGINE_MAX_RANDOM_PARTICLES = 150000;
+  // Per frame in flight, limiting the work of the skinning pre-pass
+  static const int KRENGINE_MAX_SKINNING_DISPATCHES = 1024;
+  static const VkDeviceSize KRENGINE_SKINNING_PALETTE_SIZE = 1024 * 1024;
 
   KRMeshManager(KRContext& context);
   void init();
@@ -84,12 +88,12 @@ public:
     } vbo_type;
 
     KRVBOData();
-    KRVBOData(KRMeshManager* manager, mimir::Block* data, mimir::Block* index_data, int vertex_attrib_flags, bool static_vbo, vbo_type t
+    KRVBOData(KRMeshManager* manager, mimir::Block* data, mimir::Block* index_data, VkIndexType index_type, int vertex_attrib_flags, bool static_vbo, vbo_type t
 #if KRENGINE_DEBUG_GPU_LABELS
         , const char* debug_label
 #endif
     );
-    void init(KRMeshManager* manager, mimir::Block* data, mimir::Block* index_data, int vertex_attrib_flags, bool static_vbo, vbo_type t
+    void init(KRMeshManager* manager, mimir::Block* data, mimir::Block* index_data, VkIndexType index_type, int vertex_attrib_flags, bool static_vbo, vbo_type t
 #if KRENGINE_DEBUG_GPU_LABELS
       , const char* debug_label
 #endif
@@ -112,6 +116,8 @@ public:
     void load(VkCommandBuffer& commandBuffer);
     void unload();
     void bind(VkCommandBuffer& commandBuffer);
+    // Binds another vertex buffer with the same layout in place of this VBO's
+    void bind(VkCommandBuffer& commandBuffer, VkBuffer vertexBuffer);
 
     // KRMeshManager depends on the address of KRVBOData's being constant
     // after allocation.  This is enforced by deleted copy constructors.
@@ -144,6 +150,7 @@ public:
 
   private:
     KRMeshManager* m_manager;
+    VkIndexType m_index_type;
     int m_vertex_attrib_flags;
     long m_size;
 
@@ -171,6 +178,8 @@ public:
   };
 
   void bindVBO(VkCommandBuffer& commandBuffer, KRVBOData* vbo_data, float lodCoverage);
+  // Binds vertices skinned from vbo_data, drawn with vbo_data's indexes
+  void bindSkinnedVBO(VkCommandBuffer& commandBuffer, KRVBOData* vbo_data, VkBuffer vertexBuffer, float lodCoverage);
   long getMemUsed();
   long getMemActive();
 
@@ -210,6 +219,44 @@ public:
 
   void doStreaming(long& memoryRemaining, long& memoryRemainingThisFrame);
 
+  // Matches the push constants of skinning.comp.  Offsets are in 32-bit words,
+  // and are -1 for attributes that are not present.
+  struct SkinningConstants
+  {
+    uint32_t vertex_count;
+    uint32_t vertex_stride;
+    int32_t position_offset;
+    int32_t normal_offset;
+    int32_t tangent_offset;
+    int32_t bone_index_offset;
+    int32_t bone_weight_offset;
+    uint32_t flags;
+    uint32_t bone_count;
+  };
+  static const uint32_t SKINNING_NORMAL_SHORT = 1;
+  static const uint32_t SKINNING_TANGENT_SHORT = 2;
+  static const uint32_t SKINNING_TANGENT_BYTE = 4;
+  static const uint32_t SKINNING_BONEWEIGHTS_BYTE = 8;
+
+  struct SkinnedBuffer
+  {
+    VkBuffer buffer;
+    VmaAllocation allocation;
+    VkDeviceSize size;
+  };
+
+  // The skinning pre-pass records compute dispatches for the frame in flight
+  // between skinningStart and skinningEnd, then submits them to the compute
+  // queue.  Graphics submissions made afterwards wait for them.
+  bool skinningStart(KrDeviceHandle deviceHandle);
+  bool skinningUploadPalette(KrDeviceHandle deviceHandle, const std::vector<hydra::Matrix4>& bone_palette, VkDescriptorBufferInfo& paletteInfo);
+  bool skinningDispatch(KrDeviceHandle deviceHandle, VkBuffer source, const SkinnedBuffer& destination, const VkDescriptorBufferInfo& paletteInfo, const SkinningConstants& constants);
+  void skinningEnd(KrDeviceHandle deviceHandle);
+
+  bool createSkinnedBuffer(KrDeviceHandle deviceHandle, VkDeviceSize size, SkinnedBuffer& buffer);
+  // The buffer is destroyed once every frame that may draw it has completed
+  void releaseSkinnedBuffer(KrDeviceHandle deviceHandle, const SkinnedBuffer& buffer);
+
 private:
   mimir::Block KRENGINE_VBO_3D_CUBE_VERTICES;
   __int32_t KRENGINE_VBO_3D_CUBE_ATTRIBS;
@@ -237,6 +284,40 @@ private:
   std::mutex m_streamerFenceMutex;
   bool m_streamerComplete;
 
+  struct SkinningPipeline
+  {
+    bool supported;
+    VkDescriptorSetLayout descriptorSetLayout;
+    VkPipelineLayout pipelineLayout;
+    VkPipeline pipeline;
+    VkDescriptorPool descriptorPools[KRENGINE_MAX_FRAMES_IN_FLIGHT];
+    VkBuffer paletteBuffer;
+    VmaAllocation paletteAllocation;
+    uint8_t* paletteData;
+    // Range of the palette buffer belonging to the frame being recorded
+    VkDeviceSize paletteUsage;
+    VkDeviceSize paletteLimit;
+    VkCommandBuffer commandBuffer;
+    long frame; // Frame last skinned
+    int frameIndex;
+    int dispatchCount;
+  };
+  unordered_map<KrDeviceHandle, SkinningPipeline> m_skinningPipelines;
+
+  SkinningPipeline* getSkinningPipeline(KrDeviceHandle deviceHandle);
+  void destroySkinningPipeline(KRDevice& device, SkinningPipeline& skinning);
+
+  struct RetiredSkinnedBuffer
+  {
+    KrDeviceHandle deviceHandle;
+    uint64_t frame; // Graphics frame that must complete before the buffer is destroyed
+    SkinnedBuffer buffer;
+  };
+  std::mutex m_retiredSkinnedBuffersMutex;
+  std::vector<RetiredSkinnedBuffer> m_retiredSkinnedBuffers;
+
+  void destroyRetiredSkinnedBuffers(bool force);
+
   void balanceVBOMemory(long& memoryRemaining, long& memoryRemainingThisFrame);
 
   void primeVBO(KRVBOData* vbo_data);
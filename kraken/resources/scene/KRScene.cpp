@@ -34,20 +34,27 @@
 #include "nodes/KRLight.h"
 
 #include "KRScene.h"
+#include "KRSceneBinary.h"
 #include "nodes/KRNode.h"
 #include "nodes/KRDirectionalLight.h"
 #include "nodes/KRSpotLight.h"
 #include "nodes/KRPointLight.h"
+#include "nodes/KRLODSet.h"
 #include "resources/audio/KRAudioManager.h"
 #include "resources/KRResourceRequest.h"
 #include "KRRenderPass.h"
+#include "KRThreadPool.h"
 
 using namespace mimir;
 using namespace hydra;
 
-KRScene::KRScene(KRContext& context, std::string name) : KRResource(context, name)
+KRScene::KRScene(KRContext& context, std::string name) : KRResource(context, name), m_nodeRegistry(KRNodeRegistry::Kind::scene)
 {
   m_pFirstLight = NULL;
+  m_binaryFormat = false;
+  m_attachedLODSetCount = 0;
+  m_lodSetsSorted = true;
+  m_lodNodesVisited = 0;
   m_pRootNode = new KRNode(*this, "scene_root");
   notify_sceneGraphCreate(m_pRootNode);
 }
@@ -102,6 +109,11 @@ std::set<KRLight*>& KRScene::getLights()
   return m_lights;
 }
 
+const KRNodeRegistry& KRScene::getNodeRegistry() const
+{
+  return m_nodeRegistry;
+}
+
 void KRScene::render(KRNode::RenderInfo& ri)
 {
   std::list<KRResourceRequest> resourceRequests;
@@ -113,21 +125,10 @@ void KRScene::render(KRNode::RenderInfo& ri)
   std::set<KRNode*> outerNodes = std::set<KRNode*>(m_nodeTree.getOuterSceneNodes()); // HACK - Copying the std::set as it is potentially modified as KRNode's update their bounds during the iteration.  This is very expensive and will be eliminated in the future.
 
   // Get lights from outer nodes (directional lights, which have no bounds)
-  for (std::set<KRNode*>::iterator itr = outerNodes.begin(); itr != outerNodes.end(); itr++) {
-    KRNode* node = (*itr);
-    KRPointLight* point_light = dynamic_cast<KRPointLight*>(node);
-    if (point_light) {
-      ri.point_lights.push_back(point_light);
-    }
-    KRDirectionalLight* directional_light = dynamic_cast<KRDirectionalLight*>(node);
-    if (directional_light) {
-      ri.directional_lights.push_back(directional_light);
-    }
-    KRSpotLight* spot_light = dynamic_cast<KRSpotLight*>(node);
-    if (spot_light) {
-      ri.spot_lights.push_back(spot_light);
-    }
-  }
+  const KRNodeRegistry& outerRegistry = m_nodeTree.getOuterNodeRegistry();
+  ri.point_lights.insert(ri.point_lights.end(), outerRegistry.getPointLights().begin(), outerRegistry.getPointLights().end());
+  ri.directional_lights.insert(ri.directional_lights.end(), outerRegistry.getDirectionalLights().begin(), outerRegistry.getDirectionalLights().end());
+  ri.spot_lights.insert(ri.spot_lights.end(), outerRegistry.getSpotLights().begin(), outerRegistry.getSpotLights().end());
 
   // Render outer nodes
   for (std::set<KRNode*>::iterator itr = outerNodes.begin(); itr != outerNodes.end(); itr++) {
@@ -186,27 +187,13 @@ void KRScene::render(KRNode::RenderInfo& ri, std::list<KRResourceRequest>& resou
     if (in_viewport) {
 
       // Add lights that influence this octree level and its children to the stack
-      int directional_light_count = 0;
-      int spot_light_count = 0;
-      int point_light_count = 0;
-      for (std::set<KRNode*>::iterator itr = pOctreeNode->getSceneNodes().begin(); itr != pOctreeNode->getSceneNodes().end(); itr++) {
-        KRNode* node = (*itr);
-        KRDirectionalLight* directional_light = dynamic_cast<KRDirectionalLight*>(node);
-        if (directional_light) {
-          ri.directional_lights.push_back(directional_light);
-          directional_light_count++;
-        }
-        KRSpotLight* spot_light = dynamic_cast<KRSpotLight*>(node);
-        if (spot_light) {
-          ri.spot_lights.push_back(spot_light);
-          spot_light_count++;
-        }
-        KRPointLight* point_light = dynamic_cast<KRPointLight*>(node);
-        if (point_light) {
-          ri.point_lights.push_back(point_light);
-          point_light_count++;
-        }
-      }
+      const KRNodeRegistry& registry = pOctreeNode->getNodeRegistry();
+      int directional_light_count = (int)registry.getDirectionalLights().size();
+      int spot_light_count = (int)registry.getSpotLights().size();
+      int point_light_count = (int)registry.getPointLights().size();
+      ri.directional_lights.insert(ri.directional_lights.end(), registry.getDirectionalLights().begin(), registry.getDirectionalLights().end());
+      ri.spot_lights.insert(ri.spot_lights.end(), registry.getSpotLights().begin(), registry.getSpotLights().end());
+      ri.point_lights.insert(ri.point_lights.end(), registry.getPointLights().begin(), registry.getPointLights().end());
 
       // Render objects that are at this octree level
       for (std::set<KRNode*>::iterator itr = pOctreeNode->getSceneNodes().begin(); itr != pOctreeNode->getSceneNodes().end(); itr++) {
@@ -250,9 +237,22 @@ void KRScene::render(KRNode::RenderInfo& ri, std::list<KRResourceRequest>& resou
 
 std::string KRScene::getExtension()
 {
+  if (m_binaryFormat) {
+    return "krscenebin";
+  }
   return "krscene";
 }
 
+void KRScene::setBinaryFormat(bool binaryFormat)
+{
+  m_binaryFormat = binaryFormat;
+}
+
+bool KRScene::getBinaryFormat() const
+{
+  return m_binaryFormat;
+}
+
 KRNode* KRScene::getRootNode()
 {
   return m_pRootNode;
@@ -260,6 +260,15 @@ KRNode* KRScene::getRootNode()
 
 bool KRScene::save(Block& data)
 {
+  if (m_binaryFormat) {
+    // As with .krscene files, the root node itself is stored and is
+    // re-parented under the root of the scene when loaded.
+    KRSceneBinaryWriter writer;
+    writer.addNode(m_pRootNode, KRSceneBinary::kNoParent);
+    writer.write(data);
+    return true;
+  }
+
   tinyxml2::XMLDocument doc;
   tinyxml2::XMLElement* scene_node = doc.NewElement("scene");
   doc.InsertEndChild(scene_node);
@@ -274,6 +283,23 @@ bool KRScene::save(Block& data)
 
 KRScene* KRScene::Load(KRContext& context, const std::string& name, Block* data)
 {
+  data->lock();
+  if (KRSceneBinaryReader::IsBinaryScene(data->getStart(), data->getSize())) {
+    KRScene* new_scene = new KRScene(context, name);
+    new_scene->setBinaryFormat(true);
+    KRSceneBinaryReader reader(data->getStart(), data->getSize());
+    bool loaded = reader.load(*new_scene);
+    data->unlock();
+    delete data;
+    if (!loaded) {
+      KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Invalid binary scene: %s", name.c_str());
+      delete new_scene;
+      return nullptr;
+    }
+    return new_scene;
+  }
+  data->unlock();
+
   std::string xml_string = data->getString();
   delete data;
   tinyxml2::XMLDocument doc;
@@ -339,16 +365,184 @@ void KRScene::notify_sceneGraphDelete(KRNode* pNode)
   if (light) {
     m_lights.erase(light);
   }
+  m_nodeRegistry.remove(pNode);
   m_modifiedNodes.erase(pNode);
   if (!m_newNodes.erase(pNode)) {
     m_nodeTree.remove(pNode);
   }
 }
 
-void KRScene::updateOctree(const KRViewport& viewport)
+void KRScene::notify_nodeCreate(KRNode* pNode)
+{
+  m_nodeNames.insert(std::pair<std::string, KRNode*>(pNode->getName(), pNode));
+}
+
+void KRScene::notify_nodeRename(KRNode* pNode, const std::string& previousName)
+{
+  auto range = m_nodeNames.equal_range(previousName);
+  for (auto itr = range.first; itr != range.second; itr++) {
+    if (itr->second == pNode) {
+      m_nodeNames.erase(itr);
+      break;
+    }
+  }
+  m_nodeNames.insert(std::pair<std::string, KRNode*>(pNode->getName(), pNode));
+}
+
+void KRScene::notify_nodeDestroy(KRNode* pNode)
+{
+  auto range = m_nodeNames.equal_range(pNode->getName());
+  for (auto itr = range.first; itr != range.second; itr++) {
+    if (itr->second == pNode) {
+      m_nodeNames.erase(itr);
+      break;
+    }
+  }
+
+  auto handleRange = m_nodeHandleNodes.equal_range(pNode);
+  for (auto itr = handleRange.first; itr != handleRange.second; itr++) {
+    m_nodeHandles[itr->second] = nullptr;
+  }
+  m_nodeHandleNodes.erase(pNode);
+}
+
+void KRScene::setNodeHandle(KrSceneNodeMapIndex nodeHandle, KRNode* pNode)
+{
+  if (static_cast<size_t>(nodeHandle) >= m_nodeHandles.size()) {
+    m_nodeHandles.resize(nodeHandle + 1, nullptr);
+  }
+  KRNode* previousNode = m_nodeHandles[nodeHandle];
+  if (previousNode) {
+    auto range = m_nodeHandleNodes.equal_range(previousNode);
+    for (auto itr = range.first; itr != range.second; itr++) {
+      if (itr->second == nodeHandle) {
+        m_nodeHandleNodes.erase(itr);
+        break;
+      }
+    }
+  }
+  m_nodeHandles[nodeHandle] = pNode;
+  if (pNode) {
+    m_nodeHandleNodes.insert(std::pair<KRNode*, KrSceneNodeMapIndex>(pNode, nodeHandle));
+  }
+}
+
+KRNode* KRScene::getNodeByHandle(KrSceneNodeMapIndex nodeHandle)
+{
+  if (nodeHandle == KR_NULL_HANDLE) {
+    return m_pRootNode;
+  }
+  if (nodeHandle < 0 || static_cast<size_t>(nodeHandle) >= m_nodeHandles.size()) {
+    return nullptr;
+  }
+  return m_nodeHandles[nodeHandle];
+}
+
+size_t KRScene::getNodeCount(const std::string& name)
+{
+  return m_nodeNames.count(name);
+}
+
+KRTransformHierarchy& KRScene::getTransformHierarchy()
+{
+  return m_transformHierarchy;
+}
+
+void KRScene::notify_lodSetCreate(KRLODSet* pLODSet)
+{
+  m_lodSets.push_back(pLODSet);
+  m_lodSetsSorted = false;
+}
+
+void KRScene::notify_lodSetDestroy(KRLODSet* pLODSet)
+{
+  m_lodSets.erase(std::remove(m_lodSets.begin(), m_lodSets.end(), pLODSet), m_lodSets.end());
+  m_lodSetsSorted = false;
+}
+
+void KRScene::notify_sceneGraphReparent(KRNode* pNode)
+{
+  if (!m_lodSets.empty()) {
+    m_lodSetsSorted = false;
+  }
+}
+
+void KRScene::notify_lodNodeVisit()
+{
+  m_lodNodesVisited++;
+}
+
+size_t KRScene::getLODNodesVisited() const
 {
+  return m_lodNodesVisited;
+}
+
+void KRScene::sortLODSets()
+{
+  // Sort by depth so that LOD sets nested within LOD groups are updated after
+  // the LOD sets that contain them.  Detached LOD sets are moved to the end.
+  const size_t kDetached = std::numeric_limits<size_t>::max();
+  std::vector<std::pair<size_t, KRLODSet*>> depths;
+  depths.reserve(m_lodSets.size());
+  for (KRLODSet* lodSet : m_lodSets) {
+    size_t depth = 0;
+    KRNode* node = lodSet;
+    while (node->getParent() != nullptr) {
+      node = node->getParent();
+      depth++;
+    }
+    depths.push_back(std::make_pair(node == m_pRootNode ? depth : kDetached, lodSet));
+  }
+  std::stable_sort(depths.begin(), depths.end(), [](const std::pair<size_t, KRLODSet*>& a, const std::pair<size_t, KRLODSet*>& b) {
+    return a.first < b.first;
+  });
+
+  m_attachedLODSetCount = 0;
+  for (size_t i = 0; i < depths.size(); i++) {
+    m_lodSets[i] = depths[i].second;
+    if (depths[i].first != kDetached) {
+      m_attachedLODSetCount++;
+    }
+  }
+  m_lodSetsSorted = true;
+}
+
+void KRScene::updateLODVisibility(const KRViewport& viewport)
+{
+  m_lodNodesVisited = 0;
   m_pRootNode->setLODVisibility(KRNode::LOD_VISIBILITY_VISIBLE);
-  m_pRootNode->updateLODVisibility(viewport);
+
+  if (!m_lodSetsSorted) {
+    sortLODSets();
+  }
+  for (size_t i = 0; i < m_attachedLODSetCount; i++) {
+    m_lodNodesVisited++;
+    m_lodSets[i]->updateLODVisibility(viewport);
+  }
+}
+
+void KRScene::skinModels(KrDeviceHandle deviceHandle, const KRViewport& viewport)
+{
+  // Skin each visible model once per frame with a compute dispatch, so that
+  // every pass can draw the result as static geometry.  Models that are not
+  // skinned here fall back to skinning in the vertex shader.
+  KRMeshManager* meshManager = getContext().getMeshManager();
+  if (!meshManager->skinningStart(deviceHandle)) {
+    return;
+  }
+  for (KRModel* model : m_nodeRegistry.getModels()) {
+    if (model->getLODVisibility() == KRNode::LOD_VISIBILITY_VISIBLE) {
+      model->skin(deviceHandle, viewport);
+    }
+  }
+  meshManager->skinningEnd(deviceHandle);
+}
+
+void KRScene::updateOctree(const KRViewport& viewport)
+{
+  m_transformHierarchy.update(*getContext().getThreadPool());
+
+  updateLODVisibility(viewport);
 
   std::set<KRNode*> newNodes = std::move(m_newNodes);
   std::set<KRNode*> modifiedNodes = std::move(m_modifiedNodes);
@@ -380,6 +574,7 @@ void KRScene::updateOctree(const KRViewport& viewport)
     if (light) {
       m_lights.insert(light);
     }
+    m_nodeRegistry.add(node);
   }
   for (std::set<KRNode*>::iterator itr = modifiedNodes.begin(); itr != modifiedNodes.end(); itr++) {
     KRNode* node = *itr;
@@ -426,6 +621,7 @@ void KRScene::buildOctreeForTheFirstTime()
     if (light) {
       m_lights.insert(light);
     }
+    m_nodeRegistry.add(node);
   }
 }
 
@@ -434,6 +630,9 @@ void KRScene::physicsUpdate(float deltaTime)
   for (std::set<KRNode*>::iterator itr = m_physicsNodes.begin(); itr != m_physicsNodes.end(); itr++) {
     (*itr)->physicsUpdate(deltaTime);
   }
+
+  // Apply the transform changes made during the update in one batch
+  m_transformHierarchy.update(*getContext().getThreadPool());
 }
 
 void KRScene::addDefaultLights()
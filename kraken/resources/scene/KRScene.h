@@ -42,8 +42,11 @@
 #include "nodes/KRAmbientZone.h"
 #include "nodes/KRReverbZone.h"
 #include "KROctree.h"
+#include "KRTransformHierarchy.h"
+#include "KRNodeRegistry.h"
 class KRModel;
 class KRLight;
+class KRLODSet;
 class KRSurface;
 class KRRenderGraph;
 
@@ -62,6 +65,10 @@ public:
 
   static KRScene* Load(KRContext& context, const std::string& name, mimir::Block* data);
 
+  // When set, the scene is saved as a .krscenebin rather than a .krscene
+  void setBinaryFormat(bool binaryFormat);
+  bool getBinaryFormat() const;
+
   KRNode* getRootNode();
   KRLight* getFirstLight();
 
@@ -75,11 +82,29 @@ public:
   void render(KRNode::RenderInfo& ri);
 
   void updateOctree(const KRViewport& viewport);
+  void skinModels(KrDeviceHandle deviceHandle, const KRViewport& viewport);
   void buildOctreeForTheFirstTime();
 
   void notify_sceneGraphCreate(KRNode* pNode);
   void notify_sceneGraphDelete(KRNode* pNode);
   void notify_sceneGraphModify(KRNode* pNode);
+  void notify_sceneGraphReparent(KRNode* pNode);
+
+  void notify_nodeCreate(KRNode* pNode);
+  void notify_nodeRename(KRNode* pNode, const std::string& previousName);
+  void notify_nodeDestroy(KRNode* pNode);
+
+  void notify_lodSetCreate(KRLODSet* pLODSet);
+  void notify_lodSetDestroy(KRLODSet* pLODSet);
+  void notify_lodNodeVisit();
+  // Number of nodes visited while updating LOD visibility in the last frame
+  size_t getLODNodesVisited() const;
+
+  void setNodeHandle(KrSceneNodeMapIndex nodeHandle, KRNode* pNode);
+  KRNode* getNodeByHandle(KrSceneNodeMapIndex nodeHandle);
+  size_t getNodeCount(const std::string& name);
+
+  KRTransformHierarchy& getTransformHierarchy();
 
   void physicsUpdate(float deltaTime);
   void addDefaultLights();
@@ -90,13 +115,17 @@ public:
   std::set<KRReverbZone*>& getReverbZones();
   std::set<KRLocator*>& getLocators();
   std::set<KRLight*>& getLights();
+  const KRNodeRegistry& getNodeRegistry() const;
 
 private:
   void render(KRNode::RenderInfo& ri, std::list<KRResourceRequest>& resourceRequests, KROctreeNode* pOctreeNodey);
+  void updateLODVisibility(const KRViewport& viewport);
+  void sortLODSets();
 
 
   KRNode* m_pRootNode;
   KRLight* m_pFirstLight;
+  bool m_binaryFormat;
 
   std::set<KRNode*> m_newNodes;
   std::set<KRNode*> m_modifiedNodes;
@@ -109,8 +138,27 @@ private:
   std::set<KRLocator*> m_locatorNodes;
   std::set<KRLight*> m_lights;
   std::set<KRNode*> m_alwaysStreamedNodes;
+  KRNodeRegistry m_nodeRegistry;
+
+  // Index of every node in the scene, including nodes not yet attached to the graph.
+  // Multiple nodes may share a name.
+  unordered_multimap<std::string, KRNode*> m_nodeNames;
+
+  // Public API node handles. m_nodeHandleNodes is the reverse mapping, used to
+  // release the handles of a node when it is destroyed.
+  std::vector<KRNode*> m_nodeHandles;
+  unordered_multimap<KRNode*, KrSceneNodeMapIndex> m_nodeHandleNodes;
 
   KROctree m_nodeTree;
+  KRTransformHierarchy m_transformHierarchy;
+
+  // LOD sets attached to the scene graph, outermost first, followed by
+  // detached LOD sets.  Only LOD sets are visited when updating LOD visibility,
+  // rather than the entire scene graph.
+  std::vector<KRLODSet*> m_lodSets;
+  size_t m_attachedLODSetCount;
+  bool m_lodSetsSorted;
+  size_t m_lodNodesVisited;
 
 public:
 
@@ -122,7 +170,24 @@ public:
 
   template <class T> T* find(const std::string& name)
   {
-    if (m_pRootNode) return m_pRootNode->find<T>(name);
+    auto range = m_nodeNames.equal_range(name);
+    for (auto itr = range.first; itr != range.second; itr++) {
+      T* match = dynamic_cast<T*>(itr->second);
+      if (match) {
+        return match;
+      }
+    }
     return NULL;
   }
+
+  template <class T> void findAll(const std::string& name, std::vector<T*>& matches)
+  {
+    auto range = m_nodeNames.equal_range(name);
+    for (auto itr = range.first; itr != range.second; itr++) {
+      T* match = dynamic_cast<T*>(itr->second);
+      if (match) {
+        matches.push_back(match);
+      }
+    }
+  }
 };
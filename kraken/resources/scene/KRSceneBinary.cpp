@@ -0,0 +1,366 @@
+//
+//  KRSceneBinary.cpp
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+
+#include "KRSceneBinary.h"
+#include "KRScene.h"
+#include "nodes/KRNode.h"
+#include "resources/KRResourceBinding.h"
+
+using namespace mimir;
+using namespace hydra;
+using namespace KRSceneBinary;
+
+namespace {
+
+uint32_t FloatToWord(float f)
+{
+  uint32_t word;
+  memcpy(&word, &f, sizeof(word));
+  return word;
+}
+
+float WordToFloat(uint32_t word)
+{
+  float f;
+  memcpy(&f, &word, sizeof(f));
+  return f;
+}
+
+} // anonymous namespace
+
+KRSceneBinaryWriter::KRSceneBinaryWriter()
+{
+  // String table offset 0 is always the empty string
+  addString("");
+}
+
+uint32_t KRSceneBinaryWriter::addString(const std::string& str)
+{
+  auto itr = m_stringOffsets.find(str);
+  if (itr != m_stringOffsets.end()) {
+    return itr->second;
+  }
+  uint32_t offset = (uint32_t)m_strings.size();
+  m_strings.insert(m_strings.end(), str.begin(), str.end());
+  m_strings.push_back('\0');
+  m_stringOffsets[str] = offset;
+  return offset;
+}
+
+void KRSceneBinaryWriter::addProperty(const char* name, PropertyType type, const uint32_t* values, size_t valueCount)
+{
+  KRSceneBinaryProperty property;
+  property.name = addString(name);
+  property.type = type;
+  property.value = (uint32_t)m_values.size();
+  m_values.insert(m_values.end(), values, values + valueCount);
+  m_properties.push_back(property);
+}
+
+void KRSceneBinaryWriter::addNode(KRNode* node, int32_t parent)
+{
+  int32_t nodeIndex = (int32_t)m_nodes.size();
+  KRSceneBinaryNode record;
+  record.elementName = addString(node->getElementName());
+  record.name = addString(node->getName());
+  record.parent = parent;
+  record.firstProperty = (uint32_t)m_properties.size();
+  node->visitProperties(*this);
+  record.propertyCount = (uint32_t)m_properties.size() - record.firstProperty;
+  m_nodes.push_back(record);
+
+  for (KRNode* child = node->m_firstChildNode; child != nullptr; child = child->m_nextNode) {
+    addNode(child, nodeIndex);
+  }
+}
+
+void KRSceneBinaryWriter::write(Block& data)
+{
+  KRSceneBinaryHeader header;
+  memcpy(header.magic, kMagic, sizeof(header.magic));
+  header.version = kVersion;
+  header.nodeCount = (uint32_t)m_nodes.size();
+  header.propertyCount = (uint32_t)m_properties.size();
+  header.valueCount = (uint32_t)m_values.size();
+  header.stringTableSize = (uint32_t)m_strings.size();
+  header.nodeTableOffset = sizeof(KRSceneBinaryHeader);
+  header.propertyTableOffset = header.nodeTableOffset + header.nodeCount * sizeof(KRSceneBinaryNode);
+  header.valueTableOffset = header.propertyTableOffset + header.propertyCount * sizeof(KRSceneBinaryProperty);
+  header.stringTableOffset = header.valueTableOffset + header.valueCount * sizeof(uint32_t);
+
+  data.append(&header, sizeof(header));
+  if (!m_nodes.empty()) {
+    data.append(m_nodes.data(), m_nodes.size() * sizeof(KRSceneBinaryNode));
+  }
+  if (!m_properties.empty()) {
+    data.append(m_properties.data(), m_properties.size() * sizeof(KRSceneBinaryProperty));
+  }
+  if (!m_values.empty()) {
+    data.append(m_values.data(), m_values.size() * sizeof(uint32_t));
+  }
+  data.append(m_strings.data(), m_strings.size());
+}
+
+void KRSceneBinaryWriter::visit(const char* name, int& val, int defaultVal)
+{
+  uint32_t value = (uint32_t)val;
+  addProperty(name, PROPERTY_TYPE_INT, &value, 1);
+}
+
+void KRSceneBinaryWriter::visit(const char* name, unsigned int& val, unsigned int defaultVal)
+{
+  uint32_t value = val;
+  addProperty(name, PROPERTY_TYPE_UNSIGNED_INT, &value, 1);
+}
+
+void KRSceneBinaryWriter::visit(const char* name, float& val, float defaultVal)
+{
+  uint32_t value = FloatToWord(val);
+  addProperty(name, PROPERTY_TYPE_FLOAT, &value, 1);
+}
+
+void KRSceneBinaryWriter::visit(const char* name, bool& val, bool defaultVal)
+{
+  uint32_t value = val ? 1 : 0;
+  addProperty(name, PROPERTY_TYPE_BOOL, &value, 1);
+}
+
+void KRSceneBinaryWriter::visit(const char* name, Vector3& val, const Vector3& defaultVal)
+{
+  uint32_t values[3] = { FloatToWord(val.x), FloatToWord(val.y), FloatToWord(val.z) };
+  addProperty(name, PROPERTY_TYPE_VECTOR3, values, 3);
+}
+
+void KRSceneBinaryWriter::visit(const char* name, AABB& val, const AABB& defaultVal)
+{
+  uint32_t values[6] = {
+    FloatToWord(val.min.x), FloatToWord(val.min.y), FloatToWord(val.min.z),
+    FloatToWord(val.max.x), FloatToWord(val.max.y), FloatToWord(val.max.z)
+  };
+  addProperty(name, PROPERTY_TYPE_AABB, values, 6);
+}
+
+void KRSceneBinaryWriter::visit(const char* name, std::string& val, const std::string& defaultVal)
+{
+  uint32_t value = addString(val);
+  addProperty(name, PROPERTY_TYPE_STRING, &value, 1);
+}
+
+void KRSceneBinaryWriter::visit(const char* name, KRResourceBinding& val)
+{
+  uint32_t value = addString(val.getName());
+  addProperty(name, PROPERTY_TYPE_RESOURCE_BINDING, &value, 1);
+}
+
+KRSceneBinaryReader::KRSceneBinaryReader(const void* start, size_t size)
+  : m_start((const uint8_t*)start)
+  , m_size(size)
+  , m_header(nullptr)
+  , m_nodes(nullptr)
+  , m_properties(nullptr)
+  , m_values(nullptr)
+  , m_strings(nullptr)
+  , m_propertyStart(0)
+  , m_propertyEnd(0)
+  , m_propertyCursor(0)
+{
+  if (IsBinaryScene(start, size)) {
+    m_header = (const KRSceneBinaryHeader*)m_start;
+  }
+}
+
+bool KRSceneBinaryReader::IsBinaryScene(const void* start, size_t size)
+{
+  if (start == nullptr || size < sizeof(KRSceneBinaryHeader)) {
+    return false;
+  }
+  return memcmp(start, kMagic, sizeof(kMagic)) == 0;
+}
+
+bool KRSceneBinaryReader::validate() const
+{
+  if (m_header == nullptr || m_header->version != kVersion) {
+    return false;
+  }
+  auto tableFits = [this](uint32_t offset, uint64_t count, uint64_t elementSize) {
+    return offset % sizeof(uint32_t) == 0 && (uint64_t)offset + count * elementSize <= m_size;
+  };
+  if (!tableFits(m_header->nodeTableOffset, m_header->nodeCount, sizeof(KRSceneBinaryNode))
+    || !tableFits(m_header->propertyTableOffset, m_header->propertyCount, sizeof(KRSceneBinaryProperty))
+    || !tableFits(m_header->valueTableOffset, m_header->valueCount, sizeof(uint32_t))
+    || (uint64_t)m_header->stringTableOffset + m_header->stringTableSize > m_size) {
+    return false;
+  }
+  // The string table must be terminated so that getString can not run off the end
+  if (m_header->stringTableSize == 0 || m_start[m_header->stringTableOffset + m_header->stringTableSize - 1] != '\0') {
+    return false;
+  }
+  return true;
+}
+
+const char* KRSceneBinaryReader::getString(uint32_t offset) const
+{
+  if (offset >= m_header->stringTableSize) {
+    return "";
+  }
+  return m_strings + offset;
+}
+
+bool KRSceneBinaryReader::load(KRScene& scene)
+{
+  if (!validate()) {
+    return false;
+  }
+  m_nodes = (const KRSceneBinaryNode*)(m_start + m_header->nodeTableOffset);
+  m_properties = (const KRSceneBinaryProperty*)(m_start + m_header->propertyTableOffset);
+  m_values = (const uint32_t*)(m_start + m_header->valueTableOffset);
+  m_strings = (const char*)(m_start + m_header->stringTableOffset);
+
+  std::vector<KRNode*> nodes(m_header->nodeCount, nullptr);
+  for (uint32_t i = 0; i < m_header->nodeCount; i++) {
+    const KRSceneBinaryNode& record = m_nodes[i];
+
+    // Parents are always written before their children.  If a parent could
+    // not be created, its subtree is skipped as it would be for a .krscene.
+    KRNode* parent = nullptr;
+    if (record.parent == kNoParent) {
+      parent = scene.getRootNode();
+    } else if (record.parent >= 0 && (uint32_t)record.parent < i) {
+      parent = nodes[record.parent];
+    }
+    if (parent == nullptr) {
+      continue;
+    }
+    if (record.firstProperty > m_header->propertyCount || record.propertyCount > m_header->propertyCount - record.firstProperty) {
+      return false;
+    }
+
+    KRNode* node = KRNode::CreateFromElementName(scene, getString(record.elementName), getString(record.name));
+    if (node == nullptr) {
+      continue;
+    }
+    m_propertyStart = record.firstProperty;
+    m_propertyEnd = record.firstProperty + record.propertyCount;
+    m_propertyCursor = m_propertyStart;
+    node->visitProperties(*this);
+    node->propertiesLoaded();
+
+    parent->appendChild(node);
+    nodes[i] = node;
+  }
+  return true;
+}
+
+const uint32_t* KRSceneBinaryReader::findProperty(const char* name, PropertyType type, size_t valueCount)
+{
+  // Properties are written in the order they are visited, so the property
+  // following the last match is almost always the one requested.  The
+  // remaining properties of the node are searched to tolerate files written
+  // with a different set of properties.
+  uint32_t propertyCount = m_propertyEnd - m_propertyStart;
+  for (uint32_t i = 0; i < propertyCount; i++) {
+    uint32_t index = m_propertyCursor + i;
+    if (index >= m_propertyEnd) {
+      index -= propertyCount;
+    }
+    const KRSceneBinaryProperty& property = m_properties[index];
+    if (strcmp(getString(property.name), name) == 0) {
+      m_propertyCursor = index + 1;
+      if (property.type != type || (uint64_t)property.value + valueCount > m_header->valueCount) {
+        return nullptr;
+      }
+      return m_values + property.value;
+    }
+  }
+  return nullptr;
+}
+
+void KRSceneBinaryReader::visit(const char* name, int& val, int defaultVal)
+{
+  const uint32_t* value = findProperty(name, PROPERTY_TYPE_INT, 1);
+  val = value ? (int)*value : defaultVal;
+}
+
+void KRSceneBinaryReader::visit(const char* name, unsigned int& val, unsigned int defaultVal)
+{
+  const uint32_t* value = findProperty(name, PROPERTY_TYPE_UNSIGNED_INT, 1);
+  val = value ? *value : defaultVal;
+}
+
+void KRSceneBinaryReader::visit(const char* name, float& val, float defaultVal)
+{
+  const uint32_t* value = findProperty(name, PROPERTY_TYPE_FLOAT, 1);
+  val = value ? WordToFloat(*value) : defaultVal;
+}
+
+void KRSceneBinaryReader::visit(const char* name, bool& val, bool defaultVal)
+{
+  const uint32_t* value = findProperty(name, PROPERTY_TYPE_BOOL, 1);
+  val = value ? *value != 0 : defaultVal;
+}
+
+void KRSceneBinaryReader::visit(const char* name, Vector3& val, const Vector3& defaultVal)
+{
+  const uint32_t* value = findProperty(name, PROPERTY_TYPE_VECTOR3, 3);
+  if (value) {
+    val = Vector3::Create(WordToFloat(value[0]), WordToFloat(value[1]), WordToFloat(value[2]));
+  } else {
+    val = defaultVal;
+  }
+}
+
+void KRSceneBinaryReader::visit(const char* name, AABB& val, const AABB& defaultVal)
+{
+  const uint32_t* value = findProperty(name, PROPERTY_TYPE_AABB, 6);
+  if (value) {
+    val = AABB::Create(
+      Vector3::Create(WordToFloat(value[0]), WordToFloat(value[1]), WordToFloat(value[2])),
+      Vector3::Create(WordToFloat(value[3]), WordToFloat(value[4]), WordToFloat(value[5])));
+  } else {
+    val = defaultVal;
+  }
+}
+
+void KRSceneBinaryReader::visit(const char* name, std::string& val, const std::string& defaultVal)
+{
+  const uint32_t* value = findProperty(name, PROPERTY_TYPE_STRING, 1);
+  val = value ? getString(*value) : defaultVal;
+}
+
+void KRSceneBinaryReader::visit(const char* name, KRResourceBinding& val)
+{
+  const uint32_t* value = findProperty(name, PROPERTY_TYPE_RESOURCE_BINDING, 1);
+  const char* resourceName = value ? getString(*value) : "";
+  if (resourceName[0] == '\0') {
+    val.clear();
+  } else {
+    val.set(resourceName);
+  }
+}
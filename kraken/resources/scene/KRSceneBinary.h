@@ -0,0 +1,166 @@
+//
+//  KRSceneBinary.h
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+
+#pragma once
+
+#include "KREngine-common.h"
+#include "nodes/KRNodeProperty.h"
+#include "block.h"
+
+class KRNode;
+class KRScene;
+
+// .krscenebin is a binary encoding of the same node hierarchy and KRNodeProperty
+// values stored in a .krscene file.  All tables are flat and addressed by byte
+// offsets from the start of the file, so a scene can be loaded directly from a
+// memory mapped mimir::Block without any per-attribute parsing.
+//
+// Layout:
+//   KRSceneBinaryHeader
+//   KRSceneBinaryNode[nodeCount]          (depth first, parents before children)
+//   KRSceneBinaryProperty[propertyCount]  (grouped by node)
+//   uint32_t[valueCount]                  (property values, 32-bit words)
+//   char[stringTableSize]                 (null terminated strings)
+namespace KRSceneBinary {
+
+const char kMagic[8] = { 'K', 'R', 'S', 'C', 'N', 'B', 'I', 'N' };
+const uint32_t kVersion = 1;
+const int32_t kNoParent = -1;
+
+enum PropertyType : uint32_t
+{
+  PROPERTY_TYPE_INT = 0,
+  PROPERTY_TYPE_UNSIGNED_INT,
+  PROPERTY_TYPE_FLOAT,
+  PROPERTY_TYPE_BOOL,
+  PROPERTY_TYPE_VECTOR3,
+  PROPERTY_TYPE_AABB,
+  PROPERTY_TYPE_STRING,
+  PROPERTY_TYPE_RESOURCE_BINDING
+};
+
+} // namespace KRSceneBinary
+
+typedef struct
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t nodeCount;
+  uint32_t propertyCount;
+  uint32_t valueCount;
+  uint32_t stringTableSize;
+  uint32_t nodeTableOffset;
+  uint32_t propertyTableOffset;
+  uint32_t valueTableOffset;
+  uint32_t stringTableOffset;
+} KRSceneBinaryHeader;
+
+typedef struct
+{
+  uint32_t elementName; // String table offset
+  uint32_t name; // String table offset
+  int32_t parent; // Index into the node table, or KRSceneBinary::kNoParent for children of the scene root
+  uint32_t firstProperty; // Index into the property table
+  uint32_t propertyCount;
+} KRSceneBinaryNode;
+
+typedef struct
+{
+  uint32_t name; // String table offset
+  uint32_t type; // KRSceneBinary::PropertyType
+  uint32_t value; // Index into the value table.  Strings store a string table offset.
+} KRSceneBinaryProperty;
+
+class KRSceneBinaryWriter : public KRNodePropertyVisitor
+{
+public:
+  KRSceneBinaryWriter();
+
+  void addNode(KRNode* node, int32_t parent);
+  void write(mimir::Block& data);
+
+  void visit(const char* name, int& val, int defaultVal) override;
+  void visit(const char* name, unsigned int& val, unsigned int defaultVal) override;
+  void visit(const char* name, float& val, float defaultVal) override;
+  void visit(const char* name, bool& val, bool defaultVal) override;
+  void visit(const char* name, hydra::Vector3& val, const hydra::Vector3& defaultVal) override;
+  void visit(const char* name, hydra::AABB& val, const hydra::AABB& defaultVal) override;
+  void visit(const char* name, std::string& val, const std::string& defaultVal) override;
+  void visit(const char* name, KRResourceBinding& val) override;
+
+private:
+  uint32_t addString(const std::string& str);
+  void addProperty(const char* name, KRSceneBinary::PropertyType type, const uint32_t* values, size_t valueCount);
+
+  std::vector<KRSceneBinaryNode> m_nodes;
+  std::vector<KRSceneBinaryProperty> m_properties;
+  std::vector<uint32_t> m_values;
+  std::vector<char> m_strings;
+  unordered_map<std::string, uint32_t> m_stringOffsets;
+};
+
+class KRSceneBinaryReader : public KRNodePropertyVisitor
+{
+public:
+  KRSceneBinaryReader(const void* start, size_t size);
+
+  static bool IsBinaryScene(const void* start, size_t size);
+
+  // Creates the nodes of the scene and appends them to the scene root.
+  // The source data must remain mapped for the duration of the call.
+  bool load(KRScene& scene);
+
+  void visit(const char* name, int& val, int defaultVal) override;
+  void visit(const char* name, unsigned int& val, unsigned int defaultVal) override;
+  void visit(const char* name, float& val, float defaultVal) override;
+  void visit(const char* name, bool& val, bool defaultVal) override;
+  void visit(const char* name, hydra::Vector3& val, const hydra::Vector3& defaultVal) override;
+  void visit(const char* name, hydra::AABB& val, const hydra::AABB& defaultVal) override;
+  void visit(const char* name, std::string& val, const std::string& defaultVal) override;
+  void visit(const char* name, KRResourceBinding& val) override;
+
+private:
+  bool validate() const;
+  const char* getString(uint32_t offset) const;
+  const uint32_t* findProperty(const char* name, KRSceneBinary::PropertyType type, size_t valueCount);
+
+  const uint8_t* m_start;
+  size_t m_size;
+  const KRSceneBinaryHeader* m_header;
+  const KRSceneBinaryNode* m_nodes;
+  const KRSceneBinaryProperty* m_properties;
+  const uint32_t* m_values;
+  const char* m_strings;
+
+  // Properties of the node currently being loaded
+  uint32_t m_propertyStart;
+  uint32_t m_propertyEnd;
+  uint32_t m_propertyCursor;
+};
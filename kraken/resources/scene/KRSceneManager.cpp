@@ -47,7 +47,7 @@ KRSceneManager::~KRSceneManager()
 
 KRResource* KRSceneManager::loadResource(const std::string& name, const std::string& extension, Block* data)
 {
-  if (extension.compare("krscene") == 0) {
+  if (extension.compare("krscene") == 0 || extension.compare("krscenebin") == 0) {
     return loadScene(name, data);
   }
   return nullptr;
@@ -55,7 +55,7 @@ KRResource* KRSceneManager::loadResource(const std::string& name, const std::str
 
 KRResource* KRSceneManager::getResource(const std::string& name, const std::string& extension)
 {
-  if (extension.compare("krscene") == 0) {
+  if (extension.compare("krscene") == 0 || extension.compare("krscenebin") == 0) {
     return getScene(name);
   }
   return nullptr;
@@ -69,7 +69,9 @@ KRScene* KRSceneManager::loadScene(const std::string& name, Block* data)
                  lowerName.begin(), ::tolower);
 
   KRScene* pScene = KRScene::Load(*m_pContext, name, data);
-  m_scenes[lowerName] = pScene;
+  if (pScene) {
+    m_scenes[lowerName] = pScene;
+  }
   return pScene;
 }
 
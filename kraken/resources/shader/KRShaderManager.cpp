@@ -371,6 +371,69 @@ bool KRShaderManager::compileAll(KRBundle* outputBundle, KRUnknown* logResource)
     }
   }
 
+  // Compute shaders are linked on their own
+  const unordered_map<std::string, KRSource*> compSources = pSourceManager->get("comp");
+  for (const std::pair<const std::string, KRSource*> compSourceEntry : compSources) {
+    KRSource* compSource = compSourceEntry.second;
+
+    TBuiltInResource resources;
+    resources = DefaultTBuiltInResource;
+
+    EShMessages messages = EShMsgDefault;
+    const int defaultVersion = 110;
+
+    glslang::TShader compShader(EShLangCompute);
+    compShader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_3);
+    compShader.setEnvClient(glslang::EShClientVulkan, glslang::EshTargetClientVersion::EShTargetVulkan_1_1);
+    glslang::TProgram program; // this must be declared after the TShader to ensure it is deallocated before the TShader
+
+    compSource->getData()->lock();
+    std::string compSourceName = compSource->getName() + "." + compSource->getExtension();
+    const char* compSourceText[1] = { (char*)compSource->getData()->getStart() };
+    int compSourceLen[1] = { (int)compSource->getData()->getSize() };
+    const char* compSourceNameStr[1] = { compSourceName.c_str() };
+    compShader.setStringsWithLengthsAndNames(compSourceText, compSourceLen, compSourceNameStr, 1);
+
+    bool compiled = compShader.parse(&resources, defaultVersion, false, messages, m_includer);
+    if (compiled) {
+      program.addShader(&compShader);
+      compiled = program.link(messages);
+    }
+    if (!compiled) {
+      const char* log = compShader.getInfoLog();
+      if (log[0] != '\0') {
+        logResource->getData()->append(log);
+        logResource->getData()->append("\n");
+      }
+      log = program.getInfoLog();
+      if (log[0] != '\0') {
+        logResource->getData()->append(log);
+        logResource->getData()->append("\n");
+      }
+      success = false;
+    } else {
+      std::vector<unsigned int> spirv;
+      spv::SpvBuildLogger logger;
+      glslang::SpvOptions spvOptions;
+      glslang::GlslangToSpv(*program.getIntermediate(EShLangCompute), spirv, &logger, &spvOptions);
+      std::string messages = logger.getAllMessages();
+      if (!messages.empty()) {
+        logResource->getData()->append(messages.c_str());
+        logResource->getData()->append("\n");
+      }
+
+      Block* data = new Block();
+      data->append(static_cast<void*>(spirv.data()), spirv.size() * sizeof(unsigned int));
+      KRShader* shader = new KRShader(getContext(), compSourceName, "spv", data);
+      add(shader);
+      if (outputBundle) {
+        shader->moveToBundle(outputBundle);
+      }
+    }
+
+    compSource->getData()->unlock();
+  }
+
   return success;
 }
 
@@ -35,8 +35,11 @@
 #include "KRContext.h"
 #include "KRTextureManager.h"
 
+std::atomic<long> KRTexture::s_nextHandleSerial(0);
+
 KRTexture::KRTexture(KRContext& context, std::string name) : KRResource(context, name)
 {
+  m_handleSerial = ++s_nextHandleSerial;
   m_current_lod = -1;
   m_new_lod = -1;
   m_textureMemUsed = 0;
@@ -44,6 +47,14 @@ KRTexture::KRTexture(KRContext& context, std::string name) : KRResource(context,
   m_last_frame_used = 0;
   m_last_frame_max_lod_coverage = 0.0f;
   m_last_frame_usage = TEXTURE_USAGE_NONE;
+  m_feedback_slot = -1;
+  m_feedback_lod = -1;
+  m_feedback_frame = 0;
+  m_bindless_slot = -1;
+  for (int region = 0; region < KRENGINE_TEXTURE_FEEDBACK_REGIONS; region++) {
+    m_feedback_region_lod[region] = -1;
+    m_feedback_region_frame[region] = 0;
+  }
   m_handle_lock.clear();
   m_haveNewHandles = false;
 }
@@ -61,10 +72,34 @@ void KRTexture::TextureHandle::destroy(KRDeviceManager* deviceManager)
     vkDestroyImageView(d->m_logicalDevice, fullImageView, nullptr);
     fullImageView = VK_NULL_HANDLE;
   }
+  VmaAllocator allocator = d->getAllocator();
   if (image != VK_NULL_HANDLE) {
-    VmaAllocator allocator = d->getAllocator();
     vmaDestroyImage(allocator, image, allocation);
+  } else if (allocation != VK_NULL_HANDLE) {
+    vmaFreeMemory(allocator, allocation);
+  }
+  image = VK_NULL_HANDLE;
+  allocation = VK_NULL_HANDLE;
+  for (Page& page : pages) {
+    if (page.allocation != VK_NULL_HANDLE) {
+      vmaFreeMemory(allocator, page.allocation);
+    }
+  }
+  pages.clear();
+  freeSlots.clear();
+  for (std::pair<uint64_t, VmaAllocation>& unbound : unboundAllocations) {
+    vmaFreeMemory(allocator, unbound.second);
+  }
+  unboundAllocations.clear();
+  if (residencyImageView != VK_NULL_HANDLE) {
+    vkDestroyImageView(d->m_logicalDevice, residencyImageView, nullptr);
+    residencyImageView = VK_NULL_HANDLE;
   }
+  if (residencyImage != VK_NULL_HANDLE) {
+    vmaDestroyImage(allocator, residencyImage, residencyAllocation);
+  }
+  residencyImage = VK_NULL_HANDLE;
+  residencyAllocation = VK_NULL_HANDLE;
 }
 
 void KRTexture::destroyHandles()
@@ -75,6 +110,7 @@ void KRTexture::destroyHandles()
   }
   m_handles.clear();
   m_textureMemUsed = 0;
+  m_handleSerial = ++s_nextHandleSerial;
 }
 
 void KRTexture::destroyNewHandles()
@@ -115,6 +151,26 @@ long KRTexture::getReferencedMemSize()
   return 0;
 }
 
+long KRTexture::getMemRequiredForVisibleLod(int lod)
+{
+  return getMemRequiredForLod(lod);
+}
+
+long KRTexture::getMemRequiredForVisibleLodRange(int min_lod)
+{
+  long memRequired = 0;
+  for (int lod = std::min(min_lod, m_lod_count - 1); lod < m_lod_count; lod++) {
+    memRequired += getMemRequiredForVisibleLod(lod);
+  }
+  return memRequired;
+}
+
+void KRTexture::residentMemoryChanged(long memoryDelta)
+{
+  m_textureMemUsed += memoryDelta;
+  getContext().getTextureManager()->memoryChanged(memoryDelta);
+}
+
 void KRTexture::resize(int lod)
 {
   while (m_handle_lock.test_and_set()) {
@@ -178,29 +234,38 @@ kraken_stream_level KRTexture::getStreamLevel()
 
 float KRTexture::getStreamPriority()
 {
-  long current_frame = getContext().getCurrentFrame();
-  if (current_frame > m_last_frame_used + 5) {
-    return 1.0f - std::clamp((float)(current_frame - m_last_frame_used) / 60.0f, 0.0f, 1.0f);
-  } else {
-    float priority = 100.0f;
-    if (m_last_frame_usage & (TEXTURE_USAGE_UI | TEXTURE_USAGE_SHADOW_DEPTH)) {
-      priority += 10000000.0f;
-    }
-    if (m_last_frame_usage & (TEXTURE_USAGE_SKY_CUBE | TEXTURE_USAGE_PARTICLE | TEXTURE_USAGE_SPRITE | TEXTURE_USAGE_LIGHT_FLARE)) {
-      priority += 1000000.0f;
-    }
-    if (m_last_frame_usage & (TEXTURE_USAGE_MATERIAL)) {
-      priority += 100000.0f;
-    }
-    if (m_last_frame_usage & (TEXTURE_USAGE_LIGHT_MAP)) {
-      priority += 100000.0f;
+  // The weight of each usage is the relative value of one level of detail.
+  // A texture used in several ways takes the weight of its most valuable use.
+  float usage_weight = 0.25f;
+  if (m_last_frame_usage & (TEXTURE_USAGE_UI | TEXTURE_USAGE_SHADOW_DEPTH)) {
+    usage_weight = std::max(usage_weight, 1000.0f);
+  }
+  if (m_last_frame_usage & (TEXTURE_USAGE_SKY_CUBE | TEXTURE_USAGE_PARTICLE | TEXTURE_USAGE_SPRITE | TEXTURE_USAGE_LIGHT_FLARE)) {
+    usage_weight = std::max(usage_weight, 4.0f);
+  }
+  if (m_last_frame_usage & TEXTURE_USAGE_MATERIAL) {
+    int maps = m_last_frame_usage & TEXTURE_USAGE_MATERIAL_MAPS;
+    if (maps == 0 || (maps & (TEXTURE_USAGE_MATERIAL_EMISSIVE & TEXTURE_USAGE_MATERIAL_MAPS))) {
+      usage_weight = std::max(usage_weight, 1.0f);
     }
-    if (m_last_frame_usage & (TEXTURE_USAGE_REFECTION_CUBE)) {
-      priority += 100000.0f;
+    if (maps & ((TEXTURE_USAGE_MATERIAL_NORMAL | TEXTURE_USAGE_MATERIAL_CLEARCOAT_NORMAL) & TEXTURE_USAGE_MATERIAL_MAPS)) {
+      usage_weight = std::max(usage_weight, 0.75f);
     }
-    priority += m_last_frame_max_lod_coverage * 10.0f;
-    return priority;
+    usage_weight = std::max(usage_weight, 0.5f);
+  }
+  if (m_last_frame_usage & TEXTURE_USAGE_LIGHT_MAP) {
+    usage_weight = std::max(usage_weight, 0.75f);
   }
+  if (m_last_frame_usage & TEXTURE_USAGE_REFECTION_CUBE) {
+    usage_weight = std::max(usage_weight, 0.5f);
+  }
+
+  // Textures that were requested while out of view keep a small weight, so
+  // that they stay loaded at low detail.  Weight falls off with each frame
+  // since the texture was last used.
+  float coverage = 0.05f + m_last_frame_max_lod_coverage;
+  long frames_unused = std::max(getContext().getCurrentFrame() - m_last_frame_used, 0L);
+  return usage_weight * coverage / (float)(1 + frames_unused);
 }
 
 float KRTexture::getLastFrameLodCoverage() const
@@ -212,16 +277,107 @@ long KRTexture::getLastFrameUsed()
 {
   return m_last_frame_used;
 }
+
+int KRTexture::getFeedbackSlot() const
+{
+  return m_feedback_slot;
+}
+
+int KRTexture::getFeedbackSlotCount() const
+{
+  return isVirtual() ? 1 + KRENGINE_TEXTURE_FEEDBACK_REGIONS : 1;
+}
+
+void KRTexture::setFeedbackSlot(int slot)
+{
+  m_feedback_slot = slot;
+  m_feedback_lod = -1;
+  for (int region = 0; region < KRENGINE_TEXTURE_FEEDBACK_REGIONS; region++) {
+    m_feedback_region_lod[region] = -1;
+  }
+}
+
+int KRTexture::getBindlessSlot() const
+{
+  return m_bindless_slot;
+}
+
+void KRTexture::setBindlessSlot(int slot)
+{
+  m_bindless_slot = slot;
+}
+
+void KRTexture::submitFeedback(int lod)
+{
+  // The last sampled level is held for a while, so that textures that are
+  // briefly occluded do not return to their full resolution.
+  const long KRENGINE_TEXTURE_FEEDBACK_EXPIRY_FRAMES = 30;
+
+  long current_frame = getContext().getCurrentFrame();
+  if (lod != -1) {
+    m_feedback_lod = lod;
+    m_feedback_frame = current_frame;
+  } else if (m_feedback_frame + KRENGINE_TEXTURE_FEEDBACK_EXPIRY_FRAMES < current_frame) {
+    m_feedback_lod = -1;
+  }
+}
+
+void KRTexture::submitRegionFeedback(int region, int lod)
+{
+  // Regions hold their level for as long as the whole texture does
+  const long KRENGINE_TEXTURE_FEEDBACK_EXPIRY_FRAMES = 30;
+
+  long current_frame = getContext().getCurrentFrame();
+  if (lod != -1) {
+    m_feedback_region_lod[region] = lod;
+    m_feedback_region_frame[region] = current_frame;
+  } else if (m_feedback_region_frame[region] + KRENGINE_TEXTURE_FEEDBACK_EXPIRY_FRAMES < current_frame) {
+    m_feedback_region_lod[region] = -1;
+  }
+}
+
+int KRTexture::getFeedbackLod() const
+{
+  // Only material maps are drawn in the feedback pass.  Textures that are
+  // also used in other ways may be sampled more finely elsewhere.
+  if (m_last_frame_usage & ~(TEXTURE_USAGE_MATERIAL | TEXTURE_USAGE_MATERIAL_MAPS)) {
+    return -1;
+  }
+  return m_feedback_lod;
+}
+
+int KRTexture::getFeedbackRegionLod(int region) const
+{
+  if (m_last_frame_usage & ~(TEXTURE_USAGE_MATERIAL | TEXTURE_USAGE_MATERIAL_MAPS)) {
+    return -1;
+  }
+  return m_feedback_region_lod[region];
+}
 bool KRTexture::isAnimated()
 {
   return false;
 }
 
-KRTexture* KRTexture::compress(bool premultiply_alpha)
+bool KRTexture::isVirtual() const
+{
+  return false;
+}
+
+bool KRTexture::isPageCached() const
+{
+  return false;
+}
+
+KRTexture* KRTexture::compress(KrTextureCompressionFormat format, KrTextureCompressionQuality quality, bool premultiply_alpha)
 {
   return NULL;
 }
 
+int KRTexture::getLayerCount() const
+{
+  return 1;
+}
+
 int KRTexture::getLodCount() const
 {
   return m_lod_count;
@@ -259,6 +415,7 @@ void KRTexture::_swapHandles()
     if (m_haveNewHandles) {
       destroyHandles();
       m_handles.swap(m_newHandles);
+      m_handleSerial = ++s_nextHandleSerial;
       m_textureMemUsed = (long)m_newTextureMemUsed;
       m_newTextureMemUsed = 0;
       m_current_lod = m_new_lod;
@@ -288,6 +445,31 @@ VkImage KRTexture::getImage(KrDeviceHandle device)
   return VK_NULL_HANDLE;
 }
 
+VkImageLayout KRTexture::getImageLayout(KrDeviceHandle device)
+{
+  for (TextureHandle& handle : m_handles) {
+    if (handle.device == device) {
+      return handle.layout;
+    }
+  }
+  return VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+}
+
+long KRTexture::getHandleSerial() const
+{
+  return m_handleSerial;
+}
+
+VkImageView KRTexture::getResidencyImageView(KrDeviceHandle device)
+{
+  for (TextureHandle& handle : m_handles) {
+    if (handle.device == device) {
+      return handle.residencyImageView;
+    }
+  }
+  return VK_NULL_HANDLE;
+}
+
 bool KRTexture::allocate(KRDevice& device, int target_lod, VkImageCreateFlags imageCreateFlags, VkMemoryPropertyFlags properties, VkImage* image, VmaAllocation* allocation
 #if KRENGINE_DEBUG_GPU_LABELS  
 , const char* debug_label
@@ -296,16 +478,20 @@ bool KRTexture::allocate(KRDevice& device, int target_lod, VkImageCreateFlags im
 {
   int min_mip = std::min(target_lod, m_lod_count - 1);
   int mip_count = m_lod_count - min_mip;
-  hydra::Vector3i dimensions = getDimensions() / (1 << target_lod);
+  hydra::Vector3i dimensions = getDimensions();
+  bool volume = dimensions.z > 1;
+  dimensions.x = std::max(dimensions.x >> min_mip, 1);
+  dimensions.y = std::max(dimensions.y >> min_mip, 1);
+  dimensions.z = std::max(dimensions.z >> min_mip, 1);
 
   VkImageCreateInfo imageInfo{};
   imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-  imageInfo.imageType = VK_IMAGE_TYPE_2D;
+  imageInfo.imageType = volume ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D;
   imageInfo.extent.width = static_cast<uint32_t>(dimensions.x);
   imageInfo.extent.height = static_cast<uint32_t>(dimensions.y);
   imageInfo.extent.depth = static_cast<uint32_t>(dimensions.z);
   imageInfo.mipLevels = mip_count;
-  imageInfo.arrayLayers = 1;
+  imageInfo.arrayLayers = getFaceCount() * getLayerCount();
   imageInfo.format = getFormat();
   imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
   imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -54,6 +54,9 @@ public:
 
   virtual long getMemRequiredForLod(int lod) = 0;
   long getMemRequiredForLodRange(int min_lod, int max_lod = 0xff);
+  // Memory needed to keep a level resident where it is visible, for the streamer's budget
+  virtual long getMemRequiredForVisibleLod(int lod);
+  long getMemRequiredForVisibleLodRange(int min_lod);
   virtual void resize(int lod);
 
   long getLastFrameUsed();
@@ -72,35 +75,39 @@ public:
 
     TEXTURE_USAGE_MATERIAL = 0x01000000,
 
+    // Material maps use bits above the other usages, as the usages of a frame are combined
     TEXTURE_USAGE_MATERIAL_BASE_COLOR = TEXTURE_USAGE_MATERIAL | 0x00,
-    TEXTURE_USAGE_MATERIAL_NORMAL = TEXTURE_USAGE_MATERIAL | 0x01,
-    TEXTURE_USAGE_MATERIAL_EMISSIVE = TEXTURE_USAGE_MATERIAL | 0x02,
-    TEXTURE_USAGE_MATERIAL_OCCLUSION = TEXTURE_USAGE_MATERIAL | 0x04,
-    TEXTURE_USAGE_MATERIAL_METALIC_ROUGHNESS = TEXTURE_USAGE_MATERIAL | 0x08,
-    TEXTURE_USAGE_MATERIAL_ANISOTROPY = TEXTURE_USAGE_MATERIAL | 0x10,
-    TEXTURE_USAGE_MATERIAL_CLEARCOAT = TEXTURE_USAGE_MATERIAL | 0x20,
-    TEXTURE_USAGE_MATERIAL_CLEARCOAT_ROUGHNESS = TEXTURE_USAGE_MATERIAL | 0x40,
-    TEXTURE_USAGE_MATERIAL_CLEARCOAT_NORMAL = TEXTURE_USAGE_MATERIAL | 0x80,
-    TEXTURE_USAGE_MATERIAL_SPECULAR = TEXTURE_USAGE_MATERIAL | 0x100,
-    TEXTURE_USAGE_MATERIAL_SPECULAR_COLOR = TEXTURE_USAGE_MATERIAL | 0x200,
-    TEXTURE_USAGE_MATERIAL_THICKNESS = TEXTURE_USAGE_MATERIAL | 0x400,
-    TEXTURE_USAGE_MATERIAL_TRANSMISSION = TEXTURE_USAGE_MATERIAL | 0x800,
+    TEXTURE_USAGE_MATERIAL_NORMAL = TEXTURE_USAGE_MATERIAL | 0x100,
+    TEXTURE_USAGE_MATERIAL_EMISSIVE = TEXTURE_USAGE_MATERIAL | 0x200,
+    TEXTURE_USAGE_MATERIAL_OCCLUSION = TEXTURE_USAGE_MATERIAL | 0x400,
+    TEXTURE_USAGE_MATERIAL_METALIC_ROUGHNESS = TEXTURE_USAGE_MATERIAL | 0x800,
+    TEXTURE_USAGE_MATERIAL_ANISOTROPY = TEXTURE_USAGE_MATERIAL | 0x1000,
+    TEXTURE_USAGE_MATERIAL_CLEARCOAT = TEXTURE_USAGE_MATERIAL | 0x2000,
+    TEXTURE_USAGE_MATERIAL_CLEARCOAT_ROUGHNESS = TEXTURE_USAGE_MATERIAL | 0x4000,
+    TEXTURE_USAGE_MATERIAL_CLEARCOAT_NORMAL = TEXTURE_USAGE_MATERIAL | 0x8000,
+    TEXTURE_USAGE_MATERIAL_SPECULAR = TEXTURE_USAGE_MATERIAL | 0x10000,
+    TEXTURE_USAGE_MATERIAL_SPECULAR_COLOR = TEXTURE_USAGE_MATERIAL | 0x20000,
+    TEXTURE_USAGE_MATERIAL_THICKNESS = TEXTURE_USAGE_MATERIAL | 0x40000,
+    TEXTURE_USAGE_MATERIAL_TRANSMISSION = TEXTURE_USAGE_MATERIAL | 0x80000,
+    TEXTURE_USAGE_MATERIAL_MAPS = 0x00ffff00,
 
 
   } texture_usage_t;
 
+  // Relative value of this texture's detail, used to share the texture memory budget
   float getStreamPriority();
 
   virtual void requestResidency(float lodCoverage, texture_usage_t textureUsage);
   void requestResidency(uint32_t usage, float lodCoverage = 0.0f) override;
   virtual bool isAnimated();
 
-  virtual KRTexture* compress(bool premultiply_alpha = false);
+  virtual KRTexture* compress(KrTextureCompressionFormat format, KrTextureCompressionQuality quality, bool premultiply_alpha = false);
   int getCurrentLodMaxDim();
   int getNewLod(); // For use by streamer only
   int getMaxMipMap();
   bool hasMipmaps();
   virtual int getFaceCount() const = 0;
+  virtual int getLayerCount() const;
   virtual VkFormat getFormat() const = 0;
   virtual hydra::Vector3i getDimensions() const = 0;
   int getLodCount() const;
@@ -108,10 +115,37 @@ public:
   kraken_stream_level getStreamLevel();
   float getLastFrameLodCoverage() const;
 
+  // Virtual textures are split into pages, which are resident only where they are visible
+  virtual bool isVirtual() const;
+  // Virtual textures on devices without sparse residency copy their pages into a cache image
+  virtual bool isPageCached() const;
+
+  // Texture feedback, recorded by the RENDER_PASS_TEXTURE_FEEDBACK pass.
+  // Virtual textures also record each region of a KRENGINE_TEXTURE_FEEDBACK_REGION_GRID
+  // square grid, in the slots following their own.
+  static const int KRENGINE_TEXTURE_FEEDBACK_REGION_GRID = 8;
+  static const int KRENGINE_TEXTURE_FEEDBACK_REGIONS = KRENGINE_TEXTURE_FEEDBACK_REGION_GRID * KRENGINE_TEXTURE_FEEDBACK_REGION_GRID;
+  int getFeedbackSlot() const;
+  int getFeedbackSlotCount() const;
+  void setFeedbackSlot(int slot); // For use by texture manager only
+  void submitFeedback(int lod); // For use by texture manager only
+  void submitRegionFeedback(int region, int lod); // For use by texture manager only
+  int getFeedbackLod() const; // Finest level sampled by the GPU, or -1 if not known
+  int getFeedbackRegionLod(int region) const; // Finest level sampled in the region, or -1 if not sampled
+
+  // Index of the texture in the bindless texture table, or -1 if not in the table
+  int getBindlessSlot() const;
+  void setBindlessSlot(int slot); // For use by texture manager only
+
   void _swapHandles();
 
   VkImageView getFullImageView(KrDeviceHandle device);
   VkImage getImage(KrDeviceHandle device);
+  VkImageLayout getImageLayout(KrDeviceHandle device);
+  // Finest resident level of each page of a virtual texture, or VK_NULL_HANDLE
+  VkImageView getResidencyImageView(KrDeviceHandle device);
+  // Unique to each set of handles, so cached descriptors never outlive the views they reference
+  long getHandleSerial() const;
 
 protected:
   virtual bool createGPUTexture(int lod) = 0;
@@ -124,6 +158,29 @@ protected:
     VkImageView fullImageView;
     KrDeviceHandle device;
     VmaAllocation allocation;
+    VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    // Page table of virtual textures.  Sparse images hold the memory bound to
+    // each page, and bind their mip tail to allocation.  Page cached textures
+    // hold the slot of the cache image each page is copied to, and keep their
+    // mip tail in slot 0.
+    struct Page
+    {
+      VmaAllocation allocation = VK_NULL_HANDLE;
+      int slot = -1;
+      bool mapped = false; // Included in the residency image
+      uint64_t unmappedFrame = 0; // Graphics frames submitted when removed from the residency image
+    };
+    std::vector<Page> pages;
+    std::vector<int> freeSlots;
+    // Page memory that has been unbound, freed once the streaming semaphore
+    // reaches the value of the unbind
+    std::vector<std::pair<uint64_t, VmaAllocation>> unboundAllocations;
+    // The residency image of sparse images, or the indirection image of page
+    // cached textures
+    VkImage residencyImage = VK_NULL_HANDLE;
+    VkImageView residencyImageView = VK_NULL_HANDLE;
+    VmaAllocation residencyAllocation = VK_NULL_HANDLE;
 
     void destroy(KRDeviceManager* deviceManager);
   };
@@ -143,6 +200,16 @@ protected:
   float m_last_frame_max_lod_coverage;
   texture_usage_t m_last_frame_usage;
 
+  int m_feedback_slot;
+  std::atomic<int> m_feedback_lod;
+  long m_feedback_frame;
+  std::atomic<int> m_feedback_region_lod[KRENGINE_TEXTURE_FEEDBACK_REGIONS];
+  long m_feedback_region_frame[KRENGINE_TEXTURE_FEEDBACK_REGIONS];
+
+  int m_bindless_slot;
+
+  void residentMemoryChanged(long memoryDelta);
+
   bool allocate(KRDevice& device, int target_lod, VkImageCreateFlags imageCreateFlags, VkMemoryPropertyFlags properties, VkImage* image, VmaAllocation* allocation
 #if KRENGINE_DEBUG_GPU_LABELS  
   , const char* debug_label
@@ -152,4 +219,6 @@ protected:
 private:
   std::atomic<long> m_textureMemUsed;
   std::atomic<long> m_newTextureMemUsed;
+  std::atomic<long> m_handleSerial;
+  static std::atomic<long> s_nextHandleSerial;
 };
@@ -32,6 +32,12 @@
 #include "KREngine-common.h"
 #include "KRTexture2D.h"
 #include "KRTextureManager.h"
+#include "KRTextureKTX.h"
+#include "KRThreadPool.h"
+#include "KRContext.h"
+#include "cmp_core.h"
+
+#include <chrono>
 using namespace hydra;
 
 using namespace mimir;
@@ -39,6 +45,10 @@ using namespace mimir;
 KRTexture2D::KRTexture2D(KRContext& context, Block* data, std::string name) : KRTexture(context, name)
 {
   m_pData = data;
+  m_virtual = VIRTUAL_UNKNOWN;
+  m_pageWidth = 0;
+  m_pageHeight = 0;
+  m_mipTailLod = 0;
 }
 
 KRTexture2D::~KRTexture2D()
@@ -52,10 +62,52 @@ bool KRTexture2D::createGPUTexture(int targetLod)
     return true;
   }
 
+  if (isVirtual()) {
+    bool success = true;
+    m_new_lod = -1;
+    KRDeviceManager* deviceManager = getContext().getDeviceManager();
+    for (auto deviceItr = deviceManager->getDevices().begin(); deviceItr != deviceManager->getDevices().end(); deviceItr++) {
+      KRDevice& device = *(*deviceItr).second;
+      bool firstDevice = m_newHandles.empty();
+      KRTexture::TextureHandle& texture = m_newHandles.emplace_back();
+      texture.device = (*deviceItr).first;
+      texture.allocation = VK_NULL_HANDLE;
+      texture.image = VK_NULL_HANDLE;
+      texture.fullImageView = VK_NULL_HANDLE;
+      bool created = m_virtual == VIRTUAL_SPARSE ? createSparseTexture(device, texture, firstDevice) : createPageCacheTexture(device, texture);
+      if (!created) {
+        success = false;
+        break;
+      }
+    }
+
+    if (success) {
+      // Only the mip tail is resident until pages are streamed in
+      m_new_lod = std::min(m_mipTailLod, m_lod_count - 1);
+      m_haveNewHandles = true;
+    } else {
+      destroyNewHandles();
+    }
+    return success;
+  }
+
   Vector3i dimensions = getDimensions();
   size_t bufferSize = getMemRequiredForLodRange(targetLod);
   void* buffer = malloc(bufferSize);
 
+  // Cube faces and array layers of each level are stored consecutively, as
+  // are the slices of volume textures
+  int faceCount = getFaceCount();
+  int layerCount = faceCount * getLayerCount();
+  VkImageViewType viewType = VK_IMAGE_VIEW_TYPE_2D;
+  if (dimensions.z > 1) {
+    viewType = VK_IMAGE_VIEW_TYPE_3D;
+  } else if (faceCount == 6) {
+    viewType = layerCount > 6 ? VK_IMAGE_VIEW_TYPE_CUBE_ARRAY : VK_IMAGE_VIEW_TYPE_CUBE;
+  } else if (layerCount > 1) {
+    viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+  }
+
   if (!getLodData(buffer, targetLod)) {
     free(buffer);
     return false;
@@ -75,7 +127,7 @@ bool KRTexture2D::createGPUTexture(int targetLod)
     texture.allocation = VK_NULL_HANDLE;
     texture.image = VK_NULL_HANDLE;
 
-    if (!allocate(device, targetLod, 0, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &texture.image, &texture.allocation
+    if (!allocate(device, targetLod, faceCount == 6 ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &texture.image, &texture.allocation
 #if KRENGINE_DEBUG_GPU_LABELS
       , getName().c_str()
 #endif
@@ -90,13 +142,13 @@ bool KRTexture2D::createGPUTexture(int targetLod)
     VkImageViewCreateInfo viewInfo{};
     viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
     viewInfo.image = texture.image;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.viewType = viewType;
     viewInfo.format = getFormat();
     viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     viewInfo.subresourceRange.baseMipLevel = 0;
     viewInfo.subresourceRange.levelCount = mip_count;
     viewInfo.subresourceRange.baseArrayLayer = 0;
-    viewInfo.subresourceRange.layerCount = 1;
+    viewInfo.subresourceRange.layerCount = layerCount;
     VkResult res = vkCreateImageView(device.m_logicalDevice, &viewInfo, nullptr, &texture.fullImageView);
     if (res != VK_SUCCESS) {
       success = false;
@@ -107,7 +159,7 @@ bool KRTexture2D::createGPUTexture(int targetLod)
 	  regions.resize(mip_count, VkBufferImageCopy{});
     int bufferOffset = 0;
     for (int mip = min_mip; mip < min_mip + mip_count; mip++) {
-        VkBufferImageCopy& region = regions[mip];
+        VkBufferImageCopy& region = regions[mip - min_mip];
         region.bufferOffset = bufferOffset;
         region.bufferRowLength = 0;
         region.bufferImageHeight = 0;
@@ -115,13 +167,13 @@ bool KRTexture2D::createGPUTexture(int targetLod)
         region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
         region.imageSubresource.mipLevel = mip - min_mip;
         region.imageSubresource.baseArrayLayer = 0;
-        region.imageSubresource.layerCount = 1;
+        region.imageSubresource.layerCount = layerCount;
 
         region.imageOffset = { 0, 0, 0 };
         region.imageExtent = {
-            (unsigned int)dimensions.x,
-            (unsigned int)dimensions.y,
-            (unsigned int)dimensions.z
+            (unsigned int)std::max(dimensions.x >> mip, 1),
+            (unsigned int)std::max(dimensions.y >> mip, 1),
+            (unsigned int)std::max(dimensions.z >> mip, 1)
         };
 
 		    bufferOffset += getMemRequiredForLod(mip);
@@ -142,6 +194,1356 @@ bool KRTexture2D::createGPUTexture(int targetLod)
   return success;
 }
 
+bool KRTexture2D::isVirtual() const
+{
+  int isVirtualTexture = m_virtual;
+  if (isVirtualTexture == VIRTUAL_UNKNOWN) {
+    if (getContext().getDeviceManager()->getDevices().empty()) {
+      return false;
+    }
+    isVirtualTexture = determineVirtual();
+    m_virtual = isVirtualTexture;
+  }
+  return isVirtualTexture != VIRTUAL_NONE;
+}
+
+bool KRTexture2D::isPageCached() const
+{
+  return isVirtual() && m_virtual == VIRTUAL_PAGE_CACHE;
+}
+
+int KRTexture2D::determineVirtual() const
+{
+  Vector3i dimensions = getDimensions();
+  if (std::max(dimensions.x, dimensions.y) < KRENGINE_VIRTUAL_TEXTURE_MIN_DIMENSION || dimensions.z > 1) {
+    return VIRTUAL_NONE;
+  }
+  if (getFaceCount() != 1 || getLayerCount() != 1 || !supportsLodRegionData()) {
+    return VIRTUAL_NONE;
+  }
+  if (determineSparse()) {
+    return VIRTUAL_SPARSE;
+  }
+  if (determinePageCache()) {
+    return VIRTUAL_PAGE_CACHE;
+  }
+  return VIRTUAL_NONE;
+}
+
+bool KRTexture2D::determineSparse() const
+{
+  Vector3i dimensions = getDimensions();
+
+  // The page size must match on all devices, as they share the page visibility
+  int pageWidth = 0;
+  int pageHeight = 0;
+  bool alignedMipSize = false;
+  KRDeviceManager* deviceManager = getContext().getDeviceManager();
+  for (auto deviceItr = deviceManager->getDevices().begin(); deviceItr != deviceManager->getDevices().end(); deviceItr++) {
+    KRDevice& device = *(*deviceItr).second;
+    if (!device.m_sparseResidency) {
+      return false;
+    }
+
+    uint32_t propertyCount = 0;
+    vkGetPhysicalDeviceSparseImageFormatProperties(device.m_device, getFormat(), VK_IMAGE_TYPE_2D, VK_SAMPLE_COUNT_1_BIT,
+      VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_IMAGE_TILING_OPTIMAL, &propertyCount, nullptr);
+    std::vector<VkSparseImageFormatProperties> properties(propertyCount);
+    vkGetPhysicalDeviceSparseImageFormatProperties(device.m_device, getFormat(), VK_IMAGE_TYPE_2D, VK_SAMPLE_COUNT_1_BIT,
+      VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_IMAGE_TILING_OPTIMAL, &propertyCount, properties.data());
+
+    const VkSparseImageFormatProperties* colorProperties = nullptr;
+    for (const VkSparseImageFormatProperties& property : properties) {
+      if (property.aspectMask & VK_IMAGE_ASPECT_COLOR_BIT) {
+        colorProperties = &property;
+        break;
+      }
+    }
+    if (colorProperties == nullptr) {
+      return false;
+    }
+
+    int granularityWidth = (int)colorProperties->imageGranularity.width;
+    int granularityHeight = (int)colorProperties->imageGranularity.height;
+    if (granularityWidth <= 0 || granularityHeight <= 0) {
+      return false;
+    }
+    if (pageWidth == 0) {
+      pageWidth = granularityWidth;
+      pageHeight = granularityHeight;
+    } else if (pageWidth != granularityWidth || pageHeight != granularityHeight) {
+      return false;
+    }
+    if (colorProperties->flags & VK_SPARSE_IMAGE_FORMAT_ALIGNED_MIP_SIZE_BIT) {
+      alignedMipSize = true;
+    }
+  }
+  if (pageWidth == 0) {
+    return false;
+  }
+
+  // Levels smaller than a page are packed into the mip tail, which is always resident
+  int mipTailLod = m_lod_count;
+  for (int lod = 0; lod < m_lod_count; lod++) {
+    int width = std::max(dimensions.x >> lod, 1);
+    int height = std::max(dimensions.y >> lod, 1);
+    if (width < pageWidth || height < pageHeight
+      || (alignedMipSize && (width % pageWidth != 0 || height % pageHeight != 0))) {
+      mipTailLod = lod;
+      break;
+    }
+  }
+
+  m_pageWidth = pageWidth;
+  m_pageHeight = pageHeight;
+  m_mipTailLod = mipTailLod;
+  return true;
+}
+
+bool KRTexture2D::determinePageCache() const
+{
+  // Pages, their borders, and the mip tail are copied in whole blocks, so each
+  // level copied must be a whole number of blocks, and at least as large as
+  // the border that wraps around it
+  int blockWidth, blockHeight, blockBytes;
+  if (!GetFormatBlockInfo(getFormat(), blockWidth, blockHeight, blockBytes)) {
+    return false;
+  }
+  const int pageSize = KRENGINE_VIRTUAL_TEXTURE_CACHE_PAGE_SIZE;
+  const int border = KRENGINE_VIRTUAL_TEXTURE_CACHE_BORDER;
+  if (pageSize % blockWidth != 0 || pageSize % blockHeight != 0 || border % blockWidth != 0 || border % blockHeight != 0) {
+    return false;
+  }
+
+  // Evicted slots are reused once the frames that sampled them have completed
+  KRDeviceManager* deviceManager = getContext().getDeviceManager();
+  for (auto deviceItr = deviceManager->getDevices().begin(); deviceItr != deviceManager->getDevices().end(); deviceItr++) {
+    if (!(*deviceItr).second->m_timelineSemaphore) {
+      return false;
+    }
+  }
+
+  // The mip tail is the first level that fits in one page
+  Vector3i dimensions = getDimensions();
+  int mipTailLod = -1;
+  for (int lod = 0; lod < m_lod_count; lod++) {
+    int width = std::max(dimensions.x >> lod, 1);
+    int height = std::max(dimensions.y >> lod, 1);
+    if (width % blockWidth != 0 || height % blockHeight != 0 || width < border || height < border) {
+      return false;
+    }
+    if (width <= pageSize && height <= pageSize) {
+      mipTailLod = lod;
+      break;
+    }
+  }
+  if (mipTailLod == -1) {
+    return false;
+  }
+
+  // The indirection image holds the slot coordinates and level in 8 bits each
+  static_assert(KRENGINE_VIRTUAL_TEXTURE_CACHE_SLOTS <= 256, "Page cache slots must be addressable by the indirection image");
+  m_pageWidth = pageSize;
+  m_pageHeight = pageSize;
+  m_mipTailLod = mipTailLod;
+  return true;
+}
+
+int KRTexture2D::getPageCountX(int lod) const
+{
+  int width = std::max(getDimensions().x >> lod, 1);
+  return (width + m_pageWidth - 1) / m_pageWidth;
+}
+
+int KRTexture2D::getPageCountY(int lod) const
+{
+  int height = std::max(getDimensions().y >> lod, 1);
+  return (height + m_pageHeight - 1) / m_pageHeight;
+}
+
+bool KRTexture2D::isRegionVisible(int region_x, int region_y, int lod) const
+{
+  // Regions wrap, as do the texture coordinates of tiled textures
+  const int grid = KRENGINE_TEXTURE_FEEDBACK_REGION_GRID;
+  region_x = (region_x % grid + grid) % grid;
+  region_y = (region_y % grid + grid) % grid;
+  int region_lod = getFeedbackRegionLod(region_y * grid + region_x);
+  return region_lod != -1 && region_lod <= lod;
+}
+
+bool KRTexture2D::isPageVisible(int lod, int page_x, int page_y) const
+{
+  if (lod >= m_mipTailLod || getFeedbackLod() == -1) {
+    // Without feedback, every page of the streamed levels is resident
+    return true;
+  }
+
+  // Pages next to the sampled regions are also resident, so they are ready
+  // before they come into view
+  Vector3i dimensions = getDimensions();
+  int width = std::max(dimensions.x >> lod, 1);
+  int height = std::max(dimensions.y >> lod, 1);
+  const int grid = KRENGINE_TEXTURE_FEEDBACK_REGION_GRID;
+  int region_x0 = page_x * m_pageWidth * grid / width - 1;
+  int region_x1 = (std::min((page_x + 1) * m_pageWidth, width) - 1) * grid / width + 1;
+  int region_y0 = page_y * m_pageHeight * grid / height - 1;
+  int region_y1 = (std::min((page_y + 1) * m_pageHeight, height) - 1) * grid / height + 1;
+  for (int region_y = region_y0; region_y <= region_y1; region_y++) {
+    for (int region_x = region_x0; region_x <= region_x1; region_x++) {
+      if (isRegionVisible(region_x, region_y, lod)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+long KRTexture2D::getMemRequiredForVisibleLod(int lod)
+{
+  if (!isVirtual() || lod >= m_mipTailLod || getFeedbackLod() == -1) {
+    return getMemRequiredForLod(lod);
+  }
+
+  // Only the pages of the sampled regions, and their neighbours, are resident
+  const int grid = KRENGINE_TEXTURE_FEEDBACK_REGION_GRID;
+  int visibleRegions = 0;
+  for (int region_y = 0; region_y < grid; region_y++) {
+    for (int region_x = 0; region_x < grid; region_x++) {
+      bool visible = false;
+      for (int y = region_y - 1; y <= region_y + 1 && !visible; y++) {
+        for (int x = region_x - 1; x <= region_x + 1 && !visible; x++) {
+          visible = isRegionVisible(x, y, lod);
+        }
+      }
+      if (visible) {
+        visibleRegions++;
+      }
+    }
+  }
+  return (long)((long long)getMemRequiredForLod(lod) * visibleRegions / KRENGINE_TEXTURE_FEEDBACK_REGIONS);
+}
+
+void KRTexture2D::resize(int lod)
+{
+  if (!isVirtual()) {
+    KRTexture::resize(lod);
+    return;
+  }
+
+  while (m_handle_lock.test_and_set()); // Spin lock
+  bool created = !m_handles.empty() && !m_haveNewHandles;
+  m_handle_lock.clear();
+
+  if (!created) {
+    // Virtual textures are created with only their mip tail resident
+    KRTexture::resize(m_mipTailLod);
+    return;
+  }
+
+  // Pages are bound or copied in place, so the handles are not replaced
+  int target_lod = std::min(lod, m_mipTailLod);
+  bool complete = true;
+  KRDeviceManager* deviceManager = getContext().getDeviceManager();
+  while (m_handle_lock.test_and_set()); // Spin lock
+  for (TextureHandle& texture : m_handles) {
+    std::unique_ptr<KRDevice>& device = deviceManager->getDevice(texture.device);
+    if (!device) {
+      continue;
+    }
+    if (m_virtual == VIRTUAL_PAGE_CACHE) {
+      updateCachePages(*device, texture, target_lod, complete);
+    } else {
+      updatePages(*device, texture, target_lod, complete);
+    }
+  }
+  if (complete) {
+    m_current_lod = target_lod;
+    m_new_lod = target_lod;
+  }
+  m_handle_lock.clear();
+}
+
+bool KRTexture2D::createSparseTexture(KRDevice& device, TextureHandle& texture, bool firstDevice)
+{
+  // Everything that can fail is created before the mip tail is bound, so a
+  // failed texture is destroyed in one place and nothing is freed while a
+  // bind may still be using it
+  std::vector<VkSparseMemoryBind> tailBinds;
+  std::vector<unsigned char> tailData;
+  bool success = allocateSparseTexture(device, texture, firstDevice, tailBinds, tailData);
+  if (success && !tailBinds.empty()) {
+    VkSparseImageOpaqueMemoryBindInfo opaqueBind{};
+    opaqueBind.image = texture.image;
+    opaqueBind.bindCount = (uint32_t)tailBinds.size();
+    opaqueBind.pBinds = tailBinds.data();
+    VkBindSparseInfo bindInfo{};
+    bindInfo.sType = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO;
+    bindInfo.imageOpaqueBindCount = 1;
+    bindInfo.pImageOpaqueBinds = &opaqueBind;
+    success = device.bindSparse(bindInfo);
+  }
+  if (!success) {
+    texture.destroy(getContext().getDeviceManager());
+    return false;
+  }
+
+  // The transfer waits for the bind, which is submitted before it
+  Vector3i dimensions = getDimensions();
+  std::vector<VkBufferImageCopy> regions;
+  size_t bufferOffset = 0;
+  for (int lod = m_mipTailLod; lod < m_lod_count; lod++) {
+    VkBufferImageCopy& region = regions.emplace_back(VkBufferImageCopy{});
+    region.bufferOffset = bufferOffset;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = lod;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = { 0, 0, 0 };
+    region.imageExtent = {
+      (unsigned int)std::max(dimensions.x >> lod, 1),
+      (unsigned int)std::max(dimensions.y >> lod, 1),
+      1
+    };
+    bufferOffset += getMemRequiredForLod(lod);
+  }
+  device.streamUpdate(tailData.data(), tailData.size(), texture.image, VK_IMAGE_LAYOUT_UNDEFINED, regions.data(), (int)regions.size());
+  texture.layout = VK_IMAGE_LAYOUT_GENERAL;
+
+  int pagesX = getPageCountX(0);
+  int pagesY = getPageCountY(0);
+  std::vector<unsigned char> residency((size_t)pagesX * pagesY, (unsigned char)m_mipTailLod);
+  VkBufferImageCopy residencyRegion{};
+  residencyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  residencyRegion.imageSubresource.layerCount = 1;
+  residencyRegion.imageExtent = { (unsigned int)pagesX, (unsigned int)pagesY, 1 };
+  device.streamUpdate(residency.data(), residency.size(), texture.residencyImage, VK_IMAGE_LAYOUT_UNDEFINED, &residencyRegion, 1);
+
+  size_t pageCount = 0;
+  for (int lod = 0; lod < m_mipTailLod; lod++) {
+    pageCount += (size_t)getPageCountX(lod) * getPageCountY(lod);
+  }
+  texture.pages.resize(pageCount);
+  return true;
+}
+
+bool KRTexture2D::allocateSparseTexture(KRDevice& device, TextureHandle& texture, bool firstDevice, std::vector<VkSparseMemoryBind>& tailBinds, std::vector<unsigned char>& tailData)
+{
+  Vector3i dimensions = getDimensions();
+  VkFormat format = getFormat();
+  VmaAllocator allocator = device.getAllocator();
+
+  VkImageCreateInfo imageInfo{};
+  imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+  imageInfo.flags = VK_IMAGE_CREATE_SPARSE_BINDING_BIT | VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT;
+  imageInfo.imageType = VK_IMAGE_TYPE_2D;
+  imageInfo.extent.width = static_cast<uint32_t>(dimensions.x);
+  imageInfo.extent.height = static_cast<uint32_t>(dimensions.y);
+  imageInfo.extent.depth = 1;
+  imageInfo.mipLevels = m_lod_count;
+  imageInfo.arrayLayers = 1;
+  imageInfo.format = format;
+  imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+  imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+  imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+  uint32_t queueFamilyIndices[2] = {};
+  imageInfo.pQueueFamilyIndices = queueFamilyIndices;
+  imageInfo.queueFamilyIndexCount = 0;
+  device.getQueueFamiliesForSharing(queueFamilyIndices, &imageInfo.queueFamilyIndexCount, &imageInfo.sharingMode);
+
+  if (vkCreateImage(device.m_logicalDevice, &imageInfo, nullptr, &texture.image) != VK_SUCCESS) {
+    texture.image = VK_NULL_HANDLE;
+    return false;
+  }
+#if KRENGINE_DEBUG_GPU_LABELS
+  device.setDebugLabel(texture.image, getName().c_str());
+#endif
+
+  VkMemoryRequirements memoryRequirements;
+  vkGetImageMemoryRequirements(device.m_logicalDevice, texture.image, &memoryRequirements);
+  uint32_t requirementCount = 0;
+  vkGetImageSparseMemoryRequirements(device.m_logicalDevice, texture.image, &requirementCount, nullptr);
+  std::vector<VkSparseImageMemoryRequirements> sparseRequirements(requirementCount);
+  vkGetImageSparseMemoryRequirements(device.m_logicalDevice, texture.image, &requirementCount, sparseRequirements.data());
+
+  // The color and metadata mip tails share one allocation
+  const VkSparseImageMemoryRequirements* colorRequirements = nullptr;
+  VkDeviceSize tailSize = 0;
+  for (const VkSparseImageMemoryRequirements& requirements : sparseRequirements) {
+    bool metadata = (requirements.formatProperties.aspectMask & VK_IMAGE_ASPECT_METADATA_BIT) != 0;
+    if (requirements.formatProperties.aspectMask & VK_IMAGE_ASPECT_COLOR_BIT) {
+      colorRequirements = &requirements;
+    }
+    if (requirements.imageMipTailSize == 0 || (!metadata && requirements.imageMipTailFirstLod >= (uint32_t)m_lod_count)) {
+      continue;
+    }
+    VkSparseMemoryBind& bind = tailBinds.emplace_back(VkSparseMemoryBind{});
+    bind.resourceOffset = requirements.imageMipTailOffset;
+    bind.size = requirements.imageMipTailSize;
+    bind.memoryOffset = tailSize;
+    bind.flags = metadata ? VK_SPARSE_MEMORY_BIND_METADATA_BIT : 0;
+    tailSize += (requirements.imageMipTailSize + memoryRequirements.alignment - 1) / memoryRequirements.alignment * memoryRequirements.alignment;
+  }
+  if (colorRequirements == nullptr) {
+    return false;
+  }
+
+  // The devices share the page table, so they must agree on the mip tail
+  int mipTailLod = std::min((int)colorRequirements->imageMipTailFirstLod, m_lod_count);
+  if (firstDevice) {
+    m_mipTailLod = mipTailLod;
+  } else if (mipTailLod != m_mipTailLod) {
+    KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Virtual texture mip tail differs between devices: %s", getName().c_str());
+    return false;
+  }
+
+  if (tailSize > 0) {
+    VkMemoryRequirements tailRequirements = memoryRequirements;
+    tailRequirements.size = tailSize;
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+    VmaAllocationInfo allocationInfo{};
+    if (vmaAllocateMemory(allocator, &tailRequirements, &allocInfo, &texture.allocation, &allocationInfo) != VK_SUCCESS) {
+      texture.allocation = VK_NULL_HANDLE;
+      return false;
+    }
+    for (VkSparseMemoryBind& bind : tailBinds) {
+      bind.memory = allocationInfo.deviceMemory;
+      bind.memoryOffset += allocationInfo.offset;
+    }
+  }
+
+  VkImageViewCreateInfo viewInfo{};
+  viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+  viewInfo.image = texture.image;
+  viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+  viewInfo.format = format;
+  viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  viewInfo.subresourceRange.baseMipLevel = 0;
+  viewInfo.subresourceRange.levelCount = m_lod_count;
+  viewInfo.subresourceRange.baseArrayLayer = 0;
+  viewInfo.subresourceRange.layerCount = 1;
+  if (vkCreateImageView(device.m_logicalDevice, &viewInfo, nullptr, &texture.fullImageView) != VK_SUCCESS) {
+    texture.fullImageView = VK_NULL_HANDLE;
+    return false;
+  }
+
+  // The residency image has a texel for each page of the first level, holding
+  // the finest level resident in that page
+  VkImageCreateInfo residencyInfo = imageInfo;
+  residencyInfo.flags = 0;
+  residencyInfo.extent.width = static_cast<uint32_t>(getPageCountX(0));
+  residencyInfo.extent.height = static_cast<uint32_t>(getPageCountY(0));
+  residencyInfo.mipLevels = 1;
+  residencyInfo.format = VK_FORMAT_R8_UNORM;
+  VmaAllocationCreateInfo residencyAllocInfo{};
+  residencyAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+  if (vmaCreateImage(allocator, &residencyInfo, &residencyAllocInfo, &texture.residencyImage, &texture.residencyAllocation, nullptr) != VK_SUCCESS) {
+    texture.residencyImage = VK_NULL_HANDLE;
+    texture.residencyAllocation = VK_NULL_HANDLE;
+    return false;
+  }
+  viewInfo.image = texture.residencyImage;
+  viewInfo.format = VK_FORMAT_R8_UNORM;
+  viewInfo.subresourceRange.levelCount = 1;
+  if (vkCreateImageView(device.m_logicalDevice, &viewInfo, nullptr, &texture.residencyImageView) != VK_SUCCESS) {
+    texture.residencyImageView = VK_NULL_HANDLE;
+    return false;
+  }
+
+  if (m_mipTailLod < m_lod_count) {
+    tailData.resize(getMemRequiredForLodRange(m_mipTailLod));
+    if (!getLodData(tailData.data(), m_mipTailLod)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void KRTexture2D::updatePages(KRDevice& device, TextureHandle& texture, int lod, bool& complete)
+{
+  Vector3i dimensions = getDimensions();
+  VmaAllocator allocator = device.getAllocator();
+
+  // Each page is allocated separately, with the size and alignment of a sparse block
+  VkMemoryRequirements pageRequirements;
+  vkGetImageMemoryRequirements(device.m_logicalDevice, texture.image, &pageRequirements);
+  pageRequirements.size = pageRequirements.alignment;
+  VmaAllocationCreateInfo allocInfo{};
+  allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+  struct PageUpload
+  {
+    TextureHandle::Page* page;
+    int lod;
+    VkOffset3D offset;
+    VkExtent3D extent;
+  };
+  std::vector<PageUpload> uploads;
+  std::vector<VkSparseImageMemoryBind> binds;
+  std::vector<TextureHandle::Page*> evicted;
+  std::vector<VmaAllocation> evictedAllocations;
+  std::vector<int> levelPageStart(m_mipTailLod);
+  bool residencyChanged = false;
+  long memoryDelta = 0;
+  uint64_t framesSubmitted = device.getGraphicsFramesSubmitted();
+  uint64_t framesCompleted = device.getGraphicsFramesCompleted();
+
+  // Memory unbound by earlier passes is freed once the binds have executed
+  uint64_t streamingCompleted = device.getStreamingCompleted();
+  for (auto itr = texture.unboundAllocations.begin(); itr != texture.unboundAllocations.end();) {
+    if ((*itr).first <= streamingCompleted) {
+      vmaFreeMemory(allocator, (*itr).second);
+      itr = texture.unboundAllocations.erase(itr);
+    } else {
+      itr++;
+    }
+  }
+
+  int pageStart = 0;
+  for (int level = 0; level < m_mipTailLod; level++) {
+    levelPageStart[level] = pageStart;
+    int width = std::max(dimensions.x >> level, 1);
+    int height = std::max(dimensions.y >> level, 1);
+    int pagesX = getPageCountX(level);
+    int pagesY = getPageCountY(level);
+    for (int page_y = 0; page_y < pagesY; page_y++) {
+      for (int page_x = 0; page_x < pagesX; page_x++) {
+        TextureHandle::Page& page = texture.pages[pageStart + page_y * pagesX + page_x];
+        bool visible = level >= lod && isPageVisible(level, page_x, page_y);
+        if (visible) {
+          if (page.allocation == VK_NULL_HANDLE) {
+            // Pages are mapped in the pass after they are uploaded
+            complete = false;
+            if (uploads.size() >= KRENGINE_VIRTUAL_TEXTURE_PAGES_PER_UPDATE) {
+              continue;
+            }
+            VmaAllocationInfo allocationInfo{};
+            if (vmaAllocateMemory(allocator, &pageRequirements, &allocInfo, &page.allocation, &allocationInfo) != VK_SUCCESS) {
+              page.allocation = VK_NULL_HANDLE;
+              continue;
+            }
+            VkSparseImageMemoryBind& bind = binds.emplace_back(VkSparseImageMemoryBind{});
+            bind.subresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            bind.subresource.mipLevel = level;
+            bind.subresource.arrayLayer = 0;
+            bind.offset = { page_x * m_pageWidth, page_y * m_pageHeight, 0 };
+            bind.extent = {
+              (uint32_t)std::min(m_pageWidth, width - bind.offset.x),
+              (uint32_t)std::min(m_pageHeight, height - bind.offset.y),
+              1
+            };
+            bind.memory = allocationInfo.deviceMemory;
+            bind.memoryOffset = allocationInfo.offset;
+            uploads.push_back({ &page, level, bind.offset, bind.extent });
+            memoryDelta += (long)pageRequirements.size;
+          } else if (!page.mapped) {
+            page.mapped = true;
+            residencyChanged = true;
+          }
+        } else if (page.mapped) {
+          // Pages are removed from the residency image before they are unbound
+          page.mapped = false;
+          page.unmappedFrame = framesSubmitted;
+          residencyChanged = true;
+        } else if (page.allocation != VK_NULL_HANDLE && framesCompleted >= page.unmappedFrame + KRENGINE_MAX_FRAMES_IN_FLIGHT) {
+          // Frames that were in flight when the page was unmapped may still sample it
+          VkSparseImageMemoryBind& bind = binds.emplace_back(VkSparseImageMemoryBind{});
+          bind.subresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+          bind.subresource.mipLevel = level;
+          bind.subresource.arrayLayer = 0;
+          bind.offset = { page_x * m_pageWidth, page_y * m_pageHeight, 0 };
+          bind.extent = {
+            (uint32_t)std::min(m_pageWidth, width - bind.offset.x),
+            (uint32_t)std::min(m_pageHeight, height - bind.offset.y),
+            1
+          };
+          bind.memory = VK_NULL_HANDLE;
+          evicted.push_back(&page);
+          evictedAllocations.push_back(page.allocation);
+          page.allocation = VK_NULL_HANDLE;
+          memoryDelta -= (long)pageRequirements.size;
+        }
+      }
+    }
+    pageStart += pagesX * pagesY;
+  }
+
+  if (!binds.empty()) {
+    VkSparseImageMemoryBindInfo imageBind{};
+    imageBind.image = texture.image;
+    imageBind.bindCount = (uint32_t)binds.size();
+    imageBind.pBinds = binds.data();
+    VkBindSparseInfo bindInfo{};
+    bindInfo.sType = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO;
+    bindInfo.imageBindCount = 1;
+    bindInfo.pImageBinds = &imageBind;
+    if (!device.bindSparse(bindInfo)) {
+      KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Failed to bind pages of virtual texture: %s", getName().c_str());
+      for (PageUpload& upload : uploads) {
+        vmaFreeMemory(allocator, upload.page->allocation);
+        upload.page->allocation = VK_NULL_HANDLE;
+        memoryDelta -= (long)pageRequirements.size;
+      }
+      uploads.clear();
+      // Evicted pages are still bound, and are evicted again in a later pass
+      for (size_t i = 0; i < evicted.size(); i++) {
+        evicted[i]->allocation = evictedAllocations[i];
+        memoryDelta += (long)pageRequirements.size;
+      }
+      evictedAllocations.clear();
+      complete = false;
+    } else {
+      uint64_t bindValue = device.getStreamingSubmitted();
+      for (VmaAllocation allocation : evictedAllocations) {
+        texture.unboundAllocations.push_back(std::make_pair(bindValue, allocation));
+      }
+    }
+  }
+
+  if (!uploads.empty()) {
+    int blockWidth = 1, blockHeight = 1, blockBytes = 1;
+    GetFormatBlockInfo(getFormat(), blockWidth, blockHeight, blockBytes);
+    std::vector<VkBufferImageCopy> regions(uploads.size(), VkBufferImageCopy{});
+    size_t bufferSize = 0;
+    for (size_t i = 0; i < uploads.size(); i++) {
+      regions[i].bufferOffset = bufferSize;
+      bufferSize += (size_t)((uploads[i].extent.width + blockWidth - 1) / blockWidth)
+        * ((uploads[i].extent.height + blockHeight - 1) / blockHeight) * blockBytes;
+    }
+    std::vector<unsigned char> buffer(bufferSize);
+    for (size_t i = 0; i < uploads.size(); i++) {
+      PageUpload& upload = uploads[i];
+      if (!getLodRegionData(buffer.data() + regions[i].bufferOffset, upload.lod, upload.offset.x, upload.offset.y, upload.extent.width, upload.extent.height)) {
+        KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Failed to read page of virtual texture: %s", getName().c_str());
+      }
+      VkBufferImageCopy& region = regions[i];
+      region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+      region.imageSubresource.mipLevel = upload.lod;
+      region.imageSubresource.baseArrayLayer = 0;
+      region.imageSubresource.layerCount = 1;
+      region.imageOffset = upload.offset;
+      region.imageExtent = upload.extent;
+    }
+    device.streamUpdate(buffer.data(), bufferSize, texture.image, VK_IMAGE_LAYOUT_GENERAL, regions.data(), (int)regions.size());
+    getContext().getTextureManager()->addMemoryTransferredThisFrame((long)bufferSize);
+  }
+
+  if (residencyChanged) {
+    // Each texel holds the finest level from which it can be sampled without
+    // reaching a page that is not resident
+    int pagesX = getPageCountX(0);
+    int pagesY = getPageCountY(0);
+    std::vector<unsigned char> residency((size_t)pagesX * pagesY);
+    for (int cell_y = 0; cell_y < pagesY; cell_y++) {
+      for (int cell_x = 0; cell_x < pagesX; cell_x++) {
+        int resident_lod = m_mipTailLod;
+        for (int level = m_mipTailLod - 1; level >= 0; level--) {
+          int levelPagesX = getPageCountX(level);
+          int page_x = std::min(cell_x >> level, levelPagesX - 1);
+          int page_y = std::min(cell_y >> level, getPageCountY(level) - 1);
+          if (!texture.pages[levelPageStart[level] + page_y * levelPagesX + page_x].mapped) {
+            break;
+          }
+          resident_lod = level;
+        }
+        residency[cell_y * pagesX + cell_x] = (unsigned char)resident_lod;
+      }
+    }
+    VkBufferImageCopy residencyRegion{};
+    residencyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    residencyRegion.imageSubresource.layerCount = 1;
+    residencyRegion.imageExtent = { (unsigned int)pagesX, (unsigned int)pagesY, 1 };
+    device.streamUpdate(residency.data(), residency.size(), texture.residencyImage, VK_IMAGE_LAYOUT_GENERAL, &residencyRegion, 1);
+  }
+
+  if (memoryDelta != 0) {
+    residentMemoryChanged(memoryDelta);
+  }
+}
+
+namespace {
+// A span of texels along one axis of a page cache slot, read from one span of the level
+struct CacheRun
+{
+  int source;
+  int length;
+  int dest;
+};
+
+// Splits a page and the border around it into spans that do not cross the
+// edge of the level, wrapping as the coordinates of tiled textures do
+int getCacheRuns(int page, int pageSize, int border, int levelSize, CacheRun* runs)
+{
+  int start = page * pageSize;
+  int length = std::min(pageSize, levelSize - start);
+  int count = 0;
+  runs[count++] = { (start - border + levelSize) % levelSize, border, 0 };
+  runs[count++] = { start, length, border };
+  int source = (start + length) % levelSize;
+  int dest = border + length;
+  int remaining = border;
+  while (remaining > 0) {
+    int run = std::min(remaining, levelSize - source);
+    runs[count++] = { source, run, dest };
+    source = 0;
+    dest += run;
+    remaining -= run;
+  }
+  return count;
+}
+} // anonymous namespace
+
+bool KRTexture2D::createPageCacheTexture(KRDevice& device, TextureHandle& texture)
+{
+  // As with sparse images, everything that can fail is done before any
+  // transfer is recorded, and a failed texture is destroyed in one place
+  std::vector<unsigned char> tailData;
+  std::vector<VkBufferImageCopy> tailRegions;
+  if (!allocatePageCacheTexture(device, texture, tailData, tailRegions)) {
+    texture.destroy(getContext().getDeviceManager());
+    return false;
+  }
+
+  device.streamUpdate(tailData.data(), tailData.size(), texture.image, VK_IMAGE_LAYOUT_UNDEFINED, tailRegions.data(), (int)tailRegions.size());
+  texture.layout = VK_IMAGE_LAYOUT_GENERAL;
+
+  size_t pageCount = 0;
+  for (int lod = 0; lod < m_mipTailLod; lod++) {
+    pageCount += (size_t)getPageCountX(lod) * getPageCountY(lod);
+  }
+  texture.pages.resize(pageCount);
+  updateIndirection(device, texture, VK_IMAGE_LAYOUT_UNDEFINED);
+
+  // Slot 0 holds the mip tail
+  const int slotCount = KRENGINE_VIRTUAL_TEXTURE_CACHE_SLOTS * KRENGINE_VIRTUAL_TEXTURE_CACHE_SLOTS;
+  for (int slot = slotCount - 1; slot > 0; slot--) {
+    texture.freeSlots.push_back(slot);
+  }
+  return true;
+}
+
+bool KRTexture2D::allocatePageCacheTexture(KRDevice& device, TextureHandle& texture, std::vector<unsigned char>& tailData, std::vector<VkBufferImageCopy>& tailRegions)
+{
+  VmaAllocator allocator = device.getAllocator();
+  const int slotSize = KRENGINE_VIRTUAL_TEXTURE_CACHE_PAGE_SIZE + 2 * KRENGINE_VIRTUAL_TEXTURE_CACHE_BORDER;
+  const int cacheSize = slotSize * KRENGINE_VIRTUAL_TEXTURE_CACHE_SLOTS;
+
+  if (!readCachePage(m_mipTailLod, 0, 0, 0, tailData, tailRegions)) {
+    return false;
+  }
+
+  VkImageCreateInfo imageInfo{};
+  imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+  imageInfo.imageType = VK_IMAGE_TYPE_2D;
+  imageInfo.extent.width = static_cast<uint32_t>(cacheSize);
+  imageInfo.extent.height = static_cast<uint32_t>(cacheSize);
+  imageInfo.extent.depth = 1;
+  imageInfo.mipLevels = 1;
+  imageInfo.arrayLayers = 1;
+  imageInfo.format = getFormat();
+  imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+  imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+  imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+  uint32_t queueFamilyIndices[2] = {};
+  imageInfo.pQueueFamilyIndices = queueFamilyIndices;
+  imageInfo.queueFamilyIndexCount = 0;
+  device.getQueueFamiliesForSharing(queueFamilyIndices, &imageInfo.queueFamilyIndexCount, &imageInfo.sharingMode);
+  VmaAllocationCreateInfo allocInfo{};
+  allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+  if (vmaCreateImage(allocator, &imageInfo, &allocInfo, &texture.image, &texture.allocation, nullptr) != VK_SUCCESS) {
+    texture.image = VK_NULL_HANDLE;
+    texture.allocation = VK_NULL_HANDLE;
+    return false;
+  }
+#if KRENGINE_DEBUG_GPU_LABELS
+  device.setDebugLabel(texture.image, getName().c_str());
+#endif
+
+  VkImageViewCreateInfo viewInfo{};
+  viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+  viewInfo.image = texture.image;
+  viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+  viewInfo.format = imageInfo.format;
+  viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  viewInfo.subresourceRange.baseMipLevel = 0;
+  viewInfo.subresourceRange.levelCount = 1;
+  viewInfo.subresourceRange.baseArrayLayer = 0;
+  viewInfo.subresourceRange.layerCount = 1;
+  if (vkCreateImageView(device.m_logicalDevice, &viewInfo, nullptr, &texture.fullImageView) != VK_SUCCESS) {
+    texture.fullImageView = VK_NULL_HANDLE;
+    return false;
+  }
+
+  // The indirection image has a texel for each page of the first level, and a
+  // level for each level of the texture down to the mip tail
+  VkImageCreateInfo indirectionInfo = imageInfo;
+  indirectionInfo.extent.width = static_cast<uint32_t>(getPageCountX(0));
+  indirectionInfo.extent.height = static_cast<uint32_t>(getPageCountY(0));
+  indirectionInfo.mipLevels = m_mipTailLod + 1;
+  indirectionInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+  if (vmaCreateImage(allocator, &indirectionInfo, &allocInfo, &texture.residencyImage, &texture.residencyAllocation, nullptr) != VK_SUCCESS) {
+    texture.residencyImage = VK_NULL_HANDLE;
+    texture.residencyAllocation = VK_NULL_HANDLE;
+    return false;
+  }
+  viewInfo.image = texture.residencyImage;
+  viewInfo.format = indirectionInfo.format;
+  viewInfo.subresourceRange.levelCount = indirectionInfo.mipLevels;
+  if (vkCreateImageView(device.m_logicalDevice, &viewInfo, nullptr, &texture.residencyImageView) != VK_SUCCESS) {
+    texture.residencyImageView = VK_NULL_HANDLE;
+    return false;
+  }
+  return true;
+}
+
+bool KRTexture2D::readCachePage(int lod, int page_x, int page_y, int slot, std::vector<unsigned char>& buffer, std::vector<VkBufferImageCopy>& regions)
+{
+  const int pageSize = KRENGINE_VIRTUAL_TEXTURE_CACHE_PAGE_SIZE;
+  const int border = KRENGINE_VIRTUAL_TEXTURE_CACHE_BORDER;
+  const int slotSize = pageSize + 2 * border;
+  int blockWidth = 1, blockHeight = 1, blockBytes = 1;
+  GetFormatBlockInfo(getFormat(), blockWidth, blockHeight, blockBytes);
+
+  Vector3i dimensions = getDimensions();
+  CacheRun runsX[4];
+  CacheRun runsY[4];
+  int countX = getCacheRuns(page_x, pageSize, border, std::max(dimensions.x >> lod, 1), runsX);
+  int countY = getCacheRuns(page_y, pageSize, border, std::max(dimensions.y >> lod, 1), runsY);
+  int slotX = (slot % KRENGINE_VIRTUAL_TEXTURE_CACHE_SLOTS) * slotSize;
+  int slotY = (slot / KRENGINE_VIRTUAL_TEXTURE_CACHE_SLOTS) * slotSize;
+
+  bool success = true;
+  for (int y = 0; y < countY; y++) {
+    for (int x = 0; x < countX; x++) {
+      const CacheRun& runX = runsX[x];
+      const CacheRun& runY = runsY[y];
+      VkBufferImageCopy& region = regions.emplace_back(VkBufferImageCopy{});
+      region.bufferOffset = buffer.size();
+      region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+      region.imageSubresource.mipLevel = 0;
+      region.imageSubresource.baseArrayLayer = 0;
+      region.imageSubresource.layerCount = 1;
+      region.imageOffset = { slotX + runX.dest, slotY + runY.dest, 0 };
+      region.imageExtent = { (uint32_t)runX.length, (uint32_t)runY.length, 1 };
+      buffer.resize(buffer.size() + (size_t)(runX.length / blockWidth) * (runY.length / blockHeight) * blockBytes);
+      if (!getLodRegionData(buffer.data() + region.bufferOffset, lod, runX.source, runY.source, runX.length, runY.length)) {
+        success = false;
+      }
+    }
+  }
+  return success;
+}
+
+void KRTexture2D::updateCachePages(KRDevice& device, TextureHandle& texture, int lod, bool& complete)
+{
+  int blockWidth = 1, blockHeight = 1, blockBytes = 1;
+  GetFormatBlockInfo(getFormat(), blockWidth, blockHeight, blockBytes);
+  const int slotSize = KRENGINE_VIRTUAL_TEXTURE_CACHE_PAGE_SIZE + 2 * KRENGINE_VIRTUAL_TEXTURE_CACHE_BORDER;
+  const long slotBytes = (long)(slotSize / blockWidth) * (slotSize / blockHeight) * blockBytes;
+
+  std::vector<unsigned char> buffer;
+  std::vector<VkBufferImageCopy> regions;
+  int uploadCount = 0;
+  bool indirectionChanged = false;
+  long memoryDelta = 0;
+  uint64_t framesSubmitted = device.getGraphicsFramesSubmitted();
+  uint64_t framesCompleted = device.getGraphicsFramesCompleted();
+
+  std::vector<int> levelPageStart(m_mipTailLod);
+  int pageStart = 0;
+  for (int level = 0; level < m_mipTailLod; level++) {
+    levelPageStart[level] = pageStart;
+    pageStart += getPageCountX(level) * getPageCountY(level);
+  }
+
+  // Coarser pages take the free slots first, as finer pages fall back to them
+  // when they are not resident
+  for (int level = m_mipTailLod - 1; level >= 0; level--) {
+    int pagesX = getPageCountX(level);
+    int pagesY = getPageCountY(level);
+    for (int page_y = 0; page_y < pagesY; page_y++) {
+      for (int page_x = 0; page_x < pagesX; page_x++) {
+        TextureHandle::Page& page = texture.pages[levelPageStart[level] + page_y * pagesX + page_x];
+        bool visible = level >= lod && isPageVisible(level, page_x, page_y);
+        if (visible) {
+          if (page.slot == -1) {
+            // Pages are mapped in the pass after they are uploaded
+            complete = false;
+            if (uploadCount >= KRENGINE_VIRTUAL_TEXTURE_PAGES_PER_UPDATE || texture.freeSlots.empty()) {
+              continue;
+            }
+            page.slot = texture.freeSlots.back();
+            texture.freeSlots.pop_back();
+            if (!readCachePage(level, page_x, page_y, page.slot, buffer, regions)) {
+              KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Failed to read page of virtual texture: %s", getName().c_str());
+            }
+            uploadCount++;
+            memoryDelta += slotBytes;
+          } else if (!page.mapped) {
+            page.mapped = true;
+            indirectionChanged = true;
+          }
+        } else if (page.mapped) {
+          // Pages are removed from the indirection image before their slot is reused
+          page.mapped = false;
+          page.unmappedFrame = framesSubmitted;
+          indirectionChanged = true;
+        } else if (page.slot != -1 && framesCompleted >= page.unmappedFrame + KRENGINE_MAX_FRAMES_IN_FLIGHT) {
+          // Frames that were in flight when the page was unmapped may still sample its slot
+          texture.freeSlots.push_back(page.slot);
+          page.slot = -1;
+          memoryDelta -= slotBytes;
+        }
+      }
+    }
+  }
+
+  if (!regions.empty()) {
+    device.streamUpdate(buffer.data(), buffer.size(), texture.image, VK_IMAGE_LAYOUT_GENERAL, regions.data(), (int)regions.size());
+    getContext().getTextureManager()->addMemoryTransferredThisFrame((long)buffer.size());
+  }
+  if (indirectionChanged) {
+    updateIndirection(device, texture, VK_IMAGE_LAYOUT_GENERAL);
+  }
+  if (memoryDelta != 0) {
+    residentMemoryChanged(memoryDelta);
+  }
+}
+
+void KRTexture2D::updateIndirection(KRDevice& device, TextureHandle& texture, VkImageLayout oldLayout)
+{
+  // Each level of the indirection image covers the pages of the same level of
+  // the texture.  Its texels hold the slot and level of the finest mapped page
+  // at or above that level, falling back to the mip tail in slot 0.
+  Vector3i dimensions = getDimensions();
+  const int pageSize = KRENGINE_VIRTUAL_TEXTURE_CACHE_PAGE_SIZE;
+  int pagesX = getPageCountX(0);
+  int pagesY = getPageCountY(0);
+
+  std::vector<int> levelPageStart(m_mipTailLod);
+  int pageStart = 0;
+  for (int level = 0; level < m_mipTailLod; level++) {
+    levelPageStart[level] = pageStart;
+    pageStart += getPageCountX(level) * getPageCountY(level);
+  }
+
+  std::vector<unsigned char> indirection;
+  std::vector<VkBufferImageCopy> regions;
+  for (int level = 0; level <= m_mipTailLod; level++) {
+    int sizeX = std::max(pagesX >> level, 1);
+    int sizeY = std::max(pagesY >> level, 1);
+    VkBufferImageCopy& region = regions.emplace_back(VkBufferImageCopy{});
+    region.bufferOffset = indirection.size();
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = level;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent = { (uint32_t)sizeX, (uint32_t)sizeY, 1 };
+    for (int y = 0; y < sizeY; y++) {
+      for (int x = 0; x < sizeX; x++) {
+        // Texels are matched to the page under their center
+        float u = (x + 0.5f) / sizeX;
+        float v = (y + 0.5f) / sizeY;
+        int slot = 0;
+        int resident_lod = m_mipTailLod;
+        for (int page_level = level; page_level < m_mipTailLod; page_level++) {
+          int levelPagesX = getPageCountX(page_level);
+          int levelPagesY = getPageCountY(page_level);
+          int page_x = std::min((int)(u * std::max(dimensions.x >> page_level, 1) / pageSize), levelPagesX - 1);
+          int page_y = std::min((int)(v * std::max(dimensions.y >> page_level, 1) / pageSize), levelPagesY - 1);
+          const TextureHandle::Page& page = texture.pages[levelPageStart[page_level] + page_y * levelPagesX + page_x];
+          if (page.mapped) {
+            slot = page.slot;
+            resident_lod = page_level;
+            break;
+          }
+        }
+        indirection.push_back((unsigned char)(slot % KRENGINE_VIRTUAL_TEXTURE_CACHE_SLOTS));
+        indirection.push_back((unsigned char)(slot / KRENGINE_VIRTUAL_TEXTURE_CACHE_SLOTS));
+        indirection.push_back((unsigned char)resident_lod);
+        indirection.push_back(0xff);
+      }
+    }
+  }
+  device.streamUpdate(indirection.data(), indirection.size(), texture.residencyImage, oldLayout, regions.data(), (int)regions.size());
+}
+
+bool KRTexture2D::supportsLodRegionData() const
+{
+  return false;
+}
+
+bool KRTexture2D::getLodRegionData(void* buffer, int lod, int x, int y, int width, int height)
+{
+  return false;
+}
+
+bool KRTexture2D::GetFormatBlockInfo(VkFormat format, int& blockWidth, int& blockHeight, int& blockBytes)
+{
+  blockWidth = 1;
+  blockHeight = 1;
+  switch (format) {
+  case VK_FORMAT_R8_UNORM:
+  case VK_FORMAT_R8_SRGB:
+    blockBytes = 1;
+    return true;
+  case VK_FORMAT_R8G8_UNORM:
+  case VK_FORMAT_R8G8_SRGB:
+  case VK_FORMAT_R16_UNORM:
+  case VK_FORMAT_R16_SFLOAT:
+    blockBytes = 2;
+    return true;
+  case VK_FORMAT_R8G8B8A8_UNORM:
+  case VK_FORMAT_R8G8B8A8_SRGB:
+  case VK_FORMAT_B8G8R8A8_UNORM:
+  case VK_FORMAT_B8G8R8A8_SRGB:
+  case VK_FORMAT_R32_SFLOAT:
+    blockBytes = 4;
+    return true;
+  case VK_FORMAT_R16G16B16A16_SFLOAT:
+    blockBytes = 8;
+    return true;
+  case VK_FORMAT_R32G32B32A32_SFLOAT:
+    blockBytes = 16;
+    return true;
+  default:
+    break;
+  }
+
+  blockWidth = 4;
+  blockHeight = 4;
+  switch (format) {
+  case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+  case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+  case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+  case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+  case VK_FORMAT_BC4_UNORM_BLOCK:
+  case VK_FORMAT_BC4_SNORM_BLOCK:
+  case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+  case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+  case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
+  case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
+  case VK_FORMAT_EAC_R11_UNORM_BLOCK:
+  case VK_FORMAT_EAC_R11_SNORM_BLOCK:
+    blockBytes = 8;
+    return true;
+  case VK_FORMAT_BC2_UNORM_BLOCK:
+  case VK_FORMAT_BC2_SRGB_BLOCK:
+  case VK_FORMAT_BC3_UNORM_BLOCK:
+  case VK_FORMAT_BC3_SRGB_BLOCK:
+  case VK_FORMAT_BC5_UNORM_BLOCK:
+  case VK_FORMAT_BC5_SNORM_BLOCK:
+  case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+  case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+  case VK_FORMAT_BC7_UNORM_BLOCK:
+  case VK_FORMAT_BC7_SRGB_BLOCK:
+  case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+  case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+  case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:
+  case VK_FORMAT_EAC_R11G11_SNORM_BLOCK:
+  case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+  case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+    blockBytes = 16;
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool KRTexture2D::CopyLevelRegion(const unsigned char* level, size_t levelSize, VkFormat format, int levelWidth, int levelHeight, void* buffer, int x, int y, int width, int height)
+{
+  int blockWidth, blockHeight, blockBytes;
+  if (!GetFormatBlockInfo(format, blockWidth, blockHeight, blockBytes)) {
+    return false;
+  }
+  size_t levelBlocksX = (levelWidth + blockWidth - 1) / blockWidth;
+  size_t levelBlocksY = (levelHeight + blockHeight - 1) / blockHeight;
+  if (levelBlocksY == 0) {
+    return false;
+  }
+  // Rows may be padded, as they are in KTX files
+  size_t pitch = levelSize / levelBlocksY;
+  if (pitch < levelBlocksX * blockBytes) {
+    return false;
+  }
+
+  size_t blockX = x / blockWidth;
+  size_t blockY = y / blockHeight;
+  size_t rowBytes = (size_t)((width + blockWidth - 1) / blockWidth) * blockBytes;
+  size_t rowCount = (height + blockHeight - 1) / blockHeight;
+  if (blockX * blockBytes + rowBytes > pitch || blockY + rowCount > levelBlocksY) {
+    return false;
+  }
+
+  unsigned char* dest = (unsigned char*)buffer;
+  for (size_t row = 0; row < rowCount; row++) {
+    memcpy(dest + row * rowBytes, level + (blockY + row) * pitch + blockX * blockBytes, rowBytes);
+  }
+  return true;
+}
+
+void KRTexture2D::DownsampleRGBA8(const unsigned char* source, int source_width, int source_height, unsigned char* dest)
+{
+  int width = std::max(source_width >> 1, 1);
+  int height = std::max(source_height >> 1, 1);
+  size_t source_stride = (size_t)source_width * 4;
+  for (int y = 0; y < height; y++) {
+    const unsigned char* row0 = source + (size_t)std::min(y * 2, source_height - 1) * source_stride;
+    const unsigned char* row1 = source + (size_t)std::min(y * 2 + 1, source_height - 1) * source_stride;
+    for (int x = 0; x < width; x++) {
+      size_t x0 = (size_t)std::min(x * 2, source_width - 1) * 4;
+      size_t x1 = (size_t)std::min(x * 2 + 1, source_width - 1) * 4;
+      for (int channel = 0; channel < 4; channel++) {
+        *dest++ = (unsigned char)((row0[x0 + channel] + row0[x1 + channel] + row1[x0 + channel] + row1[x1 + channel] + 2) >> 2);
+      }
+    }
+  }
+}
+
+#if !TARGET_OS_IPHONE && !defined(ANDROID)
+
+KRTexture* KRTexture2D::compress(KrTextureCompressionFormat format, KrTextureCompressionQuality quality, bool premultiply_alpha)
+{
+  // Textures that are decoded to RGBA8 are compressed on the CPU, with a full mip chain
+  if (getFormat() != VK_FORMAT_R8G8B8A8_SRGB || getFaceCount() != 1) {
+    return nullptr;
+  }
+
+  Vector3i dimensions = getDimensions();
+  int width = dimensions.x;
+  int height = dimensions.y;
+  if (width <= 0 || height <= 0) {
+    return nullptr;
+  }
+
+  std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+  std::vector<unsigned char> image(getMemRequiredForLodRange(0));
+  if (!getLodData(image.data(), 0)) {
+    return nullptr;
+  }
+  image.resize((size_t)width * height * 4);
+
+  bool has_alpha = false;
+  for (size_t i = 3; i < image.size(); i += 4) {
+    if (image[i] != 0xff) {
+      has_alpha = true;
+      break;
+    }
+  }
+  if (premultiply_alpha && has_alpha) {
+    for (size_t i = 0; i < image.size(); i += 4) {
+      for (int channel = 0; channel < 3; channel++) {
+        image[i + channel] = (unsigned char)((image[i + channel] * image[i + 3] + 127) / 255);
+      }
+    }
+  }
+
+  if (format == KR_TEXTURE_COMPRESSION_FORMAT_AUTO) {
+    if (quality == KR_TEXTURE_COMPRESSION_QUALITY_HIGH) {
+      format = KR_TEXTURE_COMPRESSION_FORMAT_BC7;
+    } else {
+      format = has_alpha ? KR_TEXTURE_COMPRESSION_FORMAT_BC3 : KR_TEXTURE_COMPRESSION_FORMAT_BC1;
+    }
+  }
+
+  float cmp_quality = 0.5f;
+  switch (quality) {
+  case KR_TEXTURE_COMPRESSION_QUALITY_FAST:
+    cmp_quality = 0.05f;
+    break;
+  case KR_TEXTURE_COMPRESSION_QUALITY_HIGH:
+    cmp_quality = 1.0f;
+    break;
+  default:
+    break;
+  }
+
+  void* options = nullptr;
+  int block_size = 16;
+  unsigned int internal_format = 0;
+  unsigned int base_internal_format = 0;
+  const char* format_name = nullptr;
+  switch (format) {
+  case KR_TEXTURE_COMPRESSION_FORMAT_BC1:
+    CreateOptionsBC1(&options);
+    SetQualityBC1(options, cmp_quality);
+    block_size = 8;
+    internal_format = 0x8C4C; // COMPRESSED_SRGB_S3TC_DXT1_EXT
+    base_internal_format = 0x1907; // GL_RGB
+    format_name = "BC1";
+    break;
+  case KR_TEXTURE_COMPRESSION_FORMAT_BC3:
+    CreateOptionsBC3(&options);
+    SetQualityBC3(options, cmp_quality);
+    internal_format = 0x8C4F; // COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+    base_internal_format = 0x1908; // GL_RGBA
+    format_name = "BC3";
+    break;
+  case KR_TEXTURE_COMPRESSION_FORMAT_BC5:
+    // Two channel data, such as tangent space normal maps, is not color encoded
+    CreateOptionsBC5(&options);
+    SetQualityBC5(options, cmp_quality);
+    internal_format = 0x8DBD; // COMPRESSED_RG_RGTC2
+    base_internal_format = 0x8227; // GL_RG
+    format_name = "BC5";
+    break;
+  case KR_TEXTURE_COMPRESSION_FORMAT_BC7:
+    CreateOptionsBC7(&options);
+    SetQualityBC7(options, cmp_quality);
+    internal_format = 0x8E8D; // COMPRESSED_SRGB_ALPHA_BPTC_UNORM
+    base_internal_format = 0x1908; // GL_RGBA
+    format_name = "BC7";
+    break;
+  default:
+    return nullptr;
+  }
+
+  // Blocks are compressed a row at a time on the thread pool.  The error of
+  // the first level is measured as it is compressed, to report its PSNR.
+  KRThreadPool* thread_pool = getContext().getThreadPool();
+  std::list<Block*> blocks;
+  std::vector<unsigned char> next_image;
+  std::vector<double> row_squared_error;
+  double squared_error = 0.0;
+  long long pixel_count = 0;
+  int level_index = 0;
+  while (true) {
+    int blocks_x = (width + 3) / 4;
+    int blocks_y = (height + 3) / 4;
+    Block* level = new Block();
+    level->expand((size_t)blocks_x * blocks_y * block_size);
+    level->lock();
+    unsigned char* compressed = (unsigned char*)level->getStart();
+    bool measure_error = level_index == 0;
+    row_squared_error.assign(blocks_y, 0.0);
+
+    thread_pool->parallelFor(blocks_y, 1, [&](size_t begin, size_t end) {
+      for (size_t block_y = begin; block_y < end; block_y++) {
+        for (int block_x = 0; block_x < blocks_x; block_x++) {
+          // Blocks overlapping the edge of the image repeat the last row and column
+          unsigned char source_block[16 * 4];
+          for (int y = 0; y < 4; y++) {
+            for (int x = 0; x < 4; x++) {
+              int source_x = std::min(block_x * 4 + x, width - 1);
+              int source_y = std::min((int)block_y * 4 + y, height - 1);
+              memcpy(source_block + (y * 4 + x) * 4, image.data() + ((size_t)source_y * width + source_x) * 4, 4);
+            }
+          }
+
+          unsigned char* compressed_block = compressed + ((size_t)block_y * blocks_x + block_x) * block_size;
+          unsigned char decoded_block[16 * 4];
+          int channel_count = 4;
+          switch (format) {
+          case KR_TEXTURE_COMPRESSION_FORMAT_BC1:
+            CompressBlockBC1(source_block, 16, compressed_block, options);
+            if (measure_error) {
+              DecompressBlockBC1(compressed_block, decoded_block, options);
+            }
+            channel_count = 3;
+            break;
+          case KR_TEXTURE_COMPRESSION_FORMAT_BC3:
+            CompressBlockBC3(source_block, 16, compressed_block, options);
+            if (measure_error) {
+              DecompressBlockBC3(compressed_block, decoded_block, options);
+            }
+            break;
+          case KR_TEXTURE_COMPRESSION_FORMAT_BC5:
+          {
+            unsigned char red[16];
+            unsigned char green[16];
+            for (int i = 0; i < 16; i++) {
+              red[i] = source_block[i * 4];
+              green[i] = source_block[i * 4 + 1];
+            }
+            CompressBlockBC5(red, 4, green, 4, compressed_block, options);
+            if (measure_error) {
+              DecompressBlockBC5(compressed_block, red, green, options);
+              for (int i = 0; i < 16; i++) {
+                decoded_block[i * 4] = red[i];
+                decoded_block[i * 4 + 1] = green[i];
+              }
+            }
+            channel_count = 2;
+            break;
+          }
+          default:
+            CompressBlockBC7(source_block, 16, compressed_block, options);
+            if (measure_error) {
+              DecompressBlockBC7(compressed_block, decoded_block, options);
+            }
+            break;
+          }
+
+          if (measure_error) {
+            // Only the pixels within the image are measured
+            for (int y = 0; y < 4 && (int)block_y * 4 + y < height; y++) {
+              for (int x = 0; x < 4 && block_x * 4 + x < width; x++) {
+                for (int channel = 0; channel < channel_count; channel++) {
+                  int difference = (int)source_block[(y * 4 + x) * 4 + channel] - (int)decoded_block[(y * 4 + x) * 4 + channel];
+                  row_squared_error[block_y] += difference * difference;
+                }
+              }
+            }
+          }
+        }
+      }
+    });
+
+    if (measure_error) {
+      for (double row_error : row_squared_error) {
+        squared_error += row_error;
+      }
+      squared_error /= (double)width * height * (format == KR_TEXTURE_COMPRESSION_FORMAT_BC5 ? 2 : (format == KR_TEXTURE_COMPRESSION_FORMAT_BC1 ? 3 : 4));
+    }
+
+    level->unlock();
+    blocks.push_back(level);
+    pixel_count += (long long)width * height;
+    level_index++;
+
+    if (width == 1 && height == 1) {
+      break;
+    }
+    next_image.resize((size_t)std::max(width >> 1, 1) * std::max(height >> 1, 1) * 4);
+    DownsampleRGBA8(image.data(), width, height, next_image.data());
+    image.swap(next_image);
+    width = std::max(width >> 1, 1);
+    height = std::max(height >> 1, 1);
+  }
+
+  switch (format) {
+  case KR_TEXTURE_COMPRESSION_FORMAT_BC1:
+    DestroyOptionsBC1(options);
+    break;
+  case KR_TEXTURE_COMPRESSION_FORMAT_BC3:
+    DestroyOptionsBC3(options);
+    break;
+  case KR_TEXTURE_COMPRESSION_FORMAT_BC5:
+    DestroyOptionsBC5(options);
+    break;
+  default:
+    DestroyOptionsBC7(options);
+    break;
+  }
+
+  KRTextureKTX* new_texture = new KRTextureKTX(getContext(), getName(), internal_format, base_internal_format, dimensions.x, dimensions.y, blocks);
+
+  for (Block* block : blocks) {
+    delete block;
+  }
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  double psnr = squared_error > 0.0 ? 10.0 * log10(255.0 * 255.0 / squared_error) : std::numeric_limits<double>::infinity();
+  KRContext::Log(KRContext::LOG_LEVEL_INFORMATION, "Compressed texture %s to %s: %ix%i, %i levels, %.2f megapixels per second, PSNR %.2f dB",
+                 getName().c_str(), format_name, dimensions.x, dimensions.y, level_index, pixel_count / 1000000.0 / std::max(seconds, 1e-6), psnr);
+
+  return new_texture;
+}
+#endif
+
 bool KRTexture2D::save(const std::string& path)
 {
   if (m_pData) {
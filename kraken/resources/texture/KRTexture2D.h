@@ -50,8 +50,73 @@ public:
 
   virtual bool getLodData(void* buffer, int lod) = 0;
 
+  virtual bool isVirtual() const override;
+  virtual bool isPageCached() const override;
+  virtual void resize(int lod) override;
+  virtual long getMemRequiredForVisibleLod(int lod) override;
+
+#if !TARGET_OS_IPHONE && !defined(ANDROID)
+  virtual KRTexture* compress(KrTextureCompressionFormat format, KrTextureCompressionQuality quality, bool premultiply_alpha = false) override;
+#endif
+
 protected:
   mimir::Block* m_pData;
 
+  // Textures at least this large are virtual.  Where every device supports sparse
+  // residency their pages are bound in place, otherwise they are copied into a page cache.
+  static const int KRENGINE_VIRTUAL_TEXTURE_MIN_DIMENSION = 8192;
+  // Pages transferred to each device in a streamer pass
+  static const int KRENGINE_VIRTUAL_TEXTURE_PAGES_PER_UPDATE = 32;
+  // Layout of the page cache, which must match textureVirtualCache in virtual_texture.glsl.
+  // Each slot holds a page and a border of the texels around it, for filtering.
+  static const int KRENGINE_VIRTUAL_TEXTURE_CACHE_PAGE_SIZE = 128;
+  static const int KRENGINE_VIRTUAL_TEXTURE_CACHE_BORDER = 4;
+  static const int KRENGINE_VIRTUAL_TEXTURE_CACHE_SLOTS = 16; // Slots in each row and column of the cache
+
+  // Copies a rectangle of one level, in whole blocks with rows tightly packed.
+  // Formats whose levels can not be read by region return false, and are never virtual.
+  virtual bool supportsLodRegionData() const;
+  virtual bool getLodRegionData(void* buffer, int lod, int x, int y, int width, int height);
+  static bool GetFormatBlockInfo(VkFormat format, int& blockWidth, int& blockHeight, int& blockBytes);
+  // Copies a rectangle from a level whose rows of blocks are equally spaced
+  static bool CopyLevelRegion(const unsigned char* level, size_t levelSize, VkFormat format, int levelWidth, int levelHeight, void* buffer, int x, int y, int width, int height);
+
+  // Averages each 2x2 block of an RGBA8 image into the next mip level
+  static void DownsampleRGBA8(const unsigned char* source, int source_width, int source_height, unsigned char* dest);
+
   bool createGPUTexture(int targetLod) override;
+
+private:
+  enum
+  {
+    VIRTUAL_UNKNOWN = -1,
+    VIRTUAL_NONE,
+    VIRTUAL_SPARSE,
+    VIRTUAL_PAGE_CACHE
+  };
+
+  // Virtual textures are determined once, when first streamed
+  mutable std::atomic<int> m_virtual;
+  mutable int m_pageWidth;
+  mutable int m_pageHeight;
+  // First level of the mip tail, which is always resident.  For sparse images
+  // this is predicted until the first device's image is created, then set to
+  // the level reported by the device.
+  mutable int m_mipTailLod;
+
+  int determineVirtual() const;
+  bool determineSparse() const;
+  bool determinePageCache() const;
+  int getPageCountX(int lod) const;
+  int getPageCountY(int lod) const;
+  bool isRegionVisible(int region_x, int region_y, int lod) const;
+  bool isPageVisible(int lod, int page_x, int page_y) const;
+  bool createSparseTexture(KRDevice& device, TextureHandle& texture, bool firstDevice);
+  bool allocateSparseTexture(KRDevice& device, TextureHandle& texture, bool firstDevice, std::vector<VkSparseMemoryBind>& tailBinds, std::vector<unsigned char>& tailData);
+  void updatePages(KRDevice& device, TextureHandle& texture, int lod, bool& complete);
+  bool createPageCacheTexture(KRDevice& device, TextureHandle& texture);
+  bool allocatePageCacheTexture(KRDevice& device, TextureHandle& texture, std::vector<unsigned char>& tailData, std::vector<VkBufferImageCopy>& tailRegions);
+  bool readCachePage(int lod, int page_x, int page_y, int slot, std::vector<unsigned char>& buffer, std::vector<VkBufferImageCopy>& regions);
+  void updateCachePages(KRDevice& device, TextureHandle& texture, int lod, bool& complete);
+  void updateIndirection(KRDevice& device, TextureHandle& texture, VkImageLayout oldLayout);
 };
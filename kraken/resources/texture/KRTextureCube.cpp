@@ -40,12 +40,13 @@ KRTextureCube::KRTextureCube(KRContext& context, std::string name) : KRTexture(c
 {
   m_lod_count = 0;
 
+  // Only levels present in every face are part of the cube image
   for (int i = 0; i < 6; i++) {
     m_textures[i] = NULL;
     std::string faceName = getName() + SUFFIXES[i];
     m_textures[i] = (KRTexture2D*)getContext().getTextureManager()->getTexture(faceName);
     if (m_textures[i]) {
-	  m_lod_count = std::max(m_lod_count, m_textures[i]->getLodCount());
+      m_lod_count = i == 0 ? m_textures[i]->getLodCount() : std::min(m_lod_count, m_textures[i]->getLodCount());
     } else {
       assert(false);
     }
@@ -57,57 +58,73 @@ KRTextureCube::~KRTextureCube()
 
 bool KRTextureCube::createGPUTexture(int lod)
 {
-  assert(!m_haveNewHandles); // Only allow one resize per frame
-
-  bool success = true;
-
-  int target_lod = m_new_lod;
-  m_new_lod = -1;
-  bool bMipMaps = false;
-
-  Vector2i dimensions = Vector2i::Zero();
+  if (m_haveNewHandles) {
+    return true;
+  }
 
+  Vector3i dimensions = Vector3i::Zero();
+  VkFormat format = VK_FORMAT_UNDEFINED;
   for (int i = 0; i < 6; i++) {
     if (!m_textures[i]) {
-      success = false;
-    } else {
-      KRTexture2D& tex = *m_textures[i];
-      Vector2i texDimensions = tex.getDimensions().xy();
-      if (dimensions.x == 0) {
-        dimensions = texDimensions;
-      } else if (dimensions != texDimensions) {
-        success = false;
-      }
-      if (tex.hasMipmaps()) {
-        bMipMaps = true;
-      }
+      return false;
+    }
+    KRTexture2D& tex = *m_textures[i];
+    if (i == 0) {
+      dimensions = tex.getDimensions();
+      format = tex.getFormat();
+    } else if (tex.getDimensions().xy() != dimensions.xy() || tex.getFormat() != format) {
+      // Faces must share their dimensions and format to form one image
+      KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Cube map %s has faces with mismatched dimensions or formats.", getName().c_str());
+      return false;
     }
   }
-  if (!success) {
-    // Not all face images were loaded, or they have
-    // mismatched dimensions
-    // TODO - Perhaps we should have multiple error result codes.
+  if (format == VK_FORMAT_UNDEFINED || dimensions.x != dimensions.y) {
     return false;
   }
 
-  size_t bufferSizes[6] = {};
-  void* buffers[6] = {};
-  for (int i = 0; i < 6; i++) {
-      bufferSizes[i] = getMemRequiredForLodRange(lod);
-      buffers[i] = malloc(bufferSizes[i]);
-	  m_textures[i]->getLodData(buffers[i], lod);
+  int target_lod = std::min(lod, m_lod_count - 1);
+  int mip_count = m_lod_count - target_lod;
+  size_t bufferSize = getMemRequiredForLodRange(target_lod);
+  std::vector<unsigned char> buffer(bufferSize);
+  if (!getLodData(buffer.data(), target_lod)) {
+    return false;
+  }
+
+  std::vector<VkBufferImageCopy> regions(mip_count, VkBufferImageCopy{});
+  size_t levelOffset = 0;
+  for (int mip = 0; mip < mip_count; mip++) {
+    VkBufferImageCopy& region = regions[mip];
+    region.bufferOffset = levelOffset;
+    levelOffset += getMemRequiredForLod(target_lod + mip);
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = mip;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 6;
+
+    region.imageOffset = { 0, 0, 0 };
+    region.imageExtent = {
+        (unsigned int)std::max(dimensions.x >> (target_lod + mip), 1),
+        (unsigned int)std::max(dimensions.y >> (target_lod + mip), 1),
+        1
+    };
   }
 
+  bool success = true;
+  m_new_lod = -1;
+
   KRDeviceManager* deviceManager = getContext().getDeviceManager();
 
   for (auto deviceItr = deviceManager->getDevices().begin(); deviceItr != deviceManager->getDevices().end(); deviceItr++) {
     KRDevice& device = *(*deviceItr).second;
     KrDeviceHandle deviceHandle = (*deviceItr).first;
-    VmaAllocator allocator = device.getAllocator();
     KRTexture::TextureHandle& texture = m_newHandles.emplace_back();
     texture.device = deviceHandle;
     texture.allocation = VK_NULL_HANDLE;
     texture.image = VK_NULL_HANDLE;
+    texture.fullImageView = VK_NULL_HANDLE;
 
     if (!allocate(device, target_lod, VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &texture.image, &texture.allocation
 #if KRENGINE_DEBUG_GPU_LABELS
@@ -118,46 +135,76 @@ bool KRTextureCube::createGPUTexture(int lod)
       break;
     }
 
-    for (int i = 0; i < 6; i++) {
-      std::string faceName = getName() + SUFFIXES[i];
-      if (m_textures[i]) {
-          VkBufferImageCopy region{};
-          region.bufferOffset = 0;
-          region.bufferRowLength = 0;
-          region.bufferImageHeight = 0;
-
-          region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-          region.imageSubresource.mipLevel = 0;
-          region.imageSubresource.baseArrayLayer = 0;
-          region.imageSubresource.layerCount = 1;
-
-          region.imageOffset = { 0, 0, 0 };
-          region.imageExtent = {
-              (unsigned int)dimensions.x,
-              (unsigned int)dimensions.y,
-              (unsigned int)1
-          };
-
-          // TODO - Vulkan refactoring.  We need to create a cube map texture rather than individual 2d textures.
-          device.streamUpload(buffers[i], bufferSizes[i], texture.image, &region, 1);
-      }
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = texture.image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_CUBE;
+    viewInfo.format = format;
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.subresourceRange.baseMipLevel = 0;
+    viewInfo.subresourceRange.levelCount = mip_count;
+    viewInfo.subresourceRange.baseArrayLayer = 0;
+    viewInfo.subresourceRange.layerCount = 6;
+    if (vkCreateImageView(device.m_logicalDevice, &viewInfo, nullptr, &texture.fullImageView) != VK_SUCCESS) {
+      success = false;
+      break;
     }
+
+    // All six faces of every level are uploaded in one staging transfer
+    device.streamUpload(buffer.data(), bufferSize, texture.image, regions.data(), regions.size());
   }
+
   if (success) {
+    m_new_lod = target_lod;
     m_haveNewHandles = true;
   } else {
-    destroyHandles();
-    m_new_lod = target_lod;
+    destroyNewHandles();
+  }
+
+  return success;
+}
+
+bool KRTextureCube::getLodData(void* buffer, int lod)
+{
+  if (m_lod_count == 0) {
+    return false;
+  }
+
+  // The faces of each level are stored consecutively, as the six layers of a
+  // single copy region.  Each face is decoded with its full chain from the
+  // target lod, then its levels are scattered into place.
+  int target_lod = std::min(lod, m_lod_count - 1);
+  int mip_count = m_lod_count - target_lod;
+  std::vector<size_t> levelOffsets(mip_count);
+  size_t levelOffset = 0;
+  for (int mip = 0; mip < mip_count; mip++) {
+    levelOffsets[mip] = levelOffset;
+    levelOffset += getMemRequiredForLod(target_lod + mip);
   }
 
+  std::vector<unsigned char> faceBuffer;
   for (int i = 0; i < 6; i++) {
-    if (buffers[i]) {
-      free(buffers[i]);
-      buffers[i] = nullptr;
+    if (!m_textures[i]) {
+      return false;
+    }
+    KRTexture2D& tex = *m_textures[i];
+    for (int mip = 0; mip < mip_count; mip++) {
+      if (tex.getMemRequiredForLod(target_lod + mip) != m_textures[0]->getMemRequiredForLod(target_lod + mip)) {
+        return false; // Faces of a level must be the same size
+      }
+    }
+    faceBuffer.resize(tex.getMemRequiredForLodRange(target_lod));
+    if (!tex.getLodData(faceBuffer.data(), target_lod)) {
+      return false;
+    }
+    size_t faceOffset = 0;
+    for (int mip = 0; mip < mip_count; mip++) {
+      size_t faceLevelSize = tex.getMemRequiredForLod(target_lod + mip);
+      memcpy((unsigned char*)buffer + levelOffsets[mip] + faceLevelSize * i, faceBuffer.data() + faceOffset, faceLevelSize);
+      faceOffset += faceLevelSize;
     }
   }
-
-  return success;
+  return true;
 }
 
 long KRTextureCube::getMemRequiredForLod(int lod)
@@ -171,16 +218,6 @@ long KRTextureCube::getMemRequiredForLod(int lod)
   return memoryRequired;
 }
 
-void KRTextureCube::requestResidency(float lodCoverage, texture_usage_t textureUsage)
-{
-    KRTexture::requestResidency(lodCoverage, textureUsage);
-    for(int i=0; i<6; i++) {
-        if(m_textures[i]) {
-            m_textures[i]->requestResidency(lodCoverage, textureUsage); // Ensure that side of cube maps do not expire from the texture pool prematurely, as they are referenced indirectly
-        }
-    }
-}
-
 std::string KRTextureCube::getExtension()
 {
   return ""; // Cube maps are just references; there are no files to output
@@ -203,8 +240,8 @@ int KRTextureCube::getFaceCount() const
 
 VkFormat KRTextureCube::getFormat() const
 {
-  // TODO - Implement
-  return VK_FORMAT_UNDEFINED;
+  // Faces with differing formats are rejected when the image is created
+  return m_textures[0] ? m_textures[0]->getFormat() : VK_FORMAT_UNDEFINED;
 }
 
 hydra::Vector3i KRTextureCube::getDimensions() const
@@ -44,8 +44,11 @@ public:
   virtual bool save(const std::string& path) override;
   virtual bool save(mimir::Block& data) override;
 
+  // Writes the levels from lod to the smallest, each with its six faces in
+  // order, as they are uploaded to the cube image
+  bool getLodData(void* buffer, int lod);
+
   virtual long getMemRequiredForLod(int lod) override;
-  virtual void requestResidency(float lodCoverage, texture_usage_t textureUsage) override;
   virtual int getFaceCount() const override;
   virtual VkFormat getFormat() const override;
   virtual hydra::Vector3i getDimensions() const override;
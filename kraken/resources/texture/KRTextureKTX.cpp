@@ -320,6 +320,23 @@ VkFormat KRTextureKTX::getFormat() const
     // Generic compressed formats not supported
     return VK_FORMAT_UNDEFINED;
     break;
+  // S3TC formats, from EXT_texture_compression_s3tc and EXT_texture_sRGB
+  case 0x83F0: // COMPRESSED_RGB_S3TC_DXT1_EXT
+    return VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+  case 0x83F1: // COMPRESSED_RGBA_S3TC_DXT1_EXT
+    return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+  case 0x83F2: // COMPRESSED_RGBA_S3TC_DXT3_EXT
+    return VK_FORMAT_BC2_UNORM_BLOCK;
+  case 0x83F3: // COMPRESSED_RGBA_S3TC_DXT5_EXT
+    return VK_FORMAT_BC3_UNORM_BLOCK;
+  case 0x8C4C: // COMPRESSED_SRGB_S3TC_DXT1_EXT
+    return VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+  case 0x8C4D: // COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+    return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+  case 0x8C4E: // COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT
+    return VK_FORMAT_BC2_SRGB_BLOCK;
+  case 0x8C4F: // COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+    return VK_FORMAT_BC3_SRGB_BLOCK;
   case 0x8DBC: // COMPRESSED_SIGNED_RED_RGTC1 RED Specific snorm
     return VK_FORMAT_BC4_SNORM_BLOCK;
   case 0x8DBD: // COMPRESSED_RG_RGTC2 RG Specific unorm
@@ -378,6 +395,26 @@ bool KRTextureKTX::getLodData(void* buffer, int lod)
   return true;
 }
 
+bool KRTextureKTX::supportsLodRegionData() const
+{
+  int blockWidth, blockHeight, blockBytes;
+  return m_header.numberOfFaces <= 1 && m_header.numberOfArrayElements <= 1 && GetFormatBlockInfo(getFormat(), blockWidth, blockHeight, blockBytes);
+}
+
+bool KRTextureKTX::getLodRegionData(void* buffer, int lod, int x, int y, int width, int height)
+{
+  if (lod < 0 || lod >= (int)m_blocks.size()) {
+    return false;
+  }
+
+  Block* block = m_blocks[lod];
+  block->lock();
+  bool success = CopyLevelRegion((const unsigned char*)block->getStart(), block->getSize(), getFormat(),
+    std::max((int)m_header.pixelWidth >> lod, 1), std::max((int)m_header.pixelHeight >> lod, 1), buffer, x, y, width, height);
+  block->unlock();
+  return success;
+}
+
 std::string KRTextureKTX::getExtension()
 {
   return "ktx";
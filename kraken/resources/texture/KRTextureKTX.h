@@ -51,6 +51,8 @@ public:
   virtual VkFormat getFormat() const override;
 
 protected:
+  bool supportsLodRegionData() const override;
+  bool getLodRegionData(void* buffer, int lod, int x, int y, int width, int height) override;
 
   std::vector<Block*> m_blocks;
 
@@ -31,9 +31,13 @@
 
 #include "KRTextureKTX2.h"
 #include "KRTextureManager.h"
+#include "KRThreadPool.h"
+#include "KRContext.h"
 
 #include "KREngine-common.h"
 
+#include "zstd.h"
+
 using namespace mimir;
 using namespace hydra;
 
@@ -47,28 +51,36 @@ KRTextureKTX2::KRTextureKTX2(KRContext& context, Block* data, std::string name)
   if (memcmp(_KTX2FileIdentifier, m_header.identifier, 12) != 0) {
     assert(false); // Header not recognized
   }
-  if (m_header.pixelDepth != 0) {
-    assert(false); // 3d textures not (yet) supported
-  }
-  if (m_header.layerCount != 0) {
-    assert(false); // Array textures not (yet) supported
-  }
   if (m_header.faceCount != 1 && m_header.faceCount != 6) {
     assert(false);
   }
-  if (m_header.supercompressionScheme != 0) {
-    assert(false); // Not yet supported
+  if (m_header.pixelDepth > 1 && (m_header.layerCount > 1 || m_header.faceCount != 1)) {
+    assert(false); // Volume textures can not have layers or faces
+  }
+  if (m_header.supercompressionScheme != KTX2_SUPERCOMPRESSION_NONE && m_header.supercompressionScheme != KTX2_SUPERCOMPRESSION_ZSTD) {
+    KRContext::Log(KRContext::LOG_LEVEL_ERROR, "KTX2 texture %s uses an unsupported supercompression scheme (%i).", name.c_str(), m_header.supercompressionScheme);
   }
 
-  uint32_t width = m_header.pixelWidth >> m_header.levelCount;
-  uint32_t height = m_header.pixelHeight >> m_header.levelCount;
-  if (width < 1) {
-    width = 1;
+  // A level count of 0 requests generation of the mip chain, which is not
+  // supported; only the base level is loaded.
+  m_lod_count = (int)std::max(m_header.levelCount, (__uint32_t)1);
+  m_levels.resize(m_lod_count);
+  if (m_pData->getSize() < sizeof(KTX2Header) + sizeof(KTX2LevelIndex) * m_lod_count) {
+    // Levels of a truncated file are placed past its end, so reading them fails
+    KRContext::Log(KRContext::LOG_LEVEL_ERROR, "KTX2 texture %s is too small for its level index.", name.c_str());
+    for (KTX2LevelIndex& level : m_levels) {
+      level.byteOffset = std::numeric_limits<__uint64_t>::max();
+      level.byteLength = 0;
+      level.uncompressedByteLength = 0;
+    }
+    return;
   }
-  if (height < 1) {
-    height = 1;
+  m_pData->copy(m_levels.data(), sizeof(KTX2Header), sizeof(KTX2LevelIndex) * m_lod_count);
+  if (m_header.supercompressionScheme == KTX2_SUPERCOMPRESSION_NONE) {
+    for (KTX2LevelIndex& level : m_levels) {
+      level.uncompressedByteLength = level.byteLength;
+    }
   }
-  m_lod_count = (int)std::max(m_header.levelCount, (__uint32_t)1);
 }
 
 KRTextureKTX2::~KRTextureKTX2()
@@ -77,31 +89,85 @@ KRTextureKTX2::~KRTextureKTX2()
 
 Vector3i KRTextureKTX2::getDimensions() const
 {
-  return Vector3i::Create(Vector3i::Create(m_header.pixelWidth, m_header.pixelHeight, m_header.pixelDepth));
+  return Vector3i::Create(m_header.pixelWidth, std::max(m_header.pixelHeight, (__uint32_t)1), std::max(m_header.pixelDepth, (__uint32_t)1));
 }
 
 long KRTextureKTX2::getMemRequiredForLod(int lod)
 {
   int target_lod = std::min(lod, m_lod_count - 1);
 
-  KTX2LevelIndex levelIndex;
-  m_pData->copy(&levelIndex, sizeof(m_header) + sizeof(KTX2LevelIndex) * target_lod, sizeof(KTX2LevelIndex));
-
-  return (long)levelIndex.byteLength;
+  // Includes every layer, face and slice of the level, after supercompression is removed
+  return (long)m_levels[target_lod].uncompressedByteLength;
 }
 
 bool KRTextureKTX2::getLodData(void* buffer, int lod)
 {
-  unsigned char* converted_image = (unsigned char*)buffer;
+  if (m_header.supercompressionScheme != KTX2_SUPERCOMPRESSION_NONE && m_header.supercompressionScheme != KTX2_SUPERCOMPRESSION_ZSTD) {
+    return false;
+  }
+
+  // Levels are written consecutively from the target lod, so each level's
+  // position in the buffer is known before any are decompressed
   int target_lod = std::min(lod, m_lod_count - 1);
+  int level_count = m_lod_count - target_lod;
+  std::vector<size_t> offsets(level_count);
+  size_t offset = 0;
+  for (int level = 0; level < level_count; level++) {
+    offsets[level] = offset;
+    offset += (size_t)m_levels[target_lod + level].uncompressedByteLength;
+  }
 
-  KTX2LevelIndex levelIndex;
-  m_pData->copy(&levelIndex, sizeof(m_header) + sizeof(KTX2LevelIndex) * target_lod, sizeof(KTX2LevelIndex));
+  m_pData->lock();
+  const uint8_t* start = (const uint8_t*)m_pData->getStart();
+  size_t size = m_pData->getSize();
+  std::atomic<bool> success(true);
+
+  // Zstd levels are decompressed on the thread pool, a level per batch
+  getContext().getThreadPool()->parallelFor(level_count, m_header.supercompressionScheme == KTX2_SUPERCOMPRESSION_ZSTD ? 1 : level_count, [&](size_t begin, size_t end) {
+    for (size_t level = begin; level < end; level++) {
+      const KTX2LevelIndex& levelIndex = m_levels[target_lod + level];
+      uint8_t* dest = (uint8_t*)buffer + offsets[level];
+      if (levelIndex.byteOffset > size || levelIndex.byteLength > size - levelIndex.byteOffset) {
+        success = false;
+      } else if (m_header.supercompressionScheme == KTX2_SUPERCOMPRESSION_ZSTD) {
+        size_t decompressed = ZSTD_decompress(dest, (size_t)levelIndex.uncompressedByteLength, start + levelIndex.byteOffset, (size_t)levelIndex.byteLength);
+        if (ZSTD_isError(decompressed) || decompressed != levelIndex.uncompressedByteLength) {
+          success = false;
+        }
+      } else {
+        memcpy(dest, start + levelIndex.byteOffset, (size_t)levelIndex.byteLength);
+      }
+    }
+  });
+
+  m_pData->unlock();
+  return success;
+}
 
-  // TODO - Implement copy of buffer data
-  assert(false);
+bool KRTextureKTX2::supportsLodRegionData() const
+{
+  // Supercompressed levels can only be decoded whole
+  int blockWidth, blockHeight, blockBytes;
+  return m_header.supercompressionScheme == KTX2_SUPERCOMPRESSION_NONE && GetFormatBlockInfo(getFormat(), blockWidth, blockHeight, blockBytes);
+}
 
-  return true;
+bool KRTextureKTX2::getLodRegionData(void* buffer, int lod, int x, int y, int width, int height)
+{
+  if (m_header.supercompressionScheme != KTX2_SUPERCOMPRESSION_NONE || lod < 0 || lod >= m_lod_count) {
+    return false;
+  }
+
+  const KTX2LevelIndex& levelIndex = m_levels[lod];
+  m_pData->lock();
+  const uint8_t* start = (const uint8_t*)m_pData->getStart();
+  size_t size = m_pData->getSize();
+  bool success = false;
+  if (levelIndex.byteOffset <= size && levelIndex.byteLength <= size - levelIndex.byteOffset) {
+    success = CopyLevelRegion(start + levelIndex.byteOffset, (size_t)levelIndex.byteLength, getFormat(),
+      std::max((int)m_header.pixelWidth >> lod, 1), std::max((int)m_header.pixelHeight >> lod, 1), buffer, x, y, width, height);
+  }
+  m_pData->unlock();
+  return success;
 }
 
 std::string KRTextureKTX2::getExtension()
@@ -115,9 +181,14 @@ int KRTextureKTX2::getFaceCount() const
   return m_header.faceCount;
 }
 
+int KRTextureKTX2::getLayerCount() const
+{
+  return (int)std::max(m_header.layerCount, (__uint32_t)1);
+}
 
 VkFormat KRTextureKTX2::getFormat() const
 {
-  // TODO - Implement
-  return VK_FORMAT_UNDEFINED;
+  // KTX2 stores the Vulkan format directly.  Basis Universal textures have no
+  // format until transcoded, and are reported as VK_FORMAT_UNDEFINED.
+  return (VkFormat)m_header.vkFormat;
 }
@@ -45,9 +45,12 @@ public:
   virtual long getMemRequiredForLod(int lod) override;
   virtual hydra::Vector3i getDimensions() const override;
   virtual int getFaceCount() const override;
+  virtual int getLayerCount() const override;
   virtual VkFormat getFormat() const override;
 
 protected:
+  bool supportsLodRegionData() const override;
+  bool getLodRegionData(void* buffer, int lod, int x, int y, int width, int height) override;
 
   typedef struct
   {
@@ -66,8 +69,8 @@ protected:
     __uint32_t dfdByteLength;
     __uint32_t kvdByteOffset;
     __uint32_t kvdByteLength;
-    __uint32_t sgdByteOffset;
-    __uint32_t sgdByteLength;
+    __uint64_t sgdByteOffset;
+    __uint64_t sgdByteLength;
   } KTX2Header;
 
   typedef struct
@@ -77,5 +80,14 @@ protected:
     __uint64_t uncompressedByteLength;
   } KTX2LevelIndex;
 
+  typedef enum
+  {
+    KTX2_SUPERCOMPRESSION_NONE = 0,
+    KTX2_SUPERCOMPRESSION_BASIS_LZ = 1,
+    KTX2_SUPERCOMPRESSION_ZSTD = 2,
+    KTX2_SUPERCOMPRESSION_ZLIB = 3
+  } KTX2SupercompressionScheme;
+
   KTX2Header m_header;
+  std::vector<KTX2LevelIndex> m_levels;
 };
@@ -48,10 +48,16 @@ KRTextureManager::KRTextureManager(KRContext& context) : KRResourceManager(conte
 
   m_memoryTransferredThisFrame = 0;
   m_streamerComplete = true;
+  m_frameStarted = false;
 }
 
 void KRTextureManager::destroy()
 {
+  destroyFeedbackBuffers();
+  m_feedbackTextures.clear();
+  destroyBindlessTables();
+  m_bindlessTextures.clear();
+  m_freeBindlessSlots.clear();
   for (unordered_map<std::string, KRTexture*>::iterator itr = m_textures.begin(); itr != m_textures.end(); ++itr) {
     delete (*itr).second;
   }
@@ -216,6 +222,9 @@ long KRTextureManager::getMemActive()
 
 void KRTextureManager::startFrame(float deltaTime)
 {
+  m_frameStarted = true;
+  readFeedback();
+
   // TODO - Implement proper double-buffering to reduce copy operations
   m_streamerFenceMutex.lock();
 
@@ -232,6 +241,8 @@ void KRTextureManager::startFrame(float deltaTime)
         // Expire textures that haven't been used in a long time
         expiredTextures.insert(activeTexture);
         activeTexture->releaseHandles();
+        releaseFeedbackSlot(activeTexture);
+        releaseBindlessSlot(activeTexture);
       } else {
         float priority = activeTexture->getStreamPriority();
         m_activeTextures_streamer_copy.push_back(std::pair<float, KRTexture*>(priority, activeTexture));
@@ -277,94 +288,126 @@ void KRTextureManager::doStreaming(long& memoryRemaining, long& memoryRemainingT
 
 void KRTextureManager::balanceTextureMemory(long& memoryRemaining, long& memoryRemainingThisFrame)
 {
-  // Balance texture memory by reducing and increasing the maximum mip-map level of both active and inactive textures
-  // Favour performance over maximum texture resolution when memory is insufficient for textures at full resolution.
-
-  /*
-   NEW ALGORITHM:
-
-   Textures are assigned a “weight” by tuneable criteria:
-   - Area of screen coverage taken by objects containing material (more accurate and generic than distance)
-   - Type of texture (separate weight for normal, diffuse, spec maps)
-   - Last used time (to keep textures loaded for recently seen objects that are outside of the view frustum)
-   Those factors combine together to give a “weight”, which represents a proportion relative to all other textures weights
-   Mipmap levels are stripped off of each texture until they occupy the amount of memory they should proportionally have
-   This is in contrast to the global ceiling of texture resolution that slowly drops until the textures fit
-
-   */
+  // Balance texture memory by choosing the level of detail of each active texture.
+  // Every texture first receives its low quality level.  Finer levels are then
+  // granted in order of benefit per byte until the budget is spent.  The benefit
+  // of a level is the texture's weight, from KRTexture::getStreamPriority,
+  // doubled for each finer level.  Each finer level needs four times the memory,
+  // so its benefit per byte is halved, and large textures must be worth more to
+  // receive the same level as small ones.
+  //
+  // Levels that are already resident have their benefit raised, so that textures
+  // of similar weight do not trade memory back and forth between passes.
+  const float KRENGINE_TEXTURE_LOD_HYSTERESIS = 1.5f;
+
+  struct Residency
+  {
+    KRTexture* texture;
+    float weight;
+    int currentLod;
+    int targetLod;
+    int finestLod;
+  };
+
+  struct Upgrade
+  {
+    float benefit;
+    size_t residency;
+    long memoryRequired;
+
+    bool operator<(const Upgrade& other) const
+    {
+      return benefit < other.benefit;
+    }
+  };
 
-   // ---------------
+  std::sort(m_activeTextures_streamer.begin(), m_activeTextures_streamer.end(), std::greater<std::pair<float, KRTexture*>>());
 
-   //long MAX_STREAM_TIME = 66;
-   //long startTime = getContext().getAbsoluteTimeMilliseconds();
+  std::vector<Residency> residencies;
+  residencies.reserve(m_activeTextures_streamer.size());
+  std::priority_queue<Upgrade> upgrades;
 
-  std::sort(m_activeTextures_streamer.begin(), m_activeTextures_streamer.end(), std::greater<std::pair<float, KRTexture*>>());
+  auto queueUpgrade = [&](size_t index) {
+    Residency& residency = residencies[index];
+    if (residency.targetLod <= residency.finestLod) {
+      return;
+    }
+    int lod = residency.targetLod - 1;
+    Upgrade upgrade;
+    upgrade.residency = index;
+    upgrade.memoryRequired = residency.texture->getMemRequiredForVisibleLod(lod);
+    upgrade.benefit = residency.weight * exp2f((float)-lod) / (float)std::max(upgrade.memoryRequired, 1L);
+    if (residency.currentLod != -1 && residency.currentLod <= lod) {
+      upgrade.benefit *= KRENGINE_TEXTURE_LOD_HYSTERESIS;
+    }
+    upgrades.push(upgrade);
+  };
 
   for (auto itr = m_activeTextures_streamer.begin(); itr != m_activeTextures_streamer.end(); itr++) {
     KRTexture* texture = (*itr).second;
-    int min_lod_level = std::min(getContext().KRENGINE_TEXTURE_LQ_LOD, texture->getLodCount() - 1);
-    long minLodMem = texture->getMemRequiredForLodRange(min_lod_level);
-    memoryRemaining -= minLodMem;
-
-    if (memoryRemainingThisFrame > minLodMem && (texture->getNewLod() != -1 || texture->getNewLod() > min_lod_level)) {
-      memoryRemainingThisFrame -= minLodMem;
-      texture->resize(min_lod_level);
+    Residency residency;
+    residency.texture = texture;
+    residency.weight = (*itr).first;
+    residency.currentLod = texture->getNewLod();
+    residency.targetLod = std::min(getContext().KRENGINE_TEXTURE_LQ_LOD, texture->getLodCount() - 1);
+    residency.finestLod = std::min(getContext().KRENGINE_TEXTURE_HQ_LOD, residency.targetLod);
+    int feedbackLod = texture->getFeedbackLod();
+    if (feedbackLod != -1) {
+      // Levels finer than the GPU sampled would not be seen.  Minified textures
+      // may stay coarser than the low quality level.
+      residency.finestLod = std::min(std::max(residency.finestLod, feedbackLod), texture->getLodCount() - 1);
+      residency.targetLod = std::max(residency.targetLod, residency.finestLod);
     }
+    memoryRemaining -= texture->getMemRequiredForVisibleLodRange(residency.targetLod);
+    residencies.push_back(residency);
+    queueUpgrade(residencies.size() - 1);
   }
 
-  //long minMipTime = getContext().getAbsoluteTimeMilliseconds() - startTime;
-
-  std::vector<int> mipPercents = { 75, 75, 50, 50, 50 };
-  int mip_drop = -1;
-  auto mip_itr = mipPercents.begin();
-  long memoryRemainingThisMip = 0;
-
-  for (auto itr = m_activeTextures_streamer.begin(); itr != m_activeTextures_streamer.end(); itr++) {
-    if (memoryRemainingThisMip <= 0) {
-      if (mip_itr == mipPercents.end()) {
-        break;
-      } else {
-        memoryRemainingThisMip = memoryRemaining / 100L * (long)(*mip_itr);
-        mip_drop++;
-        mip_itr++;
-      }
+  while (!upgrades.empty()) {
+    Upgrade upgrade = upgrades.top();
+    upgrades.pop();
+    if (upgrade.memoryRequired > memoryRemaining) {
+      // Finer levels of this texture cost more, so it receives no more.
+      // Cheaper levels of other textures may still fit.
+      continue;
     }
+    memoryRemaining -= upgrade.memoryRequired;
+    residencies[upgrade.residency].targetLod--;
+    queueUpgrade(upgrade.residency);
+  }
 
-    KRTexture* texture = (*itr).second;
-    int min_lod_level = std::min(getContext().KRENGINE_TEXTURE_LQ_LOD, texture->getLodCount());
-    int target_lod_level = std::min(getContext().KRENGINE_TEXTURE_HQ_LOD + mip_drop, texture->getLodCount());
-    long targetMem = texture->getMemRequiredForLodRange(target_lod_level);
-    long additionalMemRequired = targetMem - texture->getMemRequiredForLodRange(min_lod_level);
-    memoryRemainingThisMip -= additionalMemRequired;
-    memoryRemaining -= additionalMemRequired;
-    if (memoryRemainingThisMip > 0 && memoryRemainingThisFrame > targetMem) {
-      int current_lod_level = texture->getNewLod();
-      if (current_lod_level == (target_lod_level + 1) || target_lod_level > current_lod_level) {
-        // We are are just one lod level away from the target, or we are reducing the quality.
-        // Advance directly to the target level.
-        memoryRemainingThisFrame -= targetMem;
-        texture->resize(target_lod_level);
-      } else if (current_lod_level == (target_lod_level + 2)) {
-        // We are two lod levels away from the target.
-        // Advance to the lod level inbetween.
-        memoryRemainingThisFrame -= texture->getMemRequiredForLodRange(target_lod_level + 1);
-        texture->resize(target_lod_level + 1);
-      } else if (current_lod_level > (target_lod_level + 2)) {
-        // We are more than two lod levels away from the target.
-        // Advance directly to the lod 2 levels away from the target.
-        memoryRemainingThisFrame -= texture->getMemRequiredForLodRange(target_lod_level + 2);
-        texture->resize(target_lod_level + 2);
-      }
+  // Move textures towards their targets, highest weight first, within the
+  // memory that can be transferred this frame
+  for (Residency& residency : residencies) {
+    KRTexture* texture = residency.texture;
+    int current_lod_level = residency.currentLod;
+    int target_lod_level = residency.targetLod;
+    if (texture->isVirtual()) {
+      // Virtual textures are resized each pass, to page in newly visible regions.
+      // They transfer a bounded number of pages each time.
+      texture->resize(target_lod_level);
+      continue;
+    }
+    if (current_lod_level == target_lod_level) {
+      continue;
+    }
+    int lod_level = target_lod_level;
+    if (current_lod_level != -1 && current_lod_level > target_lod_level + 2) {
+      // We are more than two lod levels away from the target.
+      // Advance to the lod 2 levels away from the target, which is faster to transfer.
+      lod_level = target_lod_level + 2;
+    }
+    long memoryRequired = texture->getMemRequiredForLodRange(lod_level);
+    if (memoryRequired >= memoryRemainingThisFrame && current_lod_level == -1) {
+      // Load textures that are not yet resident at low quality first
+      lod_level = std::min(getContext().KRENGINE_TEXTURE_LQ_LOD, texture->getLodCount() - 1);
+      memoryRequired = texture->getMemRequiredForLodRange(lod_level);
+    }
+    if (memoryRequired < memoryRemainingThisFrame) {
+      memoryRemainingThisFrame -= memoryRequired;
+      texture->resize(lod_level);
     }
-
-    //if(getContext().getAbsoluteTimeMilliseconds() - startTime > MAX_STREAM_TIME) {
-    //    return; // Bail out early if we spend too long
-    //}
   }
-
-  //long streamerTime = getContext().getAbsoluteTimeMilliseconds() - startTime;
-  //fprintf(stderr, "%i / %i\n", (int)minMipTime, (int)streamerTime);
-
 }
 
 long KRTextureManager::getMemoryTransferedThisFrame()
@@ -390,36 +433,47 @@ unordered_map<std::string, KRTexture*>& KRTextureManager::getTextures()
 
 void KRTextureManager::compress(bool premultiply_alpha)
 {
-  std::vector<KRTexture*> textures_to_remove;
-  std::vector<KRTexture*> textures_to_add;
-
+  std::vector<KRTexture*> textures;
   for (unordered_map<std::string, KRTexture*>::iterator itr = m_textures.begin(); itr != m_textures.end(); itr++) {
-    KRTexture* texture = (*itr).second;
-    KRTexture* compressed_texture = texture->compress(premultiply_alpha);
-    if (compressed_texture) {
-      textures_to_remove.push_back(texture);
-      textures_to_add.push_back(compressed_texture);
-    } else {
-      assert(false);
-    }
+    textures.push_back((*itr).second);
   }
 
-  for (std::vector<KRTexture*>::iterator itr = textures_to_remove.begin(); itr != textures_to_remove.end(); itr++) {
-    KRTexture* texture = *itr;
-    std::string lowerName = texture->getName();
-    std::transform(lowerName.begin(), lowerName.end(),
-                   lowerName.begin(), ::tolower);
-    m_textures.erase(lowerName);
-    delete texture;
+  // Textures that are already compressed are skipped
+  for (KRTexture* texture : textures) {
+    compressTexture(texture, KR_TEXTURE_COMPRESSION_FORMAT_AUTO, KR_TEXTURE_COMPRESSION_QUALITY_NORMAL, premultiply_alpha);
   }
+}
 
-  for (std::vector<KRTexture*>::iterator itr = textures_to_add.begin(); itr != textures_to_add.end(); itr++) {
-    KRTexture* texture = *itr;
-    std::string lowerName = texture->getName();
-    std::transform(lowerName.begin(), lowerName.end(),
-                   lowerName.begin(), ::tolower);
-    m_textures[lowerName] = texture;
+bool KRTextureManager::canReplaceTextures() const
+{
+  return !m_frameStarted;
+}
+
+KRTexture* KRTextureManager::compressTexture(KRTexture* texture, KrTextureCompressionFormat format, KrTextureCompressionQuality quality, bool premultiply_alpha)
+{
+#if TARGET_OS_IPHONE || defined(ANDROID)
+  return nullptr;
+#else
+  if (!canReplaceTextures()) {
+    return nullptr;
+  }
+  KRTexture* compressed_texture = texture->compress(format, quality, premultiply_alpha);
+  if (compressed_texture == nullptr) {
+    return nullptr;
   }
+
+  std::string lowerName = texture->getName();
+  std::transform(lowerName.begin(), lowerName.end(),
+                 lowerName.begin(), ::tolower);
+
+  m_activeTextures.erase(texture);
+  texture->releaseHandles();
+  releaseFeedbackSlot(texture);
+  releaseBindlessSlot(texture);
+  delete texture;
+  m_textures[lowerName] = compressed_texture;
+  return compressed_texture;
+#endif
 }
 
 
@@ -435,3 +489,342 @@ void KRTextureManager::primeTexture(KRTexture* texture)
   }
 }
 
+bool KRTextureManager::requestFeedbackSlot(KRTexture* texture)
+{
+  if (texture->getFeedbackSlot() != -1) {
+    return true;
+  }
+  // Virtual textures use a run of slots, for their regions.  Slots are
+  // requested rarely, so the first run that fits is found by a scan.
+  int count = texture->getFeedbackSlotCount();
+  int slot = 0;
+  int run = 0;
+  while (slot + run < (int)m_feedbackTextures.size() && run < count) {
+    if (m_feedbackTextures[slot + run] == nullptr) {
+      run++;
+    } else {
+      slot += run + 1;
+      run = 0;
+    }
+  }
+  if (slot + count > KRENGINE_TEXTURE_FEEDBACK_SLOTS) {
+    return false;
+  }
+  if (slot + count > (int)m_feedbackTextures.size()) {
+    m_feedbackTextures.resize(slot + count, nullptr);
+  }
+  for (int i = 0; i < count; i++) {
+    m_feedbackTextures[slot + i] = texture;
+  }
+  texture->setFeedbackSlot(slot);
+
+  // The slot is released when the texture expires from the active textures
+  primeTexture(texture);
+  return true;
+}
+
+void KRTextureManager::releaseFeedbackSlot(KRTexture* texture)
+{
+  int slot = texture->getFeedbackSlot();
+  if (slot != -1) {
+    int count = texture->getFeedbackSlotCount();
+    for (int i = 0; i < count; i++) {
+      m_feedbackTextures[slot + i] = nullptr;
+    }
+    texture->setFeedbackSlot(-1);
+  }
+}
+
+bool KRTextureManager::getFeedbackBuffer(KrDeviceHandle deviceHandle, VkDescriptorBufferInfo& bufferInfo)
+{
+  // Each frame in flight records to its own slice of the buffer
+  const VkDeviceSize sliceSize = KRENGINE_TEXTURE_FEEDBACK_SLOTS * sizeof(__uint32_t);
+
+  auto itr = m_feedbackBuffers.find(deviceHandle);
+  if (itr == m_feedbackBuffers.end()) {
+    std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(deviceHandle);
+    if (!device->m_deviceFeatures.fragmentStoresAndAtomics) {
+      // The feedback pass can not record on this device
+      return false;
+    }
+    FeedbackBuffer feedback{};
+    if (!device->createBuffer(
+      sliceSize * KRENGINE_MAX_FRAMES_IN_FLIGHT,
+      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+      &feedback.buffer,
+      &feedback.allocation
+#if KRENGINE_DEBUG_GPU_LABELS
+      , "Texture Feedback"
+#endif
+    )) {
+      KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Unable to allocate texture feedback buffer.");
+      return false;
+    }
+    if (vmaMapMemory(device->getAllocator(), feedback.allocation, (void**)&feedback.data) != VK_SUCCESS) {
+      vmaDestroyBuffer(device->getAllocator(), feedback.buffer, feedback.allocation);
+      KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Unable to map texture feedback buffer.");
+      return false;
+    }
+    // 0xffffffff indicates that no level has been sampled
+    memset(feedback.data, 0xff, sliceSize * KRENGINE_MAX_FRAMES_IN_FLIGHT);
+    itr = m_feedbackBuffers.insert(std::pair<KrDeviceHandle, FeedbackBuffer>(deviceHandle, feedback)).first;
+  }
+
+  // Each frame in flight records to its own slice
+  std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(deviceHandle);
+  bufferInfo.buffer = (*itr).second.buffer;
+  bufferInfo.offset = device->getFrameIndex() * sliceSize;
+  bufferInfo.range = sliceSize;
+  return true;
+}
+
+void KRTextureManager::readFeedback()
+{
+  if (m_feedbackBuffers.empty()) {
+    return;
+  }
+
+  // Each device's slice for the frame in flight about to be recorded was last
+  // recorded by the frame that used the same frame index, whose fence the
+  // presentation thread waited on before starting this frame.
+  KRDeviceManager* deviceManager = getContext().getDeviceManager();
+  std::vector<__uint32_t*> slices;
+  for (auto itr = m_feedbackBuffers.begin(); itr != m_feedbackBuffers.end(); itr++) {
+    std::unique_ptr<KRDevice>& device = deviceManager->getDevice((*itr).first);
+    slices.push_back((*itr).second.data + (size_t)device->getFrameIndex() * KRENGINE_TEXTURE_FEEDBACK_SLOTS);
+  }
+
+  for (int slot = 0; slot < (int)m_feedbackTextures.size(); slot++) {
+    KRTexture* texture = m_feedbackTextures[slot];
+    if (texture == nullptr) {
+      continue;
+    }
+    __uint32_t lod = 0xffffffff;
+    for (__uint32_t* slice : slices) {
+      lod = std::min(lod, slice[slot]);
+    }
+    int region = slot - texture->getFeedbackSlot() - 1;
+    if (region < 0) {
+      texture->submitFeedback(lod == 0xffffffff ? -1 : (int)lod);
+    } else {
+      texture->submitRegionFeedback(region, lod == 0xffffffff ? -1 : (int)lod);
+    }
+  }
+
+  for (__uint32_t* slice : slices) {
+    memset(slice, 0xff, KRENGINE_TEXTURE_FEEDBACK_SLOTS * sizeof(__uint32_t));
+  }
+}
+
+void KRTextureManager::destroyFeedbackBuffers()
+{
+  for (auto itr = m_feedbackBuffers.begin(); itr != m_feedbackBuffers.end(); itr++) {
+    FeedbackBuffer& feedback = (*itr).second;
+    std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice((*itr).first);
+    // TODO - Validate that device has not been lost
+    VmaAllocator allocator = device->getAllocator();
+    vmaUnmapMemory(allocator, feedback.allocation);
+    vmaDestroyBuffer(allocator, feedback.buffer, feedback.allocation);
+  }
+  m_feedbackBuffers.clear();
+}
+
+
+bool KRTextureManager::requestBindlessSlot(KRTexture* texture)
+{
+  if (texture->getBindlessSlot() != -1) {
+    return true;
+  }
+  // The table holds only 2D images, sampled without a residency map
+  if (texture->isVirtual() || texture->isAnimated() || texture->getFaceCount() != 1
+    || texture->getLayerCount() != 1 || texture->getDimensions().z > 1) {
+    return false;
+  }
+  int slot;
+  if (!m_freeBindlessSlots.empty()) {
+    slot = m_freeBindlessSlots.back();
+    m_freeBindlessSlots.pop_back();
+  } else if ((int)m_bindlessTextures.size() < KRENGINE_BINDLESS_TEXTURE_SLOTS) {
+    slot = (int)m_bindlessTextures.size();
+    m_bindlessTextures.push_back(nullptr);
+  } else {
+    return false;
+  }
+  // Handle serials are never reused, so a slot's new texture is always written
+  // over the elements of the texture that last held it
+  m_bindlessTextures[slot] = texture;
+  texture->setBindlessSlot(slot);
+
+  // The slot is released when the texture expires from the active textures,
+  // after the frames in flight have stopped sampling it
+  primeTexture(texture);
+  return true;
+}
+
+void KRTextureManager::releaseBindlessSlot(KRTexture* texture)
+{
+  int slot = texture->getBindlessSlot();
+  if (slot != -1) {
+    m_bindlessTextures[slot] = nullptr;
+    m_freeBindlessSlots.push_back(slot);
+    texture->setBindlessSlot(-1);
+  }
+}
+
+bool KRTextureManager::updateBindlessSlot(KrDeviceHandle deviceHandle, KRTexture* texture)
+{
+  int slot = texture->getBindlessSlot();
+  BindlessTable* table = getBindlessTable(deviceHandle);
+  if (slot == -1 || table == nullptr || slot >= table->slotCount) {
+    return false;
+  }
+
+  // Arrays are selected by the device's frame in flight, whose fence has been waited on
+  std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(deviceHandle);
+  int frameIndex = device->getFrameIndex();
+  long serial = texture->getHandleSerial();
+  if (table->serials[frameIndex][slot] == serial) {
+    return true;
+  }
+  VkImageView imageView = texture->getFullImageView(deviceHandle);
+  if (imageView == VK_NULL_HANDLE) {
+    return false;
+  }
+
+  // This frame's array is no longer in use by the GPU, and elements may be
+  // updated after the array has been bound while recording
+  VkDescriptorImageInfo imageInfo{};
+  imageInfo.imageLayout = texture->getImageLayout(deviceHandle);
+  imageInfo.imageView = imageView;
+  imageInfo.sampler = getContext().getSamplerManager()->DEFAULT_WRAPPING_SAMPLER->getSampler(deviceHandle);
+
+  VkWriteDescriptorSet descriptorWrite{};
+  descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+  descriptorWrite.dstSet = table->descriptorSets[frameIndex];
+  descriptorWrite.dstBinding = 0;
+  descriptorWrite.dstArrayElement = slot;
+  descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+  descriptorWrite.descriptorCount = 1;
+  descriptorWrite.pImageInfo = &imageInfo;
+  vkUpdateDescriptorSets(device->m_logicalDevice, 1, &descriptorWrite, 0, nullptr);
+
+  table->serials[frameIndex][slot] = serial;
+  return true;
+}
+
+VkDescriptorSetLayout KRTextureManager::getBindlessLayout(KrDeviceHandle deviceHandle)
+{
+  BindlessTable* table = getBindlessTable(deviceHandle);
+  if (table == nullptr) {
+    return VK_NULL_HANDLE;
+  }
+  return table->layout;
+}
+
+VkDescriptorSet KRTextureManager::getBindlessDescriptorSet(KrDeviceHandle deviceHandle)
+{
+  BindlessTable* table = getBindlessTable(deviceHandle);
+  if (table == nullptr) {
+    return VK_NULL_HANDLE;
+  }
+  std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(deviceHandle);
+  return table->descriptorSets[device->getFrameIndex()];
+}
+
+KRTextureManager::BindlessTable* KRTextureManager::getBindlessTable(KrDeviceHandle deviceHandle)
+{
+  auto itr = m_bindlessTables.find(deviceHandle);
+  if (itr != m_bindlessTables.end()) {
+    return &(*itr).second;
+  }
+
+  std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice(deviceHandle);
+  if (!device->m_descriptorIndexing) {
+    // Bindless materials can not be drawn on this device
+    return nullptr;
+  }
+
+  BindlessTable table{};
+  table.slotCount = (int)std::min((uint32_t)KRENGINE_BINDLESS_TEXTURE_SLOTS, device->m_maxBindlessTextures);
+
+  // Elements that are not sampled need not be written
+  VkDescriptorBindingFlags bindingFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+  VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+  bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+  bindingFlagsInfo.bindingCount = 1;
+  bindingFlagsInfo.pBindingFlags = &bindingFlags;
+
+  VkDescriptorSetLayoutBinding binding{};
+  binding.binding = 0;
+  binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+  binding.descriptorCount = table.slotCount;
+  binding.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+
+  VkDescriptorSetLayoutCreateInfo layoutInfo{};
+  layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  layoutInfo.pNext = &bindingFlagsInfo;
+  layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+  layoutInfo.bindingCount = 1;
+  layoutInfo.pBindings = &binding;
+  if (vkCreateDescriptorSetLayout(device->m_logicalDevice, &layoutInfo, nullptr, &table.layout) != VK_SUCCESS) {
+    KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Unable to create bindless texture descriptor set layout.");
+    return nullptr;
+  }
+
+  VkDescriptorPoolSize poolSize{};
+  poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+  poolSize.descriptorCount = table.slotCount * KRENGINE_MAX_FRAMES_IN_FLIGHT;
+
+  VkDescriptorPoolCreateInfo poolInfo{};
+  poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+  poolInfo.poolSizeCount = 1;
+  poolInfo.pPoolSizes = &poolSize;
+  poolInfo.maxSets = KRENGINE_MAX_FRAMES_IN_FLIGHT;
+  if (vkCreateDescriptorPool(device->m_logicalDevice, &poolInfo, nullptr, &table.pool) != VK_SUCCESS) {
+    vkDestroyDescriptorSetLayout(device->m_logicalDevice, table.layout, nullptr);
+    KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Unable to create bindless texture descriptor pool.");
+    return nullptr;
+  }
+
+  VkDescriptorSetLayout layouts[KRENGINE_MAX_FRAMES_IN_FLIGHT];
+  for (int i = 0; i < KRENGINE_MAX_FRAMES_IN_FLIGHT; i++) {
+    layouts[i] = table.layout;
+  }
+  VkDescriptorSetAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  allocInfo.descriptorPool = table.pool;
+  allocInfo.descriptorSetCount = KRENGINE_MAX_FRAMES_IN_FLIGHT;
+  allocInfo.pSetLayouts = layouts;
+  if (vkAllocateDescriptorSets(device->m_logicalDevice, &allocInfo, table.descriptorSets) != VK_SUCCESS) {
+    vkDestroyDescriptorPool(device->m_logicalDevice, table.pool, nullptr);
+    vkDestroyDescriptorSetLayout(device->m_logicalDevice, table.layout, nullptr);
+    KRContext::Log(KRContext::LOG_LEVEL_ERROR, "Unable to allocate bindless texture descriptor sets.");
+    return nullptr;
+  }
+
+  for (int i = 0; i < KRENGINE_MAX_FRAMES_IN_FLIGHT; i++) {
+    table.serials[i].resize(table.slotCount, 0);
+  }
+  itr = m_bindlessTables.insert(std::pair<KrDeviceHandle, BindlessTable>(deviceHandle, table)).first;
+  return &(*itr).second;
+}
+
+void KRTextureManager::destroyBindlessTables()
+{
+  for (auto itr = m_bindlessTables.begin(); itr != m_bindlessTables.end(); itr++) {
+    BindlessTable& table = (*itr).second;
+    std::unique_ptr<KRDevice>& device = getContext().getDeviceManager()->getDevice((*itr).first);
+    // TODO - Validate that device has not been lost
+    // The descriptor sets are freed with their pool
+    vkDestroyDescriptorPool(device->m_logicalDevice, table.pool, nullptr);
+    vkDestroyDescriptorSetLayout(device->m_logicalDevice, table.layout, nullptr);
+  }
+  m_bindlessTables.clear();
+  for (KRTexture* texture : m_bindlessTextures) {
+    if (texture) {
+      texture->setBindlessSlot(-1);
+    }
+  }
+}
@@ -72,6 +72,11 @@ public:
   unordered_map<std::string, KRTexture*>& getTextures();
 
   void compress(bool premultiply_alpha = false);
+  // Replaces texture with a compressed copy, returning nullptr if it can not be compressed.
+  // The old texture is deleted, so this is only possible before the first frame starts,
+  // while no material, streamer pass or command buffer can be referencing it.
+  bool canReplaceTextures() const;
+  KRTexture* compressTexture(KRTexture* texture, KrTextureCompressionFormat format, KrTextureCompressionQuality quality, bool premultiply_alpha);
 
   std::set<KRTexture*>& getActiveTextures();
 
@@ -80,6 +85,26 @@ public:
   void doStreaming(long& memoryRemaining, long& memoryRemainingThisFrame);
   void primeTexture(KRTexture* texture);
 
+  // Texture feedback: the feedback pass records the finest mip level sampled from
+  // each texture in a slot of a host visible buffer, which is read back once the
+  // GPU has completed the frame.
+  static const int KRENGINE_TEXTURE_FEEDBACK_SLOTS = 4096;
+  bool requestFeedbackSlot(KRTexture* texture);
+  bool getFeedbackBuffer(KrDeviceHandle deviceHandle, VkDescriptorBufferInfo& bufferInfo);
+
+  // Bindless textures: textures sampled by bindless materials are written to an
+  // array of combined image samplers in descriptor set KRENGINE_BINDLESS_TEXTURE_SET,
+  // at a slot that is stable while the texture remains active.  Each frame in
+  // flight has its own copy of the array, so an element is only rewritten once
+  // the GPU has completed the frames that sample it.
+  static const int KRENGINE_BINDLESS_TEXTURE_SLOTS = 4096;
+  static const uint32_t KRENGINE_BINDLESS_TEXTURE_SET = 1;
+  bool requestBindlessSlot(KRTexture* texture);
+  // Writes the texture to this frame's array, returning false if it has no image to sample
+  bool updateBindlessSlot(KrDeviceHandle deviceHandle, KRTexture* texture);
+  VkDescriptorSetLayout getBindlessLayout(KrDeviceHandle deviceHandle);
+  VkDescriptorSet getBindlessDescriptorSet(KrDeviceHandle deviceHandle);
+
 private:
 
   long m_memoryTransferredThisFrame;
@@ -93,10 +118,41 @@ private:
   std::vector<std::pair<float, KRTexture*> > m_activeTextures_streamer;
   std::vector<std::pair<float, KRTexture*> > m_activeTextures_streamer_copy;
   bool m_streamerComplete;
+  bool m_frameStarted;
 
   std::atomic<long> m_textureMemUsed;
 
   void balanceTextureMemory(long& memoryRemaining, long& memoryRemainingThisFrame);
 
+  struct FeedbackBuffer
+  {
+    VkBuffer buffer;
+    VmaAllocation allocation;
+    __uint32_t* data;
+  };
+  unordered_map<KrDeviceHandle, FeedbackBuffer> m_feedbackBuffers;
+  std::vector<KRTexture*> m_feedbackTextures;
+
+  void readFeedback();
+  void releaseFeedbackSlot(KRTexture* texture);
+  void destroyFeedbackBuffers();
+
+  struct BindlessTable
+  {
+    VkDescriptorSetLayout layout;
+    VkDescriptorPool pool;
+    VkDescriptorSet descriptorSets[KRENGINE_MAX_FRAMES_IN_FLIGHT];
+    // Handle serial last written to each slot of each frame's array
+    std::vector<long> serials[KRENGINE_MAX_FRAMES_IN_FLIGHT];
+    int slotCount;
+  };
+  unordered_map<KrDeviceHandle, BindlessTable> m_bindlessTables;
+  std::vector<KRTexture*> m_bindlessTextures;
+  std::vector<int> m_freeBindlessSlots;
+
+  BindlessTable* getBindlessTable(KrDeviceHandle deviceHandle);
+  void releaseBindlessSlot(KRTexture* texture);
+  void destroyBindlessTables();
+
   std::mutex m_streamerFenceMutex;
 };
@@ -33,6 +33,10 @@
 #include "KRContext.h"
 #include "KRTextureKTX2.h"
 
+#if defined(KRAKEN_USE_SSE2)
+#include <emmintrin.h>
+#endif
+
 using namespace hydra;
 
 #define SWAP_2(x) ( (((x) & 0xff) << 8) | ((uint16_t)(x) >> 8) )
@@ -64,44 +68,743 @@ struct PNG_HEADER
 };
 #pragma pack()
 
+namespace {
+
+// Decompresses the zlib stream stored across a PNG's IDAT chunks.  The chunks
+// are read in place, so the compressed data is never concatenated.
+class PNGInflater
+{
+public:
+  PNGInflater(const std::vector<std::pair<const uint8_t*, size_t>>& spans, uint8_t* out, size_t out_size)
+    : m_spans(spans)
+    , m_span(0)
+    , m_pos(nullptr)
+    , m_end(nullptr)
+    , m_bits(0)
+    , m_bitCount(0)
+    , m_out(out)
+    , m_outStart(out)
+    , m_outEnd(out + out_size)
+  {
+    if (!m_spans.empty()) {
+      m_pos = m_spans[0].first;
+      m_end = m_pos + m_spans[0].second;
+    }
+  }
+
+  // Returns true if the stream decompressed to exactly out_size bytes
+  bool inflate()
+  {
+    uint32_t cmf = getBits(8);
+    uint32_t flg = getBits(8);
+    if ((cmf & 0x0f) != 8 || (cmf * 256 + flg) % 31 != 0 || (flg & 0x20)) {
+      return false; // Not deflate, corrupt header or preset dictionary
+    }
+
+    uint32_t final_block = 0;
+    do {
+      final_block = getBits(1);
+      switch (getBits(2)) {
+      case 0:
+        if (!inflateStored()) {
+          return false;
+        }
+        break;
+      case 1:
+        if (!inflateFixed()) {
+          return false;
+        }
+        break;
+      case 2:
+        if (!inflateDynamic()) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+      }
+    } while (!final_block);
+
+    return m_out == m_outEnd;
+  }
+
+private:
+  static const int kFastBits = 10;
+
+  struct Huffman
+  {
+    uint16_t fast[1 << kFastBits]; // (symbol << 4) | code length, or 0 for longer codes
+    uint16_t counts[16];
+    uint16_t symbols[288];
+  };
+
+  const std::vector<std::pair<const uint8_t*, size_t>>& m_spans;
+  size_t m_span;
+  const uint8_t* m_pos;
+  const uint8_t* m_end;
+  uint64_t m_bits;
+  int m_bitCount;
+  uint8_t* m_out;
+  uint8_t* m_outStart;
+  uint8_t* m_outEnd;
+
+  uint32_t nextByte()
+  {
+    while (m_pos == m_end) {
+      if (++m_span >= m_spans.size()) {
+        // Past the end of the stream.  Reading ahead is harmless, as truncated
+        // streams are detected by the output size.
+        m_span = m_spans.size();
+        return 0;
+      }
+      m_pos = m_spans[m_span].first;
+      m_end = m_pos + m_spans[m_span].second;
+    }
+    return *m_pos++;
+  }
+
+  void refill()
+  {
+    if (m_end - m_pos >= 8) {
+      // Read whole bytes from the current chunk with a single load.  The
+      // stream is little-endian, as are the platforms Kraken supports.
+      int byte_count = (63 - m_bitCount) >> 3;
+      uint64_t next;
+      memcpy(&next, m_pos, sizeof(next));
+      m_bits |= (next & ((1ull << (byte_count * 8)) - 1)) << m_bitCount;
+      m_pos += byte_count;
+      m_bitCount += byte_count * 8;
+      return;
+    }
+    while (m_bitCount <= 56) {
+      m_bits |= (uint64_t)nextByte() << m_bitCount;
+      m_bitCount += 8;
+    }
+  }
+
+  uint32_t getBits(int count)
+  {
+    if (m_bitCount < count) {
+      refill();
+    }
+    uint32_t value = (uint32_t)(m_bits & ((1ull << count) - 1));
+    m_bits >>= count;
+    m_bitCount -= count;
+    return value;
+  }
+
+  static bool BuildHuffman(Huffman& huffman, const uint8_t* lengths, int count)
+  {
+    memset(huffman.counts, 0, sizeof(huffman.counts));
+    memset(huffman.fast, 0, sizeof(huffman.fast));
+    for (int i = 0; i < count; i++) {
+      huffman.counts[lengths[i]]++;
+    }
+    huffman.counts[0] = 0;
+
+    // Reject over-subscribed codes.  Incomplete codes are permitted, as deflate
+    // uses them for blocks with a single distance code.
+    int left = 1;
+    for (int length = 1; length < 16; length++) {
+      left = (left << 1) - huffman.counts[length];
+      if (left < 0) {
+        return false;
+      }
+    }
+
+    uint16_t offsets[16];
+    offsets[1] = 0;
+    for (int length = 1; length < 15; length++) {
+      offsets[length + 1] = offsets[length] + huffman.counts[length];
+    }
+    for (int i = 0; i < count; i++) {
+      if (lengths[i]) {
+        huffman.symbols[offsets[lengths[i]]++] = (uint16_t)i;
+      }
+    }
+
+    // Canonical codes are assigned in order of length, then symbol.  Deflate
+    // stores them starting with the most significant bit, so the fast table is
+    // indexed with the bits reversed.
+    int code = 0;
+    int symbol_index = 0;
+    for (int length = 1; length <= kFastBits; length++) {
+      for (int i = 0; i < huffman.counts[length]; i++) {
+        int reversed = 0;
+        for (int bit = 0; bit < length; bit++) {
+          reversed |= ((code >> bit) & 1) << (length - 1 - bit);
+        }
+        uint16_t entry = (uint16_t)((huffman.symbols[symbol_index] << 4) | length);
+        for (int index = reversed; index < (1 << kFastBits); index += 1 << length) {
+          huffman.fast[index] = entry;
+        }
+        code++;
+        symbol_index++;
+      }
+      code <<= 1;
+    }
+    return true;
+  }
+
+  // Returns the next symbol, or -1 if the bits do not form a code
+  int decode(const Huffman& huffman)
+  {
+    if (m_bitCount < 16) {
+      refill();
+    }
+    uint16_t entry = huffman.fast[m_bits & ((1 << kFastBits) - 1)];
+    if (entry) {
+      int length = entry & 15;
+      m_bits >>= length;
+      m_bitCount -= length;
+      return entry >> 4;
+    }
+
+    // Codes longer than kFastBits are decoded one bit at a time
+    int code = 0;
+    int first = 0;
+    int index = 0;
+    for (int length = 1; length < 16; length++) {
+      code |= (int)getBits(1);
+      int count = huffman.counts[length];
+      if (code - count < first) {
+        return huffman.symbols[index + (code - first)];
+      }
+      index += count;
+      first += count;
+      first <<= 1;
+      code <<= 1;
+    }
+    return -1;
+  }
+
+  bool inflateStored()
+  {
+    // Stored blocks start on a byte boundary
+    getBits(m_bitCount & 7);
+    uint32_t length = getBits(16);
+    uint32_t inverse_length = getBits(16);
+    if ((length ^ 0xffff) != inverse_length || length > (size_t)(m_outEnd - m_out)) {
+      return false;
+    }
+    while (length--) {
+      *m_out++ = (uint8_t)getBits(8);
+    }
+    return true;
+  }
+
+  bool inflateFixed()
+  {
+    uint8_t lengths[288 + 30];
+    memset(lengths, 8, 144);
+    memset(lengths + 144, 9, 112);
+    memset(lengths + 256, 7, 24);
+    memset(lengths + 280, 8, 8);
+    memset(lengths + 288, 5, 30);
+
+    Huffman literals, distances;
+    BuildHuffman(literals, lengths, 288);
+    BuildHuffman(distances, lengths + 288, 30);
+    return inflateBlock(literals, distances);
+  }
+
+  bool inflateDynamic()
+  {
+    static const uint8_t code_length_order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+    int literal_count = (int)getBits(5) + 257;
+    int distance_count = (int)getBits(5) + 1;
+    int code_length_count = (int)getBits(4) + 4;
+    if (literal_count > 286 || distance_count > 30) {
+      return false;
+    }
+
+    uint8_t code_lengths[19] = {};
+    for (int i = 0; i < code_length_count; i++) {
+      code_lengths[code_length_order[i]] = (uint8_t)getBits(3);
+    }
+    Huffman code_length_huffman;
+    if (!BuildHuffman(code_length_huffman, code_lengths, 19)) {
+      return false;
+    }
+
+    uint8_t lengths[286 + 30];
+    int length_count = literal_count + distance_count;
+    int i = 0;
+    while (i < length_count) {
+      int symbol = decode(code_length_huffman);
+      int repeat_length = 0;
+      int repeat_count = 0;
+      if (symbol < 0) {
+        return false;
+      } else if (symbol < 16) {
+        lengths[i++] = (uint8_t)symbol;
+        continue;
+      } else if (symbol == 16) {
+        if (i == 0) {
+          return false;
+        }
+        repeat_length = lengths[i - 1];
+        repeat_count = 3 + (int)getBits(2);
+      } else if (symbol == 17) {
+        repeat_count = 3 + (int)getBits(3);
+      } else {
+        repeat_count = 11 + (int)getBits(7);
+      }
+      if (i + repeat_count > length_count) {
+        return false;
+      }
+      memset(lengths + i, repeat_length, repeat_count);
+      i += repeat_count;
+    }
+    if (lengths[256] == 0) {
+      return false; // No end of block code
+    }
+
+    Huffman literals, distances;
+    if (!BuildHuffman(literals, lengths, literal_count) || !BuildHuffman(distances, lengths + literal_count, distance_count)) {
+      return false;
+    }
+    return inflateBlock(literals, distances);
+  }
+
+  bool inflateBlock(const Huffman& literals, const Huffman& distances)
+  {
+    static const uint16_t length_base[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    static const uint8_t length_extra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    static const uint16_t distance_base[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    static const uint8_t distance_extra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+    while (true) {
+      int symbol = decode(literals);
+      if (symbol < 256) {
+        if (symbol < 0 || m_out == m_outEnd) {
+          return false;
+        }
+        *m_out++ = (uint8_t)symbol;
+      } else if (symbol == 256) {
+        return true;
+      } else {
+        symbol -= 257;
+        if (symbol >= 29) {
+          return false;
+        }
+        size_t length = length_base[symbol] + getBits(length_extra[symbol]);
+        int distance_symbol = decode(distances);
+        if (distance_symbol < 0 || distance_symbol >= 30) {
+          return false;
+        }
+        size_t distance = distance_base[distance_symbol] + getBits(distance_extra[distance_symbol]);
+        if (distance > (size_t)(m_out - m_outStart) || length > (size_t)(m_outEnd - m_out)) {
+          return false;
+        }
+        const uint8_t* source = m_out - distance;
+        if (distance >= length) {
+          memcpy(m_out, source, length);
+          m_out += length;
+        } else {
+          // Overlapping copies repeat the most recent bytes
+          while (length--) {
+            *m_out++ = *source++;
+          }
+        }
+      }
+    }
+  }
+};
+
+#if defined(KRAKEN_USE_SSE2)
+// Sub, Average and Paeth depend on the pixel to the left, so for 3 and 4 byte
+// pixels each pixel is reconstructed with all of its channels at once.
+template <int bpp>
+inline __m128i LoadPixel(const uint8_t* pixel)
+{
+  uint32_t value;
+  if (bpp == 3) {
+    // Assembled in a register, as a 3 byte copy to the stack would stall the 4 byte load
+    value = (uint32_t)pixel[0] | ((uint32_t)pixel[1] << 8) | ((uint32_t)pixel[2] << 16);
+  } else {
+    memcpy(&value, pixel, sizeof(value));
+  }
+  return _mm_cvtsi32_si128((int)value);
+}
+
+template <int bpp>
+inline void StorePixel(uint8_t* pixel, __m128i value)
+{
+  uint32_t v = (uint32_t)_mm_cvtsi128_si32(value);
+  memcpy(pixel, &v, bpp);
+}
+
+template <int bpp>
+void UnfilterSubSSE2(uint8_t* row, size_t row_bytes)
+{
+  __m128i a = _mm_setzero_si128();
+  for (size_t i = 0; i < row_bytes; i += bpp) {
+    a = _mm_add_epi8(a, LoadPixel<bpp>(row + i));
+    StorePixel<bpp>(row + i, a);
+  }
+}
+
+template <int bpp>
+void UnfilterAverageSSE2(uint8_t* row, const uint8_t* prior, size_t row_bytes)
+{
+  const __m128i one = _mm_set1_epi8(1);
+  __m128i a = _mm_setzero_si128();
+  for (size_t i = 0; i < row_bytes; i += bpp) {
+    __m128i b = LoadPixel<bpp>(prior + i);
+    // _mm_avg_epu8 rounds up, where PNG rounds down
+    __m128i average = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+    a = _mm_add_epi8(LoadPixel<bpp>(row + i), average);
+    StorePixel<bpp>(row + i, a);
+  }
+}
+
+inline __m128i Abs16(__m128i x)
+{
+  return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+}
+
+inline __m128i Select(__m128i mask, __m128i a, __m128i b)
+{
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+template <int bpp>
+void UnfilterPaethSSE2(uint8_t* row, const uint8_t* prior, size_t row_bytes)
+{
+  const __m128i zero = _mm_setzero_si128();
+  __m128i a = zero;
+  __m128i c = zero;
+  for (size_t i = 0; i < row_bytes; i += bpp) {
+    __m128i b = _mm_unpacklo_epi8(LoadPixel<bpp>(prior + i), zero);
+    // With p = a + b - c: |p - a| = |b - c|, |p - b| = |a - c|, |p - c| = |a + b - 2c|
+    __m128i pa = _mm_sub_epi16(b, c);
+    __m128i pb = _mm_sub_epi16(a, c);
+    __m128i pc = _mm_add_epi16(pa, pb);
+    pa = Abs16(pa);
+    pb = Abs16(pb);
+    pc = Abs16(pc);
+    __m128i smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+    __m128i predictor = Select(_mm_cmpeq_epi16(smallest, pb), b, c);
+    predictor = Select(_mm_cmpeq_epi16(smallest, pa), a, predictor);
+    __m128i pixel = _mm_add_epi8(LoadPixel<bpp>(row + i), _mm_packus_epi16(predictor, predictor));
+    StorePixel<bpp>(row + i, pixel);
+    a = _mm_unpacklo_epi8(pixel, zero);
+    c = b;
+  }
+}
+#endif
+
+inline uint8_t Paeth(int a, int b, int c)
+{
+  int pa = abs(b - c);
+  int pb = abs(a - c);
+  int pc = abs(a + b - 2 * c);
+  // Selected without branches, as the choice is unpredictable in noisy images
+  int nearest = pb <= pc ? b : c;
+  return (uint8_t)(pa <= pb && pa <= pc ? a : nearest);
+}
+
+// Reverses the filter applied to a scanline, given the already reconstructed
+// previous scanline.  bpp is the number of bytes per complete pixel, rounded up to 1.
+bool UnfilterRow(uint8_t filter, uint8_t* row, const uint8_t* prior, size_t row_bytes, int bpp)
+{
+  switch (filter) {
+  case 0: // None
+    return true;
+  case 1: // Sub
+#if defined(KRAKEN_USE_SSE2)
+    if (bpp == 3 || bpp == 4) {
+      bpp == 3 ? UnfilterSubSSE2<3>(row, row_bytes) : UnfilterSubSSE2<4>(row, row_bytes);
+      return true;
+    }
+#endif
+    for (size_t i = bpp; i < row_bytes; i++) {
+      row[i] += row[i - bpp];
+    }
+    return true;
+  case 2: // Up
+  {
+    size_t i = 0;
+#if defined(KRAKEN_USE_SSE2)
+    for (; i + 16 <= row_bytes; i += 16) {
+      __m128i sum = _mm_add_epi8(_mm_loadu_si128((const __m128i*)(row + i)), _mm_loadu_si128((const __m128i*)(prior + i)));
+      _mm_storeu_si128((__m128i*)(row + i), sum);
+    }
+#endif
+    for (; i < row_bytes; i++) {
+      row[i] += prior[i];
+    }
+    return true;
+  }
+  case 3: // Average
+#if defined(KRAKEN_USE_SSE2)
+    if (bpp == 3 || bpp == 4) {
+      bpp == 3 ? UnfilterAverageSSE2<3>(row, prior, row_bytes) : UnfilterAverageSSE2<4>(row, prior, row_bytes);
+      return true;
+    }
+#endif
+    for (size_t i = 0; i < (size_t)bpp && i < row_bytes; i++) {
+      row[i] += prior[i] >> 1;
+    }
+    for (size_t i = bpp; i < row_bytes; i++) {
+      row[i] += (uint8_t)(((int)row[i - bpp] + (int)prior[i]) >> 1);
+    }
+    return true;
+  case 4: // Paeth
+#if defined(KRAKEN_USE_SSE2)
+    if (bpp == 3 || bpp == 4) {
+      bpp == 3 ? UnfilterPaethSSE2<3>(row, prior, row_bytes) : UnfilterPaethSSE2<4>(row, prior, row_bytes);
+      return true;
+    }
+#endif
+    for (size_t i = 0; i < (size_t)bpp && i < row_bytes; i++) {
+      row[i] += prior[i];
+    }
+    for (size_t i = bpp; i < row_bytes; i++) {
+      row[i] += Paeth(row[i - bpp], prior[i], prior[i - bpp]);
+    }
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Converts unfiltered scanlines of any PNG color type and bit depth to RGBA8
+struct PNGPixelFormat
+{
+  uint8_t colorType;
+  uint8_t depth;
+  const uint8_t* palette;
+  size_t paletteLength;
+  const uint8_t* transparency;
+  size_t transparencyLength;
+
+  int getChannelCount() const
+  {
+    switch (colorType) {
+    case 2:
+      return 3;
+    case 4:
+      return 2;
+    case 6:
+      return 4;
+    default:
+      return 1;
+    }
+  }
+
+  uint32_t sample(const uint8_t* row, size_t index) const
+  {
+    switch (depth) {
+    case 8:
+      return row[index];
+    case 16:
+      return ((uint32_t)row[index * 2] << 8) | row[index * 2 + 1];
+    default:
+    {
+      size_t bit = index * depth;
+      return (row[bit >> 3] >> (8 - depth - (bit & 7))) & ((1 << depth) - 1);
+    }
+    }
+  }
+
+  // Scales a sample to 8 bits
+  uint8_t toByte(uint32_t value) const
+  {
+    switch (depth) {
+    case 16:
+      return (uint8_t)(value >> 8);
+    case 8:
+      return (uint8_t)value;
+    default:
+      return (uint8_t)(value * 255 / ((1 << depth) - 1));
+    }
+  }
+
+  // Writes width pixels to dest, advancing by dest_step bytes per pixel
+  void expandRow(const uint8_t* row, int width, uint8_t* dest, size_t dest_step) const
+  {
+    bool has_key = transparency != nullptr && (colorType == 0 || colorType == 2);
+    uint32_t key[3] = {};
+    if (has_key) {
+      for (int channel = 0; channel < 3 && (size_t)channel * 2 + 1 < transparencyLength; channel++) {
+        key[channel] = ((uint32_t)transparency[channel * 2] << 8) | transparency[channel * 2 + 1];
+      }
+    }
+
+    if (colorType == 6 && depth == 8 && dest_step == 4) {
+      memcpy(dest, row, (size_t)width * 4);
+      return;
+    }
+
+    for (int x = 0; x < width; x++, dest += dest_step) {
+      switch (colorType) {
+      case 0: // Greyscale
+      {
+        uint32_t grey = sample(row, x);
+        dest[0] = dest[1] = dest[2] = toByte(grey);
+        dest[3] = has_key && grey == key[0] ? 0 : 0xff;
+        break;
+      }
+      case 2: // RGB
+      {
+        uint32_t r = sample(row, (size_t)x * 3);
+        uint32_t g = sample(row, (size_t)x * 3 + 1);
+        uint32_t b = sample(row, (size_t)x * 3 + 2);
+        dest[0] = toByte(r);
+        dest[1] = toByte(g);
+        dest[2] = toByte(b);
+        dest[3] = has_key && r == key[0] && g == key[1] && b == key[2] ? 0 : 0xff;
+        break;
+      }
+      case 3: // Palette
+      {
+        uint32_t index = sample(row, x);
+        if ((size_t)index * 3 + 2 < paletteLength) {
+          dest[0] = palette[index * 3];
+          dest[1] = palette[index * 3 + 1];
+          dest[2] = palette[index * 3 + 2];
+        } else {
+          dest[0] = dest[1] = dest[2] = 0;
+        }
+        dest[3] = transparency != nullptr && index < transparencyLength ? transparency[index] : 0xff;
+        break;
+      }
+      case 4: // Greyscale + Alpha
+        dest[0] = dest[1] = dest[2] = toByte(sample(row, (size_t)x * 2));
+        dest[3] = toByte(sample(row, (size_t)x * 2 + 1));
+        break;
+      case 6: // RGB + Alpha
+        dest[0] = toByte(sample(row, (size_t)x * 4));
+        dest[1] = toByte(sample(row, (size_t)x * 4 + 1));
+        dest[2] = toByte(sample(row, (size_t)x * 4 + 2));
+        dest[3] = toByte(sample(row, (size_t)x * 4 + 3));
+        break;
+      }
+    }
+  }
+};
+
+// Decodes the image data of a PNG, given its IDAT chunks, to RGBA8
+bool DecodePNG(const std::vector<std::pair<const uint8_t*, size_t>>& idat, const PNGPixelFormat& format, int width, int height, bool interlaced, uint8_t* image)
+{
+  // Adam7 interlacing stores the image as 7 reduced images
+  static const int pass_x[7] = { 0, 4, 0, 2, 0, 1, 0 };
+  static const int pass_y[7] = { 0, 0, 4, 0, 2, 0, 1 };
+  static const int pass_dx[7] = { 8, 8, 4, 4, 2, 2, 1 };
+  static const int pass_dy[7] = { 8, 8, 8, 4, 4, 2, 2 };
+  int pass_count = interlaced ? 7 : 1;
+
+  int bits_per_pixel = format.getChannelCount() * format.depth;
+  int bpp = std::max(bits_per_pixel / 8, 1);
+
+  size_t raw_size = 0;
+  size_t max_row_bytes = 0;
+  for (int pass = 0; pass < pass_count; pass++) {
+    int dx = interlaced ? pass_dx[pass] : 1;
+    int dy = interlaced ? pass_dy[pass] : 1;
+    int x0 = interlaced ? pass_x[pass] : 0;
+    int y0 = interlaced ? pass_y[pass] : 0;
+    size_t pass_width = width > x0 ? (width - x0 + dx - 1) / dx : 0;
+    size_t pass_height = height > y0 ? (height - y0 + dy - 1) / dy : 0;
+    if (pass_width && pass_height) {
+      size_t row_bytes = (pass_width * bits_per_pixel + 7) / 8;
+      raw_size += pass_height * (row_bytes + 1);
+      max_row_bytes = std::max(max_row_bytes, row_bytes);
+    }
+  }
+
+  std::vector<uint8_t> raw(raw_size);
+  PNGInflater inflater(idat, raw.data(), raw.size());
+  if (!inflater.inflate()) {
+    return false;
+  }
+
+  std::vector<uint8_t> zero_row(max_row_bytes, 0);
+  uint8_t* scanline = raw.data();
+  size_t image_stride = (size_t)width * 4;
+  for (int pass = 0; pass < pass_count; pass++) {
+    int dx = interlaced ? pass_dx[pass] : 1;
+    int dy = interlaced ? pass_dy[pass] : 1;
+    int x0 = interlaced ? pass_x[pass] : 0;
+    int y0 = interlaced ? pass_y[pass] : 0;
+    int pass_width = width > x0 ? (width - x0 + dx - 1) / dx : 0;
+    int pass_height = height > y0 ? (height - y0 + dy - 1) / dy : 0;
+    if (pass_width == 0 || pass_height == 0) {
+      continue;
+    }
+    size_t row_bytes = ((size_t)pass_width * bits_per_pixel + 7) / 8;
+    const uint8_t* prior = zero_row.data();
+    for (int y = 0; y < pass_height; y++) {
+      uint8_t* row = scanline + 1;
+      if (!UnfilterRow(scanline[0], row, prior, row_bytes, bpp)) {
+        return false;
+      }
+      format.expandRow(row, pass_width, image + (size_t)(y0 + y * dy) * image_stride + (size_t)x0 * 4, (size_t)dx * 4);
+      prior = row;
+      scanline += row_bytes + 1;
+    }
+  }
+  return true;
+}
+
+} // namespace
 KRTexturePNG::KRTexturePNG(KRContext& context, Block* data, std::string name) : KRTexture2D(context, data, name)
 {
+  m_dimensions = Vector2i::Create(0, 0);
+  m_colorType = 0;
+  m_bitDepth = 0;
+  m_interlaced = false;
+  m_lod_count = 0;
+
   data->lock();
   PNG_HEADER* pHeader = (PNG_HEADER*)data->getStart();
   uint8_t expected_magic[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
-  if (memcmp(pHeader->magic, expected_magic, 8) != 0) {
+  if (data->getSize() < sizeof(PNG_HEADER) || memcmp(pHeader->magic, expected_magic, 8) != 0 || memcmp(pHeader->chunk_IHDR.header.type, "IHDR", 4) != 0) {
     assert(false);
     data->unlock();
     return; // Not a valid PNG file
   }
 
-  m_dimensions.x = SWAP_4(pHeader->chunk_IHDR.width);
-  m_dimensions.y = SWAP_4(pHeader->chunk_IHDR.height);
-  m_lod_count = 1; // Mipmaps not yet supported for PNG images
-  switch (pHeader->chunk_IHDR.colorType) {
+  m_colorType = pHeader->chunk_IHDR.colorType;
+  m_bitDepth = pHeader->chunk_IHDR.depth;
+  m_interlaced = pHeader->chunk_IHDR.interlateMethod == 1;
+
+  bool valid_depth = false;
+  switch (m_colorType) {
   case 0:
-      // greyscale
-      m_imageSize = m_dimensions.x * m_dimensions.y * pHeader->chunk_IHDR.depth / 8;
-      break;
-  case 2:
-      // RGB
-      m_imageSize = m_dimensions.x * m_dimensions.y * pHeader->chunk_IHDR.depth / 8 * 3;
-      break;
+    // Greyscale
+    valid_depth = m_bitDepth == 1 || m_bitDepth == 2 || m_bitDepth == 4 || m_bitDepth == 8 || m_bitDepth == 16;
+    break;
   case 3:
-      // Palette
-      m_imageSize = m_dimensions.x * m_dimensions.y * 3;
-      break;
+    // Palette
+    valid_depth = m_bitDepth == 1 || m_bitDepth == 2 || m_bitDepth == 4 || m_bitDepth == 8;
+    break;
+  case 2:
+    // RGB
   case 4:
-      // Greyscale + alpha
-      m_imageSize = m_dimensions.x * m_dimensions.y * pHeader->chunk_IHDR.depth / 8 * 2;
-      break;
+    // Greyscale + alpha
   case 6:
-      // RGB + Alpha
-      m_imageSize = m_dimensions.x * m_dimensions.y * pHeader->chunk_IHDR.depth / 8 * 4;
-      break;
-  default:
-      assert(false);
-      break;
+    // RGB + Alpha
+    valid_depth = m_bitDepth == 8 || m_bitDepth == 16;
+    break;
+  }
+  if (!valid_depth || pHeader->chunk_IHDR.compressionMethod != 0 || pHeader->chunk_IHDR.filterMethod != 0 || pHeader->chunk_IHDR.interlateMethod > 1) {
+    assert(false);
+    data->unlock();
+    return; // Unsupported PNG format
+  }
+
+  m_dimensions.x = SWAP_4(pHeader->chunk_IHDR.width);
+  m_dimensions.y = SWAP_4(pHeader->chunk_IHDR.height);
+
+  // PNG images contain only the base level.  The rest of the mip chain is
+  // generated when the image is decoded.
+  m_lod_count = 1;
+  while ((m_dimensions.x >> m_lod_count) > 0 || (m_dimensions.y >> m_lod_count) > 0) {
+    m_lod_count++;
   }
 
   data->unlock();
@@ -114,52 +817,79 @@ KRTexturePNG::~KRTexturePNG()
 
 bool KRTexturePNG::getLodData(void* buffer, int lod)
 {
-  unsigned char* converted_image = (unsigned char*)buffer;
+  if (m_lod_count == 0) {
+    return false;
+  }
+  int target_lod = std::min(lod, m_lod_count - 1);
+
   // TODO - Vulkan Refactoring - Perhaps it would be more efficient to reformat the color channels during the copy to the staging buffer.
   m_pData->lock();
-  PNG_HEADER* pHeader = (PNG_HEADER*)m_pData->getStart();
+  const uint8_t* start = (const uint8_t*)m_pData->getStart();
+  size_t size = m_pData->getSize();
 
-  PNG_CHUNK_IHDR* chunk_IHDR = &pHeader->chunk_IHDR;
+  PNGPixelFormat format = {};
+  format.colorType = m_colorType;
+  format.depth = m_bitDepth;
+  std::vector<std::pair<const uint8_t*, size_t>> idat;
 
-  PNG_CHUNK_HEADER* chunk = &chunk_IHDR->header;
+  size_t offset = sizeof(PNG_HEADER::magic);
+  while (offset + sizeof(PNG_CHUNK_HEADER) <= size) {
+    const PNG_CHUNK_HEADER* chunk = (const PNG_CHUNK_HEADER*)(start + offset);
+    size_t length = SWAP_4(chunk->length);
+    const uint8_t* chunk_data = start + offset + sizeof(PNG_CHUNK_HEADER);
+    if (length > size - offset - sizeof(PNG_CHUNK_HEADER)) {
+      break; // Truncated chunk
+    }
+    if (memcmp(chunk->type, "IEND", 4) == 0) {
+      break;
+    } else if (memcmp(chunk->type, "PLTE", 4) == 0) {
+      format.palette = chunk_data;
+      format.paletteLength = length;
+    } else if (memcmp(chunk->type, "tRNS", 4) == 0) {
+      format.transparency = chunk_data;
+      format.transparencyLength = length;
+    } else if (memcmp(chunk->type, "IDAT", 4) == 0) {
+      idat.push_back(std::make_pair(chunk_data, length));
+    }
+    offset += sizeof(PNG_CHUNK_HEADER) + length + 4; // Chunks are followed by a CRC
+  }
 
-  uint8_t* palette_data = nullptr;
-  size_t palette_length = 0;
-  uint8_t* alpha_data = nullptr;
-  size_t alpha_length = 0;
-  while(chunk != nullptr)
-  {
-	  chunk = (PNG_CHUNK_HEADER*)((uint8_t*)chunk + sizeof(PNG_CHUNK_HEADER) + SWAP_4(chunk->length));
-	  assert(chunk < (PNG_CHUNK_HEADER*)m_pData->getEnd());
-      if (memcmp(chunk->type, "IEND", 4) == 0) {
-          chunk = nullptr;
-      } else if (memcmp(chunk->type, "PLTE", 4) == 0) {
-          palette_data = (uint8_t*)chunk + sizeof(PNG_CHUNK_HEADER);
-		  palette_length = SWAP_4(chunk->length);
-      } else if (memcmp(chunk->type, "tRNS", 4) == 0) {
-          alpha_data = (uint8_t*)chunk + sizeof(PNG_CHUNK_HEADER);
-          alpha_length = SWAP_4(chunk->length);
-      } else if (memcmp(chunk->type, "IDAT", 4) == 0) {
-          break;
-	  }
+  // Levels below the target lod are only needed to generate the smaller levels,
+  // so they are decoded into scratch memory.  The rest are written directly
+  // into the buffer.
+  std::vector<uint8_t> scratch(target_lod > 0 ? getMemRequiredForLodRange(0, target_lod - 1) : 0);
+  unsigned char* level = target_lod == 0 ? (unsigned char*)buffer : scratch.data();
+
+  bool success = m_colorType != 3 || format.palette != nullptr;
+  if (success) {
+    success = DecodePNG(idat, format, m_dimensions.x, m_dimensions.y, m_interlaced, level);
   }
+  m_pData->unlock();
 
-  return true;
-}
+  if (!success) {
+    return false;
+  }
 
-#if !TARGET_OS_IPHONE && !defined(ANDROID)
+  for (int mip = 1; mip < m_lod_count; mip++) {
+    unsigned char* next_level = nullptr;
+    if (mip < target_lod) {
+      next_level = scratch.data() + getMemRequiredForLodRange(0, mip - 1);
+    } else if (mip == target_lod) {
+      next_level = (unsigned char*)buffer;
+    } else {
+      next_level = (unsigned char*)buffer + getMemRequiredForLodRange(target_lod, mip - 1);
+    }
+    DownsampleRGBA8(level, std::max(m_dimensions.x >> (mip - 1), 1), std::max(m_dimensions.y >> (mip - 1), 1), next_level);
+    level = next_level;
+  }
 
-KRTexture* KRTexturePNG::compress(bool premultiply_alpha)
-{
-  //  TODO - Vulkan refactoring... Not Implemented...
-  assert(false);
-  return nullptr;
+  return true;
 }
-#endif
 
 long KRTexturePNG::getMemRequiredForLod(int lod)
 {
-  return m_imageSize;
+  // Images are always expanded to RGBA8
+  return (long)std::max(m_dimensions.x >> lod, 1) * (long)std::max(m_dimensions.y >> lod, 1) * 4;
 }
 
 Vector3i KRTexturePNG::getDimensions() const
@@ -44,15 +44,13 @@ public:
 
   bool getLodData(void* buffer, int lod) override;
 
-#if !TARGET_OS_IPHONE && !defined(ANDROID)
-  virtual KRTexture* compress(bool premultiply_alpha = false) override;
-#endif
-
   virtual long getMemRequiredForLod(int lod) override;
   virtual hydra::Vector3i getDimensions() const override;
   virtual VkFormat getFormat() const override;
   virtual int getFaceCount() const override;
 private:
-  long m_imageSize;
   hydra::Vector2i m_dimensions;
+  uint8_t m_colorType;
+  uint8_t m_bitDepth;
+  bool m_interlaced;
 };
@@ -33,6 +33,14 @@
 #include "KRContext.h"
 #include "KRTextureKTX2.h"
 
+#if defined(KRAKEN_USE_AVX2) || defined(KRAKEN_USE_SSSE3)
+#include <immintrin.h>
+#elif defined(KRAKEN_USE_SSE2)
+#include <emmintrin.h>
+#elif defined(KRAKEN_USE_ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 using namespace hydra;
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -72,6 +80,135 @@ typedef struct
 #endif
 
 
+namespace {
+
+// TGA stores pixels as BGR or BGRA.  These convert runs of pixels to RGBA8,
+// using the widest vector instructions available.
+
+void ConvertBGRAToRGBA(const unsigned char* source, unsigned char* dest, size_t pixel_count)
+{
+  size_t i = 0;
+#if defined(KRAKEN_USE_AVX2)
+  const __m256i shuffle_bgra = _mm256_setr_epi8(
+    2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+    2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+  for (; i + 8 <= pixel_count; i += 8) {
+    __m256i pixels = _mm256_loadu_si256((const __m256i*)(source + i * 4));
+    _mm256_storeu_si256((__m256i*)(dest + i * 4), _mm256_shuffle_epi8(pixels, shuffle_bgra));
+  }
+#elif defined(KRAKEN_USE_SSE2)
+  // Swap the red and blue bytes of each 32-bit pixel
+  const __m128i mask_ga = _mm_set1_epi32((int)0xff00ff00);
+  const __m128i mask_b = _mm_set1_epi32(0x000000ff);
+  for (; i + 4 <= pixel_count; i += 4) {
+    __m128i pixels = _mm_loadu_si128((const __m128i*)(source + i * 4));
+    __m128i ga = _mm_and_si128(pixels, mask_ga);
+    __m128i r = _mm_and_si128(_mm_srli_epi32(pixels, 16), mask_b);
+    __m128i b = _mm_slli_epi32(_mm_and_si128(pixels, mask_b), 16);
+    _mm_storeu_si128((__m128i*)(dest + i * 4), _mm_or_si128(ga, _mm_or_si128(r, b)));
+  }
+#elif defined(KRAKEN_USE_ARM_NEON)
+  for (; i + 16 <= pixel_count; i += 16) {
+    uint8x16x4_t pixels = vld4q_u8(source + i * 4);
+    uint8x16_t blue = pixels.val[0];
+    pixels.val[0] = pixels.val[2];
+    pixels.val[2] = blue;
+    vst4q_u8(dest + i * 4, pixels);
+  }
+#endif
+  for (; i < pixel_count; i++) {
+    dest[i * 4] = source[i * 4 + 2];
+    dest[i * 4 + 1] = source[i * 4 + 1];
+    dest[i * 4 + 2] = source[i * 4];
+    dest[i * 4 + 3] = source[i * 4 + 3];
+  }
+}
+
+void ConvertBGRToRGBA(const unsigned char* source, unsigned char* dest, size_t pixel_count)
+{
+  size_t i = 0;
+#if defined(KRAKEN_USE_AVX2)
+  // Each 128-bit lane expands 4 pixels.  The loads read 4 bytes beyond the
+  // 12 that are used, so the loop stops short of the end of the source.
+  const __m256i shuffle_bgr = _mm256_setr_epi8(
+    2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1,
+    2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+  const __m256i alpha = _mm256_set1_epi32((int)0xff000000);
+  for (; i + 10 <= pixel_count; i += 8) {
+    __m256i pixels = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(source + i * 3))), _mm_loadu_si128((const __m128i*)(source + i * 3 + 12)), 1);
+    _mm256_storeu_si256((__m256i*)(dest + i * 4), _mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle_bgr), alpha));
+  }
+#elif defined(KRAKEN_USE_SSSE3)
+  // The loads read 4 bytes beyond the 12 that are used, so the loop stops
+  // short of the end of the source.
+  const __m128i shuffle_bgr = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+  const __m128i alpha = _mm_set1_epi32((int)0xff000000);
+  for (; i + 6 <= pixel_count; i += 4) {
+    __m128i pixels = _mm_loadu_si128((const __m128i*)(source + i * 3));
+    _mm_storeu_si128((__m128i*)(dest + i * 4), _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle_bgr), alpha));
+  }
+#elif defined(KRAKEN_USE_ARM_NEON)
+  for (; i + 16 <= pixel_count; i += 16) {
+    uint8x16x3_t pixels = vld3q_u8(source + i * 3);
+    uint8x16x4_t expanded;
+    expanded.val[0] = pixels.val[2];
+    expanded.val[1] = pixels.val[1];
+    expanded.val[2] = pixels.val[0];
+    expanded.val[3] = vdupq_n_u8(0xff);
+    vst4q_u8(dest + i * 4, expanded);
+  }
+#endif
+  for (; i < pixel_count; i++) {
+    dest[i * 4] = source[i * 3 + 2];
+    dest[i * 4 + 1] = source[i * 3 + 1];
+    dest[i * 4 + 2] = source[i * 3];
+    dest[i * 4 + 3] = 0xff;
+  }
+}
+
+// Expands run length encoded BGR or BGRA packets.  Returns false if the
+// source ends before the image is complete.
+bool DecodeRLE(const unsigned char* source, const unsigned char* source_end, unsigned char* dest, size_t pixel_count, int source_pixel_size)
+{
+  unsigned char* dest_end = dest + pixel_count * 4;
+  while (dest < dest_end) {
+    if (source >= source_end) {
+      return false;
+    }
+    size_t count = std::min((size_t)(*source & 0x7f) + 1, (size_t)(dest_end - dest) / 4);
+    bool rle_packet = (*source & 0x80) != 0;
+    source++;
+    if (rle_packet) {
+      // RLE Packet
+      if (source_end - source < source_pixel_size) {
+        return false;
+      }
+      unsigned char pixel[4] = { source[2], source[1], source[0], source_pixel_size == 4 ? source[3] : (unsigned char)0xff };
+      uint32_t value;
+      memcpy(&value, pixel, 4);
+      for (size_t i = 0; i < count; i++) {
+        memcpy(dest + i * 4, &value, 4);
+      }
+      source += source_pixel_size;
+    } else {
+      // RAW Packet
+      if ((size_t)(source_end - source) < count * source_pixel_size) {
+        return false;
+      }
+      if (source_pixel_size == 4) {
+        ConvertBGRAToRGBA(source, dest, count);
+      } else {
+        ConvertBGRToRGBA(source, dest, count);
+      }
+      source += count * source_pixel_size;
+    }
+    dest += count * 4;
+  }
+  return true;
+}
+
+} // namespace
+
 KRTextureTGA::KRTextureTGA(KRContext& context, Block* data, std::string name) : KRTexture2D(context, data, name)
 {
   data->lock();
@@ -124,216 +261,42 @@ bool KRTextureTGA::getLodData(void* buffer, int lod)
   m_pData->lock();
   TGA_HEADER* pHeader = (TGA_HEADER*)m_pData->getStart();
   unsigned char* pData = (unsigned char*)pHeader + (long)pHeader->idlength + (long)pHeader->colourmaplength * (long)pHeader->colourmaptype + sizeof(TGA_HEADER);
+  unsigned char* pDataEnd = (unsigned char*)m_pData->getEnd();
 
   if (pHeader->colourmaptype != 0) {
     m_pData->unlock();
     return false; // Mapped colors not supported
   }
 
+  size_t pixel_count = (size_t)pHeader->width * (size_t)pHeader->height;
+  int source_pixel_size = pHeader->bitsperpixel / 8;
+  if (pHeader->bitsperpixel != 24 && pHeader->bitsperpixel != 32) {
+    m_pData->unlock();
+    return false; // 16-bit images not yet supported
+  }
+
+  bool success = true;
   switch (pHeader->imagetype) {
   case 2: // rgb
-    switch (pHeader->bitsperpixel) {
-    case 24:
-    {
-      
-      unsigned char* pSource = pData;
-      unsigned char* pDest = converted_image;
-      unsigned char* pEnd = pData + pHeader->height * pHeader->width * 3;
-      while (pSource < pEnd) {
-        *pDest++ = pSource[2];
-        *pDest++ = pSource[1];
-        *pDest++ = pSource[0];
-        *pDest++ = 0xff;
-        pSource += 3;
-      }
-      assert(pSource <= m_pData->getEnd());
-    }
-    break;
-    case 32:
-    {
-        unsigned char* pSource = pData;
-        unsigned char* pDest = converted_image;
-        unsigned char* pEnd = pData + pHeader->height * pHeader->width * 3;
-        while (pSource < pEnd) {
-            *pDest++ = (__uint32_t)pSource[2];
-            *pDest++ = (__uint32_t)pSource[1];
-            *pDest++ = (__uint32_t)pSource[0];
-            *pDest++ = pSource[3];
-            pSource += 4;
-        
-            assert(pSource <= m_pData->getEnd());
-      }
-    }
-    break;
-    default:
-      m_pData->unlock();
-      return false; // 16-bit images not yet supported
+    if ((size_t)(pDataEnd - pData) < pixel_count * source_pixel_size) {
+      success = false; // Truncated image
+    } else if (source_pixel_size == 4) {
+      ConvertBGRAToRGBA(pData, converted_image, pixel_count);
+    } else {
+      ConvertBGRToRGBA(pData, converted_image, pixel_count);
     }
     break;
   case 10: // rgb + rle
-    switch (pHeader->bitsperpixel) {
-    case 32:
-    {
-      unsigned char* pSource = pData;
-      unsigned char* pDest = converted_image;
-      unsigned char* pEnd = converted_image + pHeader->height * pHeader->width * 4;
-      
-      while (pDest < pEnd) {
-        int count = (*pSource & 0x7f) + 1;
-        if (*pSource & 0x80) {
-          // RLE Packet
-          pSource++;
-          while (count--) {
-            *pDest++ = pSource[2];
-            *pDest++ = pSource[1];
-            *pDest++ = pSource[0];
-            *pDest++ = pSource[3];
-          }
-          pSource += 4;
-        } else {
-          // RAW Packet
-          pSource++;
-          while (count--) {
-            *pDest++ = pSource[2];
-            *pDest++ = pSource[1];
-            *pDest++ = pSource[0];
-            *pDest++ = pSource[3];
-            pSource += 4;
-          }
-        }
-      }
-      assert(pSource <= m_pData->getEnd());
-      assert(pDest == pEnd);
-    }
-    break;
-    case 24:
-    {
-      unsigned char* pSource = pData;
-      unsigned char* pDest = converted_image;
-      unsigned char* pEnd = converted_image + pHeader->height * pHeader->width * 4;
-      while (pDest < pEnd) {
-        int count = (*pSource & 0x7f) + 1;
-        if (*pSource & 0x80) {
-          // RLE Packet
-          pSource++;
-          while (count--) {
-            *pDest++ = pSource[2];
-            *pDest++ = pSource[1];
-            *pDest++ = pSource[0];
-            *pDest++ = 0xff;
-          }
-          pSource += 3;
-        } else {
-          // RAW Packet
-          pSource++;
-          while (count--) {
-            *pDest++ = pSource[2];
-            *pDest++ = pSource[1];
-            *pDest++ = pSource[0];
-            *pDest++ = 0xff;
-            pSource += 3;
-          }
-        }
-      }
-      assert(pSource <= m_pData->getEnd());
-      assert(pDest == pEnd);
-    }
-    break;
-    default:
-      m_pData->unlock();
-      return false; // 16-bit images not yet supported
-    }
+    success = DecodeRLE(pData, pDataEnd, converted_image, pixel_count, source_pixel_size);
     break;
   default:
-    m_pData->unlock();
-    return false; // Image type not yet supported
-  }
-
-  m_pData->unlock();
-  return true;
-}
-
-#if !TARGET_OS_IPHONE && !defined(ANDROID)
-
-KRTexture* KRTextureTGA::compress(bool premultiply_alpha)
-{
-  //  TODO - Vulkan refactoring...
-  assert(false);
-  return nullptr;
-  /*
-   * TODO - Vulkan refactoring...
-
-  m_pData->lock();
-
-  std::list<Block *> blocks;
-
-  getContext().getTextureManager()->_setActiveTexture(0);
-
-  int compressed_handle = 0;
-  GLDEBUG(glGenTextures(1, &compressed_handle));
-
-  GLDEBUG(glBindTexture(GL_TEXTURE_2D, compressed_handle));
-
-  int current_max_dim = 0;
-  if(!uploadTexture(m_max_lod_max_dim, current_max_dim, premultiply_alpha)) {
-      assert(false); // Failed to upload the texture
-  }
-  GLDEBUG(glGenerateMipmap(GL_TEXTURE_2D));
-
-  GLint width = 0, height = 0, internal_format, base_internal_format;
-
-
-  GLDEBUG(glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width));
-  GLDEBUG(glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height));
-  GLDEBUG(glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &internal_format));
-
-  switch(internal_format)
-  {
-      case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
-          base_internal_format = GL_BGRA;
-          break;
-      case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
-          base_internal_format = GL_BGRA;
-          break;
-      default:
-          assert(false); // Not yet supported
-          break;
-  }
-
-  int lod_level = 0;
-  GLint compressed_size = 0;
-  int lod_width = width;
-  while(lod_width > 1) {
-      GLDEBUG(glGetTexLevelParameteriv(GL_TEXTURE_2D, lod_level, GL_TEXTURE_WIDTH, &lod_width));
-      GLDEBUG(glGetTexLevelParameteriv(GL_TEXTURE_2D, lod_level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &compressed_size));
-      Block *new_block = new Block();
-      new_block->expand(compressed_size);
-      new_block->lock();
-      GLDEBUG(glGetCompressedTexImage(GL_TEXTURE_2D, lod_level, new_block->getStart()));
-      new_block->unlock();
-      blocks.push_back(new_block);
-
-      lod_level++;
+    success = false; // Image type not yet supported
+    break;
   }
-  assert(lod_width == 1);
-
-  GLDEBUG(glBindTexture(GL_TEXTURE_2D, 0));
-  getContext().getTextureManager()->selectTexture(0, NULL, 0.0f, KRTexture::TEXTURE_USAGE_NONE);
-  GLDEBUG(glDeleteTextures(1, &compressed_handle));
-
-  KRTextureKTX *new_texture = new KRTextureKTX(getContext(), getName(), internal_format, base_internal_format, width, height, blocks);
 
   m_pData->unlock();
-
-  for(auto block_itr = blocks.begin(); block_itr != blocks.end(); block_itr++) {
-      Block *block = *block_itr;
-      delete block;
-  }
-
-  return new_texture;
-  */
+  return success;
 }
-#endif
 
 long KRTextureTGA::getMemRequiredForLod(int lod)
 {
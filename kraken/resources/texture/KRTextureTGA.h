@@ -44,10 +44,6 @@ public:
 
   bool getLodData(void* buffer, int lod) override;
 
-#if !TARGET_OS_IPHONE && !defined(ANDROID)
-  virtual KRTexture* compress(bool premultiply_alpha = false) override;
-#endif
-
   virtual long getMemRequiredForLod(int lod) override;
   virtual hydra::Vector3i getDimensions() const override;
   virtual VkFormat getFormat() const override;
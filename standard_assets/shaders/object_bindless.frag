@@ -0,0 +1,99 @@
+//
+//  object_bindless.frag
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+// Textures are sampled from the bindless texture table, at the slots held in
+// the material's record.  A slot of -1 marks a map that is unbound or not yet
+// streamed in, which is drawn with its factor alone.
+
+// Matches KRMaterialManager::MaterialRecord
+struct Material
+{
+  vec4 baseColorFactor;
+  vec3 emissiveFactor;
+  float normalScale;
+  float metalicFactor;
+  float roughnessFactor;
+  float occlusionStrength;
+  float alphaCutoff;
+  // Scale in xy and offset in zw, for each map
+  vec4 baseColorTransform;
+  vec4 normalTransform;
+  vec4 emissiveTransform;
+  vec4 occlusionTransform;
+  vec4 metalicRoughnessTransform;
+  int baseColorTexture;
+  int normalTexture;
+  int emissiveTexture;
+  int occlusionTexture;
+  int metalicRoughnessTexture;
+  int alphaMode;
+};
+
+layout(set = 1, binding = 0) uniform sampler2D textures[];
+
+layout(std430, set = 2, binding = 0) readonly buffer Materials
+{
+  Material materials[];
+};
+
+layout(location = 0) in vec2 texcoord;
+layout(location = 1) flat in int material_index;
+
+layout(location = 0) out vec4 colorOut;
+
+// Every fragment of a draw takes the same branch, as the slot is per material
+vec4 sampleMap(int slot, vec4 transform, vec4 unbound)
+{
+  if (slot < 0) {
+    return unbound;
+  }
+  return texture(textures[nonuniformEXT(slot)], texcoord * transform.xy + transform.zw);
+}
+
+void main()
+{
+  Material material = materials[material_index];
+
+  vec4 baseColor = material.baseColorFactor * sampleMap(material.baseColorTexture, material.baseColorTransform, vec4(1.0));
+  // KRMATERIAL_ALPHA_MODE_TEST
+  if (material.alphaMode == 1 && baseColor.a < material.alphaCutoff) {
+    discard;
+  }
+
+  float occlusion = 1.0 + material.occlusionStrength * (sampleMap(material.occlusionTexture, material.occlusionTransform, vec4(1.0)).r - 1.0);
+  vec3 emissive = material.emissiveFactor * sampleMap(material.emissiveTexture, material.emissiveTransform, vec4(1.0)).rgb;
+
+  colorOut = vec4(baseColor.rgb * occlusion + emissive, baseColor.a);
+}
@@ -0,0 +1,63 @@
+//
+//  object_virtual.vert
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+
+#version 450
+
+// Draws a material whose base color map is a virtual texture, with per-draw
+// descriptors for the map and its residency or indirection image.
+
+layout(location = 0) in vec3 vertex_position;
+layout(location = 1) in vec2 vertex_uv;
+
+layout(push_constant) uniform PushConstants
+{
+  mat4 mvp_matrix; // mvp_matrix is the result of multiplying the model, view, and projection matrices
+  vec4 material_baseColor_factor;
+  vec2 material_baseColor_map_scale;
+  vec2 material_baseColor_map_offset;
+  vec2 material_baseColor_map_dimensions;
+  int material_baseColor_map_cached;
+} constants;
+
+layout(location = 0) out vec2 texcoord;
+layout(location = 1) flat out vec4 baseColorFactor;
+layout(location = 2) flat out vec2 dimensions;
+layout(location = 3) flat out int cached;
+
+void main()
+{
+  gl_Position = constants.mvp_matrix * vec4(vertex_position, 1.0);
+  texcoord = vertex_uv * constants.material_baseColor_map_scale + constants.material_baseColor_map_offset;
+  baseColorFactor = constants.material_baseColor_factor;
+  dimensions = constants.material_baseColor_map_dimensions;
+  cached = constants.material_baseColor_map_cached;
+}
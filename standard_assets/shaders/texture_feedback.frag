@@ -0,0 +1,89 @@
+//
+//  texture_feedback.frag
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+
+#version 450
+
+layout(location = 0) in vec2 baseColor_texel;
+layout(location = 1) in vec2 normal_texel;
+layout(location = 2) flat in ivec2 feedback_slot;
+layout(location = 3) flat in ivec2 feedback_regions;
+layout(location = 4) flat in vec4 texel_dimensions;
+
+// One entry per feedback slot, reset to 0xffffffff by the CPU after each read
+layout(std430, binding = 0) buffer TextureFeedback
+{
+  uint min_lod[];
+} feedback;
+
+layout(location = 0) out vec4 colorOut;
+
+float mipLevel(vec2 texel)
+{
+  vec2 dx = dFdx(texel);
+  vec2 dy = dFdy(texel);
+  return 0.5 * log2(max(dot(dx, dx), dot(dy, dy)));
+}
+
+void recordMip(int slot, uint mip)
+{
+  // Skip the atomic when a finer level has already been recorded
+  if (mip < feedback.min_lod[slot]) {
+    atomicMin(feedback.min_lod[slot], mip);
+  }
+}
+
+void recordLevel(int slot, float level, int regions, vec2 texel, vec2 dimensions)
+{
+  if (slot >= 0) {
+    uint mip = uint(max(level, 0.0));
+    recordMip(slot, mip);
+    // Virtual textures follow their slot with a slot for each region of a
+    // regions x regions grid, wrapped as tiled texture coordinates are
+    if (regions > 0) {
+      ivec2 region = clamp(ivec2(fract(texel / max(dimensions, vec2(1.0))) * float(regions)), ivec2(0), ivec2(regions - 1));
+      recordMip(slot + 1 + region.y * regions + region.x, mip);
+    }
+  }
+}
+
+void main()
+{
+  // Derivatives must be evaluated in uniform control flow
+  float baseColorLevel = mipLevel(baseColor_texel);
+  float normalLevel = mipLevel(normal_texel);
+
+  recordLevel(feedback_slot.x, baseColorLevel, feedback_regions.x, baseColor_texel, texel_dimensions.xy);
+  recordLevel(feedback_slot.y, normalLevel, feedback_regions.y, normal_texel, texel_dimensions.zw);
+
+  // Color writes are masked for this pass
+  colorOut = vec4(0.0);
+}
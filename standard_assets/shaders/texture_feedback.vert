@@ -0,0 +1,71 @@
+//
+//  texture_feedback.vert
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+
+#version 450
+
+// Records the finest mip level sampled from each material texture.
+// Texture coordinates are scaled to texels so that the fragment shader
+// can estimate the level from their screen space derivatives.
+
+layout(location = 0) in vec3 vertex_position;
+layout(location = 1) in vec2 vertex_uv;
+
+layout(push_constant) uniform PushConstants
+{
+  mat4 mvp_matrix; // mvp_matrix is the result of multiplying the model, view, and projection matrices
+  vec2 material_baseColor_map_scale;
+  vec2 material_baseColor_map_offset;
+  vec2 material_baseColor_map_dimensions;
+  vec2 material_normal_map_scale;
+  vec2 material_normal_map_offset;
+  vec2 material_normal_map_dimensions;
+  int material_baseColor_map_feedback;
+  int material_normal_map_feedback;
+  int material_baseColor_map_regions;
+  int material_normal_map_regions;
+} constants;
+
+layout(location = 0) out vec2 baseColor_texel;
+layout(location = 1) out vec2 normal_texel;
+layout(location = 2) flat out ivec2 feedback_slot;
+layout(location = 3) flat out ivec2 feedback_regions;
+layout(location = 4) flat out vec4 texel_dimensions;
+
+void main()
+{
+  gl_Position = constants.mvp_matrix * vec4(vertex_position, 1.0);
+  baseColor_texel = (vertex_uv * constants.material_baseColor_map_scale + constants.material_baseColor_map_offset) * constants.material_baseColor_map_dimensions;
+  normal_texel = (vertex_uv * constants.material_normal_map_scale + constants.material_normal_map_offset) * constants.material_normal_map_dimensions;
+  feedback_slot = ivec2(constants.material_baseColor_map_feedback, constants.material_normal_map_feedback);
+  feedback_regions = ivec2(constants.material_baseColor_map_regions, constants.material_normal_map_regions);
+  texel_dimensions = vec4(constants.material_baseColor_map_dimensions, constants.material_normal_map_dimensions);
+}
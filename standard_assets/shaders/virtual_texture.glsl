@@ -0,0 +1,73 @@
+//
+//  virtual_texture.glsl
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+// Samples a virtual texture, whose pages are resident only where the texture
+// feedback pass has seen them sampled.  Declare its residency image as a
+// sampler named "<map>_residency", next to the sampler of the map itself.
+// Each residency texel holds the finest level resident in one page of the
+// first level, so sampling is clamped to levels that are bound.
+vec4 textureVirtual(sampler2D tex, sampler2D residency, vec2 uv)
+{
+  ivec2 size = textureSize(residency, 0);
+  ivec2 page = clamp(ivec2(fract(uv) * vec2(size)), ivec2(0), size - 1);
+  float minLod = texelFetch(residency, page, 0).r * 255.0;
+  return textureLod(tex, uv, max(textureQueryLod(tex, uv).y, minLod));
+}
+
+// Must match the KRENGINE_VIRTUAL_TEXTURE_CACHE_* constants of KRTexture2D
+const float VIRTUAL_CACHE_PAGE_SIZE = 128.0;
+const float VIRTUAL_CACHE_BORDER = 4.0;
+
+// Samples a virtual texture on a device without sparse residency, whose
+// resident pages are copied into the slots of a cache image.  Declare its
+// indirection image as a sampler named "<map>_residency".  Each level of the
+// indirection image has a texel for each page of the same level of the
+// texture, holding the slot and level of the finest page resident there.
+// Pages are filtered within their level only, using the border of their slot.
+vec4 textureVirtualCache(sampler2D cache, sampler2D indirection, vec2 uv, vec2 dimensions)
+{
+  vec2 texel = uv * dimensions;
+  vec2 dx = dFdx(texel);
+  vec2 dy = dFdy(texel);
+  float lod = 0.5 * log2(max(max(dot(dx, dx), dot(dy, dy)), 1.0));
+  int level = min(int(lod), textureQueryLevels(indirection) - 1);
+
+  vec2 wrapped = fract(uv);
+  ivec2 size = textureSize(indirection, level);
+  vec4 entry = texelFetch(indirection, clamp(ivec2(wrapped * vec2(size)), ivec2(0), size - 1), level);
+  vec2 slot = floor(entry.xy * 255.0 + 0.5);
+  float residentLevel = floor(entry.z * 255.0 + 0.5);
+
+  vec2 levelTexel = wrapped * max(floor(dimensions / exp2(residentLevel)), vec2(1.0));
+  vec2 pageTexel = levelTexel - floor(levelTexel / VIRTUAL_CACHE_PAGE_SIZE) * VIRTUAL_CACHE_PAGE_SIZE;
+  vec2 cacheTexel = slot * (VIRTUAL_CACHE_PAGE_SIZE + 2.0 * VIRTUAL_CACHE_BORDER) + VIRTUAL_CACHE_BORDER + pageTexel;
+  return textureLod(cache, cacheTexel / vec2(textureSize(cache, 0)), 0.0);
+}
@@ -0,0 +1,102 @@
+//
+//  harness.cpp
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+#include "KREngine-common.h"
+#include "KRContext.h"
+
+#include "harness.h"
+
+namespace {
+
+struct Test
+{
+  const char* name;
+  TestFunction function;
+};
+
+std::vector<Test>& Tests()
+{
+  static std::vector<Test> tests;
+  return tests;
+}
+
+KRContext* g_context = nullptr;
+int g_failures = 0;
+
+} // anonymous namespace
+
+TestRegistration::TestRegistration(const char* name, TestFunction function)
+{
+  Tests().push_back(Test{ name, function });
+}
+
+void test_check(bool passed, const char* expression, const char* file, int line)
+{
+  if (!passed) {
+    fprintf(stderr, "%s:%i: check failed: %s\n", file, line, expression);
+    g_failures++;
+  }
+}
+
+KRContext& test_context()
+{
+  if (g_context == nullptr) {
+    KrInitializeInfo init_info = {};
+    init_info.sType = KR_STRUCTURE_TYPE_INITIALIZE;
+    init_info.resourceMapSize = 1024;
+    init_info.nodeMapSize = 1024;
+    g_context = new KRContext(&init_info);
+  }
+  return *g_context;
+}
+
+int main(int argc, char** argv)
+{
+  int failed_tests = 0;
+  for (const Test& test : Tests()) {
+    int failures = g_failures;
+    test.function();
+    if (g_failures != failures) {
+      fprintf(stderr, "FAILED: %s\n", test.name);
+      failed_tests++;
+    } else {
+      printf("passed: %s\n", test.name);
+    }
+  }
+
+  if (g_context) {
+    delete g_context;
+    g_context = nullptr;
+  }
+
+  printf("%i of %i tests passed\n", (int)Tests().size() - failed_tests, (int)Tests().size());
+  return failed_tests == 0 ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+//
+//  test_animation_curve.cpp
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+#include "KREngine-common.h"
+#include "KRContext.h"
+#include "resources/animation_curve/KRAnimationCurve.h"
+
+#include "harness.h"
+
+using namespace mimir;
+
+namespace {
+
+const int kFrameCount = 600;
+const float kTolerance = 0.001f;
+
+// A curve with the shapes FitKeys has to handle: a smooth section, a held
+// value, a linear ramp and a discontinuity.
+float CurveValue(int frame)
+{
+  if (frame < 200) {
+    return sinf((float)frame * 0.05f) * 3.0f;
+  } else if (frame < 300) {
+    return 1.5f;
+  } else if (frame < 450) {
+    return 1.5f + (float)(frame - 300) * 0.02f;
+  }
+  return -4.0f + cosf((float)frame * 0.01f);
+}
+
+KRAnimationCurve* CreateCurve(const char* name)
+{
+  KRAnimationCurve* curve = new KRAnimationCurve(test_context(), name);
+  curve->setFrameCount(kFrameCount);
+  for (int frame = 0; frame < kFrameCount; frame++) {
+    curve->setValue(frame, CurveValue(frame));
+  }
+  return curve;
+}
+
+bool WithinTolerance(KRAnimationCurve& curve, float tolerance)
+{
+  for (int frame = 0; frame < kFrameCount; frame++) {
+    if (fabsf(curve.getValue(frame) - CurveValue(frame)) > tolerance) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+KR_TEST(animation_curve_compress_within_tolerance)
+{
+  KRAnimationCurve* curve = CreateCurve("compress");
+  KR_CHECK(curve->compress(kTolerance));
+  KR_CHECK(curve->isCompressed());
+  KR_CHECK(WithinTolerance(*curve, kTolerance));
+  delete curve;
+}
+
+KR_TEST(animation_curve_compressed_save_load)
+{
+  KRAnimationCurve* curve = CreateCurve("save");
+  KR_CHECK(curve->compress(kTolerance));
+
+  Block* data = new Block();
+  KR_CHECK(curve->save(*data));
+  delete curve;
+
+  KRAnimationCurve* loaded = KRAnimationCurve::Load(test_context(), "save", data);
+  KR_CHECK(loaded != nullptr);
+  if (loaded) {
+    KR_CHECK(loaded->isCompressed());
+    KR_CHECK(loaded->getFrameCount() == kFrameCount);
+    KR_CHECK(WithinTolerance(*loaded, kTolerance));
+    delete loaded;
+  }
+}
+
+KR_TEST(animation_curve_decompress)
+{
+  KRAnimationCurve* curve = CreateCurve("decompress");
+  KR_CHECK(curve->compress(kTolerance));
+  KR_CHECK(curve->decompress());
+  KR_CHECK(!curve->isCompressed());
+  KR_CHECK(WithinTolerance(*curve, kTolerance));
+
+  // Modifying a value of a compressed curve decompresses it first
+  KR_CHECK(curve->compress(kTolerance));
+  KR_CHECK(curve->setValue(10, 100.0f));
+  KR_CHECK(!curve->isCompressed());
+  KR_CHECK(curve->getValue(10) == 100.0f);
+  delete curve;
+}
+
+KR_TEST(animation_curve_incompressible_stays_dense)
+{
+  // Values that alternate every frame need a key per frame, which is larger
+  // than the dense representation.
+  KRAnimationCurve* curve = new KRAnimationCurve(test_context(), "noise");
+  curve->setFrameCount(kFrameCount);
+  for (int frame = 0; frame < kFrameCount; frame++) {
+    curve->setValue(frame, (frame & 1) ? 1.0f : -1.0f);
+  }
+  KR_CHECK(curve->compress(kTolerance));
+  KR_CHECK(!curve->isCompressed());
+  for (int frame = 0; frame < kFrameCount; frame++) {
+    KR_CHECK(curve->getValue(frame) == ((frame & 1) ? 1.0f : -1.0f));
+  }
+  delete curve;
+}
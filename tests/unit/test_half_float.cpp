@@ -0,0 +1,136 @@
+//
+//  test_half_float.cpp
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+#include "KREngine-common.h"
+#include "KRHelpers.h"
+
+#include "harness.h"
+
+using namespace kraken;
+
+namespace {
+
+bool IsHalfNaN(uint16_t half)
+{
+  return (half & 0x7c00) == 0x7c00 && (half & 0x03ff) != 0;
+}
+
+float FloatFromBits(uint32_t bits)
+{
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+} // anonymous namespace
+
+KR_TEST(half_round_trip)
+{
+  // Every half converts to a float and back without change
+  bool exact = true;
+  bool nan = true;
+  for (uint32_t half = 0; half <= 0xffff; half++) {
+    uint16_t result = FloatToHalf(HalfToFloat((uint16_t)half));
+    if (IsHalfNaN((uint16_t)half)) {
+      nan = nan && IsHalfNaN(result) && (result & 0x8000) == (half & 0x8000);
+    } else {
+      exact = exact && result == half;
+    }
+  }
+  KR_CHECK(exact);
+  KR_CHECK(nan);
+}
+
+KR_TEST(half_round_to_nearest_even)
+{
+  // Values between each pair of adjacent finite halves round to the nearer,
+  // and halfway values round to the one with an even mantissa.
+  bool nearest = true;
+  bool even = true;
+  for (uint32_t sign = 0; sign <= 0x8000; sign += 0x8000) {
+    for (uint32_t half = 0; half < 0x7bff; half++) {
+      uint16_t lower = (uint16_t)(sign | half);
+      uint16_t upper = (uint16_t)(sign | (half + 1));
+      // Adjacent halves differ by at most 12 significant bits, so the
+      // midpoint is exact in single precision
+      float midpoint = (float)(((double)HalfToFloat(lower) + (double)HalfToFloat(upper)) * 0.5);
+      float away = sign ? -INFINITY : INFINITY;
+      nearest = nearest && FloatToHalf(nextafterf(midpoint, 0.0f)) == lower;
+      nearest = nearest && FloatToHalf(nextafterf(midpoint, away)) == upper;
+      even = even && FloatToHalf(midpoint) == ((half & 1) ? upper : lower);
+    }
+  }
+  KR_CHECK(nearest);
+  KR_CHECK(even);
+}
+
+KR_TEST(half_overflow)
+{
+  KR_CHECK(FloatToHalf(65504.0f) == 0x7bff);
+  // Just below the midpoint between the largest half and the next power of two
+  KR_CHECK(FloatToHalf(nextafterf(65520.0f, 0.0f)) == 0x7bff);
+  KR_CHECK(FloatToHalf(65520.0f) == 0x7c00);
+  KR_CHECK(FloatToHalf(1.0e10f) == 0x7c00);
+  KR_CHECK(FloatToHalf(-1.0e10f) == 0xfc00);
+  KR_CHECK(FloatToHalf(INFINITY) == 0x7c00);
+  KR_CHECK(FloatToHalf(-INFINITY) == 0xfc00);
+  KR_CHECK(FloatToHalf(std::numeric_limits<float>::max()) == 0x7c00);
+}
+
+KR_TEST(half_nan)
+{
+  KR_CHECK(IsHalfNaN(FloatToHalf(NAN)));
+  KR_CHECK(IsHalfNaN(FloatToHalf(-NAN)));
+  // NaN payloads in the low bits of the float mantissa must not become infinity
+  KR_CHECK(IsHalfNaN(FloatToHalf(FloatFromBits(0x7f800001))));
+  KR_CHECK(std::isnan(HalfToFloat(0x7e00)));
+}
+
+KR_TEST(half_subnormal_and_underflow)
+{
+  const float kSmallestSubnormal = 5.9604644775390625e-8f; // 2^-24
+  KR_CHECK(FloatToHalf(kSmallestSubnormal) == 0x0001);
+  KR_CHECK(FloatToHalf(-kSmallestSubnormal) == 0x8001);
+  KR_CHECK(HalfToFloat(0x0001) == kSmallestSubnormal);
+  KR_CHECK(HalfToFloat(0x03ff) == kSmallestSubnormal * 1023.0f);
+  // The largest subnormal rounds up into the smallest normal
+  KR_CHECK(FloatToHalf(nextafterf(6.103515625e-5f, 0.0f)) == 0x0400);
+
+  // Half of the smallest subnormal is a tie, and rounds to even zero
+  KR_CHECK(FloatToHalf(kSmallestSubnormal * 0.5f) == 0x0000);
+  KR_CHECK(FloatToHalf(nextafterf(kSmallestSubnormal * 0.5f, 1.0f)) == 0x0001);
+  // Smaller values flush to zero, keeping their sign
+  KR_CHECK(FloatToHalf(kSmallestSubnormal * 0.25f) == 0x0000);
+  KR_CHECK(FloatToHalf(-kSmallestSubnormal * 0.25f) == 0x8000);
+  KR_CHECK(FloatToHalf(std::numeric_limits<float>::min()) == 0x0000);
+  KR_CHECK(FloatToHalf(FloatFromBits(0x00000001)) == 0x0000);
+  KR_CHECK(FloatToHalf(-0.0f) == 0x8000);
+}
@@ -0,0 +1,232 @@
+//
+//  test_mesh_indexing.cpp
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+#include "KREngine-common.h"
+#include "KRContext.h"
+#include "resources/mesh/KRMesh.h"
+
+#include "harness.h"
+
+using namespace hydra;
+
+namespace {
+
+typedef struct
+{
+  Vector3 position;
+  Vector3 normal;
+  Vector2 uv;
+} Vertex;
+
+// Triangles keyed by their vertex positions, rotated so that the smallest
+// position comes first.  Indexing and vertex cache optimization may reorder
+// triangles and rotate their vertices, but must not change their winding.
+typedef std::map<std::array<float, 9>, std::array<Vertex, 3>> TriangleSet;
+
+bool PositionLess(const Vector3& a, const Vector3& b)
+{
+  if (a.x != b.x) return a.x < b.x;
+  if (a.y != b.y) return a.y < b.y;
+  return a.z < b.z;
+}
+
+bool AddTriangle(TriangleSet& triangles, const Vertex (&vertices)[3])
+{
+  int first = 0;
+  for (int i = 1; i < 3; i++) {
+    if (PositionLess(vertices[i].position, vertices[first].position)) {
+      first = i;
+    }
+  }
+  std::array<float, 9> key;
+  std::array<Vertex, 3> triangle;
+  for (int i = 0; i < 3; i++) {
+    const Vertex& v = vertices[(first + i) % 3];
+    key[i * 3] = v.position.x;
+    key[i * 3 + 1] = v.position.y;
+    key[i * 3 + 2] = v.position.z;
+    triangle[i] = v;
+  }
+  return triangles.insert(std::make_pair(key, triangle)).second;
+}
+
+Vector3 GridNormal(int x, int y, int size)
+{
+  Vector3 n = Vector3::Create((float)(x - size / 2), (float)(y - size / 2), (float)size);
+  float length = sqrtf(n.x * n.x + n.y * n.y + n.z * n.z);
+  return Vector3::Create(n.x / length, n.y / length, n.z / length);
+}
+
+// Appends a submesh with a grid of size x size quads as unindexed triangles.
+// Vertices on seam_column have different texture coordinates on either side
+// of the seam, so they must not be welded.
+void AppendGrid(KRMesh::mesh_info& mi, TriangleSet& triangles, int size, float z, int seam_column)
+{
+  mi.submesh_starts.push_back((int)mi.vertices.size());
+  mi.material_names.push_back("grid");
+  const int corners[6][2] = { {0, 0}, {1, 0}, {1, 1}, {0, 0}, {1, 1}, {0, 1} };
+  for (int y = 0; y < size; y++) {
+    for (int x = 0; x < size; x++) {
+      for (int t = 0; t < 2; t++) {
+        Vertex triangle[3];
+        for (int i = 0; i < 3; i++) {
+          int cx = x + corners[t * 3 + i][0];
+          int cy = y + corners[t * 3 + i][1];
+          Vertex& v = triangle[i];
+          v.position = Vector3::Create((float)cx, (float)cy, z);
+          v.normal = GridNormal(cx, cy, size);
+          v.uv = Vector2::Create((float)cx / (float)size * 0.5f, (float)cy / (float)size);
+          if (cx == seam_column && x >= seam_column) {
+            v.uv.x += 0.25f;
+          }
+          mi.vertices.push_back(v.position);
+          mi.normals.push_back(v.normal);
+          mi.uva.push_back(v.uv);
+        }
+        AddTriangle(triangles, triangle);
+      }
+    }
+  }
+  mi.submesh_lengths.push_back((int)mi.vertices.size() - mi.submesh_starts.back());
+}
+
+void ReadTriangles(KRMesh& mesh, int submesh, TriangleSet& triangles, std::set<int>& vertex_indexes)
+{
+  mesh._lockData();
+  int vertex_count = mesh.getVertexCount(submesh);
+  for (int i = 0; i + 2 < vertex_count; i += 3) {
+    Vertex triangle[3];
+    for (int k = 0; k < 3; k++) {
+      int index = mesh.getTriangleVertexIndex(submesh, i + k);
+      vertex_indexes.insert(index);
+      triangle[k].position = mesh.getVertexPosition(index);
+      triangle[k].normal = mesh.getVertexNormal(index);
+      triangle[k].uv = mesh.getVertexUVA(index);
+    }
+    KR_CHECK(AddTriangle(triangles, triangle));
+  }
+  mesh._unlockData();
+}
+
+// Normals and texture coordinates are stored as 16-bit snorm values
+bool Near(float a, float b)
+{
+  return fabsf(a - b) <= 1.0e-4f;
+}
+
+bool SameTriangles(const TriangleSet& expected, const TriangleSet& actual)
+{
+  if (expected.size() != actual.size()) {
+    return false;
+  }
+  for (const auto& triangle : expected) {
+    auto match = actual.find(triangle.first);
+    if (match == actual.end()) {
+      return false;
+    }
+    for (int i = 0; i < 3; i++) {
+      const Vertex& a = triangle.second[i];
+      const Vertex& b = match->second[i];
+      if (!Near(a.normal.x, b.normal.x) || !Near(a.normal.y, b.normal.y) || !Near(a.normal.z, b.normal.z)
+        || !Near(a.uv.x, b.uv.x) || !Near(a.uv.y, b.uv.y)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+KR_TEST(mesh_convert_to_indexed_preserves_triangles)
+{
+  const int kGridSize = 24;
+  const int kSeamColumn = 10;
+
+  KRMesh::mesh_info mi;
+  mi.format = ModelFormat::KRENGINE_MODEL_FORMAT_TRIANGLES;
+  std::vector<TriangleSet> expected(2);
+  AppendGrid(mi, expected[0], kGridSize, 0.0f, -1);
+  AppendGrid(mi, expected[1], kGridSize, 1.0f, kSeamColumn);
+
+  // Unindexed triangles are converted to indexed triangles when loaded
+  KRMesh* mesh = new KRMesh(test_context(), "indexing");
+  mesh->LoadData(mi, false, false);
+  KR_CHECK(mesh->getModelFormat() == ModelFormat::KRENGINE_MODEL_FORMAT_INDEXED_TRIANGLES);
+  KR_CHECK(mesh->getSubmeshCount() == 2);
+
+  const int grid_vertices = (kGridSize + 1) * (kGridSize + 1);
+  const int welded_counts[2] = { grid_vertices, grid_vertices + kGridSize + 1 };
+  for (int submesh = 0; submesh < 2 && submesh < mesh->getSubmeshCount(); submesh++) {
+    KR_CHECK(mesh->getVertexCount(submesh) == mi.submesh_lengths[submesh]);
+    TriangleSet triangles;
+    std::set<int> vertex_indexes;
+    ReadTriangles(*mesh, submesh, triangles, vertex_indexes);
+    KR_CHECK(SameTriangles(expected[submesh], triangles));
+    KR_CHECK((int)vertex_indexes.size() == welded_counts[submesh]);
+  }
+  delete mesh;
+}
+
+KR_TEST(mesh_32bit_indexes_round_trip)
+{
+  // A single submesh with more than 0xffff distinct vertices needs 32-bit indexes
+  const int kGridSize = 260;
+
+  KRMesh::mesh_info mi;
+  mi.format = ModelFormat::KRENGINE_MODEL_FORMAT_TRIANGLES;
+  TriangleSet expected;
+  AppendGrid(mi, expected, kGridSize, 0.0f, -1);
+
+  KRMesh* mesh = new KRMesh(test_context(), "indexes32");
+  mesh->LoadData(mi, false, false);
+  KR_CHECK(mesh->getModelFormat() == ModelFormat::KRENGINE_MODEL_FORMAT_INDEXED_TRIANGLES);
+
+  TriangleSet triangles;
+  std::set<int> vertex_indexes;
+  ReadTriangles(*mesh, 0, triangles, vertex_indexes);
+  KR_CHECK(SameTriangles(expected, triangles));
+  KR_CHECK((int)vertex_indexes.size() == (kGridSize + 1) * (kGridSize + 1));
+  KR_CHECK(!vertex_indexes.empty() && *vertex_indexes.rbegin() > 0xffff);
+
+  mimir::Block* data = new mimir::Block();
+  KR_CHECK(mesh->save(*data));
+  delete mesh;
+
+  KRMesh* loaded = new KRMesh(test_context(), "indexes32", data);
+  KR_CHECK(loaded->getSubmeshCount() == 1);
+  TriangleSet loaded_triangles;
+  std::set<int> loaded_vertex_indexes;
+  ReadTriangles(*loaded, 0, loaded_triangles, loaded_vertex_indexes);
+  KR_CHECK(SameTriangles(expected, loaded_triangles));
+  KR_CHECK(loaded_vertex_indexes == vertex_indexes);
+  delete loaded;
+}
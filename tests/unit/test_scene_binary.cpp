@@ -0,0 +1,136 @@
+//
+//  test_scene_binary.cpp
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+#include "KREngine-common.h"
+#include "KRContext.h"
+#include "resources/scene/KRScene.h"
+#include "resources/scene/KRSceneBinary.h"
+#include "nodes/KRNode.h"
+#include "nodes/KRPointLight.h"
+
+#include "harness.h"
+
+using namespace mimir;
+using namespace hydra;
+
+namespace {
+
+KRScene* CreateTestScene()
+{
+  KRScene* scene = new KRScene(test_context(), "binary_test");
+  scene->setBinaryFormat(true);
+
+  KRNode* parent = new KRNode(*scene, "parent");
+  parent->setLocalTranslation(Vector3::Create(1.0f, -2.5f, 1.0e6f));
+  parent->setLocalScale(Vector3::Create(0.5f, 2.0f, 3.0f));
+  scene->getRootNode()->appendChild(parent);
+
+  KRPointLight* light = new KRPointLight(*scene, "light");
+  light->setIntensity(42.0f);
+  light->setColor(Vector3::Create(0.25f, 0.5f, 1.0f));
+  light->setLocalRotation(Vector3::Create(0.1f, 0.2f, 0.3f));
+  parent->appendChild(light);
+
+  return scene;
+}
+
+Block* SaveScene(KRScene& scene)
+{
+  Block* data = new Block();
+  KR_CHECK(scene.save(*data));
+  return data;
+}
+
+bool Equal(const Vector3& a, const Vector3& b)
+{
+  return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+} // anonymous namespace
+
+KR_TEST(scene_binary_round_trip)
+{
+  KRScene* scene = CreateTestScene();
+  Block* data = SaveScene(*scene);
+
+  KRScene* loaded = KRScene::Load(test_context(), "binary_test", data);
+  KR_CHECK(loaded != nullptr);
+  if (loaded) {
+    KRNode* parent = loaded->find<KRNode>("parent");
+    KRPointLight* light = loaded->find<KRPointLight>("light");
+    KR_CHECK(parent != nullptr);
+    KR_CHECK(light != nullptr);
+    if (parent && light) {
+      KR_CHECK(light->getParent() == parent);
+      KR_CHECK(Equal(parent->getLocalTranslation(), Vector3::Create(1.0f, -2.5f, 1.0e6f)));
+      KR_CHECK(Equal(parent->getLocalScale(), Vector3::Create(0.5f, 2.0f, 3.0f)));
+      KR_CHECK(Equal(light->getLocalRotation(), Vector3::Create(0.1f, 0.2f, 0.3f)));
+      KR_CHECK(Equal(light->getColor(), Vector3::Create(0.25f, 0.5f, 1.0f)));
+      KR_CHECK(light->getIntensity() == 42.0f);
+    }
+    delete loaded;
+  }
+  delete scene;
+}
+
+KR_TEST(scene_binary_rejects_truncated_file)
+{
+  KRScene* scene = CreateTestScene();
+  Block* data = SaveScene(*scene);
+  delete scene;
+
+  // Dropping the terminator of the string table must fail validation
+  // rather than reading past the end of the data.
+  std::vector<unsigned char> bytes(data->getSize());
+  data->copy(bytes.data(), 0, (int)bytes.size());
+  delete data;
+
+  Block* truncated = new Block();
+  truncated->append(bytes.data(), bytes.size() - 1);
+  KR_CHECK(KRScene::Load(test_context(), "truncated", truncated) == nullptr);
+}
+
+KR_TEST(scene_binary_rejects_unknown_version)
+{
+  KRScene* scene = CreateTestScene();
+  Block* data = SaveScene(*scene);
+  delete scene;
+
+  std::vector<unsigned char> bytes(data->getSize());
+  data->copy(bytes.data(), 0, (int)bytes.size());
+  delete data;
+
+  uint32_t version = KRSceneBinary::kVersion + 1;
+  memcpy(bytes.data() + offsetof(KRSceneBinaryHeader, version), &version, sizeof(version));
+  Block* future = new Block();
+  future->append(bytes.data(), bytes.size());
+  KR_CHECK(KRScene::Load(test_context(), "future", future) == nullptr);
+}
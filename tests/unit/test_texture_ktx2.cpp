@@ -0,0 +1,301 @@
+//
+//  test_texture_ktx2.cpp
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+#include "KREngine-common.h"
+#include "KRContext.h"
+#include "resources/texture/KRTextureKTX2.h"
+#include "resources/texture/KRTextureCube.h"
+#include "resources/texture/KRTextureManager.h"
+
+#include "zstd.h"
+
+#include "harness.h"
+
+namespace {
+
+// Exposes the region reads used by virtual texturing
+class TestTextureKTX2 : public KRTextureKTX2
+{
+public:
+  using KRTextureKTX2::KRTextureKTX2;
+  using KRTextureKTX2::supportsLodRegionData;
+  using KRTextureKTX2::getLodRegionData;
+};
+
+typedef struct
+{
+  uint32_t width;
+  uint32_t height;
+  uint32_t layers;
+  uint32_t faces;
+  uint32_t levels;
+  uint32_t supercompression;
+} KTX2Info;
+
+const uint32_t kSupercompressionZstd = 2;
+const size_t kHeaderSize = 80;
+const size_t kLevelIndexSize = 24;
+
+void Put32(std::vector<uint8_t>& out, uint32_t value)
+{
+  out.insert(out.end(), (uint8_t*)&value, (uint8_t*)&value + 4);
+}
+
+void Put64(std::vector<uint8_t>& out, uint64_t value)
+{
+  out.insert(out.end(), (uint8_t*)&value, (uint8_t*)&value + 8);
+}
+
+// Uncompressed RGBA8 data of a level, with every layer and face.  The seed
+// distinguishes the contents of different files.
+std::vector<uint8_t> LevelData(const KTX2Info& info, int level, int seed = 0)
+{
+  size_t width = std::max(info.width >> level, 1u);
+  size_t height = std::max(info.height >> level, 1u);
+  std::vector<uint8_t> data(width * height * 4 * std::max(info.layers, 1u) * info.faces);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = (uint8_t)(level * 61 + seed * 29 + i * 7 + i / 251);
+  }
+  return data;
+}
+
+// Writes a KTX2 file with its levels stored smallest first, as the
+// specification recommends, so that the level index is not in file order.
+mimir::Block* CreateKTX2(const KTX2Info& info, size_t level_index_count, int seed = 0)
+{
+  static const uint8_t kIdentifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+  std::vector<uint8_t> file(kIdentifier, kIdentifier + 12);
+  Put32(file, VK_FORMAT_R8G8B8A8_UNORM);
+  Put32(file, 1);
+  Put32(file, info.width);
+  Put32(file, info.height);
+  Put32(file, 0);
+  Put32(file, info.layers);
+  Put32(file, info.faces);
+  Put32(file, info.levels);
+  Put32(file, info.supercompression);
+  for (int i = 0; i < 4; i++) {
+    Put32(file, 0); // No data format descriptor or key/value data
+  }
+  Put64(file, 0);
+  Put64(file, 0);
+
+  std::vector<std::vector<uint8_t>> levels;
+  for (uint32_t level = 0; level < info.levels; level++) {
+    std::vector<uint8_t> data = LevelData(info, level, seed);
+    if (info.supercompression == kSupercompressionZstd) {
+      std::vector<uint8_t> compressed(ZSTD_compressBound(data.size()));
+      compressed.resize(ZSTD_compress(compressed.data(), compressed.size(), data.data(), data.size(), 3));
+      levels.push_back(compressed);
+    } else {
+      levels.push_back(data);
+    }
+  }
+
+  std::vector<uint64_t> offsets(info.levels);
+  size_t offset = kHeaderSize + kLevelIndexSize * info.levels;
+  for (int level = (int)info.levels - 1; level >= 0; level--) {
+    offset = (offset + 7) & ~(size_t)7;
+    offsets[level] = offset;
+    offset += levels[level].size();
+  }
+  for (size_t level = 0; level < level_index_count; level++) {
+    Put64(file, offsets[level]);
+    Put64(file, levels[level].size());
+    Put64(file, LevelData(info, (int)level).size());
+  }
+  if (level_index_count == info.levels) {
+    for (int level = (int)info.levels - 1; level >= 0; level--) {
+      file.resize(offsets[level], 0);
+      file.insert(file.end(), levels[level].begin(), levels[level].end());
+    }
+  }
+
+  mimir::Block* data = new mimir::Block();
+  data->append(file.data(), file.size());
+  return data;
+}
+
+// The levels from lod to the last, as getLodData writes them
+std::vector<uint8_t> ExpectedLodData(const KTX2Info& info, int lod)
+{
+  std::vector<uint8_t> expected;
+  for (int level = lod; level < (int)info.levels; level++) {
+    std::vector<uint8_t> data = LevelData(info, level);
+    expected.insert(expected.end(), data.begin(), data.end());
+  }
+  return expected;
+}
+
+std::vector<uint8_t> GetLodData(KRTextureKTX2& texture, int lod)
+{
+  std::vector<uint8_t> buffer(texture.getMemRequiredForLodRange(lod));
+  if (!texture.getLodData(buffer.data(), lod)) {
+    return std::vector<uint8_t>();
+  }
+  return buffer;
+}
+
+} // anonymous namespace
+
+KR_TEST(ktx2_level_index)
+{
+  KTX2Info info = { 16, 8, 0, 1, 5, 0 };
+  KRTextureKTX2 texture(test_context(), CreateKTX2(info, info.levels), "ktx2_levels");
+  KR_CHECK(texture.getLodCount() == 5);
+  KR_CHECK(texture.getFormat() == VK_FORMAT_R8G8B8A8_UNORM);
+  KR_CHECK(texture.getDimensions().x == 16 && texture.getDimensions().y == 8 && texture.getDimensions().z == 1);
+  KR_CHECK(texture.getLayerCount() == 1);
+  KR_CHECK(texture.getFaceCount() == 1);
+  for (int lod = 0; lod < 5; lod++) {
+    KR_CHECK(texture.getMemRequiredForLod(lod) == (long)LevelData(info, lod).size());
+  }
+
+  KR_CHECK(GetLodData(texture, 0) == ExpectedLodData(info, 0));
+  KR_CHECK(GetLodData(texture, 2) == ExpectedLodData(info, 2));
+  // Levels past the end of the chain are clamped to the smallest level
+  KR_CHECK(GetLodData(texture, 9) == ExpectedLodData(info, 4));
+}
+
+KR_TEST(ktx2_level_region)
+{
+  KTX2Info info = { 16, 8, 0, 1, 5, 0 };
+  TestTextureKTX2 texture(test_context(), CreateKTX2(info, info.levels), "ktx2_region");
+  KR_CHECK(texture.supportsLodRegionData());
+
+  for (int lod = 0; lod < 2; lod++) {
+    const int x = 2 >> lod, y = 2 >> lod, width = 8 >> lod, height = 4 >> lod;
+    const int level_width = 16 >> lod;
+    std::vector<uint8_t> level = LevelData(info, lod);
+    std::vector<uint8_t> expected;
+    for (int row = y; row < y + height; row++) {
+      expected.insert(expected.end(), level.begin() + (row * level_width + x) * 4, level.begin() + (row * level_width + x + width) * 4);
+    }
+    std::vector<uint8_t> region(expected.size());
+    KR_CHECK(texture.getLodRegionData(region.data(), lod, x, y, width, height));
+    KR_CHECK(region == expected);
+  }
+
+  // Regions must lie within the level
+  std::vector<uint8_t> region(16 * 8 * 4);
+  KR_CHECK(!texture.getLodRegionData(region.data(), 0, 12, 0, 8, 4));
+  KR_CHECK(!texture.getLodRegionData(region.data(), 0, 0, 6, 8, 4));
+  KR_CHECK(!texture.getLodRegionData(region.data(), 5, 0, 0, 1, 1));
+}
+
+KR_TEST(ktx2_zstd_supercompression)
+{
+  KTX2Info info = { 32, 32, 0, 1, 6, kSupercompressionZstd };
+  TestTextureKTX2 texture(test_context(), CreateKTX2(info, info.levels), "ktx2_zstd");
+  // Sizes are reported after supercompression is removed
+  KR_CHECK(texture.getMemRequiredForLod(0) == 32 * 32 * 4);
+  KR_CHECK(!texture.supportsLodRegionData());
+  KR_CHECK(GetLodData(texture, 0) == ExpectedLodData(info, 0));
+  KR_CHECK(GetLodData(texture, 3) == ExpectedLodData(info, 3));
+}
+
+KR_TEST(ktx2_array_layers)
+{
+  KTX2Info info = { 8, 8, 3, 1, 4, 0 };
+  KRTextureKTX2 texture(test_context(), CreateKTX2(info, info.levels), "ktx2_array");
+  KR_CHECK(texture.getLayerCount() == 3);
+  KR_CHECK(texture.getMemRequiredForLod(1) == 4 * 4 * 4 * 3);
+  KR_CHECK(GetLodData(texture, 1) == ExpectedLodData(info, 1));
+}
+
+KR_TEST(ktx2_cube_map_faces)
+{
+  // Each level holds the six faces consecutively, as the layers of one copy
+  KTX2Info info = { 8, 8, 0, 6, 4, 0 };
+  KRTextureKTX2 texture(test_context(), CreateKTX2(info, info.levels), "ktx2_cube");
+  KR_CHECK(texture.getFaceCount() == 6);
+  KR_CHECK(texture.getMemRequiredForLod(0) == 8 * 8 * 4 * 6);
+  KR_CHECK(GetLodData(texture, 0) == ExpectedLodData(info, 0));
+}
+
+KR_TEST(ktx2_truncated_level_index)
+{
+  // The file ends part way through its level index
+  KTX2Info info = { 16, 8, 0, 1, 5, 0 };
+  KRTextureKTX2 texture(test_context(), CreateKTX2(info, 2), "ktx2_truncated");
+  KR_CHECK(GetLodData(texture, 0).empty());
+}
+
+KR_TEST(ktx2_level_past_end_of_file)
+{
+  KTX2Info info = { 16, 8, 0, 1, 5, 0 };
+  mimir::Block* data = CreateKTX2(info, info.levels);
+  std::vector<uint8_t> bytes(data->getSize());
+  data->copy(bytes.data(), 0, (int)bytes.size());
+  delete data;
+
+  // Level 0 is stored last, so dropping a byte truncates only that level
+  bytes.pop_back();
+  data = new mimir::Block();
+  data->append(bytes.data(), bytes.size());
+  KRTextureKTX2 texture(test_context(), data, "ktx2_short");
+  KR_CHECK(GetLodData(texture, 0).empty());
+  KR_CHECK(GetLodData(texture, 1) == ExpectedLodData(info, 1));
+}
+
+KR_TEST(cube_map_faces_from_textures)
+{
+  // A cube map made of six 2D textures is uploaded with the faces of each
+  // level interleaved in the same way as a KTX2 cube map
+  static const char* kSuffixes[6] = { "_positive_x", "_negative_x", "_positive_y", "_negative_y", "_positive_z", "_negative_z" };
+  KRTextureManager* textureManager = test_context().getTextureManager();
+  KTX2Info info = { 8, 8, 0, 1, 4, 0 };
+  for (int face = 0; face < 6; face++) {
+    std::string name = std::string("test_cube") + kSuffixes[face];
+    KR_CHECK(textureManager->loadTexture(name.c_str(), "ktx2", CreateKTX2(info, info.levels, face)) != nullptr);
+  }
+
+  KRTextureCube* cube = dynamic_cast<KRTextureCube*>(textureManager->getTextureCube("test_cube"));
+  KR_CHECK(cube != nullptr);
+  if (cube == nullptr) {
+    return;
+  }
+  KR_CHECK(cube->getLodCount() == 4);
+  KR_CHECK(cube->getMemRequiredForLod(1) == 4 * 4 * 4 * 6);
+
+  for (int lod = 0; lod < 2; lod++) {
+    std::vector<uint8_t> expected;
+    for (int level = lod; level < (int)info.levels; level++) {
+      for (int face = 0; face < 6; face++) {
+        std::vector<uint8_t> data = LevelData(info, level, face);
+        expected.insert(expected.end(), data.begin(), data.end());
+      }
+    }
+    std::vector<uint8_t> buffer(cube->getMemRequiredForLodRange(lod));
+    KR_CHECK(cube->getLodData(buffer.data(), lod));
+    KR_CHECK(buffer == expected);
+  }
+}
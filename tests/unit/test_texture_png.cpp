@@ -0,0 +1,571 @@
+//
+//  test_texture_png.cpp
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+#include "KREngine-common.h"
+#include "KRContext.h"
+#include "resources/texture/KRTexturePNG.h"
+
+#include "harness.h"
+
+// PNG files are assembled here from raw scanlines, so that every filter type,
+// deflate block type and chunk layout the decoder supports can be covered
+// without binary fixtures.  The CRCs and Adler-32 checksums are correct,
+// although the decoder does not verify them.
+
+namespace {
+
+enum class Deflate
+{
+  kStored,
+  kFixed,
+  kDynamic
+};
+
+uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc = 0)
+{
+  crc = ~crc;
+  for (size_t i = 0; i < size; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xedb88320u & (0u - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+uint32_t Adler32(const std::vector<uint8_t>& data)
+{
+  uint32_t a = 1, b = 0;
+  for (uint8_t byte : data) {
+    a = (a + byte) % 65521;
+    b = (b + a) % 65521;
+  }
+  return (b << 16) | a;
+}
+
+void PutBigEndian(std::vector<uint8_t>& out, uint32_t value)
+{
+  out.push_back((uint8_t)(value >> 24));
+  out.push_back((uint8_t)(value >> 16));
+  out.push_back((uint8_t)(value >> 8));
+  out.push_back((uint8_t)value);
+}
+
+class BitWriter
+{
+public:
+  BitWriter(std::vector<uint8_t>& out) : m_out(out), m_bits(0), m_count(0) {}
+
+  void put(uint32_t value, int count)
+  {
+    for (int i = 0; i < count; i++) {
+      m_bits |= ((value >> i) & 1) << m_count;
+      if (++m_count == 8) {
+        flush();
+      }
+    }
+  }
+
+  // Huffman codes are packed starting with their most significant bit
+  void putCode(uint32_t code, int length)
+  {
+    for (int i = length - 1; i >= 0; i--) {
+      put((code >> i) & 1, 1);
+    }
+  }
+
+  void align()
+  {
+    if (m_count) {
+      flush();
+    }
+  }
+
+private:
+  void flush()
+  {
+    m_out.push_back((uint8_t)m_bits);
+    m_bits = 0;
+    m_count = 0;
+  }
+
+  std::vector<uint8_t>& m_out;
+  uint32_t m_bits;
+  int m_count;
+};
+
+// Assigns canonical Huffman codes to the given code lengths, as in RFC 1951 3.2.2
+std::vector<uint32_t> CanonicalCodes(const std::vector<int>& lengths)
+{
+  int count[16] = {};
+  for (int length : lengths) {
+    count[length]++;
+  }
+  count[0] = 0;
+  uint32_t next[16] = {};
+  uint32_t code = 0;
+  for (int bits = 1; bits < 16; bits++) {
+    code = (code + count[bits - 1]) << 1;
+    next[bits] = code;
+  }
+  std::vector<uint32_t> codes(lengths.size());
+  for (size_t symbol = 0; symbol < lengths.size(); symbol++) {
+    if (lengths[symbol]) {
+      codes[symbol] = next[lengths[symbol]]++;
+    }
+  }
+  return codes;
+}
+
+// Encodes literals and matches of 3 to 10 bytes at distances of 1 to 4,
+// which need no extra bits.
+void PutHuffmanData(BitWriter& writer, const std::vector<uint8_t>& data, const std::vector<int>& literal_lengths, const std::vector<int>& distance_lengths)
+{
+  std::vector<uint32_t> literal_codes = CanonicalCodes(literal_lengths);
+  std::vector<uint32_t> distance_codes = CanonicalCodes(distance_lengths);
+  size_t i = 0;
+  while (i < data.size()) {
+    size_t best_length = 0;
+    size_t best_distance = 0;
+    for (size_t distance = 1; distance <= 4 && distance <= i; distance++) {
+      size_t length = 0;
+      while (length < 10 && i + length < data.size() && data[i + length] == data[i + length - distance]) {
+        length++;
+      }
+      if (length > best_length) {
+        best_length = length;
+        best_distance = distance;
+      }
+    }
+    if (best_length >= 3) {
+      int symbol = 257 + (int)best_length - 3;
+      writer.putCode(literal_codes[symbol], literal_lengths[symbol]);
+      int distance_symbol = (int)best_distance - 1;
+      writer.putCode(distance_codes[distance_symbol], distance_lengths[distance_symbol]);
+      i += best_length;
+    } else {
+      writer.putCode(literal_codes[data[i]], literal_lengths[data[i]]);
+      i++;
+    }
+  }
+  writer.putCode(literal_codes[256], literal_lengths[256]);
+}
+
+std::vector<uint8_t> Compress(const std::vector<uint8_t>& data, Deflate mode)
+{
+  std::vector<uint8_t> out;
+  out.push_back(0x78);
+  out.push_back(0x01);
+  BitWriter writer(out);
+
+  switch (mode) {
+  case Deflate::kStored:
+  {
+    // Small blocks, so that a stream spans several
+    const size_t kBlockSize = 100;
+    size_t offset = 0;
+    do {
+      size_t length = std::min(kBlockSize, data.size() - offset);
+      writer.put(offset + length == data.size() ? 1 : 0, 1);
+      writer.put(0, 2);
+      writer.align();
+      out.push_back((uint8_t)length);
+      out.push_back((uint8_t)(length >> 8));
+      out.push_back((uint8_t)~length);
+      out.push_back((uint8_t)(~length >> 8));
+      out.insert(out.end(), data.begin() + offset, data.begin() + offset + length);
+      offset += length;
+    } while (offset < data.size());
+    break;
+  }
+  case Deflate::kFixed:
+  {
+    std::vector<int> literal_lengths(288, 8);
+    std::fill(literal_lengths.begin() + 144, literal_lengths.begin() + 256, 9);
+    std::fill(literal_lengths.begin() + 256, literal_lengths.begin() + 280, 7);
+    std::vector<int> distance_lengths(30, 5);
+    writer.put(1, 1);
+    writer.put(1, 2);
+    PutHuffmanData(writer, data, literal_lengths, distance_lengths);
+    writer.align();
+    break;
+  }
+  case Deflate::kDynamic:
+  {
+    // Complete codes that differ from the fixed codes: literals of 9 bits,
+    // lengths of 6 and 5 bits and distances of 5 and 4 bits.
+    std::vector<int> literal_lengths(286, 9);
+    std::fill(literal_lengths.begin() + 256, literal_lengths.begin() + 284, 6);
+    std::fill(literal_lengths.begin() + 284, literal_lengths.end(), 5);
+    std::vector<int> distance_lengths(30, 5);
+    distance_lengths[28] = distance_lengths[29] = 4;
+
+    // The code lengths are sent with a code length code giving 2 bits to
+    // each of the lengths used.
+    static const int kCodeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+    std::vector<int> code_length_lengths(19, 0);
+    code_length_lengths[4] = code_length_lengths[5] = code_length_lengths[6] = code_length_lengths[9] = 2;
+    std::vector<uint32_t> code_length_codes = CanonicalCodes(code_length_lengths);
+    const int kCodeLengthCount = 12; // Up to symbol 4 in kCodeLengthOrder
+
+    writer.put(1, 1);
+    writer.put(2, 2);
+    writer.put((uint32_t)literal_lengths.size() - 257, 5);
+    writer.put((uint32_t)distance_lengths.size() - 1, 5);
+    writer.put(kCodeLengthCount - 4, 4);
+    for (int i = 0; i < kCodeLengthCount; i++) {
+      writer.put(code_length_lengths[kCodeLengthOrder[i]], 3);
+    }
+    for (int length : literal_lengths) {
+      writer.putCode(code_length_codes[length], code_length_lengths[length]);
+    }
+    for (int length : distance_lengths) {
+      writer.putCode(code_length_codes[length], code_length_lengths[length]);
+    }
+    PutHuffmanData(writer, data, literal_lengths, distance_lengths);
+    writer.align();
+    break;
+  }
+  }
+
+  PutBigEndian(out, Adler32(data));
+  return out;
+}
+
+uint8_t PaethPredictor(int a, int b, int c)
+{
+  int p = a + b - c;
+  int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+  if (pa <= pb && pa <= pc) return (uint8_t)a;
+  if (pb <= pc) return (uint8_t)b;
+  return (uint8_t)c;
+}
+
+// Filters each row, cycling through the five filter types, and prefixes
+// each with its filter type.
+void AppendFiltered(std::vector<uint8_t>& out, const std::vector<std::vector<uint8_t>>& rows, int bpp, int first_filter = 0)
+{
+  std::vector<uint8_t> prior;
+  for (size_t y = 0; y < rows.size(); y++) {
+    const std::vector<uint8_t>& row = rows[y];
+    if (prior.empty()) {
+      prior.assign(row.size(), 0);
+    }
+    uint8_t filter = (uint8_t)((y + first_filter) % 5);
+    out.push_back(filter);
+    for (size_t i = 0; i < row.size(); i++) {
+      int a = i >= (size_t)bpp ? row[i - bpp] : 0;
+      int b = prior[i];
+      int c = i >= (size_t)bpp ? prior[i - bpp] : 0;
+      int predicted = 0;
+      switch (filter) {
+      case 1: predicted = a; break;
+      case 2: predicted = b; break;
+      case 3: predicted = (a + b) / 2; break;
+      case 4: predicted = PaethPredictor(a, b, c); break;
+      }
+      out.push_back((uint8_t)(row[i] - predicted));
+    }
+    prior = row;
+  }
+}
+
+typedef struct
+{
+  int width;
+  int height;
+  uint8_t depth;
+  uint8_t colorType;
+  bool interlaced;
+  std::vector<uint8_t> palette;
+  std::vector<uint8_t> transparency;
+} PNGInfo;
+
+void AppendChunk(std::vector<uint8_t>& out, const char* type, const uint8_t* data, size_t size)
+{
+  PutBigEndian(out, (uint32_t)size);
+  size_t start = out.size();
+  out.insert(out.end(), type, type + 4);
+  out.insert(out.end(), data, data + size);
+  PutBigEndian(out, Crc32(out.data() + start, out.size() - start));
+}
+
+// Stores the zlib stream in IDAT chunks of idat_size bytes
+mimir::Block* CreatePNG(const PNGInfo& info, const std::vector<uint8_t>& zlib, size_t idat_size)
+{
+  static const uint8_t kMagic[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+  std::vector<uint8_t> png(kMagic, kMagic + 8);
+
+  std::vector<uint8_t> ihdr;
+  PutBigEndian(ihdr, info.width);
+  PutBigEndian(ihdr, info.height);
+  ihdr.push_back(info.depth);
+  ihdr.push_back(info.colorType);
+  ihdr.push_back(0);
+  ihdr.push_back(0);
+  ihdr.push_back(info.interlaced ? 1 : 0);
+  AppendChunk(png, "IHDR", ihdr.data(), ihdr.size());
+  if (!info.palette.empty()) {
+    AppendChunk(png, "PLTE", info.palette.data(), info.palette.size());
+  }
+  if (!info.transparency.empty()) {
+    AppendChunk(png, "tRNS", info.transparency.data(), info.transparency.size());
+  }
+  for (size_t offset = 0; offset < zlib.size(); offset += idat_size) {
+    AppendChunk(png, "IDAT", zlib.data() + offset, std::min(idat_size, zlib.size() - offset));
+  }
+  AppendChunk(png, "IEND", nullptr, 0);
+
+  mimir::Block* data = new mimir::Block();
+  data->append(png.data(), png.size());
+  return data;
+}
+
+// Decodes the base level, or returns an empty vector on failure
+std::vector<uint8_t> Decode(mimir::Block* data)
+{
+  KRTexturePNG texture(test_context(), data, "test_png");
+  std::vector<uint8_t> buffer(texture.getMemRequiredForLodRange(0));
+  if (!texture.getLodData(buffer.data(), 0)) {
+    return std::vector<uint8_t>();
+  }
+  buffer.resize(texture.getMemRequiredForLod(0));
+  return buffer;
+}
+
+std::vector<uint8_t> TestImageRGBA(int width, int height)
+{
+  std::vector<uint8_t> rgba((size_t)width * height * 4);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      uint8_t* p = &rgba[((size_t)y * width + x) * 4];
+      p[0] = (uint8_t)(x * 7 + y * 3);
+      p[1] = (uint8_t)(x * y);
+      p[2] = (uint8_t)((x / 4) * 40); // Runs of repeated pixels, for matches
+      p[3] = (uint8_t)(255 - y * 5);
+    }
+  }
+  return rgba;
+}
+
+std::vector<std::vector<uint8_t>> Rows(const std::vector<uint8_t>& image, int width, int height, int bytes_per_pixel)
+{
+  std::vector<std::vector<uint8_t>> rows;
+  size_t stride = (size_t)width * bytes_per_pixel;
+  for (int y = 0; y < height; y++) {
+    rows.push_back(std::vector<uint8_t>(image.begin() + y * stride, image.begin() + (y + 1) * stride));
+  }
+  return rows;
+}
+
+// Widths are odd and wider than a 16 byte vector, so that the vectorized
+// filters run with a remainder.
+const int kWidth = 37;
+const int kHeight = 23;
+
+void CheckRGBA(Deflate mode, size_t idat_size)
+{
+  std::vector<uint8_t> rgba = TestImageRGBA(kWidth, kHeight);
+  std::vector<uint8_t> filtered;
+  AppendFiltered(filtered, Rows(rgba, kWidth, kHeight, 4), 4);
+  PNGInfo info = { kWidth, kHeight, 8, 6, false };
+  KR_CHECK(Decode(CreatePNG(info, Compress(filtered, mode), idat_size)) == rgba);
+}
+
+} // anonymous namespace
+
+KR_TEST(png_rgba_stored)
+{
+  CheckRGBA(Deflate::kStored, 4096);
+}
+
+KR_TEST(png_rgba_fixed_huffman)
+{
+  CheckRGBA(Deflate::kFixed, 4096);
+}
+
+KR_TEST(png_rgba_dynamic_huffman)
+{
+  CheckRGBA(Deflate::kDynamic, 4096);
+}
+
+KR_TEST(png_split_idat)
+{
+  // Chunk boundaries fall inside the zlib header, block headers and codes
+  CheckRGBA(Deflate::kStored, 1);
+  CheckRGBA(Deflate::kDynamic, 7);
+}
+
+KR_TEST(png_rgb)
+{
+  std::vector<uint8_t> rgba = TestImageRGBA(kWidth, kHeight);
+  std::vector<uint8_t> rgb;
+  for (size_t i = 0; i < rgba.size(); i += 4) {
+    rgb.insert(rgb.end(), rgba.begin() + i, rgba.begin() + i + 3);
+    rgba[i + 3] = 0xff;
+  }
+  // The first row alternates with the other filter types, as filters that
+  // read the prior row must treat it as zero.
+  for (int first_filter = 0; first_filter < 5; first_filter++) {
+    std::vector<uint8_t> filtered;
+    AppendFiltered(filtered, Rows(rgb, kWidth, kHeight, 3), 3, first_filter);
+    PNGInfo info = { kWidth, kHeight, 8, 2, false };
+    KR_CHECK(Decode(CreatePNG(info, Compress(filtered, Deflate::kFixed), 4096)) == rgba);
+  }
+}
+
+KR_TEST(png_palette_with_transparency)
+{
+  // 4-bit indexes, two per byte, with an odd width leaving half a byte per row
+  PNGInfo info = { kWidth, kHeight, 4, 3, false };
+  for (int i = 0; i < 16; i++) {
+    info.palette.push_back((uint8_t)(i * 16));
+    info.palette.push_back((uint8_t)(255 - i));
+    info.palette.push_back((uint8_t)(i * 3));
+  }
+  // Entries past the end of tRNS are opaque
+  for (int i = 0; i < 10; i++) {
+    info.transparency.push_back((uint8_t)(i * 25));
+  }
+
+  std::vector<std::vector<uint8_t>> rows;
+  std::vector<uint8_t> expected;
+  for (int y = 0; y < kHeight; y++) {
+    std::vector<uint8_t> row((kWidth + 1) / 2, 0);
+    for (int x = 0; x < kWidth; x++) {
+      int index = (x + y) % 16;
+      row[x / 2] |= (uint8_t)(x % 2 ? index : index << 4);
+      expected.push_back(info.palette[index * 3]);
+      expected.push_back(info.palette[index * 3 + 1]);
+      expected.push_back(info.palette[index * 3 + 2]);
+      expected.push_back(index < 10 ? info.transparency[index] : 0xff);
+    }
+    rows.push_back(row);
+  }
+  std::vector<uint8_t> filtered;
+  AppendFiltered(filtered, rows, 1);
+  KR_CHECK(Decode(CreatePNG(info, Compress(filtered, Deflate::kDynamic), 4096)) == expected);
+}
+
+KR_TEST(png_greyscale16_with_transparency_key)
+{
+  const uint16_t kKey = 0x1234;
+  PNGInfo info = { kWidth, kHeight, 16, 0, false };
+  info.transparency.push_back((uint8_t)(kKey >> 8));
+  info.transparency.push_back((uint8_t)kKey);
+
+  std::vector<std::vector<uint8_t>> rows;
+  std::vector<uint8_t> expected;
+  for (int y = 0; y < kHeight; y++) {
+    std::vector<uint8_t> row;
+    for (int x = 0; x < kWidth; x++) {
+      uint16_t grey = (x == y) ? kKey : (uint16_t)(x * 1700 + y * 11);
+      row.push_back((uint8_t)(grey >> 8));
+      row.push_back((uint8_t)grey);
+      expected.push_back((uint8_t)(grey >> 8));
+      expected.push_back((uint8_t)(grey >> 8));
+      expected.push_back((uint8_t)(grey >> 8));
+      expected.push_back(grey == kKey ? 0 : 0xff);
+    }
+    rows.push_back(row);
+  }
+  std::vector<uint8_t> filtered;
+  AppendFiltered(filtered, rows, 2);
+  KR_CHECK(Decode(CreatePNG(info, Compress(filtered, Deflate::kFixed), 4096)) == expected);
+}
+
+KR_TEST(png_adam7_interlaced)
+{
+  static const int pass_x[7] = { 0, 4, 0, 2, 0, 1, 0 };
+  static const int pass_y[7] = { 0, 0, 4, 0, 2, 0, 1 };
+  static const int pass_dx[7] = { 8, 8, 4, 4, 2, 2, 1 };
+  static const int pass_dy[7] = { 8, 8, 8, 4, 4, 2, 2 };
+
+  std::vector<uint8_t> rgba = TestImageRGBA(kWidth, kHeight);
+  std::vector<uint8_t> filtered;
+  for (int pass = 0; pass < 7; pass++) {
+    // Each pass is filtered as a separate image, and empty passes are omitted
+    std::vector<std::vector<uint8_t>> rows;
+    for (int y = pass_y[pass]; y < kHeight; y += pass_dy[pass]) {
+      std::vector<uint8_t> row;
+      for (int x = pass_x[pass]; x < kWidth; x += pass_dx[pass]) {
+        row.insert(row.end(), rgba.begin() + ((size_t)y * kWidth + x) * 4, rgba.begin() + ((size_t)y * kWidth + x + 1) * 4);
+      }
+      if (!row.empty()) {
+        rows.push_back(row);
+      }
+    }
+    AppendFiltered(filtered, rows, 4, pass);
+  }
+  PNGInfo info = { kWidth, kHeight, 8, 6, true };
+  KR_CHECK(Decode(CreatePNG(info, Compress(filtered, Deflate::kDynamic), 4096)) == rgba);
+}
+
+KR_TEST(png_generated_mip_levels)
+{
+  std::vector<uint8_t> rgba = TestImageRGBA(kWidth, kHeight);
+  std::vector<uint8_t> filtered;
+  AppendFiltered(filtered, Rows(rgba, kWidth, kHeight, 4), 4);
+  PNGInfo info = { kWidth, kHeight, 8, 6, false };
+  KRTexturePNG texture(test_context(), CreatePNG(info, Compress(filtered, Deflate::kStored), 4096), "test_png_mips");
+  KR_CHECK(texture.getLodCount() == 6);
+
+  // Requesting level 1 writes level 1 and all smaller levels, with each
+  // texel the rounded average of a 2x2 block of the level above
+  std::vector<uint8_t> buffer(texture.getMemRequiredForLodRange(1));
+  KR_CHECK(texture.getLodData(buffer.data(), 1));
+  int width = kWidth / 2;
+  int height = kHeight / 2;
+  bool match = true;
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      for (int channel = 0; channel < 4; channel++) {
+        int sum = rgba[((size_t)(y * 2) * kWidth + x * 2) * 4 + channel]
+          + rgba[((size_t)(y * 2) * kWidth + x * 2 + 1) * 4 + channel]
+          + rgba[((size_t)(y * 2 + 1) * kWidth + x * 2) * 4 + channel]
+          + rgba[((size_t)(y * 2 + 1) * kWidth + x * 2 + 1) * 4 + channel];
+        match = match && buffer[((size_t)y * width + x) * 4 + channel] == (uint8_t)((sum + 2) >> 2);
+      }
+    }
+  }
+  KR_CHECK(match);
+}
+
+KR_TEST(png_truncated_stream_fails)
+{
+  std::vector<uint8_t> rgba = TestImageRGBA(kWidth, kHeight);
+  std::vector<uint8_t> filtered;
+  AppendFiltered(filtered, Rows(rgba, kWidth, kHeight, 4), 4);
+  std::vector<uint8_t> zlib = Compress(filtered, Deflate::kDynamic);
+  zlib.resize(zlib.size() / 2);
+  PNGInfo info = { kWidth, kHeight, 8, 6, false };
+  KR_CHECK(Decode(CreatePNG(info, zlib, 4096)).empty());
+}
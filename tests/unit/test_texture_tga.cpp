@@ -0,0 +1,194 @@
+//
+//  test_texture_tga.cpp
+//  Kraken Engine
+//
+//  Copyright 2026 Kearwood Gilbert. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without modification, are
+//  permitted provided that the following conditions are met:
+//  
+//  1. Redistributions of source code must retain the above copyright notice, this list of
+//  conditions and the following disclaimer.
+//  
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list
+//  of conditions and the following disclaimer in the documentation and/or other materials
+//  provided with the distribution.
+//  
+//  THIS SOFTWARE IS PROVIDED BY KEARWOOD GILBERT ''AS IS'' AND ANY EXPRESS OR IMPLIED
+//  WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+//  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL KEARWOOD GILBERT OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//  The views and conclusions contained in the software and documentation are those of the
+//  authors and should not be interpreted as representing official policies, either expressed
+//  or implied, of Kearwood Gilbert.
+//
+
+#include "KREngine-common.h"
+#include "KRContext.h"
+#include "resources/texture/KRTextureTGA.h"
+
+#include "harness.h"
+
+namespace {
+
+// Odd, and long enough for the vectorized conversions to leave a remainder
+const int kWidth = 37;
+const int kHeight = 5;
+
+typedef struct
+{
+  uint8_t imageType;
+  uint8_t bitsPerPixel;
+  uint8_t idLength;
+  uint8_t colourMapType;
+} TGAInfo;
+
+std::vector<uint8_t> Header(const TGAInfo& info, int width, int height)
+{
+  // 18 bytes, little endian
+  std::vector<uint8_t> header(18, 0);
+  header[0] = info.idLength;
+  header[1] = info.colourMapType;
+  header[2] = info.imageType;
+  header[12] = (uint8_t)width;
+  header[13] = (uint8_t)(width >> 8);
+  header[14] = (uint8_t)height;
+  header[15] = (uint8_t)(height >> 8);
+  header[16] = info.bitsPerPixel;
+  for (int i = 0; i < info.idLength; i++) {
+    header.push_back((uint8_t)(0xa0 + i));
+  }
+  return header;
+}
+
+// Returns the expected RGBA8 pixels and appends the same pixels as BGR(A)
+std::vector<uint8_t> TestPixels(int bits_per_pixel, std::vector<uint8_t>& bgr)
+{
+  std::vector<uint8_t> rgba;
+  for (int i = 0; i < kWidth * kHeight; i++) {
+    uint8_t r = (uint8_t)(i * 7), g = (uint8_t)(i * 13 + 1), b = (uint8_t)(255 - i), a = (uint8_t)(i * 3 + 5);
+    if (bits_per_pixel == 24) {
+      a = 0xff;
+    }
+    rgba.insert(rgba.end(), { r, g, b, a });
+    bgr.insert(bgr.end(), { b, g, r });
+    if (bits_per_pixel == 32) {
+      bgr.push_back(a);
+    }
+  }
+  return rgba;
+}
+
+// Decodes the image, or returns an empty vector on failure
+std::vector<uint8_t> Decode(const std::vector<uint8_t>& file)
+{
+  mimir::Block* data = new mimir::Block();
+  data->append((void*)file.data(), file.size());
+  KRTextureTGA texture(test_context(), data, "test_tga");
+  std::vector<uint8_t> buffer(texture.getMemRequiredForLod(0));
+  if (!texture.getLodData(buffer.data(), 0)) {
+    return std::vector<uint8_t>();
+  }
+  return buffer;
+}
+
+std::vector<uint8_t> Uncompressed(int bits_per_pixel, std::vector<uint8_t>& expected)
+{
+  TGAInfo info = { 2, (uint8_t)bits_per_pixel, 0, 0 };
+  std::vector<uint8_t> file = Header(info, kWidth, kHeight);
+  expected = TestPixels(bits_per_pixel, file);
+  return file;
+}
+
+// Alternates raw packets and runs.  Packets may cross rows, and the last run
+// claims more pixels than remain in the image.
+std::vector<uint8_t> RunLengthEncoded(int bits_per_pixel, std::vector<uint8_t>& expected)
+{
+  TGAInfo info = { 10, (uint8_t)bits_per_pixel, 3, 0 };
+  std::vector<uint8_t> file = Header(info, kWidth, kHeight);
+  int pixel_size = bits_per_pixel / 8;
+  std::vector<uint8_t> pixels;
+  std::vector<uint8_t> source = TestPixels(bits_per_pixel, pixels);
+
+  int pixel_count = kWidth * kHeight;
+  int i = 0;
+  bool run = false;
+  while (i < pixel_count) {
+    int count = run ? 50 : 23;
+    if (run) {
+      int remaining = pixel_count - i;
+      file.push_back((uint8_t)(0x80 | (count - 1)));
+      file.insert(file.end(), pixels.begin() + i * pixel_size, pixels.begin() + (i + 1) * pixel_size);
+      for (int k = 0; k < count && k < remaining; k++) {
+        expected.insert(expected.end(), source.begin() + i * 4, source.begin() + (i + 1) * 4);
+      }
+    } else {
+      count = std::min(count, pixel_count - i);
+      file.push_back((uint8_t)(count - 1));
+      file.insert(file.end(), pixels.begin() + i * pixel_size, pixels.begin() + (i + count) * pixel_size);
+      expected.insert(expected.end(), source.begin() + i * 4, source.begin() + (i + count) * 4);
+    }
+    i += count;
+    run = !run;
+  }
+  return file;
+}
+
+} // anonymous namespace
+
+KR_TEST(tga_uncompressed_24)
+{
+  std::vector<uint8_t> expected;
+  std::vector<uint8_t> file = Uncompressed(24, expected);
+  KR_CHECK(Decode(file) == expected);
+}
+
+KR_TEST(tga_uncompressed_32)
+{
+  std::vector<uint8_t> expected;
+  std::vector<uint8_t> file = Uncompressed(32, expected);
+  KR_CHECK(Decode(file) == expected);
+}
+
+KR_TEST(tga_run_length_encoded_24)
+{
+  std::vector<uint8_t> expected;
+  std::vector<uint8_t> file = RunLengthEncoded(24, expected);
+  KR_CHECK(Decode(file) == expected);
+}
+
+KR_TEST(tga_run_length_encoded_32)
+{
+  std::vector<uint8_t> expected;
+  std::vector<uint8_t> file = RunLengthEncoded(32, expected);
+  KR_CHECK(Decode(file) == expected);
+}
+
+KR_TEST(tga_truncated_fails)
+{
+  for (int bits_per_pixel = 24; bits_per_pixel <= 32; bits_per_pixel += 8) {
+    std::vector<uint8_t> expected;
+    std::vector<uint8_t> file = Uncompressed(bits_per_pixel, expected);
+    file.pop_back();
+    KR_CHECK(Decode(file).empty());
+
+    expected.clear();
+    file = RunLengthEncoded(bits_per_pixel, expected);
+    file.pop_back();
+    KR_CHECK(Decode(file).empty());
+  }
+}
+
+KR_TEST(tga_colour_map_fails)
+{
+  TGAInfo info = { 2, 24, 0, 1 };
+  std::vector<uint8_t> file = Header(info, kWidth, kHeight);
+  TestPixels(24, file);
+  KR_CHECK(Decode(file).empty());
+}
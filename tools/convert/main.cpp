@@ -31,6 +31,8 @@
 #include "main.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <vector>
 #include <string>
 #include <iostream>
@@ -80,8 +82,26 @@ int main(int argc, char* argv[])
   move_to_bundle_info.sType = KR_STRUCTURE_TYPE_MOVE_TO_BUNDLE;
   move_to_bundle_info.bundleHandle = ResourceMapping::output_bundle;
 
+  KrSetSceneFormatInfo set_scene_format_info = {};
+  set_scene_format_info.sType = KR_STRUCTURE_TYPE_SET_SCENE_FORMAT;
+  set_scene_format_info.sceneHandle = ResourceMapping::loaded_resource;
+  set_scene_format_info.format = KR_SCENE_FORMAT_BINARY;
+
+  KrCompressAnimationCurveInfo compress_animation_curve_info = {};
+  compress_animation_curve_info.sType = KR_STRUCTURE_TYPE_COMPRESS_ANIMATION_CURVE;
+  compress_animation_curve_info.resourceHandle = ResourceMapping::loaded_resource;
+
+  KrCompressTextureInfo compress_texture_info = {};
+  compress_texture_info.sType = KR_STRUCTURE_TYPE_COMPRESS_TEXTURE;
+  compress_texture_info.resourceHandle = ResourceMapping::loaded_resource;
+  compress_texture_info.format = KR_TEXTURE_COMPRESSION_FORMAT_AUTO;
+  compress_texture_info.quality = KR_TEXTURE_COMPRESSION_QUALITY_NORMAL;
+
   char* output_bundle = nullptr;
   bool compile_shaders = false;
+  bool binary_scenes = false;
+  bool compress_curves = false;
+  bool compress_textures = false;
   char* input_list_file = nullptr;
 
   std::vector<std::string> input_files;
@@ -114,9 +134,16 @@ int main(int argc, char* argv[])
         compile_shaders = true;
         command = '\0';
         break;
+      case 'b':
+        binary_scenes = true;
+        command = '\0';
+        break;
+      case 'a':
       case 'i':
       case 'o':
-        // Next arg will be the output path
+      case 'q':
+      case 't':
+        // Next arg will be the parameter of the command
         break;
       default:
         printf("Unknown command: '%s'\n", arg);
@@ -128,10 +155,46 @@ int main(int argc, char* argv[])
 
     // Process commands that receive arguments
     switch (command) {
+    case 'a':
+      compress_curves = true;
+      compress_animation_curve_info.tolerance = strtof(arg, nullptr);
+      command = '\0';
+      continue;
     case 'i':
       input_list_file = arg;
       command = '\0';
       continue;
+    case 'q':
+      if (strcmp(arg, "fast") == 0) {
+        compress_texture_info.quality = KR_TEXTURE_COMPRESSION_QUALITY_FAST;
+      } else if (strcmp(arg, "normal") == 0) {
+        compress_texture_info.quality = KR_TEXTURE_COMPRESSION_QUALITY_NORMAL;
+      } else if (strcmp(arg, "high") == 0) {
+        compress_texture_info.quality = KR_TEXTURE_COMPRESSION_QUALITY_HIGH;
+      } else {
+        printf("Unknown texture compression quality: '%s'.  Expected fast, normal or high.\n", arg);
+        failed = true;
+      }
+      command = '\0';
+      continue;
+    case 't':
+      compress_textures = true;
+      if (strcmp(arg, "auto") == 0) {
+        compress_texture_info.format = KR_TEXTURE_COMPRESSION_FORMAT_AUTO;
+      } else if (strcmp(arg, "bc1") == 0) {
+        compress_texture_info.format = KR_TEXTURE_COMPRESSION_FORMAT_BC1;
+      } else if (strcmp(arg, "bc3") == 0) {
+        compress_texture_info.format = KR_TEXTURE_COMPRESSION_FORMAT_BC3;
+      } else if (strcmp(arg, "bc5") == 0) {
+        compress_texture_info.format = KR_TEXTURE_COMPRESSION_FORMAT_BC5;
+      } else if (strcmp(arg, "bc7") == 0) {
+        compress_texture_info.format = KR_TEXTURE_COMPRESSION_FORMAT_BC7;
+      } else {
+        printf("Unknown texture compression format: '%s'.  Expected auto, bc1, bc3, bc5 or bc7.\n", arg);
+        failed = true;
+      }
+      command = '\0';
+      continue;
     case 'o':
       output_bundle = arg;
       command = '\0';
@@ -169,6 +232,33 @@ int main(int argc, char* argv[])
       failed = true;
       continue;
     }
+    if (binary_scenes) {
+      // Scenes are converted to .krscenebin.  Other resources are unaffected.
+      res = KrSetSceneFormat(&set_scene_format_info);
+      if (res != KR_SUCCESS && res != KR_ERROR_INCORRECT_TYPE) {
+        printf("[FAIL] (KrSetSceneFormat)\n");
+        failed = true;
+        continue;
+      }
+    }
+    if (compress_curves) {
+      // Animation curves are compressed.  Other resources are unaffected.
+      res = KrCompressAnimationCurve(&compress_animation_curve_info);
+      if (res != KR_SUCCESS && res != KR_ERROR_INCORRECT_TYPE) {
+        printf("[FAIL] (KrCompressAnimationCurve)\n");
+        failed = true;
+        continue;
+      }
+    }
+    if (compress_textures) {
+      // Uncompressed textures are block compressed.  Other resources are unaffected.
+      res = KrCompressTexture(&compress_texture_info);
+      if (res != KR_SUCCESS && res != KR_ERROR_INCORRECT_TYPE) {
+        printf("[FAIL] (KrCompressTexture)\n");
+        failed = true;
+        continue;
+      }
+    }
     move_to_bundle_info.resourceHandle = ResourceMapping::loaded_resource;
     res = KrMoveToBundle(&move_to_bundle_info);
     if (res != KR_SUCCESS) {